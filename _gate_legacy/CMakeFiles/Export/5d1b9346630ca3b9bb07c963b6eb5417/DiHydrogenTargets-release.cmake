@@ -0,0 +1,29 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "RELEASE".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "H2::H2Core" for configuration "RELEASE"
+set_property(TARGET H2::H2Core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(H2::H2Core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libH2Core.a"
+  )
+
+list(APPEND _cmake_import_check_targets H2::H2Core )
+list(APPEND _cmake_import_check_files_for_H2::H2Core "${_IMPORT_PREFIX}/lib/libH2Core.a" )
+
+# Import target "H2::distconv" for configuration "RELEASE"
+set_property(TARGET H2::distconv APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(H2::distconv PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libdistconv.a"
+  )
+
+list(APPEND _cmake_import_check_targets H2::distconv )
+list(APPEND _cmake_import_check_files_for_H2::distconv "${_IMPORT_PREFIX}/lib/libdistconv.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,139 @@
+# Generated by CMake
+
+if("${CMAKE_MAJOR_VERSION}.${CMAKE_MINOR_VERSION}" LESS 2.8)
+   message(FATAL_ERROR "CMake >= 2.8.0 required")
+endif()
+if(CMAKE_VERSION VERSION_LESS "2.8.3")
+   message(FATAL_ERROR "CMake >= 2.8.3 required")
+endif()
+cmake_policy(PUSH)
+cmake_policy(VERSION 2.8.3...3.23)
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Protect against multiple inclusion, which would fail when already imported targets are added once more.
+set(_cmake_targets_defined "")
+set(_cmake_targets_not_defined "")
+set(_cmake_expected_targets "")
+foreach(_cmake_expected_target IN ITEMS H2::H2Meta H2::H2Patterns H2::H2Core H2::H2DistConv H2::distconv)
+  list(APPEND _cmake_expected_targets "${_cmake_expected_target}")
+  if(TARGET "${_cmake_expected_target}")
+    list(APPEND _cmake_targets_defined "${_cmake_expected_target}")
+  else()
+    list(APPEND _cmake_targets_not_defined "${_cmake_expected_target}")
+  endif()
+endforeach()
+unset(_cmake_expected_target)
+if(_cmake_targets_defined STREQUAL _cmake_expected_targets)
+  unset(_cmake_targets_defined)
+  unset(_cmake_targets_not_defined)
+  unset(_cmake_expected_targets)
+  unset(CMAKE_IMPORT_FILE_VERSION)
+  cmake_policy(POP)
+  return()
+endif()
+if(NOT _cmake_targets_defined STREQUAL "")
+  string(REPLACE ";" ", " _cmake_targets_defined_text "${_cmake_targets_defined}")
+  string(REPLACE ";" ", " _cmake_targets_not_defined_text "${_cmake_targets_not_defined}")
+  message(FATAL_ERROR "Some (but not all) targets in this export set were already defined.\nTargets Defined: ${_cmake_targets_defined_text}\nTargets not yet defined: ${_cmake_targets_not_defined_text}\n")
+endif()
+unset(_cmake_targets_defined)
+unset(_cmake_targets_not_defined)
+unset(_cmake_expected_targets)
+
+
+# Compute the installation prefix relative to this file.
+get_filename_component(_IMPORT_PREFIX "${CMAKE_CURRENT_LIST_FILE}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+if(_IMPORT_PREFIX STREQUAL "/")
+  set(_IMPORT_PREFIX "")
+endif()
+
+# Create imported target H2::H2Meta
+add_library(H2::H2Meta INTERFACE IMPORTED)
+
+set_target_properties(H2::H2Meta PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_SOURCES "${_IMPORT_PREFIX}/include/h2/meta/Core.hpp;${_IMPORT_PREFIX}/include/h2/meta/PartialFunctions.hpp;${_IMPORT_PREFIX}/include/h2/meta/TypeList.hpp;${_IMPORT_PREFIX}/include/h2/meta/core/Eq.hpp;${_IMPORT_PREFIX}/include/h2/meta/core/IfThenElse.hpp;${_IMPORT_PREFIX}/include/h2/meta/core/Invocable.hpp;${_IMPORT_PREFIX}/include/h2/meta/core/Lazy.hpp;${_IMPORT_PREFIX}/include/h2/meta/core/SFINAE.hpp;${_IMPORT_PREFIX}/include/h2/meta/core/ValueAsType.hpp;${_IMPORT_PREFIX}/include/h2/meta/partial_functions/Apply.hpp;${_IMPORT_PREFIX}/include/h2/meta/partial_functions/MakeFunction.hpp;${_IMPORT_PREFIX}/include/h2/meta/partial_functions/Placeholders.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Append.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/At.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Expand.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Find.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/HaskellAccessors.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Length.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/LispAccessors.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Member.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Remove.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/RemoveAll.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Replace.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/ReplaceAll.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Select.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/SelectAll.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Size.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Sort.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/TypeList.hpp;${_IMPORT_PREFIX}/include/h2/meta/typelist/Unique.hpp"
+)
+
+# Create imported target H2::H2Patterns
+add_library(H2::H2Patterns INTERFACE IMPORTED)
+
+set_target_properties(H2::H2Patterns PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_SOURCES "${_IMPORT_PREFIX}/include/h2/patterns/factory/CopyFactory.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/DefaultErrorPolicy.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/FrozenObjectFactory.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/NullptrErrorPolicy.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/ObjectFactory.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/ObjectPool.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/PooledCopyFactory.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/PooledPrototypeFactory.hpp;${_IMPORT_PREFIX}/include/h2/patterns/factory/PrototypeFactory.hpp;${_IMPORT_PREFIX}/include/h2/patterns/multimethods/SwitchDispatcher.hpp;${_IMPORT_PREFIX}/include/h2/patterns/multimethods/TableDispatcher.hpp;${_IMPORT_PREFIX}/include/h2/patterns/multimethods/ValueDispatcher.hpp"
+)
+
+# Create imported target H2::H2Core
+add_library(H2::H2Core STATIC IMPORTED)
+
+set_target_properties(H2::H2Core PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:>;spdlog::spdlog"
+  INTERFACE_SOURCES "${_IMPORT_PREFIX}/include/h2/Version.hpp;${_IMPORT_PREFIX}/include/h2/gpu/error.hpp;${_IMPORT_PREFIX}/include/h2/gpu/logger.hpp;${_IMPORT_PREFIX}/include/h2/gpu/memory_utils.hpp;${_IMPORT_PREFIX}/include/h2/gpu/runtime.hpp;${_IMPORT_PREFIX}/include/h2/utils/Error.hpp;${_IMPORT_PREFIX}/include/h2/utils/Expected.hpp;${_IMPORT_PREFIX}/include/h2/utils/Logger.hpp"
+)
+
+# Create imported target H2::H2DistConv
+add_library(H2::H2DistConv INTERFACE IMPORTED)
+
+set_target_properties(H2::H2DistConv PROPERTIES
+  INTERFACE_LINK_LIBRARIES "H2::distconv"
+)
+
+# Create imported target H2::distconv
+add_library(H2::distconv STATIC IMPORTED)
+
+set_target_properties(H2::distconv PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "/usr/local/include"
+  INTERFACE_LINK_LIBRARIES "H2::H2Core;MPI::MPI_CXX;OpenMP::OpenMP_CXX"
+)
+
+if(CMAKE_VERSION VERSION_LESS 3.1.0)
+  message(FATAL_ERROR "This file relies on consumers using CMake 3.1.0 or greater.")
+endif()
+
+# Load information for each installed configuration.
+file(GLOB _cmake_config_files "${CMAKE_CURRENT_LIST_DIR}/DiHydrogenTargets-*.cmake")
+foreach(_cmake_config_file IN LISTS _cmake_config_files)
+  include("${_cmake_config_file}")
+endforeach()
+unset(_cmake_config_file)
+unset(_cmake_config_files)
+
+# Cleanup temporary variables.
+set(_IMPORT_PREFIX)
+
+# Loop over all imported files and verify that they actually exist
+foreach(_cmake_target IN LISTS _cmake_import_check_targets)
+  foreach(_cmake_file IN LISTS "_cmake_import_check_files_for_${_cmake_target}")
+    if(NOT EXISTS "${_cmake_file}")
+      message(FATAL_ERROR "The imported target \"${_cmake_target}\" references the file
+   \"${_cmake_file}\"
+but this file does not exist.  Possible reasons include:
+* The file was deleted, renamed, or moved to another location.
+* An install or uninstall procedure did not complete successfully.
+* The installation package was faulty and contained
+   \"${CMAKE_CURRENT_LIST_FILE}\"
+but not all the files it references.
+")
+    endif()
+  endforeach()
+  unset(_cmake_file)
+  unset("_cmake_import_check_files_for_${_cmake_target}")
+endforeach()
+unset(_cmake_target)
+unset(_cmake_import_check_targets)
+
+# This file does not depend on other imported targets which have
+# been exported from the same project but in a separate export set.
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+cmake_policy(POP)
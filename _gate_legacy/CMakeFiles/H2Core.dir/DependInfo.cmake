@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Version.cpp" "CMakeFiles/H2Core.dir/src/Version.cpp.o" "gcc" "CMakeFiles/H2Core.dir/src/Version.cpp.o.d"
+  "/root/repo/src/gpu/logger.cpp" "CMakeFiles/H2Core.dir/src/gpu/logger.cpp.o" "gcc" "CMakeFiles/H2Core.dir/src/gpu/logger.cpp.o.d"
+  "/root/repo/src/utils/Error.cpp" "CMakeFiles/H2Core.dir/src/utils/Error.cpp.o" "gcc" "CMakeFiles/H2Core.dir/src/utils/Error.cpp.o.d"
+  "/root/repo/src/utils/Expected.cpp" "CMakeFiles/H2Core.dir/src/utils/Expected.cpp.o" "gcc" "CMakeFiles/H2Core.dir/src/utils/Expected.cpp.o.d"
+  "/root/repo/src/utils/Logger.cpp" "CMakeFiles/H2Core.dir/src/utils/Logger.cpp.o" "gcc" "CMakeFiles/H2Core.dir/src/utils/Logger.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/H2Core.dir/src/Version.cpp.o"
+  "CMakeFiles/H2Core.dir/src/Version.cpp.o.d"
+  "CMakeFiles/H2Core.dir/src/gpu/logger.cpp.o"
+  "CMakeFiles/H2Core.dir/src/gpu/logger.cpp.o.d"
+  "CMakeFiles/H2Core.dir/src/utils/Error.cpp.o"
+  "CMakeFiles/H2Core.dir/src/utils/Error.cpp.o.d"
+  "CMakeFiles/H2Core.dir/src/utils/Expected.cpp.o"
+  "CMakeFiles/H2Core.dir/src/utils/Expected.cpp.o.d"
+  "CMakeFiles/H2Core.dir/src/utils/Logger.cpp.o"
+  "CMakeFiles/H2Core.dir/src/utils/Logger.cpp.o.d"
+  "libH2Core.a"
+  "libH2Core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/H2Core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
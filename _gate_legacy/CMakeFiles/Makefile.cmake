@@ -0,0 +1,261 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/fmt/fmt-config-version.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-config.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets-release.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets.cmake"
+  "/root/miniconda/lib/cmake/spdlog/spdlogConfig.cmake"
+  "/root/miniconda/lib/cmake/spdlog/spdlogConfigTargets-release.cmake"
+  "/root/miniconda/lib/cmake/spdlog/spdlogConfigTargets.cmake"
+  "/root/miniconda/lib/cmake/spdlog/spdlogConfigVersion.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/config/DiHydrogenConfig.cmake.in"
+  "/root/repo/cmake/config/distconv_config.hpp.in"
+  "/root/repo/cmake/config/h2_config.hpp.in"
+  "/root/repo/cmake/modules/FindSphinx.cmake"
+  "/root/repo/cmake/modules/H2CMakeUtils.cmake"
+  "/root/repo/cmake/modules/H2CXXFeatureDetection.cmake"
+  "/root/repo/cmake/modules/SetupCXX.cmake"
+  "/root/repo/cmake/modules/SetupMPI.cmake"
+  "/root/repo/doc/CMakeLists.txt"
+  "/root/repo/include/h2/CMakeLists.txt"
+  "/root/repo/include/h2/gpu/CMakeLists.txt"
+  "/root/repo/include/h2/meta/CMakeLists.txt"
+  "/root/repo/include/h2/meta/core/CMakeLists.txt"
+  "/root/repo/include/h2/meta/partial_functions/CMakeLists.txt"
+  "/root/repo/include/h2/meta/typelist/CMakeLists.txt"
+  "/root/repo/include/h2/patterns/CMakeLists.txt"
+  "/root/repo/include/h2/patterns/factory/CMakeLists.txt"
+  "/root/repo/include/h2/patterns/multimethods/CMakeLists.txt"
+  "/root/repo/include/h2/utils/CMakeLists.txt"
+  "/root/repo/legacy/CMakeLists.txt"
+  "/root/repo/legacy/benchmarks/CMakeLists.txt"
+  "/root/repo/legacy/benchmarks/cudnn_benchmark_jsrun.sh.in"
+  "/root/repo/legacy/include/CMakeLists.txt"
+  "/root/repo/legacy/include/distconv/CMakeLists.txt"
+  "/root/repo/legacy/include/distconv/dnn_backend/CMakeLists.txt"
+  "/root/repo/legacy/include/distconv/ref/CMakeLists.txt"
+  "/root/repo/legacy/include/distconv/tensor/CMakeLists.txt"
+  "/root/repo/legacy/include/distconv/tensor/algorithms/CMakeLists.txt"
+  "/root/repo/legacy/include/distconv/util/CMakeLists.txt"
+  "/root/repo/legacy/src/CMakeLists.txt"
+  "/root/repo/legacy/src/dnn_backend/CMakeLists.txt"
+  "/root/repo/legacy/src/tensor/CMakeLists.txt"
+  "/root/repo/legacy/src/util/CMakeLists.txt"
+  "/root/repo/legacy/tests/CMakeLists.txt"
+  "/root/repo/legacy/tests/dnn_backend/CMakeLists.txt"
+  "/root/repo/legacy/tests/dnn_backend/chainer_pooling.py"
+  "/root/repo/legacy/tests/dnn_backend/test_convolution_cosmoflow.sh.in"
+  "/root/repo/legacy/tests/dnn_backend/test_cudnn_util.sh.in"
+  "/root/repo/legacy/tests/dnn_backend/test_distconv.sh.in"
+  "/root/repo/legacy/tests/dnn_backend/test_pooling.sh.in"
+  "/root/repo/legacy/tests/tensor/CMakeLists.txt"
+  "/root/repo/legacy/tests/tensor/test_halo_exchange_cuda.sh.in"
+  "/root/repo/legacy/tests/tensor/test_tensor.sh.in"
+  "/root/repo/legacy/tests/tensor/test_tensor_cuda.sh.in"
+  "/root/repo/legacy/tests/tensor/test_tensor_mpi.sh.in"
+  "/root/repo/legacy/tests/tensor/test_tensor_mpi_cuda_algorithms.sh.in"
+  "/root/repo/legacy/tests/tensor/test_tensor_mpi_cuda_copy.sh.in"
+  "/root/repo/legacy/tests/tensor/test_tensor_mpi_shuffle.sh.in"
+  "/root/repo/legacy/tests/test_util.sh.in"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/gpu/CMakeLists.txt"
+  "/root/repo/src/utils/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/static_test/CMakeLists.txt"
+  "/root/repo/test/static_test/meta/CMakeLists.txt"
+  "/root/repo/test/static_test/meta/core/CMakeLists.txt"
+  "/root/repo/test/static_test/meta/partial_functions/CMakeLists.txt"
+  "/root/repo/test/static_test/meta/typelist/CMakeLists.txt"
+  "/root/repo/test/unit_test/CMakeLists.txt"
+  "/root/repo/test/unit_test/gpu/CMakeLists.txt"
+  "/root/repo/test/unit_test/patterns/factory/CMakeLists.txt"
+  "/root/repo/test/unit_test/patterns/multimethods/CMakeLists.txt"
+  "/root/repo/test/unit_test/utils/CMakeLists.txt"
+  "/usr/lib/cmake/Catch2/Catch.cmake"
+  "/usr/lib/cmake/Catch2/Catch2Config.cmake"
+  "/usr/lib/cmake/Catch2/Catch2ConfigVersion.cmake"
+  "/usr/lib/cmake/Catch2/Catch2Targets-none.cmake"
+  "/usr/lib/cmake/Catch2/Catch2Targets.cmake"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-SameMinorVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/FindDoxygen.cmake"
+  "/usr/share/cmake-3.25/Modules/FindMPI.cmake"
+  "/usr/share/cmake-3.25/Modules/FindOpenMP.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "include/h2_config.hpp"
+  "DartConfiguration.tcl"
+  "DiHydrogenConfigVersion.cmake"
+  "DiHydrogenConfig.cmake"
+  "DiHydrogenConfig.install.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/gpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/meta/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/meta/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/meta/partial_functions/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/meta/typelist/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/patterns/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/patterns/factory/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/patterns/multimethods/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/h2/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/gpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/gpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/patterns/factory/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/patterns/multimethods/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/unit_test/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/static_test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/static_test/meta/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/static_test/meta/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/static_test/meta/partial_functions/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/static_test/meta/typelist/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "doc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/distconv_config.hpp"
+  "legacy/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/distconv/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/distconv/util/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/distconv/tensor/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/distconv/tensor/algorithms/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/distconv/ref/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/include/distconv/dnn_backend/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/src/tensor/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/src/dnn_backend/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/src/util/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/tests/test_util.sh"
+  "legacy/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/tests/tensor/test_tensor.sh"
+  "legacy/tests/tensor/test_tensor_cuda.sh"
+  "legacy/tests/tensor/test_tensor_mpi.sh"
+  "legacy/tests/tensor/test_tensor_mpi_shuffle.sh"
+  "legacy/tests/tensor/test_tensor_mpi_cuda_copy.sh"
+  "legacy/tests/tensor/test_halo_exchange_cuda.sh"
+  "legacy/tests/tensor/test_tensor_mpi_cuda_algorithms.sh"
+  "legacy/tests/tensor/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/tests/dnn_backend/test_cudnn_util.sh"
+  "legacy/tests/dnn_backend/test_distconv.sh"
+  "legacy/tests/dnn_backend/test_convolution_cosmoflow.sh"
+  "legacy/tests/dnn_backend/test_pooling.sh"
+  "legacy/tests/dnn_backend/chainer_pooling.py"
+  "legacy/tests/dnn_backend/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "legacy/benchmarks/cudnn_benchmark_jsrun.sh"
+  "legacy/benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/H2Core.dir/DependInfo.cmake"
+  "CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "test/unit_test/CMakeFiles/VersionTestExe.dir/DependInfo.cmake"
+  "test/unit_test/CMakeFiles/LoggerTestExe.dir/DependInfo.cmake"
+  "test/unit_test/CMakeFiles/SeqCatchTests.dir/DependInfo.cmake"
+  "test/static_test/CMakeFiles/StaticTest.dir/DependInfo.cmake"
+  "test/static_test/meta/typelist/CMakeFiles/static_benchmark_typelist.dir/DependInfo.cmake"
+  "test/static_test/meta/typelist/CMakeFiles/static_benchmark_typelist_10.dir/DependInfo.cmake"
+  "test/static_test/meta/typelist/CMakeFiles/static_benchmark_typelist_100.dir/DependInfo.cmake"
+  "test/static_test/meta/typelist/CMakeFiles/static_benchmark_typelist_500.dir/DependInfo.cmake"
+  "legacy/src/CMakeFiles/distconv.dir/DependInfo.cmake"
+  "legacy/tests/CMakeFiles/compare_binary_files.dir/DependInfo.cmake"
+  "legacy/tests/CMakeFiles/test_planner.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_mpi.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_mpi_copy.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_mpi_shuffle.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_file.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_mpi_io.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_checkpoint.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_load_balancer.dir/DependInfo.cmake"
+  "legacy/tests/tensor/CMakeFiles/test_tensor_deep_halo.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/distconv_benchmark.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/distconv_benchmark_pooling.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/distconv_benchmark_bn.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/shuffle_benchmark_host.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/halo_exchange_benchmark_host.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/distconv_planner.dir/DependInfo.cmake"
+  "legacy/benchmarks/CMakeFiles/deep_halo_benchmark_host.dir/DependInfo.cmake"
+  )
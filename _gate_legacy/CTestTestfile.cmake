@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_legacy
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("include/h2")
+subdirs("src")
+subdirs("test")
+subdirs("doc")
+subdirs("legacy")
@@ -0,0 +1,112 @@
+# Generated by CMake
+
+if("${CMAKE_MAJOR_VERSION}.${CMAKE_MINOR_VERSION}" LESS 2.8)
+   message(FATAL_ERROR "CMake >= 2.8.0 required")
+endif()
+if(CMAKE_VERSION VERSION_LESS "2.8.3")
+   message(FATAL_ERROR "CMake >= 2.8.3 required")
+endif()
+cmake_policy(PUSH)
+cmake_policy(VERSION 2.8.3...3.23)
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+if(CMAKE_VERSION VERSION_LESS 3.0.0)
+  message(FATAL_ERROR "This file relies on consumers using CMake 3.0.0 or greater.")
+endif()
+
+# Protect against multiple inclusion, which would fail when already imported targets are added once more.
+set(_cmake_targets_defined "")
+set(_cmake_targets_not_defined "")
+set(_cmake_expected_targets "")
+foreach(_cmake_expected_target IN ITEMS H2::H2Meta H2::H2Patterns H2::H2Core H2::H2DistConv H2::distconv)
+  list(APPEND _cmake_expected_targets "${_cmake_expected_target}")
+  if(TARGET "${_cmake_expected_target}")
+    list(APPEND _cmake_targets_defined "${_cmake_expected_target}")
+  else()
+    list(APPEND _cmake_targets_not_defined "${_cmake_expected_target}")
+  endif()
+endforeach()
+unset(_cmake_expected_target)
+if(_cmake_targets_defined STREQUAL _cmake_expected_targets)
+  unset(_cmake_targets_defined)
+  unset(_cmake_targets_not_defined)
+  unset(_cmake_expected_targets)
+  unset(CMAKE_IMPORT_FILE_VERSION)
+  cmake_policy(POP)
+  return()
+endif()
+if(NOT _cmake_targets_defined STREQUAL "")
+  string(REPLACE ";" ", " _cmake_targets_defined_text "${_cmake_targets_defined}")
+  string(REPLACE ";" ", " _cmake_targets_not_defined_text "${_cmake_targets_not_defined}")
+  message(FATAL_ERROR "Some (but not all) targets in this export set were already defined.\nTargets Defined: ${_cmake_targets_defined_text}\nTargets not yet defined: ${_cmake_targets_not_defined_text}\n")
+endif()
+unset(_cmake_targets_defined)
+unset(_cmake_targets_not_defined)
+unset(_cmake_expected_targets)
+
+
+# Create imported target H2::H2Meta
+add_library(H2::H2Meta INTERFACE IMPORTED)
+
+set_target_properties(H2::H2Meta PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/include"
+  INTERFACE_SOURCES "/root/repo/include/h2/meta/Core.hpp;/root/repo/include/h2/meta/PartialFunctions.hpp;/root/repo/include/h2/meta/TypeList.hpp;/root/repo/include/h2/meta/core/Eq.hpp;/root/repo/include/h2/meta/core/IfThenElse.hpp;/root/repo/include/h2/meta/core/Invocable.hpp;/root/repo/include/h2/meta/core/Lazy.hpp;/root/repo/include/h2/meta/core/SFINAE.hpp;/root/repo/include/h2/meta/core/ValueAsType.hpp;/root/repo/include/h2/meta/partial_functions/Apply.hpp;/root/repo/include/h2/meta/partial_functions/MakeFunction.hpp;/root/repo/include/h2/meta/partial_functions/Placeholders.hpp;/root/repo/include/h2/meta/typelist/Append.hpp;/root/repo/include/h2/meta/typelist/At.hpp;/root/repo/include/h2/meta/typelist/Expand.hpp;/root/repo/include/h2/meta/typelist/Find.hpp;/root/repo/include/h2/meta/typelist/HaskellAccessors.hpp;/root/repo/include/h2/meta/typelist/Length.hpp;/root/repo/include/h2/meta/typelist/LispAccessors.hpp;/root/repo/include/h2/meta/typelist/Member.hpp;/root/repo/include/h2/meta/typelist/Remove.hpp;/root/repo/include/h2/meta/typelist/RemoveAll.hpp;/root/repo/include/h2/meta/typelist/Replace.hpp;/root/repo/include/h2/meta/typelist/ReplaceAll.hpp;/root/repo/include/h2/meta/typelist/Select.hpp;/root/repo/include/h2/meta/typelist/SelectAll.hpp;/root/repo/include/h2/meta/typelist/Size.hpp;/root/repo/include/h2/meta/typelist/Sort.hpp;/root/repo/include/h2/meta/typelist/TypeList.hpp;/root/repo/include/h2/meta/typelist/Unique.hpp"
+)
+
+# Create imported target H2::H2Patterns
+add_library(H2::H2Patterns INTERFACE IMPORTED)
+
+set_target_properties(H2::H2Patterns PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/include"
+  INTERFACE_SOURCES "/root/repo/include/h2/patterns/factory/CopyFactory.hpp;/root/repo/include/h2/patterns/factory/DefaultErrorPolicy.hpp;/root/repo/include/h2/patterns/factory/FrozenObjectFactory.hpp;/root/repo/include/h2/patterns/factory/NullptrErrorPolicy.hpp;/root/repo/include/h2/patterns/factory/ObjectFactory.hpp;/root/repo/include/h2/patterns/factory/ObjectPool.hpp;/root/repo/include/h2/patterns/factory/PooledCopyFactory.hpp;/root/repo/include/h2/patterns/factory/PooledPrototypeFactory.hpp;/root/repo/include/h2/patterns/factory/PrototypeFactory.hpp;/root/repo/include/h2/patterns/multimethods/SwitchDispatcher.hpp;/root/repo/include/h2/patterns/multimethods/TableDispatcher.hpp;/root/repo/include/h2/patterns/multimethods/ValueDispatcher.hpp"
+)
+
+# Create imported target H2::H2Core
+add_library(H2::H2Core STATIC IMPORTED)
+
+set_target_properties(H2::H2Core PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/_gate_legacy/include;/root/repo/include"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:\$<TARGET_NAME_IF_EXISTS:h2_coverage_flags>>;spdlog::spdlog"
+  INTERFACE_SOURCES "/root/repo/include/h2/Version.hpp;/root/repo/include/h2/gpu/error.hpp;/root/repo/include/h2/gpu/logger.hpp;/root/repo/include/h2/gpu/memory_utils.hpp;/root/repo/include/h2/gpu/runtime.hpp;/root/repo/include/h2/utils/Error.hpp;/root/repo/include/h2/utils/Expected.hpp;/root/repo/include/h2/utils/Logger.hpp"
+)
+
+# Create imported target H2::H2DistConv
+add_library(H2::H2DistConv INTERFACE IMPORTED)
+
+set_target_properties(H2::H2DistConv PROPERTIES
+  INTERFACE_LINK_LIBRARIES "H2::distconv"
+)
+
+# Create imported target H2::distconv
+add_library(H2::distconv STATIC IMPORTED)
+
+set_target_properties(H2::distconv PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/_gate_legacy/include;/root/repo/legacy/src/../include"
+  INTERFACE_LINK_LIBRARIES "H2::H2Core;MPI::MPI_CXX;OpenMP::OpenMP_CXX"
+)
+
+# Import target "H2::H2Core" for configuration "RELEASE"
+set_property(TARGET H2::H2Core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(H2::H2Core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "/root/repo/_gate_legacy/libH2Core.a"
+  )
+
+# Import target "H2::distconv" for configuration "RELEASE"
+set_property(TARGET H2::distconv APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(H2::distconv PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "/root/repo/_gate_legacy/legacy/src/libdistconv.a"
+  )
+
+# This file does not depend on other imported targets which have
+# been exported from the same project but in a separate export set.
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+cmake_policy(POP)
@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "h2_config.hpp"
+
+/* #undef DISTCONV_DEBUG */
+
+/* #undef DISTCONV_HAS_CUDA */
+/* #undef DISTCONV_CUDA_VERSION_MAJOR */
+/* #undef DISTCONV_CUDA_VERSION_MINOR */
+#if DISTCONV_CUDA_VERSION_MAJOR >= 10
+#define DISTCONV_HAS_CUDA_GRAPH
+#endif
+/* #undef DISTCONV_HAS_CUDNN */
+/* #undef DISTCONV_HAS_P2P */
+#ifdef DISTCONV_DEBUG
+#define P2P_DEBUG
+#endif // DISTCONV_DEBUG
+/* #undef DISTCONV_HAS_NVSHMEM */
+
+#define DISTCONV_OPTIMIZE_FIND_DESTINATION
+
+/* #undef DISTCONV_EXPLICIT_INSTANTIATION */
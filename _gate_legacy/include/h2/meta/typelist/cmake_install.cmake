@@ -0,0 +1,67 @@
+# Install script for directory: /root/repo/include/h2/meta/typelist
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "RELEASE")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "META" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/h2/meta/typelist" TYPE FILE FILES
+    "/root/repo/include/h2/meta/typelist/Append.hpp"
+    "/root/repo/include/h2/meta/typelist/At.hpp"
+    "/root/repo/include/h2/meta/typelist/Expand.hpp"
+    "/root/repo/include/h2/meta/typelist/Find.hpp"
+    "/root/repo/include/h2/meta/typelist/HaskellAccessors.hpp"
+    "/root/repo/include/h2/meta/typelist/Length.hpp"
+    "/root/repo/include/h2/meta/typelist/LispAccessors.hpp"
+    "/root/repo/include/h2/meta/typelist/Member.hpp"
+    "/root/repo/include/h2/meta/typelist/Remove.hpp"
+    "/root/repo/include/h2/meta/typelist/RemoveAll.hpp"
+    "/root/repo/include/h2/meta/typelist/Replace.hpp"
+    "/root/repo/include/h2/meta/typelist/ReplaceAll.hpp"
+    "/root/repo/include/h2/meta/typelist/Select.hpp"
+    "/root/repo/include/h2/meta/typelist/SelectAll.hpp"
+    "/root/repo/include/h2/meta/typelist/Size.hpp"
+    "/root/repo/include/h2/meta/typelist/Sort.hpp"
+    "/root/repo/include/h2/meta/typelist/TypeList.hpp"
+    "/root/repo/include/h2/meta/typelist/Unique.hpp"
+    )
+endif()
+
@@ -0,0 +1,58 @@
+# Install script for directory: /root/repo/include/h2/patterns/factory
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "RELEASE")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "PATTERNS" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/h2/patterns/factory" TYPE FILE FILES
+    "/root/repo/include/h2/patterns/factory/CopyFactory.hpp"
+    "/root/repo/include/h2/patterns/factory/DefaultErrorPolicy.hpp"
+    "/root/repo/include/h2/patterns/factory/FrozenObjectFactory.hpp"
+    "/root/repo/include/h2/patterns/factory/NullptrErrorPolicy.hpp"
+    "/root/repo/include/h2/patterns/factory/ObjectFactory.hpp"
+    "/root/repo/include/h2/patterns/factory/ObjectPool.hpp"
+    "/root/repo/include/h2/patterns/factory/PooledCopyFactory.hpp"
+    "/root/repo/include/h2/patterns/factory/PooledPrototypeFactory.hpp"
+    "/root/repo/include/h2/patterns/factory/PrototypeFactory.hpp"
+    )
+endif()
+
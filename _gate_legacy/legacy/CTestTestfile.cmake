@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/legacy
+# Build directory: /root/repo/_gate_legacy/legacy
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("include")
+subdirs("src")
+subdirs("tests")
+subdirs("benchmarks")
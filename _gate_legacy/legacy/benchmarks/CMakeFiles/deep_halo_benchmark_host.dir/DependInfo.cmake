@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/legacy/benchmarks/deep_halo_benchmark_host.cpp" "legacy/benchmarks/CMakeFiles/deep_halo_benchmark_host.dir/deep_halo_benchmark_host.cpp.o" "gcc" "legacy/benchmarks/CMakeFiles/deep_halo_benchmark_host.dir/deep_halo_benchmark_host.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_legacy/legacy/src/CMakeFiles/distconv.dir/DependInfo.cmake"
+  "/root/repo/_gate_legacy/CMakeFiles/H2Core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/deep_halo_benchmark_host"
+  "../../bin/deep_halo_benchmark_host.pdb"
+  "CMakeFiles/deep_halo_benchmark_host.dir/deep_halo_benchmark_host.cpp.o"
+  "CMakeFiles/deep_halo_benchmark_host.dir/deep_halo_benchmark_host.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deep_halo_benchmark_host.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
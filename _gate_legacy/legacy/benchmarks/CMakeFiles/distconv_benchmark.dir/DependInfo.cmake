@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/legacy/benchmarks/distconv_benchmark.cpp" "legacy/benchmarks/CMakeFiles/distconv_benchmark.dir/distconv_benchmark.cpp.o" "gcc" "legacy/benchmarks/CMakeFiles/distconv_benchmark.dir/distconv_benchmark.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_legacy/legacy/src/CMakeFiles/distconv.dir/DependInfo.cmake"
+  "/root/repo/_gate_legacy/CMakeFiles/H2Core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
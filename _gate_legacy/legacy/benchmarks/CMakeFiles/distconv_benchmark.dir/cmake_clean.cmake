@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/distconv_benchmark"
+  "../../bin/distconv_benchmark.pdb"
+  "CMakeFiles/distconv_benchmark.dir/distconv_benchmark.cpp.o"
+  "CMakeFiles/distconv_benchmark.dir/distconv_benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/distconv_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/distconv_benchmark_bn"
+  "../../bin/distconv_benchmark_bn.pdb"
+  "CMakeFiles/distconv_benchmark_bn.dir/distconv_benchmark_bn.cpp.o"
+  "CMakeFiles/distconv_benchmark_bn.dir/distconv_benchmark_bn.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/distconv_benchmark_bn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/distconv_benchmark_pooling"
+  "../../bin/distconv_benchmark_pooling.pdb"
+  "CMakeFiles/distconv_benchmark_pooling.dir/distconv_benchmark_pooling.cpp.o"
+  "CMakeFiles/distconv_benchmark_pooling.dir/distconv_benchmark_pooling.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/distconv_benchmark_pooling.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/distconv_planner"
+  "../../bin/distconv_planner.pdb"
+  "CMakeFiles/distconv_planner.dir/distconv_planner.cpp.o"
+  "CMakeFiles/distconv_planner.dir/distconv_planner.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/distconv_planner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/halo_exchange_benchmark_host"
+  "../../bin/halo_exchange_benchmark_host.pdb"
+  "CMakeFiles/halo_exchange_benchmark_host.dir/halo_exchange_benchmark_host.cpp.o"
+  "CMakeFiles/halo_exchange_benchmark_host.dir/halo_exchange_benchmark_host.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/halo_exchange_benchmark_host.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/shuffle_benchmark_host"
+  "../../bin/shuffle_benchmark_host.pdb"
+  "CMakeFiles/shuffle_benchmark_host.dir/shuffle_benchmark_host.cpp.o"
+  "CMakeFiles/shuffle_benchmark_host.dir/shuffle_benchmark_host.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/shuffle_benchmark_host.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
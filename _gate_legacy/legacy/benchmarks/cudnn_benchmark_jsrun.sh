@@ -0,0 +1,4 @@
+#!/usr/bin/env bash
+
+unset LD_PRELOAD
+exec /root/repo/_gate_legacy/bin/cudnn_benchmark $*
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/legacy/include/distconv
+# Build directory: /root/repo/_gate_legacy/legacy/include/distconv
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("util")
+subdirs("tensor")
+subdirs("ref")
+subdirs("dnn_backend")
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/legacy/include/distconv/util
+# Build directory: /root/repo/_gate_legacy/legacy/include/distconv/util
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/legacy/src/checkpoint.cpp" "legacy/src/CMakeFiles/distconv.dir/checkpoint.cpp.o" "gcc" "legacy/src/CMakeFiles/distconv.dir/checkpoint.cpp.o.d"
+  "/root/repo/legacy/src/load_balancer.cpp" "legacy/src/CMakeFiles/distconv.dir/load_balancer.cpp.o" "gcc" "legacy/src/CMakeFiles/distconv.dir/load_balancer.cpp.o.d"
+  "/root/repo/legacy/src/perf_model.cpp" "legacy/src/CMakeFiles/distconv.dir/perf_model.cpp.o" "gcc" "legacy/src/CMakeFiles/distconv.dir/perf_model.cpp.o.d"
+  "/root/repo/legacy/src/planner.cpp" "legacy/src/CMakeFiles/distconv.dir/planner.cpp.o" "gcc" "legacy/src/CMakeFiles/distconv.dir/planner.cpp.o.d"
+  "/root/repo/legacy/src/runtime.cpp" "legacy/src/CMakeFiles/distconv.dir/runtime.cpp.o" "gcc" "legacy/src/CMakeFiles/distconv.dir/runtime.cpp.o.d"
+  "/root/repo/legacy/src/util/util.cpp" "legacy/src/CMakeFiles/distconv.dir/util/util.cpp.o" "gcc" "legacy/src/CMakeFiles/distconv.dir/util/util.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_legacy/CMakeFiles/H2Core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
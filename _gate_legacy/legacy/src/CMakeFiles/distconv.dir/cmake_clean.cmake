@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/distconv.dir/checkpoint.cpp.o"
+  "CMakeFiles/distconv.dir/checkpoint.cpp.o.d"
+  "CMakeFiles/distconv.dir/load_balancer.cpp.o"
+  "CMakeFiles/distconv.dir/load_balancer.cpp.o.d"
+  "CMakeFiles/distconv.dir/perf_model.cpp.o"
+  "CMakeFiles/distconv.dir/perf_model.cpp.o.d"
+  "CMakeFiles/distconv.dir/planner.cpp.o"
+  "CMakeFiles/distconv.dir/planner.cpp.o.d"
+  "CMakeFiles/distconv.dir/runtime.cpp.o"
+  "CMakeFiles/distconv.dir/runtime.cpp.o.d"
+  "CMakeFiles/distconv.dir/util/util.cpp.o"
+  "CMakeFiles/distconv.dir/util/util.cpp.o.d"
+  "libdistconv.a"
+  "libdistconv.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/distconv.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
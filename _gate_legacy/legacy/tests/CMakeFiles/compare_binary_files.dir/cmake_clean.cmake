@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/compare_binary_files"
+  "../../bin/compare_binary_files.pdb"
+  "CMakeFiles/compare_binary_files.dir/compare_binary_files.cpp.o"
+  "CMakeFiles/compare_binary_files.dir/compare_binary_files.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/compare_binary_files.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
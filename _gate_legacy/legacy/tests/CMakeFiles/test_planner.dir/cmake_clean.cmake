@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/test_planner"
+  "../../bin/test_planner.pdb"
+  "CMakeFiles/test_planner.dir/test_planner.cpp.o"
+  "CMakeFiles/test_planner.dir/test_planner.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_planner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
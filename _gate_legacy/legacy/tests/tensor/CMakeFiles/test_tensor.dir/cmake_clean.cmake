@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor"
+  "../../../bin/test_tensor.pdb"
+  "CMakeFiles/test_tensor.dir/test_tensor.cpp.o"
+  "CMakeFiles/test_tensor.dir/test_tensor.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_checkpoint"
+  "../../../bin/test_tensor_checkpoint.pdb"
+  "CMakeFiles/test_tensor_checkpoint.dir/test_tensor_checkpoint.cpp.o"
+  "CMakeFiles/test_tensor_checkpoint.dir/test_tensor_checkpoint.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_checkpoint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_deep_halo"
+  "../../../bin/test_tensor_deep_halo.pdb"
+  "CMakeFiles/test_tensor_deep_halo.dir/test_tensor_deep_halo.cpp.o"
+  "CMakeFiles/test_tensor_deep_halo.dir/test_tensor_deep_halo.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_deep_halo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
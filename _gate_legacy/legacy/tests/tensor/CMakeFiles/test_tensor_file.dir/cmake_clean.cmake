@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_file"
+  "../../../bin/test_tensor_file.pdb"
+  "CMakeFiles/test_tensor_file.dir/test_tensor_file.cpp.o"
+  "CMakeFiles/test_tensor_file.dir/test_tensor_file.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_load_balancer"
+  "../../../bin/test_tensor_load_balancer.pdb"
+  "CMakeFiles/test_tensor_load_balancer.dir/test_tensor_load_balancer.cpp.o"
+  "CMakeFiles/test_tensor_load_balancer.dir/test_tensor_load_balancer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_load_balancer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
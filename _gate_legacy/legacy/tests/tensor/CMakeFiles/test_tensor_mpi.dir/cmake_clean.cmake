@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_mpi"
+  "../../../bin/test_tensor_mpi.pdb"
+  "CMakeFiles/test_tensor_mpi.dir/test_tensor_mpi.cpp.o"
+  "CMakeFiles/test_tensor_mpi.dir/test_tensor_mpi.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_mpi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_mpi_copy"
+  "../../../bin/test_tensor_mpi_copy.pdb"
+  "CMakeFiles/test_tensor_mpi_copy.dir/test_tensor_mpi_copy.cpp.o"
+  "CMakeFiles/test_tensor_mpi_copy.dir/test_tensor_mpi_copy.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_mpi_copy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
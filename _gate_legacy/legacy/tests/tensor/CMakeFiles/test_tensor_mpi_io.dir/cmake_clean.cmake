@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_mpi_io"
+  "../../../bin/test_tensor_mpi_io.pdb"
+  "CMakeFiles/test_tensor_mpi_io.dir/test_tensor_mpi_io.cpp.o"
+  "CMakeFiles/test_tensor_mpi_io.dir/test_tensor_mpi_io.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_mpi_io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/test_tensor_mpi_shuffle"
+  "../../../bin/test_tensor_mpi_shuffle.pdb"
+  "CMakeFiles/test_tensor_mpi_shuffle.dir/test_tensor_mpi_shuffle.cpp.o"
+  "CMakeFiles/test_tensor_mpi_shuffle.dir/test_tensor_mpi_shuffle.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_mpi_shuffle.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+
+set -u
+set -e
+
+. /root/repo/_gate_legacy/legacy/tests/tensor/../test_util.sh
+TEST_NAME=test_tensor_cuda
+BUILD_DIR=/root/repo/_gate_legacy/legacy/tests/tensor
+
+$BUILD_DIR/$TEST_NAME
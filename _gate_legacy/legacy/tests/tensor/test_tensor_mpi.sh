@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+
+set -u
+
+. /root/repo/_gate_legacy/legacy/tests/tensor/../test_util.sh
+HOSTFILE=/dev/null
+TEST_NAME=test_tensor_mpi
+BUILD_DIR=/root/repo/_gate_legacy/legacy/tests/tensor
+
+if ! mpi_run_host 8 $HOSTFILE $BUILD_DIR/$TEST_NAME; then
+    echo "Failed"
+fi
+
+if ! mpi_run_host 16 $HOSTFILE $BUILD_DIR/$TEST_NAME; then
+    echo "Failed"
+fi
+
+if ! mpi_run_host 32 $HOSTFILE $BUILD_DIR/$TEST_NAME; then
+    echo "Failed"
+fi
+
+echo "Completed successfully"
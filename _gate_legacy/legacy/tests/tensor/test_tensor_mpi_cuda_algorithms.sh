@@ -0,0 +1,55 @@
+#!/usr/bin/env bash
+
+set -u
+set -e
+
+. /root/repo/_gate_legacy/legacy/tests/tensor/../test_util.sh
+NUM_RUNS=1
+HOSTFILE=/dev/null
+TEST_NAME=test_tensor_mpi_cuda_algorithms
+BUILD_DIR=/root/repo/_gate_legacy/legacy/tests/tensor
+###
+TIMESTAMP=$(date +%Y%m%d_%H%M%S)
+LOG=$TEST_NAME.$TIMESTAMP.log
+##############
+OPTS=`getopt -o h --long host-file:,num-runs: -- "$@"`
+if [ $? != 0 ]; then echo Failed parsing options. >&2; exit 1; fi
+eval set -- $OPTS
+while true; do
+	case $1 in
+		--host-file)
+			HOSTFILE=$2
+			shift 2
+			;;
+		--num-runs)
+			NUM_RUNS=$2
+			shift 2
+			;;
+		--)
+			shift; break
+			;;
+		*)
+			echo "Invalid option" >&2
+			exit 1
+			;;
+	esac
+done
+
+NUM_PROCS=(4 8 16)
+
+echo "Start running tests"
+echo "Output is saved in $LOG"
+for i in $(seq $NUM_RUNS); do
+	for np in "${NUM_PROCS[@]}"; do
+		echo "Testing $BUILD_DIR/$TEST_NAME with $np procs" 2>&1 |tee -a $LOG
+		set +e
+		mpi_run $np $HOSTFILE $BUILD_DIR/$TEST_NAME >> $LOG 2>&1
+		if [ $? -ne  0 ]; then
+			echo "Test failed"
+			exit 1
+		fi
+		set -e
+	done
+done
+
+echo "Completed successfully"
@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/static_test/meta/core/static_test_eq.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_eq.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_eq.cpp.o.d"
+  "/root/repo/test/static_test/meta/core/static_test_ifthenelse.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_ifthenelse.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_ifthenelse.cpp.o.d"
+  "/root/repo/test/static_test/meta/core/static_test_invocable.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_invocable.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_invocable.cpp.o.d"
+  "/root/repo/test/static_test/meta/core/static_test_lazy.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_lazy.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_lazy.cpp.o.d"
+  "/root/repo/test/static_test/meta/core/static_test_sfinae.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_sfinae.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_sfinae.cpp.o.d"
+  "/root/repo/test/static_test/meta/core/static_test_value_as_type.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_value_as_type.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/core/static_test_value_as_type.cpp.o.d"
+  "/root/repo/test/static_test/meta/partial_functions/static_test_apply.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_apply.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_apply.cpp.o.d"
+  "/root/repo/test/static_test/meta/partial_functions/static_test_placeholders.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_placeholders.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_placeholders.cpp.o.d"
+  "/root/repo/test/static_test/meta/static_test_core.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/static_test_core.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/static_test_core.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_accessors.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_accessors.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_accessors.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_append.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_append.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_append.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_at.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_at.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_at.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_expand.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_expand.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_expand.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_find.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_find.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_find.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_length.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_length.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_length.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_member.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_member.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_member.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_remove.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_remove.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_remove.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_removeall.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_removeall.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_removeall.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_replace.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_replace.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_replace.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_replaceall.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_replaceall.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_replaceall.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_select.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_select.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_select.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_selectall.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_selectall.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_selectall.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_sort.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_sort.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_sort.cpp.o.d"
+  "/root/repo/test/static_test/meta/typelist/static_test_unique.cpp" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_unique.cpp.o" "gcc" "test/static_test/CMakeFiles/StaticTest.dir/meta/typelist/static_test_unique.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_eq.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_eq.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_ifthenelse.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_ifthenelse.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_invocable.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_invocable.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_lazy.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_lazy.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_sfinae.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_sfinae.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_value_as_type.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/core/static_test_value_as_type.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_apply.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_apply.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_placeholders.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/partial_functions/static_test_placeholders.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/static_test_core.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/static_test_core.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_accessors.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_accessors.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_append.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_append.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_at.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_at.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_expand.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_expand.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_find.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_find.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_length.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_length.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_member.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_member.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_remove.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_remove.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_removeall.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_removeall.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_replace.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_replace.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_replaceall.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_replaceall.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_select.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_select.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_selectall.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_selectall.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_sort.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_sort.cpp.o.d"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_unique.cpp.o"
+  "CMakeFiles/StaticTest.dir/meta/typelist/static_test_unique.cpp.o.d"
+  "libStaticTest.pdb"
+  "libStaticTest.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/StaticTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/static_test/meta
+# Build directory: /root/repo/_gate_legacy/test/static_test/meta
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("core")
+subdirs("partial_functions")
+subdirs("typelist")
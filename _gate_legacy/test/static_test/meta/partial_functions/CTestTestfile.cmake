@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/static_test/meta/partial_functions
+# Build directory: /root/repo/_gate_legacy/test/static_test/meta/partial_functions
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
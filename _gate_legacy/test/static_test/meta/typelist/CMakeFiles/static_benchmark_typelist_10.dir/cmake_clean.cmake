@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/static_benchmark_typelist_10.dir/static_benchmark_typelist.cpp.o"
+  "CMakeFiles/static_benchmark_typelist_10.dir/static_benchmark_typelist.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/static_benchmark_typelist_10.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/LoggerTestExe"
+  "../../bin/LoggerTestExe.pdb"
+  "CMakeFiles/LoggerTestExe.dir/LoggerTest.cpp.o"
+  "CMakeFiles/LoggerTestExe.dir/LoggerTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LoggerTestExe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/unit_test/SequentialCatchMain.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/SequentialCatchMain.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/SequentialCatchMain.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/factory/unit_test_copy_factory.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_copy_factory.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_copy_factory.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/factory/unit_test_frozen_object_factory.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_frozen_object_factory.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_frozen_object_factory.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/factory/unit_test_object_factory.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_object_factory.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_object_factory.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/factory/unit_test_pooled_factory.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_pooled_factory.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_pooled_factory.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/factory/unit_test_prototype_factory.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_prototype_factory.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_prototype_factory.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/multimethods/unit_test_switch_dispatcher.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_switch_dispatcher.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_switch_dispatcher.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/multimethods/unit_test_table_dispatcher.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_table_dispatcher.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_table_dispatcher.cpp.o.d"
+  "/root/repo/test/unit_test/patterns/multimethods/unit_test_value_dispatcher.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_value_dispatcher.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_value_dispatcher.cpp.o.d"
+  "/root/repo/test/unit_test/utils/unit_test_expected.cpp" "test/unit_test/CMakeFiles/SeqCatchTests.dir/utils/unit_test_expected.cpp.o" "gcc" "test/unit_test/CMakeFiles/SeqCatchTests.dir/utils/unit_test_expected.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_legacy/CMakeFiles/H2Core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,30 @@
+file(REMOVE_RECURSE
+  "../../bin/SeqCatchTests"
+  "../../bin/SeqCatchTests.pdb"
+  "CMakeFiles/SeqCatchTests.dir/SequentialCatchMain.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/SequentialCatchMain.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_copy_factory.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_copy_factory.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_frozen_object_factory.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_frozen_object_factory.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_object_factory.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_object_factory.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_pooled_factory.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_pooled_factory.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_prototype_factory.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/factory/unit_test_prototype_factory.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_switch_dispatcher.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_switch_dispatcher.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_table_dispatcher.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_table_dispatcher.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_value_dispatcher.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/patterns/multimethods/unit_test_value_dispatcher.cpp.o.d"
+  "CMakeFiles/SeqCatchTests.dir/utils/unit_test_expected.cpp.o"
+  "CMakeFiles/SeqCatchTests.dir/utils/unit_test_expected.cpp.o.d"
+  "SeqCatchTests_tests-b12d07c.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SeqCatchTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/VersionTestExe"
+  "../../bin/VersionTestExe.pdb"
+  "CMakeFiles/VersionTestExe.dir/VersionTest.cpp.o"
+  "CMakeFiles/VersionTestExe.dir/VersionTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VersionTestExe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
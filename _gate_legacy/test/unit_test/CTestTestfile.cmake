@@ -0,0 +1,13 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/unit_test
+# Build directory: /root/repo/_gate_legacy/test/unit_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_gate_legacy/test/unit_test/SeqCatchTests_include-b12d07c.cmake")
+add_test([===[[==[Testing the Version String.]==]]===] "/root/repo/_gate_legacy/bin/VersionTestExe")
+set_tests_properties([===[[==[Testing the Version String.]==]]===] PROPERTIES  PASS_REGULAR_EXPRESSION "0.3.0" WORKING_DIRECTORY "/root/repo/_gate_legacy/test/unit_test" _BACKTRACE_TRIPLES "/root/repo/test/unit_test/CMakeLists.txt;41;add_test;/root/repo/test/unit_test/CMakeLists.txt;0;")
+subdirs("gpu")
+subdirs("patterns/factory")
+subdirs("patterns/multimethods")
+subdirs("utils")
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_gate_legacy/test/unit_test/SeqCatchTests_tests-b12d07c.cmake")
+  include("/root/repo/_gate_legacy/test/unit_test/SeqCatchTests_tests-b12d07c.cmake")
+else()
+  add_test(SeqCatchTests_NOT_BUILT-b12d07c SeqCatchTests_NOT_BUILT-b12d07c)
+endif()
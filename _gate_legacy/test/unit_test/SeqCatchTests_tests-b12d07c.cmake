@@ -0,0 +1,35 @@
+add_test( [==[testing the copy factory class]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the copy factory class]==]  )
+set_tests_properties( [==[testing the copy factory class]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the frozen factory class - std::string]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the frozen factory class - std::string]==]  )
+set_tests_properties( [==[testing the frozen factory class - std::string]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the frozen factory class - int]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the frozen factory class - int]==]  )
+set_tests_properties( [==[testing the frozen factory class - int]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Frozen factory with arguments and stateful builders]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Frozen factory with arguments and stateful builders]==]  )
+set_tests_properties( [==[Frozen factory with arguments and stateful builders]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( InplaceBuilder /root/repo/_gate_legacy/bin/SeqCatchTests InplaceBuilder  )
+set_tests_properties( InplaceBuilder PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the factory class - std::string]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the factory class - std::string]==]  )
+set_tests_properties( [==[testing the factory class - std::string]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the factory class - int]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the factory class - int]==]  )
+set_tests_properties( [==[testing the factory class - int]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the object pool]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the object pool]==]  )
+set_tests_properties( [==[testing the object pool]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the pooled prototype factory class]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the pooled prototype factory class]==]  )
+set_tests_properties( [==[testing the pooled prototype factory class]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the pooled copy factory class]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the pooled copy factory class]==]  )
+set_tests_properties( [==[testing the pooled copy factory class]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Recycled copies match their source]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Recycled copies match their source]==]  )
+set_tests_properties( [==[Recycled copies match their source]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[testing the prototype factory class]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[testing the prototype factory class]==]  )
+set_tests_properties( [==[testing the prototype factory class]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Switch dispatcher]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Switch dispatcher]==]  )
+set_tests_properties( [==[Switch dispatcher]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Table dispatcher]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Table dispatcher]==]  )
+set_tests_properties( [==[Table dispatcher]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Value dispatcher]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Value dispatcher]==]  )
+set_tests_properties( [==[Value dispatcher]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Expected holds a value or an error]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Expected holds a value or an error]==]  )
+set_tests_properties( [==[Expected holds a value or an error]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+add_test( [==[Expected<void> propagates errors]==] /root/repo/_gate_legacy/bin/SeqCatchTests [==[Expected<void> propagates errors]==]  )
+set_tests_properties( [==[Expected<void> propagates errors]==] PROPERTIES WORKING_DIRECTORY /root/repo/_gate_legacy/test/unit_test)
+set( SeqCatchTests_TESTS [==[testing the copy factory class]==] [==[testing the frozen factory class - std::string]==] [==[testing the frozen factory class - int]==] [==[Frozen factory with arguments and stateful builders]==] InplaceBuilder [==[testing the factory class - std::string]==] [==[testing the factory class - int]==] [==[testing the object pool]==] [==[testing the pooled prototype factory class]==] [==[testing the pooled copy factory class]==] [==[Recycled copies match their source]==] [==[testing the prototype factory class]==] [==[Switch dispatcher]==] [==[Table dispatcher]==] [==[Value dispatcher]==] [==[Expected holds a value or an error]==] [==[Expected<void> propagates errors]==])
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/unit_test/patterns/factory
+# Build directory: /root/repo/_gate_legacy/test/unit_test/patterns/factory
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
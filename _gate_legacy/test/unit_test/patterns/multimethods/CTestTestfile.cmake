@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/unit_test/patterns/multimethods
+# Build directory: /root/repo/_gate_legacy/test/unit_test/patterns/multimethods
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#ifndef H2_INCLUDE_H2_GPU_HOST_ALLOCATOR_HPP_INCLUDED
+#define H2_INCLUDE_H2_GPU_HOST_ALLOCATOR_HPP_INCLUDED
+
+/** @file
+ *
+ *  A caching allocator for emulated device memory. It follows the
+ *  interface and the binning policy of {cub,hipcub}::
+ *  CachingDeviceAllocator so that code written against
+ *  default_cub_allocator() works unchanged.
+ */
+
+#include "h2/gpu/runtime.hpp"
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace h2
+{
+namespace gpu
+{
+namespace host
+{
+
+class CachingHostAllocator
+{
+public:
+    static constexpr unsigned int INVALID_BIN = static_cast<unsigned int>(-1);
+    static constexpr std::size_t INVALID_SIZE = static_cast<std::size_t>(-1);
+
+    /** @brief Construct an allocator.
+     *
+     *  Requests are rounded up to the next power of bin_growth no
+     *  smaller than bin_growth^min_bin. Requests larger than
+     *  bin_growth^max_bin are allocated exactly and never cached. At
+     *  most max_cached_bytes are kept in the cache.
+     */
+    CachingHostAllocator(unsigned int bin_growth,
+                         unsigned int min_bin = 1,
+                         unsigned int max_bin = INVALID_BIN,
+                         std::size_t max_cached_bytes = INVALID_SIZE,
+                         bool skip_cleanup = false,
+                         bool debug = false);
+    ~CachingHostAllocator();
+
+    CachingHostAllocator(CachingHostAllocator const&) = delete;
+    CachingHostAllocator& operator=(CachingHostAllocator const&) = delete;
+
+    /** @brief Allocate a block for use on the given stream.
+     *
+     *  A cached block is reused if it was freed on the same stream or
+     *  if all work on its stream at the time it was freed has
+     *  completed.
+     */
+    DeviceError DeviceAllocate(void** ptr,
+                               std::size_t bytes,
+                               DeviceStream stream = nullptr);
+
+    /** @brief Return a block to the cache. */
+    DeviceError DeviceFree(void* ptr);
+
+    /** @brief Release all cached blocks. */
+    DeviceError FreeAllCached();
+
+    std::size_t cached_bytes() const;
+    std::size_t live_bytes() const;
+
+private:
+    struct Block
+    {
+        void* ptr;
+        std::size_t bytes;
+        unsigned int bin;
+        DeviceStream stream;
+        DeviceEvent ready;
+    };
+
+    void get_bin(std::size_t bytes,
+                 unsigned int& bin,
+                 std::size_t& rounded) const noexcept;
+    // Return the memory to the system. The caller ensures that no
+    // work on it is outstanding.
+    void release(Block& block);
+
+    mutable std::mutex m_mtx;
+    unsigned int m_bin_growth;
+    unsigned int m_min_bin;
+    std::size_t m_min_bin_bytes;
+    std::size_t m_max_bin_bytes;
+    std::size_t m_max_cached_bytes;
+    bool m_skip_cleanup;
+    bool m_debug;
+
+    std::multimap<unsigned int, Block> m_cached;
+    std::unordered_map<void*, Block> m_live;
+    std::size_t m_cached_bytes = 0;
+    std::size_t m_live_bytes = 0;
+}; // class CachingHostAllocator
+
+} // namespace host
+} // namespace gpu
+} // namespace h2
+#endif // H2_INCLUDE_H2_GPU_HOST_ALLOCATOR_HPP_INCLUDED
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#ifndef H2_INCLUDE_H2_GPU_HOST_MEMORY_UTILS_HPP_INCLUDED
+#define H2_INCLUDE_H2_GPU_HOST_MEMORY_UTILS_HPP_INCLUDED
+
+/** @file
+ *
+ *  Host emulation of the GPU memory functions. "Device" memory is
+ *  host memory, so copies and fills are memcpy and memset, run either
+ *  immediately or as tasks on a stream.
+ */
+
+#include "h2/gpu/logger.hpp"
+#include "h2/gpu/runtime.hpp"
+#include "h2_config.hpp"
+
+#include <cstring>
+
+namespace h2
+{
+namespace gpu
+{
+namespace host
+{
+class CachingHostAllocator;
+} // namespace host
+
+using RawCUBAllocType = host::CachingHostAllocator;
+
+MemInfo mem_info();
+
+/** @brief Synchronous copy.
+ *
+ *  This first waits for the default stream, like cudaMemcpy does.
+ */
+inline void mem_copy(void* dst, void const* src, size_t bytes)
+{
+    H2_GPU_TRACE("memcpy(dst={}, src={}, bytes={})", dst, src, bytes);
+    sync(DeviceStream{nullptr});
+    std::memcpy(dst, src, bytes);
+}
+
+inline void
+mem_copy(void* dst, void const* src, size_t bytes, DeviceStream stream)
+{
+    H2_GPU_TRACE("memcpy async(dst={}, src={}, bytes={}, stream={})",
+                 dst,
+                 src,
+                 bytes,
+                 (void*) stream);
+    launch(stream, [=]() { std::memcpy(dst, src, bytes); });
+}
+
+inline void mem_zero(void* mem, size_t bytes)
+{
+    H2_GPU_TRACE("memset(mem={}, value=0x0, bytes={})", mem, bytes);
+    sync(DeviceStream{nullptr});
+    std::memset(mem, 0x0, bytes);
+}
+
+inline void mem_zero(void* mem, size_t bytes, DeviceStream stream)
+{
+    H2_GPU_TRACE("memset async(mem={}, value=0x0, bytes={}, stream={})",
+                 mem,
+                 bytes,
+                 (void*) stream);
+    launch(stream, [=]() { std::memset(mem, 0x0, bytes); });
+}
+
+} // namespace gpu
+} // namespace h2
+#endif // H2_INCLUDE_H2_GPU_HOST_MEMORY_UTILS_HPP_INCLUDED
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#ifndef H2_INCLUDE_H2_GPU_HOST_RUNTIME_HPP_INCLUDED
+#define H2_INCLUDE_H2_GPU_HOST_RUNTIME_HPP_INCLUDED
+
+/** @file
+ *
+ *  Host emulation of the GPU runtime. There is exactly one "device",
+ *  the host itself. A stream is an in-order queue of tasks that are
+ *  run by a dedicated worker thread; an event is a completion flag
+ *  that is set (and optionally timestamped) when the worker reaches
+ *  it. The null stream is a valid, lazily-created default stream.
+ *
+ *  Unlike CUDA's legacy default stream, the default stream does not
+ *  implicitly synchronize with other streams; every stream behaves
+ *  as if created with make_stream_nonblocking(). Use events to order
+ *  work across streams.
+ */
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace h2
+{
+namespace gpu
+{
+namespace host
+{
+class Stream;
+class Event;
+} // namespace host
+
+typedef host::Stream* DeviceStream;
+typedef host::Event* DeviceEvent;
+
+enum class DeviceError
+{
+    Success = 0,
+    InvalidValue,
+    MemoryAllocation,
+    NotReady,
+    TaskFailed,
+};
+
+inline bool ok(DeviceError status) noexcept
+{
+    return (status == DeviceError::Success);
+}
+
+inline char const* error_name(DeviceError status) noexcept
+{
+    switch (status)
+    {
+    case DeviceError::Success: return "hostSuccess";
+    case DeviceError::InvalidValue: return "hostErrorInvalidValue";
+    case DeviceError::MemoryAllocation: return "hostErrorMemoryAllocation";
+    case DeviceError::NotReady: return "hostErrorNotReady";
+    case DeviceError::TaskFailed: return "hostErrorTaskFailed";
+    }
+    return "hostErrorUnknown";
+}
+
+inline char const* error_string(DeviceError status) noexcept
+{
+    switch (status)
+    {
+    case DeviceError::Success: return "no error";
+    case DeviceError::InvalidValue: return "invalid argument";
+    case DeviceError::MemoryAllocation: return "out of memory";
+    case DeviceError::NotReady: return "work not yet complete";
+    case DeviceError::TaskFailed: return "a task on the stream threw";
+    }
+    return "unknown error";
+}
+
+/** @brief Enqueue a host task on a stream.
+ *
+ *  This is the emulation counterpart of a kernel launch: the task runs
+ *  on the stream's worker thread after all previously enqueued work.
+ *  If it throws, the exception is rethrown by the next sync on the
+ *  stream (or on the device).
+ */
+void launch(DeviceStream stream, std::function<void()> task);
+
+/** @brief Whether all work enqueued on the stream has completed. */
+bool query(DeviceStream stream);
+
+} // namespace gpu
+} // namespace h2
+#endif // H2_INCLUDE_H2_GPU_HOST_RUNTIME_HPP_INCLUDED
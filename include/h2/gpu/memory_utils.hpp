@@ -22,6 +22,7 @@
  *  MemInfo mem_info();
  *
  *  typedef {cub,hipcub}::CachingDeviceAllocator RawCUBAllocType;
+ *  (host::CachingHostAllocator with the host emulation.)
  *  RawCUBAllocType& default_cub_allocator();
  *
  *  void mem_copy(void* dst, void const* src, size_t bytes);
@@ -65,6 +66,8 @@ struct MemInfo
 #include "cuda/memory_utils.hpp"
 #elif H2_HAS_ROCM
 #include "rocm/memory_utils.hpp"
+#elif H2_HAS_GPU_EMULATION
+#include "host/memory_utils.hpp"
 #endif
 
 // Forward-declare the {cub,hipcub}::CachingDeviceAllocator class.
@@ -12,11 +12,14 @@
  *
  *  The public runtime API that is exposed for user and library
  *  consumption. These are lightweight wrappers around HIP or CUDA
- *  runtime functions. The are accessible in the h2::gpu namespace.
+ *  runtime functions, or a host emulation of them (see
+ *  host/runtime.hpp). The are accessible in the h2::gpu namespace.
  *
  *  typedef {cuda,hip}Stream_t DeviceStream;
  *  typedef {cuda,hip}Event_t DeviceEvent;
  *
+ *  (The host emulation uses its own stream and event types.)
+ *
  *  int num_gpus();
  *  int current_gpu();
  *  void set_gpu(int id);
@@ -36,6 +39,11 @@
  *  DeviceEvent make_event_notiming();
  *  void destroy(DeviceEvent);
  *
+ *  void record(DeviceEvent, DeviceStream);
+ *  void wait(DeviceStream, DeviceEvent); // Stream waits on event.
+ *  bool query(DeviceEvent);              // Has the event completed?
+ *  float elapsed_time(DeviceEvent start, DeviceEvent end); // ms
+ *
  *  void sync();             // Device Sync
  *  void sync(DeviceEvent);  // Sync on event.
  *  void sync(DeviceStream); // Sync on stream.
@@ -48,6 +56,8 @@
 #include "cuda/runtime.hpp"
 #elif H2_HAS_ROCM
 #include "rocm/runtime.hpp"
+#elif H2_HAS_GPU_EMULATION
+#include "host/runtime.hpp"
 #endif
 
 // This declares the rest of the general API.
@@ -73,6 +83,11 @@ DeviceEvent make_event();
 DeviceEvent make_event_notiming();
 void destroy(DeviceEvent);
 
+void record(DeviceEvent, DeviceStream);
+void wait(DeviceStream, DeviceEvent);
+bool query(DeviceEvent);
+float elapsed_time(DeviceEvent start, DeviceEvent end);
+
 void sync();             // Device Sync
 void sync(DeviceEvent);  // Sync on event.
 void sync(DeviceStream); // Sync on stream.
@@ -8,17 +8,23 @@
 #ifndef H2_META_TYPELIST_AT_HPP_
 #define H2_META_TYPELIST_AT_HPP_
 
-#include "LispAccessors.hpp"
 #include "TypeList.hpp"
 #include "h2/meta/core/Lazy.hpp"
 
+#include <array>
+#include <cstddef>
+#include <utility>
+
 namespace h2
 {
 namespace meta
 {
 namespace tlist
 {
-/** @brief Extract the type at the given index (0-based) in the list. */
+/** @brief Extract the type at the given index (0-based) in the list.
+ *
+ *  If the index is out of bounds, Nil is returned.
+ */
 template <typename List, unsigned long Idx>
 struct AtT;
 
@@ -28,14 +34,118 @@ using At = Force<AtT<List, Idx>>;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-// Base case
+// Rather than recursing over the list, the algorithms on indices
+// build a class deriving from one IndexedEntry<I, T> per element and
+// let overload resolution find the base with a given index. This
+// instantiates O(n) templates once per list, after which every access
+// is O(1) in instantiation depth and count.
+namespace details
+{
+template <std::size_t Idx, typename T>
+struct IndexedEntry
+{};
+
+template <typename Seq, typename... Ts>
+struct IndexedTLImpl;
+
+template <std::size_t... Is, typename... Ts>
+struct IndexedTLImpl<std::index_sequence<Is...>, Ts...>
+    : IndexedEntry<Is, Ts>...
+{};
+
+template <typename List>
+struct IndexedTLT;
+
+template <typename... Ts>
+struct IndexedTLT<TL<Ts...>>
+{
+    using type = IndexedTLImpl<std::index_sequence_for<Ts...>, Ts...>;
+};
+
 template <typename List>
-struct AtT<List, 0UL> : CarT<List>
+using IndexedTL = Force<IndexedTLT<List>>;
+
+// Declaration only; used in unevaluated contexts.
+template <std::size_t Idx, typename T>
+Susp<T> GetIndexedEntry(IndexedEntry<Idx, T> const*);
+
+// The type at an in-bounds index of an IndexedTL. This is a class
+// rather than an alias so that repeated lookups are memoized.
+template <typename Indexed, std::size_t Idx>
+struct AtIndexedT
+    : decltype(GetIndexedEntry<Idx>(static_cast<Indexed const*>(nullptr)))
 {};
 
-// Recursive case
-template <typename List, unsigned long Idx>
-struct AtT : AtT<Cdr<List>, Idx - 1>
+template <typename Indexed, std::size_t Idx>
+using AtIndexed = Force<AtIndexedT<Indexed, Idx>>;
+
+// The list of the types of List at the indices in Indices::value, an
+// std::array of in-bounds indices.
+template <typename List,
+          typename Indices,
+          typename Seq = std::make_index_sequence<Indices::value.size()>>
+struct GatherT;
+
+template <typename List, typename Indices>
+using Gather = Force<GatherT<List, Indices>>;
+
+template <typename List, typename Indices, std::size_t... Js>
+struct GatherT<List, Indices, std::index_sequence<Js...>>
+{
+    using type = TL<AtIndexed<IndexedTL<List>, Indices::value[Js]>...>;
+};
+
+// The positions of the true entries of a mask
+template <std::size_t Count, std::size_t N>
+constexpr std::array<std::size_t, Count>
+MaskToIndices(std::array<bool, N> const& mask)
+{
+    std::array<std::size_t, Count> indices{};
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < N; ++i)
+        if (mask[i])
+            indices[j++] = i;
+    return indices;
+}
+
+template <std::size_t N>
+constexpr std::size_t CountTrue(std::array<bool, N> const& mask)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < N; ++i)
+        count += mask[i];
+    return count;
+}
+
+template <typename Mask>
+struct MaskIndices
+{
+    static constexpr auto value =
+        MaskToIndices<CountTrue(Mask::value)>(Mask::value);
+};
+
+// The list of the types of List for which Mask::value, an std::array
+// of Length<List> bools, is true
+template <typename List, typename Mask>
+using Filter = Gather<List, MaskIndices<Mask>>;
+
+template <typename List, unsigned long Idx, bool InBounds>
+struct AtImplT
+{
+    using type = Nil;
+};
+
+template <typename... Ts, unsigned long Idx>
+struct AtImplT<TL<Ts...>, Idx, true>
+{
+    using type = AtIndexed<IndexedTL<TL<Ts...>>, Idx>;
+};
+
+} // namespace details
+
+template <typename... Ts, unsigned long Idx>
+struct AtT<TL<Ts...>, Idx>
+    : details::AtImplT<TL<Ts...>, Idx, (Idx < sizeof...(Ts))>
 {};
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
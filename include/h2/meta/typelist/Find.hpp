@@ -8,11 +8,12 @@
 #ifndef H2_META_TYPELIST_FIND_HPP_
 #define H2_META_TYPELIST_FIND_HPP_
 
-#include "LispAccessors.hpp"
 #include "TypeList.hpp"
 #include "h2/meta/core/Lazy.hpp"
 #include "h2/meta/core/ValueAsType.hpp"
 
+#include <type_traits>
+
 namespace h2
 {
 namespace meta
@@ -35,28 +36,25 @@ inline constexpr unsigned long Find = FindV<List, T>();
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-// Base case
-template <typename T>
-struct FindVT<Empty, T> : ValueAsType<unsigned long, -1UL>
-{};
+namespace details
+{
+// A constexpr scan instead of a recursion over the list
+template <typename T, typename... Ts>
+constexpr unsigned long FindIndex()
+{
+    constexpr bool matches[] = {false, std::is_same<T, Ts>::value...};
+    for (unsigned long i = 0; i < sizeof...(Ts); ++i)
+        if (matches[i + 1])
+            return i;
+    return static_cast<unsigned long>(-1);
+}
+} // namespace details
 
-// Match case
 template <typename... Ts, typename T>
-struct FindVT<TL<T, Ts...>, T> : ValueAsType<unsigned long, 0>
+struct FindVT<TL<Ts...>, T>
+    : ValueAsType<unsigned long, details::FindIndex<T, Ts...>()>
 {};
 
-// Recursive case
-template <typename... ListTs, typename T, typename U>
-struct FindVT<TL<T, ListTs...>, U>
-{
-private:
-    static constexpr auto tmp_ = FindV<TL<ListTs...>, U>();
-    static constexpr auto invalid_ = static_cast<unsigned long>(-1);
-
-public:
-    static constexpr auto value = (tmp_ == invalid_ ? invalid_ : 1UL + tmp_);
-};
-
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 } // namespace tlist
 } // namespace meta
@@ -35,15 +35,8 @@ inline constexpr unsigned long Length = LengthV<List>();
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-// Base case
-template <>
-struct LengthVT<Empty> : ValueAsType<unsigned long, 0>
-{};
-
-// Recursive case
-template <typename T, typename... Ts>
-struct LengthVT<TL<T, Ts...>>
-    : ValueAsType<unsigned long, 1 + LengthV<TL<Ts...>>()>
+template <typename... Ts>
+struct LengthVT<TL<Ts...>> : ValueAsType<unsigned long, sizeof...(Ts)>
 {};
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
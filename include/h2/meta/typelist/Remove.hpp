@@ -8,10 +8,13 @@
 #ifndef H2_META_TYPELIST_REMOVE_HPP_
 #define H2_META_TYPELIST_REMOVE_HPP_
 
-#include "LispAccessors.hpp"
+#include "At.hpp"
+#include "Find.hpp"
 #include "TypeList.hpp"
 #include "h2/meta/core/Lazy.hpp"
 
+#include <array>
+
 namespace h2
 {
 namespace meta
@@ -28,23 +31,31 @@ using Remove = Force<RemoveT<List, T>>;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-template <typename T>
-struct RemoveT<Empty, T>
+namespace details
 {
-    using type = Empty;
-};
+template <typename List, typename T>
+struct RemoveMask;
 
-// Match case
-template <typename T, typename... Ts>
-struct RemoveT<TypeList<T, Ts...>, T>
+template <typename... Ts, typename T>
+struct RemoveMask<TL<Ts...>, T>
 {
-    using type = TypeList<Ts...>;
+    static constexpr std::array<bool, sizeof...(Ts)> value = [] {
+        std::array<bool, sizeof...(Ts)> mask{};
+        for (auto& m : mask)
+            m = true;
+        constexpr auto idx = FindV<TL<Ts...>, T>();
+        if (idx < sizeof...(Ts))
+            mask[idx] = false;
+        return mask;
+    }();
 };
+} // namespace details
 
-// Recursive call
-template <typename S, typename... Ts, typename T>
-struct RemoveT<TypeList<S, Ts...>, T> : ConsT<S, Remove<TypeList<Ts...>, T>>
-{};
+template <typename List, typename T>
+struct RemoveT
+{
+    using type = details::Filter<List, details::RemoveMask<List, T>>;
+};
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 } // namespace tlist
@@ -8,10 +8,14 @@
 #ifndef H2_META_TYPELIST_REPLACE_HPP_
 #define H2_META_TYPELIST_REPLACE_HPP_
 
-#include "LispAccessors.hpp"
+#include "Find.hpp"
 #include "TypeList.hpp"
 #include "h2/meta/core/Lazy.hpp"
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 namespace h2
 {
 namespace meta
@@ -32,23 +36,27 @@ using Replace = Force<ReplaceT<List, Old, New>>;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-// Base case
-template <typename Old, typename New>
-struct ReplaceT<Empty, Old, New>
+namespace details
 {
-    using type = Empty;
-};
+template <typename List, unsigned long Idx, typename New, typename Seq>
+struct ReplaceAtT;
 
-// Replacement case
-template <typename Old, typename New, typename... Ts>
-struct ReplaceT<TypeList<Old, Ts...>, Old, New>
+template <typename... Ts,
+          unsigned long Idx,
+          typename New,
+          std::size_t... Is>
+struct ReplaceAtT<TL<Ts...>, Idx, New, std::index_sequence<Is...>>
 {
-    using type = TypeList<New, Ts...>;
+    using type = TL<std::conditional_t<Is == Idx, New, Ts>...>;
 };
+} // namespace details
 
-// Recursive case
-template <typename List, typename Old, typename New>
-struct ReplaceT : ConsT<Car<List>, Replace<Cdr<List>, Old, New>>
+template <typename... Ts, typename Old, typename New>
+struct ReplaceT<TL<Ts...>, Old, New>
+    : details::ReplaceAtT<TL<Ts...>,
+                          FindV<TL<Ts...>, Old>(),
+                          New,
+                          std::index_sequence_for<Ts...>>
 {};
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
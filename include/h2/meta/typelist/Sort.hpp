@@ -8,11 +8,17 @@
 #ifndef H2_META_TYPELIST_SORT_HPP_
 #define H2_META_TYPELIST_SORT_HPP_
 
-#include "LispAccessors.hpp"
+#include "Append.hpp"
+#include "At.hpp"
+#include "Length.hpp"
 #include "TypeList.hpp"
-#include "h2/meta/core/IfThenElse.hpp"
 #include "h2/meta/core/Lazy.hpp"
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 namespace h2
 {
 namespace meta
@@ -35,36 +41,127 @@ using Sort = Force<SortT<List, Compare>>;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+// Stable merge sort. The halves are merged without recursing over
+// them: the position of each element in the merged list is its index
+// in its half plus its rank in the other half, which is found by a
+// binary search. A sort thus has O(log^2 n) instantiation depth and
+// O(n log^2 n) comparisons, versus O(n) depth and O(n^2) comparisons
+// for an insertion sort.
 namespace details
 {
+// Number of elements of the sorted IndexedTL in [Lo, Hi) that are
+// ordered before T. Elements equivalent to T are ordered before it
+// unless Strict, so that merging is stable.
 template <typename T,
-          typename SortedList,
+          typename Indexed,
+          std::size_t Lo,
+          std::size_t Hi,
           template <typename, typename>
-          class Compare>
-struct InsertIntoSortedT;
+          class Compare,
+          bool Strict,
+          bool Done = (Lo == Hi)>
+struct RankVT
+{
+private:
+    static constexpr std::size_t mid_ = Lo + (Hi - Lo) / 2;
+    using Mid_ = AtIndexed<Indexed, mid_>;
+    static constexpr bool before_ =
+        Strict ? Compare<Mid_, T>::value : !Compare<T, Mid_>::value;
+    using Next_ = std::conditional_t<
+        before_,
+        RankVT<T, Indexed, mid_ + 1, Hi, Compare, Strict>,
+        RankVT<T, Indexed, Lo, mid_, Compare, Strict>>;
+
+public:
+    static constexpr std::size_t value = Next_::value;
+};
 
 template <typename T,
-          typename SortedList,
+          typename Indexed,
+          std::size_t Lo,
+          std::size_t Hi,
           template <typename, typename>
-          class Compare>
-using InsertIntoSorted = Force<InsertIntoSortedT<T, SortedList, Compare>>;
-
-template <typename T, template <typename, typename> class Compare>
-struct InsertIntoSortedT<T, Empty, Compare>
+          class Compare,
+          bool Strict>
+struct RankVT<T, Indexed, Lo, Hi, Compare, Strict, true>
 {
-    using type = TL<T>;
+    static constexpr std::size_t value = Lo;
 };
 
-template <typename T,
-          typename Head,
-          typename... Tail,
+template <std::size_t N>
+constexpr std::array<std::size_t, N>
+InvertPermutation(std::array<std::size_t, N> const& p)
+{
+    std::array<std::size_t, N> inverse{};
+    for (std::size_t i = 0; i < N; ++i)
+        inverse[p[i]] = i;
+    return inverse;
+}
+
+// For each position of the merged list, the index of its element in
+// the concatenation of the two lists
+template <typename Left,
+          typename Right,
           template <typename, typename>
-          class Compare>
-struct InsertIntoSortedT<T, TL<Head, Tail...>, Compare>
-    : IfThenElseT<Compare<T, Head>::value,
-                  TL<T, Head, Tail...>,
-                  Cons<Head, InsertIntoSorted<T, TL<Tail...>, Compare>>>
-{};
+          class Compare,
+          typename LeftSeq = std::make_index_sequence<LengthV<Left>()>,
+          typename RightSeq = std::make_index_sequence<LengthV<Right>()>>
+struct MergeIndices;
+
+template <typename... Ls,
+          typename... Rs,
+          template <typename, typename>
+          class Compare,
+          std::size_t... Is,
+          std::size_t... Js>
+struct MergeIndices<TL<Ls...>,
+                    TL<Rs...>,
+                    Compare,
+                    std::index_sequence<Is...>,
+                    std::index_sequence<Js...>>
+{
+private:
+    using LeftIndexed_ = IndexedTL<TL<Ls...>>;
+    using RightIndexed_ = IndexedTL<TL<Rs...>>;
+    static constexpr std::size_t num_left_ = sizeof...(Ls);
+    static constexpr std::size_t num_right_ = sizeof...(Rs);
+
+public:
+    static constexpr auto value =
+        InvertPermutation(std::array<std::size_t, num_left_ + num_right_>{
+            {(Is
+              + RankVT<Ls, RightIndexed_, 0, num_right_, Compare, true>::
+                  value)...,
+             (Js
+              + RankVT<Rs, LeftIndexed_, 0, num_left_, Compare, false>::
+                  value)...}});
+};
+
+template <std::size_t Begin, std::size_t Count>
+struct RangeIndices
+{
+    static constexpr auto value = [] {
+        std::array<std::size_t, Count> indices{};
+        for (std::size_t i = 0; i < Count; ++i)
+            indices[i] = Begin + i;
+        return indices;
+    }();
+};
+
+template <typename List, template <typename, typename> class Compare>
+struct MergeSortT
+{
+private:
+    static constexpr std::size_t size_ = LengthV<List>();
+    using Left_ = Sort<Gather<List, RangeIndices<0, size_ / 2>>, Compare>;
+    using Right_ =
+        Sort<Gather<List, RangeIndices<size_ / 2, size_ - size_ / 2>>,
+             Compare>;
+
+public:
+    using type = Gather<Append<Left_, Right_>,
+                        MergeIndices<Left_, Right_, Compare>>;
+};
 
 } // namespace details
 
@@ -74,14 +171,14 @@ struct SortT<Empty, Compare>
     using type = Empty;
 };
 
-// Insertion sort -- it works and is straightforward to implement. If
-// lists grow large, we can reevaluate this choice.
-template <typename Head,
-          typename... Tail,
-          template <typename, typename>
-          class Compare>
-struct SortT<TL<Head, Tail...>, Compare>
-    : details::InsertIntoSortedT<Head, Sort<TL<Tail...>, Compare>, Compare>
+template <typename T, template <typename, typename> class Compare>
+struct SortT<TL<T>, Compare>
+{
+    using type = TL<T>;
+};
+
+template <typename List, template <typename, typename> class Compare>
+struct SortT : details::MergeSortT<List, Compare>
 {};
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
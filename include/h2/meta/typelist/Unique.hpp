@@ -8,11 +8,15 @@
 #ifndef H2_META_TYPELIST_UNIQUE_HPP_
 #define H2_META_TYPELIST_UNIQUE_HPP_
 
-#include "LispAccessors.hpp"
-#include "Remove.hpp"
+#include "At.hpp"
+#include "Find.hpp"
 #include "TypeList.hpp"
 #include "h2/meta/core/Lazy.hpp"
 
+#include <array>
+#include <cstddef>
+#include <utility>
+
 namespace h2
 {
 namespace meta
@@ -29,24 +33,26 @@ using Unique = Force<UniqueT<List>>;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
-// Base case
-template <>
-struct UniqueT<Empty>
+namespace details
 {
-    using type = Empty;
-};
+// Whether each element is the first occurrence of its type
+template <typename List, typename Seq>
+struct UniqueMask;
 
-// Recursive case
-template <typename List>
-struct UniqueT
+template <typename... Ts, std::size_t... Is>
+struct UniqueMask<TL<Ts...>, std::index_sequence<Is...>>
 {
-private:
-    using Head_ = Car<List>;
-    using Tail_ = Cdr<List>;
-    using UniqueTail_ = Unique<Tail_>;
+    static constexpr std::array<bool, sizeof...(Ts)> value = {
+        {(FindV<TL<Ts...>, Ts>() == Is)...}};
+};
+} // namespace details
 
-public:
-    using type = Cons<Head_, Remove<UniqueTail_, Head_>>;
+template <typename... Ts>
+struct UniqueT<TL<Ts...>>
+{
+    using type = details::Filter<
+        TL<Ts...>,
+        details::UniqueMask<TL<Ts...>, std::index_sequence_for<Ts...>>>;
 };
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_PATTERNS_FACTORY_FROZENOBJECTFACTORY_HPP_
+#define H2_PATTERNS_FACTORY_FROZENOBJECTFACTORY_HPP_
+
+#include "DefaultErrorPolicy.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace h2
+{
+namespace factory
+{
+/** @class InplaceBuilder
+ *  @brief A move-only function wrapper that never allocates.
+ *
+ *  @tparam Signature  The call signature, e.g., `std::unique_ptr<T>()`.
+ *  @tparam BufferSize The size of the in-object storage for the
+ *                     callable. Callables that do not fit are rejected
+ *                     at compile time.
+ *
+ *  This is a replacement for `std::function` as a builder type. The
+ *  callable (a function pointer or a small functor/lambda) is stored
+ *  in an inline buffer, so construction never allocates and a call is
+ *  a single indirect call. The callable is invoked as `const`, so
+ *  concurrent calls do not race on its state.
+ */
+template <typename Signature, std::size_t BufferSize = 3 * sizeof(void*)>
+class InplaceBuilder;
+
+/** @class FrozenObjectFactory
+ *  @brief Factory template for hot creation paths.
+ *
+ *  @tparam AbstractType  The base class of the types being constructed.
+ *  @tparam IdType        The index type used to differentiate concrete
+ *                        types. Must be less-than comparable and
+ *                        hashable with `std::hash`.
+ *  @tparam BuilderType   The functor type that builds concrete types.
+ *  @tparam ErrorPolicy   The policy for handling errors.
+ *
+ *  This has the interface of ObjectFactory, but stores the builders in
+ *  a flat map, i.e., in two vectors sorted by id, and by default uses
+ *  InplaceBuilder rather than `std::function`, so creating an object
+ *  performs no allocation other than the object itself.
+ *
+ *  freeze() builds an open-addressing index of the ids, sized to a
+ *  power of two at least twice the number of builders. A lookup is
+ *  then one `std::hash` evaluation and, in most cases, a single probe
+ *  of a contiguous array, without the node traversal of
+ *  `std::unordered_map`. For small dense integer ids, as enums
+ *  usually are, the index is a perfect hash. Before freezing, lookups
+ *  are a binary search.
+ *
+ *  The factory has two phases. Builders are registered and
+ *  unregistered until freeze() is called, after which the factory is
+ *  immutable and modifying it throws `std::logic_error`. Once frozen,
+ *  create_object() only reads immutable data and takes no locks, so it
+ *  is wait-free and may be called concurrently from any number of
+ *  threads, provided that the call to freeze() happens-before them
+ *  (e.g., it is done before the threads are started). Before freezing,
+ *  the factory is no more thread-safe than ObjectFactory.
+ */
+template <typename AbstractType,
+          typename IdType,
+          typename BuilderType =
+              InplaceBuilder<std::unique_ptr<AbstractType>()>,
+          template <typename, typename> class ErrorPolicy = DefaultErrorPolicy>
+class FrozenObjectFactory : private ErrorPolicy<IdType, AbstractType>
+{
+public:
+    using abstract_type = AbstractType;
+    using id_type = IdType;
+    using builder_type = BuilderType;
+    using id_list_type = std::vector<id_type>;
+    using size_type = typename id_list_type::size_type;
+
+public:
+    /** @brief Register a new builder for things of type @c id */
+    bool register_builder(id_type id, builder_type builder)
+    {
+        assert_not_frozen();
+        auto it = std::lower_bound(ids_.begin(), ids_.end(), id);
+        if (it != ids_.end() && !(id < *it))
+            return false;
+        auto const pos = it - ids_.begin();
+        builders_.insert(builders_.begin() + pos, std::move(builder));
+        ids_.insert(it, std::move(id));
+        return true;
+    }
+
+    /** @brief Unregister the current builder for things of type @c id. */
+    bool unregister(id_type const& id)
+    {
+        assert_not_frozen();
+        auto const pos = find(id);
+        if (pos == ids_.size())
+            return false;
+        ids_.erase(ids_.begin() + pos);
+        builders_.erase(builders_.begin() + pos);
+        return true;
+    }
+
+    /** @brief Make the factory immutable and build the lookup index. */
+    void freeze()
+    {
+        if (frozen_)
+            return;
+        ids_.shrink_to_fit();
+        builders_.shrink_to_fit();
+        std::size_t num_slots = 1;
+        while (num_slots < 2 * ids_.size())
+            num_slots *= 2;
+        // Slots hold the position of an id plus one, zero when empty.
+        slots_.assign(num_slots, 0);
+        mask_ = num_slots - 1;
+        for (size_type i = 0; i < ids_.size(); ++i)
+        {
+            std::size_t slot = std::hash<id_type>{}(ids_[i]) & mask_;
+            while (slots_[slot])
+                slot = (slot + 1) & mask_;
+            slots_[slot] = static_cast<slot_type>(i + 1);
+        }
+        frozen_ = true;
+    }
+
+    /** @brief Whether freeze() has been called. */
+    bool is_frozen() const noexcept { return frozen_; }
+
+    /** @brief Construct a new object forwarding extra arguments to
+     *  the builder.
+     */
+    template <typename... Ts>
+    std::unique_ptr<AbstractType> create_object(IdType const& id,
+                                                Ts&&... Args) const
+    {
+        auto const pos = find(id);
+        if (pos != ids_.size())
+            return builders_[pos](std::forward<Ts>(Args)...);
+
+        return this->handle_unknown_id(id);
+    }
+
+    /** @brief Get the ids of all builders known to the factory, in
+     *  ascending order.
+     */
+    id_list_type const& registered_ids() const noexcept { return ids_; }
+
+    /** @brief Get the number of builders known to the factory. */
+    size_type size() const noexcept { return ids_.size(); }
+
+private:
+    // Position of id, or the number of ids if it is not registered
+    size_type find(id_type const& id) const
+    {
+        if (frozen_)
+        {
+            std::size_t slot = std::hash<id_type>{}(id) & mask_;
+            for (slot_type pos; (pos = slots_[slot]) != 0;
+                 slot = (slot + 1) & mask_)
+            {
+                if (ids_[pos - 1] == id)
+                    return pos - 1;
+            }
+            return ids_.size();
+        }
+        auto it = std::lower_bound(ids_.begin(), ids_.end(), id);
+        if (it != ids_.end() && !(id < *it))
+            return it - ids_.begin();
+        return ids_.size();
+    }
+
+    void assert_not_frozen() const
+    {
+        if (frozen_)
+            throw std::logic_error("The factory is frozen.");
+    }
+
+private:
+    using slot_type = std::uint32_t;
+
+    id_list_type ids_;
+    std::vector<builder_type> builders_;
+    std::vector<slot_type> slots_;
+    std::size_t mask_ = 0;
+    bool frozen_ = false;
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+template <typename ReturnT, typename... ArgTs, std::size_t BufferSize>
+class InplaceBuilder<ReturnT(ArgTs...), BufferSize>
+{
+    struct Ops
+    {
+        ReturnT (*call)(void const*, ArgTs&&...);
+        void (*move)(void*, void*) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <typename F>
+    struct OpsFor
+    {
+        static ReturnT Call(void const* f, ArgTs&&... args)
+        {
+            return (*static_cast<F const*>(f))(std::forward<ArgTs>(args)...);
+        }
+        static void Move(void* dst, void* src) noexcept
+        {
+            new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        }
+        static void Destroy(void* f) noexcept { static_cast<F*>(f)->~F(); }
+        static constexpr Ops value = {&Call, &Move, &Destroy};
+    };
+
+public:
+    InplaceBuilder() noexcept = default;
+
+    template <typename F,
+              typename FT = std::decay_t<F>,
+              typename = std::enable_if_t<
+                  !std::is_same<FT, InplaceBuilder>::value>>
+    InplaceBuilder(F&& f) noexcept(
+        std::is_nothrow_constructible<FT, F&&>::value)
+    {
+        static_assert(sizeof(FT) <= BufferSize,
+                      "The builder does not fit in the InplaceBuilder.");
+        static_assert(alignof(FT) <= alignof(std::max_align_t),
+                      "The builder is over-aligned.");
+        static_assert(std::is_nothrow_move_constructible<FT>::value,
+                      "The builder must be nothrow move constructible.");
+        new (buffer_) FT(std::forward<F>(f));
+        ops_ = &OpsFor<FT>::value;
+    }
+
+    InplaceBuilder(InplaceBuilder&& other) noexcept : ops_(other.ops_)
+    {
+        if (ops_)
+            ops_->move(buffer_, other.buffer_);
+        other.ops_ = nullptr;
+    }
+
+    InplaceBuilder& operator=(InplaceBuilder&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            ops_ = other.ops_;
+            if (ops_)
+                ops_->move(buffer_, other.buffer_);
+            other.ops_ = nullptr;
+        }
+        return *this;
+    }
+
+    InplaceBuilder(InplaceBuilder const&) = delete;
+    InplaceBuilder& operator=(InplaceBuilder const&) = delete;
+
+    ~InplaceBuilder() { reset(); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    ReturnT operator()(ArgTs... args) const
+    {
+        return ops_->call(buffer_, std::forward<ArgTs>(args)...);
+    }
+
+private:
+    void reset() noexcept
+    {
+        if (ops_)
+            ops_->destroy(buffer_);
+        ops_ = nullptr;
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char buffer_[BufferSize];
+    Ops const* ops_ = nullptr;
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+} // namespace factory
+} // namespace h2
+#endif // H2_PATTERNS_FACTORY_FROZENOBJECTFACTORY_HPP_
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_PATTERNS_FACTORY_OBJECTPOOL_HPP_
+#define H2_PATTERNS_FACTORY_OBJECTPOOL_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace h2
+{
+namespace factory
+{
+
+template <typename AbstractType>
+class ObjectPool;
+
+/** @class PoolDeleter
+ *  @brief Deleter that returns objects to the ObjectPool they came
+ *         from.
+ *
+ *  A default-constructed deleter has no pool and deletes the object,
+ *  so that pointers to objects that are not pooled (e.g., from an
+ *  error policy) have the same type as pooled ones.
+ */
+template <typename AbstractType>
+struct PoolDeleter
+{
+    ObjectPool<AbstractType>* pool = nullptr;
+
+    void operator()(AbstractType* obj) const noexcept
+    {
+        if (pool)
+            pool->release(obj);
+        else
+            delete obj;
+    }
+};
+
+/** @class ObjectPool
+ *  @brief Arena of recyclable objects of an abstract type.
+ *
+ *  The pool owns every object it has adopted until it is destroyed.
+ *  Objects are handed out as `std::unique_ptr` with a PoolDeleter, so
+ *  destroying the handle puts the object on the free list of the pool
+ *  instead of deleting it, and acquire() returns it again later
+ *  without any allocation.
+ *
+ *  @warning All handles must be destroyed before the pool is. The pool
+ *  is not thread-safe.
+ */
+template <typename AbstractType>
+class ObjectPool
+{
+public:
+    using abstract_type = AbstractType;
+    using deleter_type = PoolDeleter<AbstractType>;
+    using pointer_type = std::unique_ptr<AbstractType, deleter_type>;
+    using size_type = std::size_t;
+
+public:
+    ObjectPool() = default;
+    ObjectPool(ObjectPool const&) = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    /** @brief Take ownership of a new object and hand it out. */
+    pointer_type adopt(std::unique_ptr<AbstractType> obj)
+    {
+        if (!obj)
+            return pointer_type(nullptr, deleter_type{this});
+        // Reserved so that release never reallocates.
+        free_.reserve(objects_.size() + 1);
+        objects_.push_back(std::move(obj));
+        return pointer_type(objects_.back().get(), deleter_type{this});
+    }
+
+    /** @brief Hand out a recycled object, or nullptr if none is free. */
+    pointer_type acquire() noexcept
+    {
+        if (free_.empty())
+            return pointer_type(nullptr, deleter_type{this});
+        AbstractType* obj = free_.back();
+        free_.pop_back();
+        return pointer_type(obj, deleter_type{this});
+    }
+
+    /** @brief Put an object handed out by this pool on the free list. */
+    void release(AbstractType* obj) noexcept { free_.push_back(obj); }
+
+    /** @brief Get the number of objects owned by the pool. */
+    size_type size() const noexcept { return objects_.size(); }
+
+    /** @brief Get the number of objects on the free list. */
+    size_type num_free() const noexcept { return free_.size(); }
+
+private:
+    std::vector<std::unique_ptr<AbstractType>> objects_;
+    std::vector<AbstractType*> free_;
+}; // class ObjectPool
+
+/** @class NoResetPolicy
+ *  @brief Reset policy that leaves recycled objects as they are.
+ *
+ *  With this policy, a recycled object keeps the state it had when it
+ *  was released, which is appropriate when users reinitialize objects
+ *  after acquiring them anyway.
+ */
+struct NoResetPolicy
+{
+    template <typename T, typename... Ts>
+    void Reset(T&, T const&, Ts&&...) const noexcept
+    {}
+}; // struct NoResetPolicy
+
+} // namespace factory
+} // namespace h2
+#endif // H2_PATTERNS_FACTORY_OBJECTPOOL_HPP_
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_PATTERNS_FACTORY_POOLEDCOPYFACTORY_HPP_
+#define H2_PATTERNS_FACTORY_POOLEDCOPYFACTORY_HPP_
+
+#include "DefaultErrorPolicy.hpp"
+#include "ObjectPool.hpp"
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace h2
+{
+namespace factory
+{
+/** @class PooledCopyFactory
+ *  @brief CopyFactory that recycles the copies it returns.
+ *
+ *  This has the interface of CopyFactory, except that copies are
+ *  returned as ObjectPool handles, with one pool per registered
+ *  dynamic type. A destroyed copy goes back to its pool, and the next
+ *  copy of an object of the same dynamic type reuses it: the
+ *  ResetPolicy is called as
+ *
+ *  @code{.cpp}
+ *     void Reset(AbstractType& obj, AbstractType const& other) const;
+ *  @endcode
+ *
+ *  to make the recycled object a copy of @c other, e.g., by assigning
+ *  it as its concrete type, which can reuse the resources it owns.
+ *  The builder is only called when the pool has no free object.
+ *
+ *  Unlike PooledPrototypeFactory, the ResetPolicy has no default: a
+ *  recycled object holds a previous copy, possibly of a different
+ *  source, so a policy that does not assign it (e.g., NoResetPolicy)
+ *  would return stale contents.
+ *
+ *  @warning All copies must be destroyed before their type is
+ *  unregistered or the factory is destroyed.
+ *
+ *  @tparam AbstractType  The base class of the types being constructed.
+ *  @tparam ResetPolicy   A policy that makes recycled objects copies of
+ *                        the source object.
+ *  @tparam BuilderType   The functor type that builds concrete types.
+ *  @tparam ErrorPolicy   The policy for handling errors.
+ */
+template <typename AbstractType,
+          typename ResetPolicy,
+          typename BuilderType =
+              std::function<std::unique_ptr<AbstractType>(AbstractType const&)>,
+          template <typename, typename> class ErrorPolicy = DefaultErrorPolicy>
+class PooledCopyFactory
+    : private ResetPolicy,
+      private ErrorPolicy<std::type_info const&, AbstractType>
+{
+public:
+    using abstract_type = AbstractType;
+    using id_type = std::type_info;
+    using key_type = std::type_index;
+    using builder_type = BuilderType;
+    using pool_type = ObjectPool<abstract_type>;
+    using pointer_type = typename pool_type::pointer_type;
+
+private:
+    struct Entry
+    {
+        builder_type builder;
+        std::unique_ptr<pool_type> pool;
+    };
+
+public:
+    using map_type = std::unordered_map<key_type, Entry>;
+    using size_type = typename map_type::size_type;
+
+public:
+    /** @brief Register a new builder for things of type @c id */
+    bool register_builder(id_type const& id, builder_type builder)
+    {
+        return map_
+            .emplace(std::type_index(id),
+                     Entry{std::move(builder),
+                           std::unique_ptr<pool_type>(new pool_type)})
+            .second;
+    }
+
+    /** @brief Unregister the current builder for things of type @c id. */
+    bool unregister(id_type const& id)
+    {
+        return (map_.erase(std::type_index(id)) == 1);
+    }
+
+    /** @brief Get a copy of an object, recycling a previous copy of
+     *  the same type if possible.
+     */
+    pointer_type copy_object(AbstractType const& other) const
+    {
+        auto const& id = typeid(other);
+        auto it = map_.find(std::type_index(id));
+        if (it == map_.end())
+            return pointer_type(this->handle_unknown_id(id).release(),
+                                typename pool_type::deleter_type{});
+
+        auto& pool = *(it->second.pool);
+        if (auto obj = pool.acquire())
+        {
+            this->Reset(*obj, other);
+            return obj;
+        }
+        return pool.adopt((it->second.builder)(other));
+    }
+
+    /** @brief Get the pool of copies of type @c id, or nullptr if it
+     *  is not registered.
+     */
+    pool_type const* get_pool(id_type const& id) const
+    {
+        auto it = map_.find(std::type_index(id));
+        return it != map_.end() ? it->second.pool.get() : nullptr;
+    }
+
+    /** @brief Get the names of all concrete products known to the factory. */
+    std::list<std::string> registered_types() const
+    {
+        std::list<std::string> names;
+        for (auto const& x : map_)
+            names.push_back(x.first.name());
+
+        return names;
+    }
+
+    /** @brief Get the number of products known to the factory. */
+    size_type size() const noexcept { return map_.size(); }
+
+private:
+    map_type map_;
+};
+
+} // namespace factory
+} // namespace h2
+#endif /* H2_PATTERNS_FACTORY_POOLEDCOPYFACTORY_HPP_ */
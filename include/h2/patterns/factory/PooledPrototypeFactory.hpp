@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_PATTERNS_FACTORY_POOLEDPROTOTYPEFACTORY_HPP_
+#define H2_PATTERNS_FACTORY_POOLEDPROTOTYPEFACTORY_HPP_
+
+#include "DefaultErrorPolicy.hpp"
+#include "ObjectPool.hpp"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace h2
+{
+namespace factory
+{
+/** @class PooledPrototypeFactory
+ *  @brief PrototypeFactory that recycles the copies it returns.
+ *
+ *  This has the interface of PrototypeFactory, except that copies are
+ *  returned as ObjectPool handles. Each prototype has its own pool:
+ *  when a copy is destroyed, it goes back to the free list of its
+ *  prototype, and the next copy_prototype() call for that id reuses it
+ *  instead of allocating a new one through the CopyPolicy.
+ *
+ *  A recycled object is reinitialized by the ResetPolicy, which must
+ *  provide
+ *
+ *  @code{.cpp}
+ *     void Reset(AbstractType& obj, AbstractType const& prototype, ...) const;
+ *  @endcode
+ *
+ *  where the variadic parameters are those given to copy_prototype().
+ *  Resetting is typically much cheaper than copying, e.g., it can
+ *  assign a few fields and keep the buffers the object owns. The
+ *  default NoResetPolicy keeps the state of recycled objects.
+ *
+ *  @warning All copies of a prototype must be destroyed before the
+ *  prototype is unregistered or the factory is destroyed.
+ *
+ *  @tparam AbstractType  The base class of the types being constructed.
+ *  @tparam IdType        The index type used to differentiate concrete types.
+ *  @tparam CopyPolicy    A policy that describes how each prototype is copied.
+ *  @tparam ResetPolicy   A policy that describes how recycled objects are
+ *                        reinitialized.
+ *  @tparam ErrorPolicy   The policy for handling errors.
+ */
+template <typename AbstractType,
+          typename IdType,
+          typename CopyPolicy,
+          typename ResetPolicy = NoResetPolicy,
+          template <typename, typename> class ErrorPolicy = DefaultErrorPolicy>
+class PooledPrototypeFactory : private CopyPolicy,
+                               private ResetPolicy,
+                               private ErrorPolicy<IdType, AbstractType>
+{
+public:
+    using abstract_type = AbstractType;
+    using id_type = IdType;
+    using abstract_ptr_type = std::unique_ptr<abstract_type>;
+    using pool_type = ObjectPool<abstract_type>;
+    using pointer_type = typename pool_type::pointer_type;
+
+private:
+    struct Entry
+    {
+        abstract_ptr_type prototype;
+        std::unique_ptr<pool_type> pool;
+    };
+
+public:
+    using map_type = std::unordered_map<id_type, Entry>;
+    using size_type = typename map_type::size_type;
+
+public:
+    /** @brief Register a new prototype for things of type @c id. */
+    bool register_prototype(id_type id, abstract_ptr_type&& prototype)
+    {
+        return map_
+            .emplace(std::move(id),
+                     Entry{std::move(prototype),
+                           std::unique_ptr<pool_type>(new pool_type)})
+            .second;
+    }
+
+    /** @brief Unregister the current prototype for things of type @c id.
+     *  @note This will free the underlying prototype instance and all
+     *        its pooled copies.
+     */
+    bool unregister(id_type const& id) { return (map_.erase(id) == 1); }
+
+    /** @brief Get a copy of a prototype, recycling a previous copy if
+     *  possible, forwarding extra arguments to the copy or reset
+     *  policy.
+     */
+    template <typename... Ts>
+    pointer_type copy_prototype(IdType const& id, Ts&&... Args) const
+    {
+        auto it = map_.find(id);
+        if (it == map_.end())
+            return pointer_type(this->handle_unknown_id(id).release(),
+                                typename pool_type::deleter_type{});
+
+        auto const& prototype = *(it->second.prototype);
+        auto& pool = *(it->second.pool);
+        if (auto obj = pool.acquire())
+        {
+            this->Reset(*obj, prototype, std::forward<Ts>(Args)...);
+            return obj;
+        }
+        return pool.adopt(this->Copy(prototype, std::forward<Ts>(Args)...));
+    }
+
+    /** @brief Get the pool of copies of the prototype @c id, or
+     *  nullptr if it is not registered.
+     */
+    pool_type const* get_pool(id_type const& id) const
+    {
+        auto it = map_.find(id);
+        return it != map_.end() ? it->second.pool.get() : nullptr;
+    }
+
+    /** @brief Get the names of all prototypes known to the factory. */
+    std::list<id_type> registered_ids() const
+    {
+        std::list<id_type> names;
+        for (auto const& x : map_)
+            names.push_back(x.first);
+
+        return names;
+    }
+
+    /** @brief Get the number of builders known to the factory. */
+    size_type size() const noexcept { return map_.size(); }
+
+private:
+    map_type map_;
+}; // class PooledPrototypeFactory
+
+} // namespace factory
+} // namespace h2
+#endif /* H2_PATTERNS_FACTORY_POOLEDPROTOTYPEFACTORY_HPP_ */
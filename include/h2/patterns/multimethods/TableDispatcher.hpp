@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_PATTERNS_MULTIMETHODS_TABLEDISPATCHER_HPP_
+#define H2_PATTERNS_MULTIMETHODS_TABLEDISPATCHER_HPP_
+
+#include "h2/meta/Core.hpp"
+#include "h2/meta/TypeList.hpp"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace h2
+{
+namespace multimethods
+{
+/** @brief Dispatch a functor call based on the dynamic type of the
+ *         arguments in constant time.
+ *
+ *  @tparam FunctorT The type of the functor to dispatch. It must
+ *          implement `operator()`. All overloads must have the same
+ *          return type.
+ *  @tparam ReturnT The return type of all overloads of `operator()`.
+ *  @tparam ArgumentTs The types of the arguments to the functor,
+ *          given as (Base, TL<DTypes>) pairs.
+ *
+ *  This is a drop-in companion to SwitchDispatcher: the template
+ *  parameters, the functor requirements (including `DispatchError`
+ *  and `DeductionError`), and the argument order of `Exec` are the
+ *  same. Only the deduction algorithm differs.
+ *
+ *  @section table-dispatch-algo Algorithm
+ *
+ *  Each type in an argument's typelist is assigned a dense index, its
+ *  position in the list. The index of an argument is obtained from
+ *  its `typeid` in a hash table that is built once per (Base,
+ *  TL<DTypes>) pair, so deducing an argument costs one virtual
+ *  `typeid` lookup and one hash lookup regardless of the list
+ *  length. The indices of all arguments select an entry of a
+ *  constexpr N-dimensional table of function pointers, each of which
+ *  casts the arguments to their concrete types and calls the functor
+ *  (or its `DispatchError` if no overload is viable).
+ *
+ *  Deduction follows SwitchDispatcher exactly. A type whose list
+ *  contains one of its bases before itself is mapped to the first
+ *  such base, since that is the first successful `dynamic_cast`. A
+ *  dynamic type that is not in the list at all (e.g., a class derived
+ *  from a listed type) falls back to the `dynamic_cast` search of
+ *  SwitchDispatcher, and `DeductionError` is called if that also
+ *  fails. `DeductionError` is passed the original arguments.
+ *
+ *  @warning The table has one entry per combination of the listed
+ *  types, and all of them are instantiated. This is the same set of
+ *  instantiations as SwitchDispatcher generates.
+ */
+template <typename FunctorT, typename ReturnT, typename... ArgumentTs>
+class TableDispatcher;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace details
+{
+
+// Concrete type with the constness of the base
+template <typename Base, typename T>
+using MatchConstT = std::conditional_t<std::is_const<Base>::value, T const, T>;
+
+// Position of the first type in the list that T can be converted to,
+// i.e., the type a dynamic_cast search of the list stops at.
+template <typename T, typename... Ts>
+constexpr std::size_t FirstConvertibleIndex(meta::TL<Ts...>)
+{
+    constexpr bool matches[] = {std::is_convertible<T*, Ts*>::value...};
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+        if (matches[i])
+            return i;
+    return sizeof...(Ts);
+}
+
+// Whether a Base reference can be downcast to T without RTTI, which
+// is not the case with virtual inheritance.
+template <typename T, typename Base, typename = void>
+struct IsStaticCastableT : std::false_type
+{};
+
+template <typename T, typename Base>
+struct IsStaticCastableT<
+    T,
+    Base,
+    std::void_t<decltype(static_cast<T&>(std::declval<Base&>()))>>
+    : std::true_type
+{};
+
+// Maps dynamic types to their index in List, or to Length<List> if
+// deduction fails.
+template <typename Base, typename List>
+class TypeIndexer;
+
+template <typename Base, typename... Ts>
+class TypeIndexer<Base, meta::TL<Ts...>>
+{
+public:
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    static std::size_t Get(Base& arg)
+    {
+        static const auto table = BuildTable();
+        auto it = table.find(&typeid(arg));
+        if (it != table.end())
+            return it->second;
+        return Search(arg);
+    }
+
+private:
+    using MapType = std::unordered_map<std::type_info const*, std::size_t>;
+
+    static MapType BuildTable()
+    {
+        MapType table;
+        // Types appearing more than once keep their first position.
+        (table.emplace(&typeid(Ts),
+                       FirstConvertibleIndex<Ts>(meta::TL<Ts...>{})),
+         ...);
+        return table;
+    }
+
+    // Tries dynamic_cast in list order as SwitchDispatcher
+    static std::size_t Search(Base& arg)
+    {
+        std::size_t i = 0;
+        (void) ((dynamic_cast<MatchConstT<Base, Ts>*>(&arg) != nullptr
+                 || (++i, false))
+                || ...);
+        return i;
+    }
+};
+
+// Splits (Base, TL<DTypes>) pairs into a list of bases and a list of
+// typelists.
+template <typename Bases, typename Lists, typename... ArgumentTs>
+struct SplitArgumentPairsT
+{
+    using bases = Bases;
+    using lists = Lists;
+};
+
+template <typename... Bases,
+          typename... Lists,
+          typename Base,
+          typename List,
+          typename... ArgumentTs>
+struct SplitArgumentPairsT<meta::TL<Bases...>,
+                           meta::TL<Lists...>,
+                           Base,
+                           List,
+                           ArgumentTs...>
+    : SplitArgumentPairsT<meta::TL<Bases..., Base>,
+                          meta::TL<Lists..., List>,
+                          ArgumentTs...>
+{};
+
+template <typename FunctorT, typename ReturnT, typename Bases, typename Lists>
+class TableDispatcherImpl;
+
+template <typename FunctorT,
+          typename ReturnT,
+          typename... Bases,
+          typename... Lists>
+class TableDispatcherImpl<FunctorT,
+                          ReturnT,
+                          meta::TL<Bases...>,
+                          meta::TL<Lists...>>
+{
+    static constexpr std::size_t num_args = sizeof...(Bases);
+    static constexpr std::array<std::size_t, num_args> sizes = {
+        meta::tlist::Length<Lists>...};
+
+    static constexpr std::size_t GetNumEntries()
+    {
+        std::size_t n = 1;
+        for (std::size_t i = 0; i < num_args; ++i)
+            n *= sizes[i];
+        return n;
+    }
+
+    // The first argument varies slowest.
+    static constexpr std::size_t GetStride(std::size_t arg)
+    {
+        std::size_t s = 1;
+        for (std::size_t i = arg + 1; i < num_args; ++i)
+            s *= sizes[i];
+        return s;
+    }
+
+    template <std::size_t Entry, std::size_t Arg>
+    using ConcreteT = MatchConstT<
+        meta::tlist::At<meta::TL<Bases...>, Arg>,
+        meta::tlist::At<meta::tlist::At<meta::TL<Lists...>, Arg>,
+                        (Entry / GetStride(Arg)) % sizes[Arg]>>;
+
+    template <typename T, typename Base>
+    static T& Cast(Base& arg)
+    {
+        if constexpr (IsStaticCastableT<T, Base>::value)
+            return static_cast<T&>(arg);
+        else
+            return dynamic_cast<T&>(arg);
+    }
+
+    template <std::size_t Entry, typename... Args, std::size_t... Is>
+    static ReturnT CallImpl(FunctorT& F,
+                            std::index_sequence<Is...>,
+                            std::tuple<Bases&...> args,
+                            Args&&... others)
+    {
+        using Invocable = meta::IsInvocableVT<FunctorT,
+                                              Args&&...,
+                                              ConcreteT<Entry, Is>&...>;
+        if constexpr (Invocable::value)
+            return F(std::forward<Args>(others)...,
+                     Cast<ConcreteT<Entry, Is>>(std::get<Is>(args))...);
+        else
+            return F.DispatchError(
+                std::forward<Args>(others)...,
+                Cast<ConcreteT<Entry, Is>>(std::get<Is>(args))...);
+    }
+
+    template <std::size_t Entry, typename... Args>
+    static ReturnT Call(FunctorT& F, Bases&... args, Args&&... others)
+    {
+        return CallImpl<Entry>(F,
+                               std::make_index_sequence<num_args>{},
+                               std::tuple<Bases&...>(args...),
+                               std::forward<Args>(others)...);
+    }
+
+    template <typename... Args>
+    using FunctionPtr = ReturnT (*)(FunctorT&, Bases&..., Args&&...);
+
+    template <typename... Args, std::size_t... Entries>
+    static constexpr std::array<FunctionPtr<Args...>, sizeof...(Entries)>
+    MakeTable(std::index_sequence<Entries...>)
+    {
+        return {{&Call<Entries, Args...>...}};
+    }
+
+    template <typename... Args>
+    struct Table
+    {
+        static constexpr auto value = MakeTable<Args...>(
+            std::make_index_sequence<GetNumEntries()>{});
+    };
+
+public:
+    template <typename... Args>
+    static ReturnT Exec(FunctorT F, Bases&... args, Args&&... others)
+    {
+        std::size_t const indices[] = {
+            TypeIndexer<Bases, Lists>::Get(args)...};
+        std::size_t entry = 0;
+        for (std::size_t i = 0; i < num_args; ++i)
+        {
+            if (indices[i] == sizes[i])
+                return F.DeductionError(args..., std::forward<Args>(others)...);
+            entry = entry * sizes[i] + indices[i];
+        }
+        return Table<Args...>::value[entry](
+            F, args..., std::forward<Args>(others)...);
+    }
+};
+
+} // namespace details
+
+template <typename FunctorT, typename ReturnT, typename... ArgumentTs>
+class TableDispatcher
+    : public details::TableDispatcherImpl<
+          FunctorT,
+          ReturnT,
+          typename details::SplitArgumentPairsT<meta::TL<>,
+                                                meta::TL<>,
+                                                ArgumentTs...>::bases,
+          typename details::SplitArgumentPairsT<meta::TL<>,
+                                                meta::TL<>,
+                                                ArgumentTs...>::lists>
+{
+    static_assert(sizeof...(ArgumentTs) % 2 == 0,
+                  "Must pass ArgumentTs as (Base, TL<DTypes>).");
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+} // namespace multimethods
+} // namespace h2
+#endif // H2_PATTERNS_MULTIMETHODS_TABLEDISPATCHER_HPP_
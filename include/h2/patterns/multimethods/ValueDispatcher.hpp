@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_PATTERNS_MULTIMETHODS_VALUEDISPATCHER_HPP_
+#define H2_PATTERNS_MULTIMETHODS_VALUEDISPATCHER_HPP_
+
+#include "h2/meta/Core.hpp"
+#include "h2/meta/TypeList.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace h2
+{
+namespace multimethods
+{
+/** @brief A compile-time case of a runtime value, optionally
+ *         associated with a type.
+ *
+ *  For example, `ValueCase<DataType::FLOAT, float>` selects `float`
+ *  when a runtime data-type enum is `DataType::FLOAT`.
+ */
+template <auto Value, typename T = void>
+struct ValueCase
+{
+    static constexpr auto value = Value;
+    using type = T;
+};
+
+/** @brief Dispatch a functor call based on runtime values.
+ *
+ *  @tparam FunctorT The type of the functor to dispatch. It must
+ *          implement `operator()`. All overloads must have the same
+ *          return type.
+ *  @tparam ReturnT The return type of all overloads of `operator()`.
+ *  @tparam CaseLists One typelist of cases per runtime value. A case
+ *          is any type with a static constexpr `value` member, such
+ *          as ValueCase or meta::ValueAsType.
+ *
+ *  This maps a tuple of runtime values, e.g., a data type, a number
+ *  of dimensions and a backend given as enums or integers, to a
+ *  template instantiation. Each runtime value is matched against the
+ *  `value` of the cases in its list, and the functor is called with a
+ *  default-constructed object of each matching case, so that it can
+ *  be implemented as a template over the cases:
+ *
+ *  @code{.cpp}
+ *  struct RunFunctor {
+ *    template <typename DTCase, typename NDCase>
+ *    int operator()(Config const& cfg, DTCase, NDCase) {
+ *      return run<typename DTCase::type, NDCase::value>(cfg);
+ *    }
+ *    template <typename... Ts> int DispatchError(Ts&&...) {...}
+ *    template <typename... Ts> int DeductionError(Ts&&...) {...}
+ *  };
+ *  using Dispatcher = ValueDispatcher<
+ *      RunFunctor, int,
+ *      TL<ValueCase<DataType::FLOAT, float>,
+ *         ValueCase<DataType::DOUBLE, double>>,
+ *      TL<ValueCase<2>, ValueCase<3>>>;
+ *  Dispatcher::Exec(RunFunctor{}, cfg.data_type, cfg.num_dims, cfg);
+ *  @endcode
+ *
+ *  `Exec` takes the functor, the runtime values in the order of the
+ *  case lists, and additional arguments, which are passed to the
+ *  functor *before* the cases as with SwitchDispatcher. The call goes
+ *  through a generated table with one function pointer per
+ *  combination of cases, so a dispatch costs a comparison against
+ *  each case of each list and a single indirect call, regardless of
+ *  how the overloads are implemented.
+ *
+ *  As with the other dispatchers, the functor must provide
+ *  `DeductionError`, which is called with the runtime values and the
+ *  additional arguments when a value matches no case, and
+ *  `DispatchError`, which is called with the additional arguments and
+ *  the cases when the functor is not invocable with a combination
+ *  (e.g., a data type not supported by a backend).
+ */
+template <typename FunctorT, typename ReturnT, typename... CaseLists>
+class ValueDispatcher;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace details
+{
+
+template <typename List>
+struct CaseValueTypeT;
+
+template <typename Case, typename... Cases>
+struct CaseValueTypeT<meta::TL<Case, Cases...>>
+{
+    using type = std::remove_cv_t<decltype(Case::value)>;
+};
+
+template <typename List>
+using CaseValueType = typename CaseValueTypeT<List>::type;
+
+// Position of the case matching v, or the length of the list
+template <typename T, typename... Cases>
+std::size_t FindCase(T const& v, meta::TL<Cases...>)
+{
+    std::size_t i = 0;
+    (void) ((v == Cases::value || (++i, false)) || ...);
+    return i;
+}
+
+} // namespace details
+
+template <typename FunctorT, typename ReturnT, typename... CaseLists>
+class ValueDispatcher
+{
+    static_assert(sizeof...(CaseLists) > 0, "Must pass at least one TL.");
+
+    static constexpr std::size_t num_values = sizeof...(CaseLists);
+    static constexpr std::array<std::size_t, num_values> sizes = {
+        meta::tlist::Length<CaseLists>...};
+
+    static constexpr std::size_t GetNumEntries()
+    {
+        std::size_t n = 1;
+        for (std::size_t i = 0; i < num_values; ++i)
+            n *= sizes[i];
+        return n;
+    }
+
+    // The first value varies slowest.
+    static constexpr std::size_t GetStride(std::size_t i)
+    {
+        std::size_t s = 1;
+        for (std::size_t j = i + 1; j < num_values; ++j)
+            s *= sizes[j];
+        return s;
+    }
+
+    template <std::size_t Entry, std::size_t I>
+    using CaseT =
+        meta::tlist::At<meta::tlist::At<meta::TL<CaseLists...>, I>,
+                        (Entry / GetStride(I)) % sizes[I]>;
+
+    template <std::size_t Entry, typename... Args, std::size_t... Is>
+    static ReturnT CallImpl(FunctorT& F,
+                            std::index_sequence<Is...>,
+                            Args&&... others)
+    {
+        if constexpr (meta::IsInvocableVT<FunctorT,
+                                          Args&&...,
+                                          CaseT<Entry, Is>...>::value)
+            return F(std::forward<Args>(others)..., CaseT<Entry, Is>{}...);
+        else
+            return F.DispatchError(std::forward<Args>(others)...,
+                                   CaseT<Entry, Is>{}...);
+    }
+
+    template <std::size_t Entry, typename... Args>
+    static ReturnT Call(FunctorT& F, Args&&... others)
+    {
+        return CallImpl<Entry>(F,
+                               std::make_index_sequence<num_values>{},
+                               std::forward<Args>(others)...);
+    }
+
+    template <typename... Args, std::size_t... Entries>
+    static constexpr auto MakeTable(std::index_sequence<Entries...>)
+    {
+        using FunctionPtr = ReturnT (*)(FunctorT&, Args&&...);
+        return std::array<FunctionPtr, sizeof...(Entries)>{
+            {&Call<Entries, Args...>...}};
+    }
+
+    template <typename... Args>
+    struct Table
+    {
+        static constexpr auto value = MakeTable<Args...>(
+            std::make_index_sequence<GetNumEntries()>{});
+    };
+
+public:
+    template <typename... Args>
+    static ReturnT Exec(FunctorT F,
+                        details::CaseValueType<CaseLists> const&... values,
+                        Args&&... others)
+    {
+        std::size_t const indices[] = {
+            details::FindCase(values, CaseLists{})...};
+        std::size_t entry = 0;
+        for (std::size_t i = 0; i < num_values; ++i)
+        {
+            if (indices[i] == sizes[i])
+                return F.DeductionError(values...,
+                                        std::forward<Args>(others)...);
+            entry = entry * sizes[i] + indices[i];
+        }
+        return Table<Args...>::value[entry](F, std::forward<Args>(others)...);
+    }
+};
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+} // namespace multimethods
+} // namespace h2
+#endif // H2_PATTERNS_MULTIMETHODS_VALUEDISPATCHER_HPP_
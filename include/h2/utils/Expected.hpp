@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H2_UTILS_EXPECTED_HPP_
+#define H2_UTILS_EXPECTED_HPP_
+
+#include "h2/utils/Error.hpp"
+
+#include <iosfwd>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/** @file Expected.hpp
+ *
+ *  A result type for reporting recoverable errors without exceptions.
+ *
+ *  An `Expected<T>` holds either a `T` or an `Error`. Neither the
+ *  success nor the failure path allocates: the error context is a
+ *  pointer to a string literal, so the type is cheap to return from
+ *  functions on hot paths such as tensor allocation.
+ *
+ *  In distconv, it is only used by the `try_allocate` functions of
+ *  memories and tensors and by the bias functions of the reference
+ *  convolution. Everything else keeps returning `int` status codes,
+ *  which `distconv::util::to_status` converts results to.
+ */
+
+/** @def H2_LIKELY(cond)
+ *  @brief Hint that `cond` is expected to be true.
+ */
+/** @def H2_UNLIKELY(cond)
+ *  @brief Hint that `cond` is expected to be false.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define H2_LIKELY(cond) __builtin_expect(!!(cond), 1)
+#define H2_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+#else
+#define H2_LIKELY(cond) (cond)
+#define H2_UNLIKELY(cond) (cond)
+#endif
+
+/** @def H2_MAKE_ERROR(code, context)
+ *  @brief Construct an h2::Error that records the current source
+ *         location.
+ *
+ *  @param code An h2::ErrorCode enumerator, without the scope.
+ *  @param context A string literal describing the failure.
+ */
+#define H2_MAKE_ERROR(code, context)                                           \
+    ::h2::Error(::h2::ErrorCode::code, context, __FILE__, __LINE__)
+
+/** @def H2_UNEXPECTED(code, context)
+ *  @brief Return an h2::Error from a function returning an Expected.
+ */
+#define H2_UNEXPECTED(code, context)                                           \
+    ::h2::make_unexpected(H2_MAKE_ERROR(code, context))
+
+/** @def H2_PROPAGATE_ERROR(expr)
+ *  @brief Evaluate `expr`, which must yield an Expected, and return
+ *         its error from the enclosing function if there is one.
+ */
+#define H2_PROPAGATE_ERROR(expr)                                               \
+    do                                                                         \
+    {                                                                          \
+        auto&& h2_propagate_result_ = (expr);                                  \
+        if (H2_UNLIKELY(!h2_propagate_result_.has_value()))                    \
+            return ::h2::make_unexpected(                                      \
+                std::move(h2_propagate_result_).error());                      \
+    } while (0)
+
+namespace h2
+{
+
+/** @brief Categories of recoverable errors. */
+enum class ErrorCode : int
+{
+    InvalidArgument = 1,
+    OutOfMemory,
+    NotImplemented,
+    NotSupported,
+    Communication,
+    Internal,
+}; // enum class ErrorCode
+
+/** @brief Get a human-readable name of the error code. */
+char const* to_string(ErrorCode code) noexcept;
+
+/** @brief Description of a failure.
+ *
+ *  The context and file strings are not owned; they are expected to be
+ *  string literals.
+ */
+class Error
+{
+public:
+    constexpr Error(ErrorCode code,
+                    char const* context = "",
+                    char const* file = "",
+                    int line = 0) noexcept
+        : m_code{code}, m_context{context}, m_file{file}, m_line{line}
+    {}
+
+    constexpr ErrorCode code() const noexcept { return m_code; }
+    constexpr char const* context() const noexcept { return m_context; }
+    constexpr char const* file() const noexcept { return m_file; }
+    constexpr int line() const noexcept { return m_line; }
+
+private:
+    ErrorCode m_code;
+    char const* m_context;
+    char const* m_file;
+    int m_line;
+}; // class Error
+
+/** @brief Print "<code>: <context> (<file>:<line>)". */
+std::ostream& operator<<(std::ostream& os, Error const& err);
+
+/** @brief Thrown when the value of an Expected holding an error is
+ *         accessed with a checked accessor.
+ */
+H2_DEFINE_FORWARDING_EXCEPTION(BadExpectedAccess, std::logic_error);
+
+/** @brief Wrapper marking a value as an error for Expected's
+ *         constructors.
+ */
+template <typename E>
+class Unexpected
+{
+public:
+    constexpr explicit Unexpected(E const& err) : m_error{err} {}
+    constexpr explicit Unexpected(E&& err) : m_error{std::move(err)} {}
+
+    constexpr E const& error() const& noexcept { return m_error; }
+    constexpr E& error() & noexcept { return m_error; }
+    constexpr E&& error() && noexcept { return std::move(m_error); }
+
+private:
+    E m_error;
+}; // class Unexpected
+
+template <typename E>
+constexpr Unexpected<std::decay_t<E>> make_unexpected(E&& err)
+{
+    return Unexpected<std::decay_t<E>>(std::forward<E>(err));
+}
+
+/** @brief Either a value of type T or an error of type E.
+ *
+ *  The unchecked accessors (`operator*`, `operator->`) are intended
+ *  for use after testing `has_value()`; `value()` throws
+ *  BadExpectedAccess instead.
+ */
+template <typename T, typename E = Error>
+class Expected
+{
+    static_assert(!std::is_reference<T>::value,
+                  "Expected does not support references");
+    static_assert(!std::is_same<std::decay_t<T>, Unexpected<E>>::value,
+                  "Expected<Unexpected<E>> is ill-formed");
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    template <typename U = T,
+              typename = std::enable_if_t<
+                  std::is_default_constructible<U>::value>>
+    constexpr Expected() : m_storage{std::in_place_index<0>}
+    {}
+
+    template <typename U = T,
+              typename = std::enable_if_t<
+                  std::is_constructible<T, U&&>::value
+                  && !std::is_same<std::decay_t<U>, Expected>::value
+                  && !std::is_same<std::decay_t<U>, Unexpected<E>>::value>>
+    constexpr Expected(U&& value)
+        : m_storage{std::in_place_index<0>, std::forward<U>(value)}
+    {}
+
+    template <typename G>
+    constexpr Expected(Unexpected<G> const& err)
+        : m_storage{std::in_place_index<1>, err.error()}
+    {}
+
+    template <typename G>
+    constexpr Expected(Unexpected<G>&& err)
+        : m_storage{std::in_place_index<1>, std::move(err).error()}
+    {}
+
+    constexpr bool has_value() const noexcept
+    {
+        return H2_LIKELY(m_storage.index() == 0);
+    }
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+
+    constexpr T& operator*() & noexcept { return *std::get_if<0>(&m_storage); }
+    constexpr T const& operator*() const& noexcept
+    {
+        return *std::get_if<0>(&m_storage);
+    }
+    constexpr T&& operator*() && noexcept
+    {
+        return std::move(*std::get_if<0>(&m_storage));
+    }
+    constexpr T* operator->() noexcept { return std::get_if<0>(&m_storage); }
+    constexpr T const* operator->() const noexcept
+    {
+        return std::get_if<0>(&m_storage);
+    }
+
+    T& value() &
+    {
+        check_value();
+        return **this;
+    }
+    T const& value() const&
+    {
+        check_value();
+        return **this;
+    }
+    T&& value() &&
+    {
+        check_value();
+        return std::move(**this);
+    }
+
+    template <typename U>
+    constexpr T value_or(U&& other) const&
+    {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(other));
+    }
+    template <typename U>
+    constexpr T value_or(U&& other) &&
+    {
+        return has_value() ? std::move(**this)
+                           : static_cast<T>(std::forward<U>(other));
+    }
+
+    constexpr E& error() & noexcept { return *std::get_if<1>(&m_storage); }
+    constexpr E const& error() const& noexcept
+    {
+        return *std::get_if<1>(&m_storage);
+    }
+    constexpr E&& error() && noexcept
+    {
+        return std::move(*std::get_if<1>(&m_storage));
+    }
+
+private:
+    void check_value() const
+    {
+        H2_ASSERT_MSG(has_value(),
+                      BadExpectedAccess,
+                      "Accessing the value of an Expected holding an error");
+    }
+
+    std::variant<T, E> m_storage;
+}; // class Expected
+
+/** @brief Specialization for functions that only report success or
+ *         failure.
+ */
+template <typename E>
+class Expected<void, E>
+{
+public:
+    using value_type = void;
+    using error_type = E;
+
+    constexpr Expected() noexcept : m_storage{std::in_place_index<0>} {}
+
+    template <typename G>
+    constexpr Expected(Unexpected<G> const& err)
+        : m_storage{std::in_place_index<1>, err.error()}
+    {}
+
+    template <typename G>
+    constexpr Expected(Unexpected<G>&& err)
+        : m_storage{std::in_place_index<1>, std::move(err).error()}
+    {}
+
+    constexpr bool has_value() const noexcept
+    {
+        return H2_LIKELY(m_storage.index() == 0);
+    }
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+
+    void value() const
+    {
+        H2_ASSERT_MSG(has_value(),
+                      BadExpectedAccess,
+                      "Accessing the value of an Expected holding an error");
+    }
+
+    constexpr E& error() & noexcept { return *std::get_if<1>(&m_storage); }
+    constexpr E const& error() const& noexcept
+    {
+        return *std::get_if<1>(&m_storage);
+    }
+    constexpr E&& error() && noexcept
+    {
+        return std::move(*std::get_if<1>(&m_storage));
+    }
+
+private:
+    std::variant<std::monostate, E> m_storage;
+}; // class Expected<void, E>
+
+} // namespace h2
+#endif // H2_UTILS_EXPECTED_HPP_
@@ -4,6 +4,9 @@
 #include "distconv/vector.hpp"
 #include "distconv/util/cxxopts.hpp"
 #include "distconv/tensor/tensor_base.hpp"
+#include "benchmark_results.hpp"
+#include "h2/meta/TypeList.hpp"
+#include "h2/patterns/multimethods/ValueDispatcher.hpp"
 #include <cstdlib>
 #include <vector>
 #include <algorithm>
@@ -38,6 +41,18 @@ struct GetType<BenchmarkDataType::HALF> {
 };
 #endif // H2_HAS_HALF
 
+// Host-only builds run the reference backend with MPI communication
+#ifdef DISTCONV_HAS_CUDNN
+constexpr char default_backend[] = "CUDNN";
+#else
+constexpr char default_backend[] = "Ref";
+#endif
+#ifdef H2_HAS_GPU
+constexpr char default_comm_method[] = "AL";
+#else
+constexpr char default_comm_method[] = "MPI";
+#endif
+
 const unsigned input_tensor_seed = 0;
 const unsigned filter_tensor_seed = 1;
 const unsigned d_output_tensor_seed = 2;
@@ -145,6 +160,7 @@ class BenchmarkConfig {
   std::string backend;
 
   std::string output_file;
+  std::string results_file;
   bool dump_input;
   bool dump_output;
   bool dump_binary;
@@ -197,8 +213,9 @@ class BenchmarkConfig {
             conv_bwd_data_algo("DEFAULT"),
             conv_bwd_filter_algo("DEFAULT"),
             pooling_mode("MAX"),
-            backend("CUDNN"),
+            backend(default_backend),
             output_file("results"),
+            results_file(""),
             dump_input(false),
             dump_output(false),
             dump_binary(false),
@@ -223,6 +240,7 @@ class BenchmarkConfig {
     run_count = pr["num-runs"].as<int>();
     warming_up_count = pr["num-warmup-runs"].as<int>();
     output_file = pr["output-file"].as<std::string>();
+    results_file = pr["results-file"].as<std::string>();
     substitute_nd_argument(i_n, i_c, i_s, pr["image-size"].as<std::string>());
     {
       const auto s = pr["filter-size"].as<std::string>();
@@ -460,6 +478,43 @@ class BenchmarkConfig {
     return os;
   }
 
+  void record_config(BenchmarkResults::Record &rec) const {
+    const auto reverse = [](const int_vector &v) {
+      return distconv::util::reverse(v);
+    };
+    std::string type_name = data_type == BenchmarkDataType::FLOAT ? "float" :
+        data_type == BenchmarkDataType::DOUBLE ? "double" : "half";
+    rec.set_config("num_samples", i_n)
+        .set_config("num_channels", i_c)
+        .set_config("image_size", reverse(i_s))
+        .set_config("num_filters", f_k)
+        .set_config("filter_size", reverse(f_s))
+        .set_config("pads", reverse(pads))
+        .set_config("strides", reverse(strides))
+        .set_config("dilations", reverse(dilations))
+        .set_config("num_groups", num_groups)
+        .set_config("use_bias", use_bias)
+        .set_config("proc_n", p_n)
+        .set_config("proc_c", p_c)
+        .set_config("proc_spatial", reverse(p_s))
+        .set_config("proc_f", p_f)
+        .set_config("backend", backend)
+        .set_config("data_type", type_name)
+        .set_config("conv_fwd_algo", conv_fwd_algo)
+        .set_config("conv_bwd_data_algo", conv_bwd_data_algo)
+        .set_config("conv_bwd_filter_algo", conv_bwd_filter_algo)
+        .set_config("pooling_mode", pooling_mode)
+        .set_config("halo_exchange_method", halo_exchange_method)
+        .set_config("overlap_halo_exchange", overlap_halo_exchange)
+        .set_config("shuffle_method", shuffle_method)
+        .set_config("batchnorm_impl", batchnorm_impl)
+        .set_config("chanfilt_algo", chanfilt_algo)
+        .set_config("global_stat", global_stat)
+        .set_config("deconv", deconv)
+        .set_config("num_warmup_runs", warming_up_count)
+        .set_config("num_runs", run_count);
+  }
+
   // Parse `arg` as a space-separated int vector and substitute the
   // elements to `spatials`.
   static void substitute_nd_argument(int_vector &spatials,
@@ -527,6 +582,7 @@ inline BenchmarkConfig<NSD> process_opt(int argc, char *argv[], int pid,
       ("r,num-runs", "Number of runs", cxxopts::value<int>()->default_value("5"))
       ("num-warmup-runs", "Number of warming-up runs", cxxopts::value<int>()->default_value("5"))
       ("o,output-file", "Save performance profile to file", cxxopts::value<std::string>()->default_value("results"))
+      ("results-file", "Save results to a JSON or CSV (*.csv) file", cxxopts::value<std::string>()->default_value(""))
       ("image-size", "Image size" + shape_notation, cxxopts::value<std::string>()->default_value(default_image_size))
       ("filter-size", "Filter size" + filter_shape_notation, cxxopts::value<std::string>()->default_value(default_filter_size))
       ("no-padding", "Does not use padding", cxxopts::value<bool>()->default_value("false"))
@@ -540,11 +596,11 @@ inline BenchmarkConfig<NSD> process_opt(int argc, char *argv[], int pid,
       ("g,conv-bwd-data-algo", "Convolution bwd data algorithm", cxxopts::value<std::string>()->default_value("DEFAULT"))
       ("k,conv-bwd-filter-algo", "Convolution bwd filter algorithm", cxxopts::value<std::string>()->default_value("DEFAULT"))
       ("pooling-mode", "Pooling mode", cxxopts::value<std::string>()->default_value("MAX"))
-      ("b,backend", "Convolution backend", cxxopts::value<std::string>()->default_value("CUDNN"))
+      ("b,backend", "Convolution backend", cxxopts::value<std::string>()->default_value(default_backend))
       ("data-type", "Data type", cxxopts::value<std::string>()->default_value("float"))
       ("mode", "Test mode", cxxopts::value<std::string>()->default_value("NORMAL"))
-      ("halo-exchange-method", "Halo exchange method", cxxopts::value<std::string>()->default_value("AL"))
-      ("shuffle-method", "Shuffle method", cxxopts::value<std::string>()->default_value("AL"))
+      ("halo-exchange-method", "Halo exchange method", cxxopts::value<std::string>()->default_value(default_comm_method))
+      ("shuffle-method", "Shuffle method", cxxopts::value<std::string>()->default_value(default_comm_method))
       ("bn-impl", "Batchnorm implementation", cxxopts::value<std::string>()->default_value("MPI"))
 
       ("num-dims", "Number of spatial dimensions", cxxopts::value<int>())
@@ -552,7 +608,7 @@ inline BenchmarkConfig<NSD> process_opt(int argc, char *argv[], int pid,
       ("i,dump-input", "Dump input tensors")
       ("d,dump-output", "Dump output tensors")
       ("dump", "Dump input and output tensors")
-      ("dump-binary", "Dump tensor in a binary format")
+      ("dump-binary", "Dump tensors in a binary format with parallel MPI-IO")
       ("profile", "Enable detailed profiling")
       ("nvtx", "Enable NVTX-based region marking")
       ("overlap", "Overlap halo exchanges")
@@ -581,6 +637,45 @@ inline BenchmarkConfig<NSD> process_opt(int argc, char *argv[], int pid,
   return o;
 }
 
+namespace internal {
+
+template <typename F>
+struct ValueDispatchFunctor {
+  F f;
+  template <typename Case>
+  bool operator()(Case c) {
+    f(c);
+    return true;
+  }
+  template <typename... Ts>
+  bool DeductionError(Ts&&...) {
+    return false;
+  }
+  template <typename... Ts>
+  bool DispatchError(Ts&&...) {
+    return false;
+  }
+};
+
+} // namespace internal
+
+/**
+   Call f with the case of Cases, a typelist of
+   h2::multimethods::ValueCase, whose value is v. This selects a
+   template instantiation through a jump table instead of an if
+   chain. Returns false if no case matches v.
+ */
+template <typename Cases, typename ValueType, typename F>
+bool dispatch_value(const ValueType &v, F f) {
+  using Functor = internal::ValueDispatchFunctor<F>;
+  return h2::multimethods::ValueDispatcher<Functor, bool, Cases>::Exec(
+      Functor{f}, v);
+}
+
+// Numbers of spatial dimensions the benchmarks are instantiated for
+using NumDimsCases = h2::meta::TL<h2::multimethods::ValueCase<2>,
+                                  h2::multimethods::ValueCase<3>>;
+
 int parse_num_dims(int argc, char *argv[]) {
   // Parse only the --num-dims argument. This have to be done before
   // `process_opt` since it requires the `NSD` template parameter,
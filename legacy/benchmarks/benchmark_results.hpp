@@ -0,0 +1,427 @@
+#pragma once
+
+#include "distconv_config.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <mpi.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+  Benchmark results in a schema common to all the benchmarks, which
+  scripts/compare_results.py reads to detect regressions.
+
+  A result set has the environment, the build flags and a list of
+  records. Each record has configuration parameters and timing
+  metrics in milliseconds. The time of each iteration of a metric is
+  that of the slowest rank, and statistics of each rank are kept as
+  well.
+
+  JSON files hold all of them. CSV files have one row per rank and
+  iteration of each metric, with the configuration parameters as
+  columns; the aggregated rows over ranks have rank "max".
+ */
+
+namespace distconv_benchmark {
+
+class BenchmarkResults {
+ public:
+  static constexpr int schema_version = 1;
+
+  struct Stats {
+    float min;
+    float mean;
+    float median;
+    float max;
+    float stdev;
+  };
+
+  // Benchmarks without MPI run as a single process
+  static void get_rank_and_size(MPI_Comm comm, int &pid, int &np) {
+    int initialized;
+    DISTCONV_CHECK_MPI(MPI_Initialized(&initialized));
+    if (!initialized) {
+      pid = 0;
+      np = 1;
+      return;
+    }
+    DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &pid));
+    DISTCONV_CHECK_MPI(MPI_Comm_size(comm, &np));
+  }
+
+  class Metric {
+   public:
+    std::string name;
+    // Per-iteration times of the slowest rank
+    std::vector<float> iterations;
+    // Per-iteration times of each rank
+    std::vector<std::vector<float>> rank_iterations;
+
+    static Stats get_stats(std::vector<float> v) {
+      Stats s{0, 0, 0, 0, 0};
+      if (v.empty()) return s;
+      std::sort(v.begin(), v.end());
+      s.min = v.front();
+      s.max = v.back();
+      s.median = v.size() % 2 ? v[v.size() / 2] :
+          (v[v.size() / 2 - 1] + v[v.size() / 2]) / 2;
+      s.mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+      if (v.size() > 1) {
+        double sq = 0;
+        for (auto x: v) sq += (x - s.mean) * (x - s.mean);
+        s.stdev = std::sqrt(sq / (v.size() - 1));
+      }
+      return s;
+    }
+  };
+
+  class Record {
+   public:
+    Record(MPI_Comm comm): m_comm(comm) {}
+
+    // Arithmetic values are written as numbers, and the others as
+    // strings formatted with operator<<.
+    template <typename T>
+    Record &set_config(const std::string &key, const T &value) {
+      std::stringstream ss;
+      if constexpr (std::is_same<T, bool>::value) {
+        ss << (value ? "true" : "false");
+      } else {
+        ss << value;
+      }
+      m_config.emplace_back(key, std::make_pair(
+          ss.str(), std::is_arithmetic<T>::value));
+      return *this;
+    }
+
+    Record &set_config(const std::string &key, const char *value) {
+      return set_config(key, std::string(value));
+    }
+
+    template <typename T>
+    Record &set_config(const std::string &key, const std::vector<T> &value) {
+      return set_config(key, distconv::util::join_array(value, "x"));
+    }
+
+    // Gathers the local times of all ranks to the root. This must be
+    // called by all the ranks of the communicator.
+    Record &add_timings(const std::string &name,
+                        const std::vector<float> &times) {
+      int pid, np;
+      get_rank_and_size(m_comm, pid, np);
+      int count = times.size();
+      std::vector<int> counts(np, count), displs(np, 0);
+      std::vector<float> all(times);
+      if (np > 1) {
+        DISTCONV_CHECK_MPI(MPI_Gather(&count, 1, MPI_INT, counts.data(), 1,
+                                      MPI_INT, 0, m_comm));
+        std::partial_sum(counts.begin(), counts.end() - 1,
+                         displs.begin() + 1);
+        all.resize(pid == 0 ? displs.back() + counts.back() : 0);
+        DISTCONV_CHECK_MPI(MPI_Gatherv(times.data(), count, MPI_FLOAT,
+                                       all.data(), counts.data(),
+                                       displs.data(), MPI_FLOAT, 0, m_comm));
+      }
+      if (pid != 0) return *this;
+      Metric m;
+      m.name = name;
+      for (int i = 0; i < np; ++i) {
+        m.rank_iterations.emplace_back(all.begin() + displs[i],
+                                       all.begin() + displs[i] + counts[i]);
+        const auto &r = m.rank_iterations.back();
+        if (m.iterations.size() < r.size()) {
+          m.iterations.resize(r.size(), 0);
+        }
+        for (size_t j = 0; j < r.size(); ++j) {
+          m.iterations[j] = std::max(m.iterations[j], r[j]);
+        }
+      }
+      m_metrics.push_back(std::move(m));
+      return *this;
+    }
+
+    // The config value and whether it is a number
+    const std::vector<std::pair<std::string, std::pair<std::string, bool>>>
+    &get_config() const {
+      return m_config;
+    }
+
+    const std::vector<Metric> &get_metrics() const {
+      return m_metrics;
+    }
+
+   private:
+    MPI_Comm m_comm;
+    std::vector<std::pair<std::string, std::pair<std::string, bool>>>
+    m_config;
+    std::vector<Metric> m_metrics;
+  };
+
+  BenchmarkResults(const std::string &benchmark, MPI_Comm comm):
+      m_benchmark(benchmark), m_comm(comm) {
+    set_environment();
+  }
+
+  // The returned reference stays valid while this object lives
+  Record &add_record() {
+    m_records.emplace_back(m_comm);
+    return m_records.back();
+  }
+
+  // Writes the results at the root. The format is CSV if the path
+  // ends with .csv, and JSON otherwise.
+  void write(const std::string &path) const {
+    int pid, np;
+    get_rank_and_size(m_comm, pid, np);
+    if (pid != 0) return;
+    std::ofstream ofs(path);
+    if (!ofs) {
+      distconv::util::MPIRootPrintStreamError()
+          << "Failed to open " << path;
+      return;
+    }
+    const std::string csv_ext = ".csv";
+    if (path.size() >= csv_ext.size() &&
+        path.compare(path.size() - csv_ext.size(), csv_ext.size(),
+                     csv_ext) == 0) {
+      write_csv(ofs);
+    } else {
+      write_json(ofs);
+    }
+  }
+
+  void write_json(std::ostream &os) const {
+    os << "{\n"
+       << "  \"schema_version\": " << schema_version << ",\n"
+       << "  \"benchmark\": " << quote(m_benchmark) << ",\n"
+       << "  \"environment\": ";
+    write_json_object(os, m_environment, "  ");
+    os << ",\n  \"build\": ";
+    write_json_object(os, get_build_flags(), "  ");
+    os << ",\n  \"records\": [";
+    for (size_t i = 0; i < m_records.size(); ++i) {
+      const auto &rec = m_records[i];
+      os << (i ? "," : "") << "\n    {\n      \"config\": ";
+      write_json_object(os, rec.get_config(), "      ");
+      os << ",\n      \"metrics\": {";
+      const auto &metrics = rec.get_metrics();
+      for (size_t j = 0; j < metrics.size(); ++j) {
+        write_json_metric(os, metrics[j], j == 0);
+      }
+      os << "\n      }\n    }";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  void write_csv(std::ostream &os) const {
+    // The union of the config keys of all records in their order of
+    // appearance
+    std::vector<std::string> keys;
+    for (const auto &rec: m_records) {
+      for (const auto &kv: rec.get_config()) {
+        if (std::find(keys.begin(), keys.end(), kv.first) == keys.end()) {
+          keys.push_back(kv.first);
+        }
+      }
+    }
+    os << "benchmark";
+    for (const auto &k: keys) os << "," << k;
+    os << ",metric,rank,iteration,time_ms\n";
+    for (const auto &rec: m_records) {
+      std::stringstream prefix;
+      prefix << m_benchmark;
+      for (const auto &k: keys) {
+        prefix << ",";
+        for (const auto &kv: rec.get_config()) {
+          if (kv.first == k) {
+            prefix << csv_field(kv.second.first);
+            break;
+          }
+        }
+      }
+      for (const auto &m: rec.get_metrics()) {
+        for (size_t i = 0; i < m.iterations.size(); ++i) {
+          os << prefix.str() << "," << m.name << ",max," << i << ","
+             << m.iterations[i] << "\n";
+        }
+        for (size_t r = 0; r < m.rank_iterations.size(); ++r) {
+          for (size_t i = 0; i < m.rank_iterations[r].size(); ++i) {
+            os << prefix.str() << "," << m.name << "," << r << "," << i
+               << "," << m.rank_iterations[r][i] << "\n";
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  using KeyValues =
+      std::vector<std::pair<std::string, std::pair<std::string, bool>>>;
+
+  std::string m_benchmark;
+  MPI_Comm m_comm;
+  KeyValues m_environment;
+  std::deque<Record> m_records;
+
+  void set_environment() {
+    int pid, np;
+    get_rank_and_size(m_comm, pid, np);
+    char hostname[256] = {0};
+    gethostname(hostname, sizeof(hostname) - 1);
+    char mpi_version[MPI_MAX_LIBRARY_VERSION_STRING];
+    int len;
+    DISTCONV_CHECK_MPI(MPI_Get_library_version(mpi_version, &len));
+    std::string mpi_version_str(mpi_version, len);
+    mpi_version_str.erase(
+        std::find_if(mpi_version_str.begin(), mpi_version_str.end(),
+                     [](char c) { return c == '\n' || c == '\0'; }),
+        mpi_version_str.end());
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ",
+                  std::gmtime(&now));
+    m_environment = {
+      {"hostname", {hostname, false}},
+      {"num_processes", {std::to_string(np), true}},
+      {"mpi_library", {mpi_version_str, false}},
+      {"timestamp", {timestamp, false}},
+    };
+  }
+
+  static KeyValues get_build_flags() {
+    const auto flag = [](bool b) {
+      return std::make_pair(std::string(b ? "true" : "false"), true);
+    };
+    KeyValues flags = {
+#if defined(__clang__)
+      {"compiler", {"clang " __clang_version__, false}},
+#elif defined(__GNUC__)
+      {"compiler", {"gcc " __VERSION__, false}},
+#else
+      {"compiler", {"unknown", false}},
+#endif
+      {"h2_version", {std::to_string(H2_VERSION_MAJOR) + "." +
+                      std::to_string(H2_VERSION_MINOR) + "." +
+                      std::to_string(H2_VERSION_PATCH), false}},
+#ifdef NDEBUG
+      {"debug", flag(false)},
+#else
+      {"debug", flag(true)},
+#endif
+      {"H2_HAS_CUDA", flag(H2_HAS_CUDA)},
+      {"H2_HAS_ROCM", flag(H2_HAS_ROCM)},
+#ifdef _OPENMP
+      {"openmp", flag(true)},
+#else
+      {"openmp", flag(false)},
+#endif
+#ifdef DISTCONV_HAS_CUDNN
+      {"DISTCONV_HAS_CUDNN", flag(true)},
+#else
+      {"DISTCONV_HAS_CUDNN", flag(false)},
+#endif
+#ifdef DISTCONV_HAS_P2P
+      {"DISTCONV_HAS_P2P", flag(true)},
+#else
+      {"DISTCONV_HAS_P2P", flag(false)},
+#endif
+#ifdef DISTCONV_HAS_NVSHMEM
+      {"DISTCONV_HAS_NVSHMEM", flag(true)},
+#else
+      {"DISTCONV_HAS_NVSHMEM", flag(false)},
+#endif
+    };
+    return flags;
+  }
+
+  static std::string quote(const std::string &s) {
+    std::stringstream ss;
+    ss << '"';
+    for (char c: s) {
+      switch (c) {
+        case '"': ss << "\\\""; break;
+        case '\\': ss << "\\\\"; break;
+        case '\n': ss << "\\n"; break;
+        case '\t': ss << "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+               << static_cast<int>(c) << std::dec;
+          } else {
+            ss << c;
+          }
+      }
+    }
+    ss << '"';
+    return ss.str();
+  }
+
+  static std::string csv_field(const std::string &s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string q = "\"";
+    for (char c: s) {
+      if (c == '"') q += '"';
+      q += c;
+    }
+    return q + "\"";
+  }
+
+  static void write_json_object(std::ostream &os, const KeyValues &kvs,
+                                const std::string &indent) {
+    os << "{";
+    for (size_t i = 0; i < kvs.size(); ++i) {
+      const auto &v = kvs[i].second;
+      os << (i ? "," : "") << "\n" << indent << "  " << quote(kvs[i].first)
+         << ": " << (v.second ? v.first : quote(v.first));
+    }
+    os << "\n" << indent << "}";
+  }
+
+  static void write_json_array(std::ostream &os,
+                               const std::vector<float> &v) {
+    os << "[";
+    for (size_t i = 0; i < v.size(); ++i) {
+      os << (i ? ", " : "") << v[i];
+    }
+    os << "]";
+  }
+
+  static void write_json_stats(std::ostream &os, const Stats &s) {
+    os << "\"min\": " << s.min << ", \"mean\": " << s.mean
+       << ", \"median\": " << s.median << ", \"max\": " << s.max
+       << ", \"stdev\": " << s.stdev;
+  }
+
+  static void write_json_metric(std::ostream &os, const Metric &m,
+                                bool first) {
+    const std::string indent = "          ";
+    os << (first ? "" : ",") << "\n        " << quote(m.name) << ": {\n"
+       << indent << "\"unit\": \"ms\",\n"
+       << indent << "\"iterations\": ";
+    write_json_array(os, m.iterations);
+    os << ",\n" << indent << "\"summary\": {";
+    write_json_stats(os, Metric::get_stats(m.iterations));
+    os << "},\n" << indent << "\"per_rank\": [";
+    for (size_t r = 0; r < m.rank_iterations.size(); ++r) {
+      os << (r ? "," : "") << "\n" << indent << "  {\"rank\": " << r << ", ";
+      write_json_stats(os, Metric::get_stats(m.rank_iterations[r]));
+      os << "}";
+    }
+    os << "\n" << indent << "]\n        }";
+  }
+};
+
+} // namespace distconv_benchmark
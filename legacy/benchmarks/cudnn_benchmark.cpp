@@ -261,6 +261,17 @@ class Profile {
 
   Profile(const BenchmarkConfig<NSD> &cfg): m_cfg(cfg) {}
 
+  static constexpr char name[] = "cudnn_benchmark";
+
+  void record_timings(distconv_benchmark::BenchmarkResults::Record &rec) const {
+    rec.add_timings("conv_fwd", conv_fwd_time)
+        .add_timings("conv_bwd_data", conv_bwd_data_time)
+        .add_timings("conv_bwd_filter", conv_bwd_filter_time);
+    if (m_cfg.use_bias) {
+      rec.add_timings("conv_bwd_bias", conv_bwd_bias_time);
+    }
+  }
+
   std::ostream &print_as_row(std::ostream &os) {
     for (size_t i = 0; i < conv_fwd_time.size(); ++i) {
       std::stringstream ss;
@@ -967,6 +978,15 @@ int run(const BenchmarkConfig<NSD> &cfg) {
 
   prof.print_as_row(*output_stream);
 
+  if (!cfg.results_file.empty()) {
+    distconv_benchmark::BenchmarkResults results(Profile<NSD>::name,
+                                                 MPI_COMM_SELF);
+    auto &rec = results.add_record();
+    cfg.record_config(rec);
+    prof.record_timings(rec);
+    results.write(cfg.results_file);
+  }
+
   if (cfg.dump_output) {
     size_t output_tensor_size = calc_len(cfg.i_n, cfg.f_k,
                                          output_spatial_dims);
@@ -1018,11 +1038,11 @@ int main(int argc, char *argv[]) {
 
   const int nsd = distconv_benchmark::parse_num_dims(argc, argv);
 
-  if(nsd == 2) {
-    run<2>(argc, argv);
-  } else if(nsd == 3) {
-    run<3>(argc, argv);
-  } else {
+  const bool valid = distconv_benchmark::dispatch_value<
+    distconv_benchmark::NumDimsCases>(nsd, [&](auto nsd_case) {
+      run<decltype(nsd_case)::value>(argc, argv);
+    });
+  if (!valid) {
     util::PrintStreamError() << "Invalid --num-dims: " << nsd;
     std::exit(1);
   }
@@ -0,0 +1,295 @@
+#include "benchmark_common.hpp"
+#include "distconv/deep_halo.hpp"
+#include "distconv/distconv.hpp"
+#include "distconv/perf_model.hpp"
+#include "distconv/planner.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/cxxopts.hpp"
+#include "distconv/util/stopwatch.h"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/*
+  Runs the forward pass of a chain of convolutions of the same shape
+  on the host with deep halos of several depths. Depth 1 exchanges
+  halos before every layer, and depth D exchanges D-times wider halos
+  before every D layers and recomputes the borders instead. Each row
+  reports the halo exchanges per pass, the floating-point operations
+  of the busiest rank, and the predicted and measured times of a
+  pass. The depth selected by the performance model is marked as
+  "auto". Outputs of all depths are checked against depth 1.
+ */
+
+using DataType = float;
+using namespace distconv;
+using distconv::tensor::Shape;
+
+namespace distconv_benchmark {
+
+using Chain = DeepHaloConvolutionChain<DataType>;
+
+struct DeepHaloConfig {
+  int num_dims;
+  int size;
+  int num_channels;
+  int num_samples;
+  int num_layers;
+  int filter_size;
+  std::vector<int> grid;
+  std::vector<std::string> depths;
+  std::string cache_path;
+  int warming_up_count;
+  int run_count;
+  bool verify;
+  std::string results_file;
+};
+
+// Values are small so that sums over the chain stay in range
+inline void init_input(Chain::TensorType &t) {
+  const auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    const auto idx = t.get_global_index(*it);
+    index_t v = 0;
+    for (int i = 0; i < idx.length(); ++i) v = v * 3 + idx[i];
+    t.set(*it, (DataType)(v % 7) / 7);
+  }
+}
+
+inline void init_filters(Chain &chain) {
+  for (int l = 0; l < chain.get_num_layers(); ++l) {
+    auto &f = chain.get_filter(l);
+    for (size_t i = 0; i < f.size(); ++i) {
+      f[i] = (DataType)((i + l) % 5) / (5 * f.size());
+    }
+  }
+}
+
+inline std::unique_ptr<Chain> make_chain(const DeepHaloConfig &cfg,
+                                         const tensor::LocaleMPI &loc,
+                                         int depth) {
+  const int nsd = cfg.num_dims;
+  Shape shape(nsd, cfg.size);
+  shape.push_back(cfg.num_channels);
+  shape.push_back(cfg.num_samples);
+  Shape proc_shape(nsd + 2, 1);
+  for (int i = 0; i < nsd; ++i) proc_shape[i] = cfg.grid[i];
+  auto chain = std::make_unique<Chain>(
+      loc, proc_shape, shape, int_vector(cfg.num_layers, cfg.num_channels),
+      std::vector<int_vector>(cfg.num_layers,
+                              int_vector(nsd, cfg.filter_size)),
+      depth);
+  init_input(chain->get_input());
+  init_filters(*chain);
+  return chain;
+}
+
+// Returns the number of output elements that differ from ref
+inline int compare_outputs(const Chain &chain, const Chain &ref) {
+  const auto &t = chain.get_output();
+  const auto &r = ref.get_output();
+  const auto local_shape = t.get_local_shape();
+  int num_errors = 0;
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    const DataType x = t.get(*it);
+    const DataType y = r.get(*it);
+    if (std::abs(x - y) > 1e-5 * std::max<DataType>(std::abs(y), 1)) {
+      ++num_errors;
+    }
+  }
+  return num_errors;
+}
+
+inline DeepHaloConfig process_opt(int argc, char *argv[], int pid,
+                                  int np) {
+  cxxopts::Options cmd_opts(argv[0], "Host Deep Halo Benchmark");
+  cmd_opts.add_options()
+      ("num-dims", "Number of spatial dimensions",
+       cxxopts::value<int>()->default_value("3"))
+      ("size", "Spatial size",
+       cxxopts::value<int>()->default_value("32"))
+      ("c,num-channels", "Number of channels of all layers",
+       cxxopts::value<int>()->default_value("8"))
+      ("n,num-samples", "Number of samples",
+       cxxopts::value<int>()->default_value("2"))
+      ("l,num-layers", "Number of layers",
+       cxxopts::value<int>()->default_value("4"))
+      ("filter-size", "Filter size of all spatial dimensions",
+       cxxopts::value<int>()->default_value("3"))
+      ("grid", "Comma-separated process grid of the spatial dimensions, "
+       "ordered from the innermost one (default: all processes at the "
+       "outermost one)",
+       cxxopts::value<std::string>()->default_value(""))
+      ("depths", "Comma-separated depths, where auto is the depth "
+       "selected by the performance model",
+       cxxopts::value<std::string>()->default_value("1,2,4,auto"))
+      ("cache", "Performance model cache file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("r,num-runs", "Number of runs",
+       cxxopts::value<int>()->default_value("5"))
+      ("num-warmup-runs", "Number of warming-up runs",
+       cxxopts::value<int>()->default_value("2"))
+      ("no-verify", "Skip checking the outputs against depth 1")
+      ("results-file", "Save results to a JSON or CSV (*.csv) file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("help", "Print help");
+  auto result = cmd_opts.parse(argc, argv);
+  if (result.count("help")) {
+    if (pid == 0) {
+      std::cout << cmd_opts.help() << "\n";
+    }
+    DISTCONV_CHECK_MPI(MPI_Finalize());
+    std::exit(0);
+  }
+  DeepHaloConfig cfg;
+  cfg.num_dims = result["num-dims"].as<int>();
+  cfg.size = result["size"].as<int>();
+  cfg.num_channels = result["num-channels"].as<int>();
+  cfg.num_samples = result["num-samples"].as<int>();
+  cfg.num_layers = result["num-layers"].as<int>();
+  cfg.filter_size = result["filter-size"].as<int>();
+  const auto grid = result["grid"].as<std::string>();
+  if (grid.empty()) {
+    cfg.grid.assign(cfg.num_dims, 1);
+    cfg.grid.back() = np;
+  } else {
+    cfg.grid = util::split_spaced_array<int>(grid);
+  }
+  cfg.depths = util::split_spaced_array<std::string>(
+      result["depths"].as<std::string>());
+  cfg.cache_path = result["cache"].as<std::string>();
+  cfg.run_count = result["num-runs"].as<int>();
+  cfg.warming_up_count = result["num-warmup-runs"].as<int>();
+  cfg.verify = result.count("no-verify") == 0;
+  cfg.results_file = result["results-file"].as<std::string>();
+  if ((int)cfg.grid.size() != cfg.num_dims ||
+      std::accumulate(cfg.grid.begin(), cfg.grid.end(), 1,
+                      std::multiplies<int>()) != np) {
+    util::MPIRootPrintStreamError()
+        << "Invalid process grid: " << util::join_array(cfg.grid, "x");
+    DISTCONV_CHECK_MPI(MPI_Finalize());
+    std::exit(1);
+  }
+  return cfg;
+}
+
+inline int run(const DeepHaloConfig &cfg, MPI_Comm comm) {
+  int pid;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &pid));
+  tensor::LocaleMPI loc(comm);
+  const int nsd = cfg.num_dims;
+
+  const auto m = perf_model::load_or_calibrate(comm, cfg.cache_path);
+  perf_model::ConvLayer layer;
+  layer.num_samples = cfg.num_samples;
+  layer.num_channels = cfg.num_channels;
+  layer.num_filters = cfg.num_channels;
+  layer.spatial.assign(nsd, cfg.size);
+  layer.filter.assign(nsd, cfg.filter_size);
+  layer.strides.assign(nsd, 1);
+  layer.pads.assign(nsd, (cfg.filter_size - 1) / 2);
+  layer.word_size = sizeof(DataType);
+  perf_model::ConvDecomposition decomp;
+  decomp.p_s = cfg.grid;
+  const int auto_depth = perf_model::plan_deep_halo_depth(
+      m, layer, decomp, cfg.num_layers);
+  util::MPIRootPrintStreamInfo() << "Selected depth: " << auto_depth;
+
+  std::unique_ptr<Chain> ref;
+  if (cfg.verify) {
+    ref = make_chain(cfg, loc, 1);
+    ref->forward();
+  }
+
+  if (pid == 0) {
+    std::cout << "depth exchanges flops predicted_ms forward_ms"
+              << std::endl;
+  }
+  BenchmarkResults results("deep_halo_benchmark_host", comm);
+  int num_failures = 0;
+  for (const auto &depth_str: cfg.depths) {
+    const int depth = depth_str == "auto" ? auto_depth
+        : std::stoi(depth_str);
+    if (depth < 1 || depth > cfg.num_layers) {
+      util::MPIRootPrintStreamInfo() << "Skipping depth " << depth;
+      continue;
+    }
+    auto chain = make_chain(cfg, loc, depth);
+    for (int i = 0; i < cfg.warming_up_count; ++i) {
+      chain->forward();
+    }
+    std::vector<float> times, local_times;
+    for (int i = 0; i < cfg.run_count; ++i) {
+      util::stopwatch_t st;
+      DISTCONV_CHECK_MPI(MPI_Barrier(comm));
+      util::stopwatch_start(&st);
+      chain->forward();
+      float time = util::stopwatch_stop(&st);
+      local_times.push_back(time);
+      // The slowest rank determines the time
+      DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_FLOAT,
+                                       MPI_MAX, comm));
+      times.push_back(time);
+    }
+
+    if (cfg.verify) {
+      int num_errors = compare_outputs(*chain, *ref);
+      DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &num_errors, 1,
+                                       MPI_INT, MPI_SUM, comm));
+      if (num_errors) {
+        util::MPIRootPrintStreamError()
+            << num_errors << " errors with depth " << depth;
+        ++num_failures;
+      }
+    }
+
+    double flops = chain->get_flops();
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &flops, 1, MPI_DOUBLE,
+                                     MPI_MAX, comm));
+    const double predicted = perf_model::predict_deep_halo_chain(
+        m, layer, decomp, cfg.num_layers, depth).get_total() * 1e3;
+    const std::string name = depth_str == "auto" ?
+        std::to_string(depth) + "(auto)" : depth_str;
+    if (pid == 0) {
+      std::cout << name << " " << chain->get_num_exchanges() << " "
+                << flops << " " << predicted << " " << get_median(times)
+                << std::endl;
+    }
+    if (!cfg.results_file.empty()) {
+      results.add_record()
+          .set_config("depth", name)
+          .set_config("num_layers", cfg.num_layers)
+          .set_config("size", cfg.size)
+          .set_config("grid", cfg.grid)
+          .set_config("num_runs", cfg.run_count)
+          .add_timings("forward", local_times);
+    }
+  }
+  if (!cfg.results_file.empty()) {
+    results.write(cfg.results_file);
+  }
+  return num_failures;
+}
+
+} // namespace distconv_benchmark
+
+int main(int argc, char *argv[]) {
+  DISTCONV_CHECK_MPI(MPI_Init(&argc, &argv));
+  int pid;
+  int np;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &pid));
+  DISTCONV_CHECK_MPI(MPI_Comm_size(MPI_COMM_WORLD, &np));
+  auto cfg = distconv_benchmark::process_opt(argc, argv, pid, np);
+  int num_failures = distconv_benchmark::run(cfg, MPI_COMM_WORLD);
+  DISTCONV_CHECK_MPI(MPI_Finalize());
+  return num_failures == 0 ? 0 : 1;
+}
@@ -14,6 +14,7 @@
 #include "distconv/tensor/tensor_mpi.hpp"
 #include "distconv/distconv.hpp"
 #include "distconv/util/util_mpi.hpp"
+#include "distconv/util/util_gpu.hpp"
 #ifdef DISTCONV_HAS_CUDA
 #include "distconv/tensor/tensor_cuda.hpp"
 #include "distconv/util/util_cuda.hpp"
@@ -25,8 +26,6 @@
 #include "distconv/util/util_gpu_dnn.hpp"
 #endif
 
-#include <Al.hpp>
-
 using namespace distconv;
 
 namespace distconv_benchmark {
@@ -54,6 +53,8 @@ class Profile {
       conv_bwd_combined_bias_time(cfg.run_count, 0),
       conv_bwd_combined_all_time(cfg.run_count, 0) {}
 
+  static constexpr char name[] = "distconv_benchmark";
+
   std::ostream &print_as_row(std::ostream &os) {
     for (size_t i = 0; i < conv_fwd_time.size(); ++i) {
       m_cfg.print_as_row(os) << " " << conv_fwd_time[i]
@@ -69,6 +70,18 @@ class Profile {
     return os;
   }
 
+  void record_timings(BenchmarkResults::Record &rec) const {
+    rec.add_timings("conv_fwd", conv_fwd_time)
+        .add_timings("conv_bwd_data", conv_bwd_data_time)
+        .add_timings("conv_bwd_filter", conv_bwd_filter_time)
+        .add_timings("conv_bwd_bias", conv_bwd_bias_time)
+        .add_timings("conv_bwd_combined_data", conv_bwd_combined_data_time)
+        .add_timings("conv_bwd_combined_filter",
+                     conv_bwd_combined_filter_time)
+        .add_timings("conv_bwd_combined_bias", conv_bwd_combined_bias_time)
+        .add_timings("conv_bwd_combined_all", conv_bwd_combined_all_time);
+  }
+
   void print_summary(std::ostream &os) {
     std::cout << "Forward mean: " << get_mean(conv_fwd_time)
               << ", median: " << get_median(conv_fwd_time)
@@ -649,6 +662,10 @@ struct ConvolutionTester<NSD, ref::Backend, DataType> {
         d, cfg, comm, be, conv, prof);
     test_convolution_backward_filter<NSD, ref::Backend, DataType>(
         d, cfg, comm, be, conv, prof);
+    if (cfg.use_bias) {
+      test_convolution_backward_bias<NSD, ref::Backend, DataType>(
+          d, cfg, comm, be, conv, prof);
+    }
     return 0;
   }
 };
@@ -770,22 +787,22 @@ int main(int argc, char *argv[]) {
   distconv_benchmark::set_device();
   int pid;
   int np;
-  Al::Initialize(argc, argv);
+  distconv_benchmark::initialize_comm(argc, argv);
   DISTCONV_CHECK_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &pid));
   DISTCONV_CHECK_MPI(MPI_Comm_size(MPI_COMM_WORLD, &np));
 
   const int nsd = distconv_benchmark::parse_num_dims(argc, argv);
 
-  if(nsd == 2) {
-    distconv_benchmark::run<2>(argc, argv, pid, np);
-  } else if(nsd == 3) {
-    distconv_benchmark::run<3>(argc, argv, pid, np);
-  } else {
+  const bool valid = distconv_benchmark::dispatch_value<
+    distconv_benchmark::NumDimsCases>(nsd, [&](auto nsd_case) {
+      distconv_benchmark::run<decltype(nsd_case)::value>(argc, argv, pid, np);
+    });
+  if (!valid) {
     util::MPIRootPrintStreamError() << "Invalid --num-dims: " << nsd;
     DISTCONV_CHECK_MPI(MPI_Finalize());
     std::exit(1);
   }
 
-  Al::Finalize();
+  distconv_benchmark::finalize_comm();
   return 0;
 }
@@ -14,6 +14,7 @@
 #include "distconv/tensor/tensor_mpi.hpp"
 #include "distconv/distconv.hpp"
 #include "distconv/util/util_mpi.hpp"
+#include "distconv/util/util_gpu.hpp"
 #ifdef DISTCONV_HAS_CUDA
 #include "distconv/tensor/tensor_cuda.hpp"
 #include "distconv/util/util_cuda.hpp"
@@ -25,8 +26,6 @@
 #include "distconv/util/util_gpu_dnn.hpp"
 #endif
 
-#include <Al.hpp>
-
 namespace distconv_benchmark {
 
 template <int NSD>
@@ -44,6 +43,8 @@ class Profile {
       bwd_time(cfg.run_count, 0),
       bwd_allreduce_time(cfg.run_count, 0) {}
 
+  static constexpr char name[] = "distconv_benchmark_bn";
+
   std::ostream &print_as_row(std::ostream &os) {
     for (size_t i = 0; i < fwd_time.size(); ++i) {
       m_cfg.print_as_row(os) << " " << fwd_time[i]
@@ -55,6 +56,13 @@ class Profile {
     return os;
   }
 
+  void record_timings(BenchmarkResults::Record &rec) const {
+    rec.add_timings("fwd", fwd_time)
+        .add_timings("fwd_allreduce", fwd_allreduce_time)
+        .add_timings("bwd", bwd_time)
+        .add_timings("bwd_allreduce", bwd_allreduce_time);
+  }
+
   void print_summary(std::ostream &os) {
     std::cout << "Forward mean: " << get_mean(fwd_time)
               << ", median: " << get_median(fwd_time)
@@ -384,13 +392,18 @@ int test_backward(Data<NSD, Backend, DataType> &d,
 template <int NSD, typename Backend, typename DataType>
 struct BNTester;
 
-// Not implemented yet
 template <int NSD, typename DataType>
 struct BNTester<NSD, ref::Backend, DataType> {
   BNTester() {}
   int operator()(Data<NSD, ref::Backend, DataType> &d,
                  const BenchmarkConfig<NSD> &cfg, MPI_Comm comm,
                  Profile<NSD> &prof) {
+    ref::Backend be;
+    BatchNormalization<ref::Backend, DataType> bn(
+        be, 2 + NSD, 0.9, 1e-5, cfg.global_stat, cfg.batchnorm_impl);
+    bn.set_num_samples(d.input.get_shape()[-1]);
+    test_forward<NSD, ref::Backend, DataType>(d, cfg, comm, be, bn, prof);
+    test_backward<NSD, ref::Backend, DataType>(d, cfg, comm, be, bn, prof);
     return 0;
   }
 };
@@ -504,22 +517,22 @@ int main(int argc, char *argv[]) {
   distconv_benchmark::set_device();
   int pid;
   int np;
-  Al::Initialize(argc, argv);
+  distconv_benchmark::initialize_comm(argc, argv);
   DISTCONV_CHECK_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &pid));
   DISTCONV_CHECK_MPI(MPI_Comm_size(MPI_COMM_WORLD, &np));
 
   const int nsd = distconv_benchmark::parse_num_dims(argc, argv);
 
-  if(nsd == 2) {
-    distconv_benchmark::run<2>(argc, argv, pid, np);
-  } else if(nsd == 3) {
-    distconv_benchmark::run<3>(argc, argv, pid, np);
-  } else {
+  const bool valid = distconv_benchmark::dispatch_value<
+    distconv_benchmark::NumDimsCases>(nsd, [&](auto nsd_case) {
+      distconv_benchmark::run<decltype(nsd_case)::value>(argc, argv, pid, np);
+    });
+  if (!valid) {
     distconv::util::MPIRootPrintStreamError() << "Invalid --num-dims: " << nsd;
     DISTCONV_CHECK_MPI(MPI_Finalize());
     std::exit(1);
   }
 
-  Al::Finalize();
+  distconv_benchmark::finalize_comm();
   return 0;
 }
@@ -12,6 +12,10 @@
 #include "distconv/util/stopwatch.h"
 #include "distconv/util/util.hpp"
 
+#ifdef H2_HAS_GPU
+#include <Al.hpp>
+#endif
+
 /*
   Miscellaneous structures and functions that should be only used for
   benchmarks using Distconv. cudnn_benchmark, e.g., should not used
@@ -53,6 +57,24 @@ inline void set_device() {
 #endif
 }
 
+// Aluminum is only used by the GPU backends. Host-only builds
+// communicate with plain MPI.
+inline void initialize_comm(int &argc, char **&argv) {
+#ifdef H2_HAS_GPU
+  Al::Initialize(argc, argv);
+#else
+  DISTCONV_CHECK_MPI(MPI_Init(&argc, &argv));
+#endif
+}
+
+inline void finalize_comm() {
+#ifdef H2_HAS_GPU
+  Al::Finalize();
+#else
+  DISTCONV_CHECK_MPI(MPI_Finalize());
+#endif
+}
+
 template <typename Tensor>
 inline int init_input_tensor(Tensor &t, unsigned seed) {
   using data_type = typename Tensor::data_type;
@@ -166,21 +188,20 @@ inline int dump_shared_tensor(const tensor::Tensor<DataType,
                               Alloccator> &t,
                               const std::string &file_path,
                               bool binary) {
+  if (binary) {
+    return tensor::Dump(t, file_path + ".out");
+  }
   if (t.get_locale().get_rank() == 0) {
     DataType *buf = (DataType*)malloc(t.get_size() * sizeof(DataType));
     t.get_data().copyout(buf);
     std::ofstream out;
-    if (binary) {
-      out.open(file_path + ".out", std::ios::out | std::ios::trunc | std::ios::binary);
-      out.write((char*)buf, t.get_size() * sizeof(DataType));
-    } else {
-      out.open(file_path + ".txt", std::ios::out | std::ios::trunc);
-      for (size_t i = 0; i < t.get_size(); ++i) {
-        auto x = buf[i];
-        out << x << std::endl;
-      }
+    out.open(file_path + ".txt", std::ios::out | std::ios::trunc);
+    for (size_t i = 0; i < t.get_size(); ++i) {
+      auto x = buf[i];
+      out << x << std::endl;
     }
     out.close();
+    free(buf);
   }
   return 0;
 }
@@ -305,6 +326,14 @@ inline int run_test_with_type(const BenchmarkConfig<NSD> &cfg, MPI_Comm comm) {
   ofs.open(ss.str(), std::fstream::app);
   prof.print_as_row(ofs);
 
+  if (!cfg.results_file.empty()) {
+    BenchmarkResults results(Profile::name, comm);
+    auto &rec = results.add_record();
+    cfg.record_config(rec);
+    prof.record_timings(rec);
+    results.write(cfg.results_file);
+  }
+
   // Dump result
   if (cfg.dump_output) {
     d.dump_output(cfg.dump_binary);
@@ -314,28 +343,40 @@ inline int run_test_with_type(const BenchmarkConfig<NSD> &cfg, MPI_Comm comm) {
 }
 
 
+// Data types the benchmarks are instantiated for
+using DataTypeCases = h2::meta::TL<
+  h2::multimethods::ValueCase<BenchmarkDataType::FLOAT, float>,
+  h2::multimethods::ValueCase<BenchmarkDataType::DOUBLE, double>
+#ifdef DISTCONV_ENABLE_FP16
+  , h2::multimethods::ValueCase<BenchmarkDataType::HALF, half>
+#endif
+  >;
+
 template <int NSD,
           typename Backend,
           template<int, typename, typename> class Data,
           template<int> class Profile,
           template<int, typename, typename> class Tester>
 inline int run_test_with_backend(const BenchmarkConfig<NSD> &cfg, MPI_Comm comm) {
-  if (cfg.data_type == BenchmarkDataType::FLOAT) {
-    return run_test_with_type<NSD, Backend, float, Data<NSD, Backend, float>,
-                              Profile<NSD>, Tester<NSD, Backend, float>>(cfg, comm);
-  } else if (cfg.data_type == BenchmarkDataType::DOUBLE) {
-    return run_test_with_type<NSD, Backend, double, Data<NSD, Backend, double>,
-                              Profile<NSD>, Tester<NSD, Backend, double>>(cfg, comm);
+  int ret = 0;
+  const bool found = dispatch_value<DataTypeCases>(
+      cfg.data_type, [&](auto dt_case) {
+        using DataType = typename decltype(dt_case)::type;
 #ifdef DISTCONV_ENABLE_FP16
-  } else if (cfg.backend == "CUDNN" &&
-             cfg.data_type == BenchmarkDataType::HALF) {
-    return run_test_with_type<NSD, Backend, half, Data<NSD, Backend, half>,
-                              Profile<NSD>, Tester<NSD, Backend, half>>(cfg, comm);
+        if (std::is_same<DataType, half>::value && cfg.backend != "CUDNN") {
+          util::MPIPrintStreamError() << "Unknown data type name\n";
+          abort();
+        }
 #endif
-  } else {
+        ret = run_test_with_type<NSD, Backend, DataType,
+                                 Data<NSD, Backend, DataType>, Profile<NSD>,
+                                 Tester<NSD, Backend, DataType>>(cfg, comm);
+      });
+  if (!found) {
     util::MPIPrintStreamError() << "Unknown data type name\n";
     abort();
   }
+  return ret;
 }
 
 template <int NSD,
@@ -16,6 +16,8 @@ class Profile {
   BenchmarkConfig<NSD> m_cfg;
   Profile(const BenchmarkConfig<NSD> &cfg): m_cfg(cfg) {}
 
+  static constexpr char name[] = "distconv_benchmark_pooling";
+
   std::ostream &print_as_row(std::ostream &os) {
     for (size_t i = 0; i < fwd_time.size(); ++i) {
       m_cfg.print_as_row(os) << " " << fwd_time[i] << " "
@@ -24,6 +26,11 @@ class Profile {
     return os;
   }
 
+  void record_timings(BenchmarkResults::Record &rec) const {
+    rec.add_timings("fwd", fwd_time)
+        .add_timings("bwd", bwd_time);
+  }
+
   void print_summary(std::ostream &os) {
     std::stringstream ss;
     ss << "Forward mean: " << get_mean(fwd_time)
@@ -149,18 +156,6 @@ class Data {
 template <int NSD, typename Backend, typename DataType>
 struct PoolingTester;
 
-template <int NSD, typename DataType>
-struct PoolingTester<NSD, ref::Backend, DataType> {
-  PoolingTester() {}
-  int operator()(Data<NSD, ref::Backend, DataType> &d,
-                 const BenchmarkConfig<NSD> &cfg, MPI_Comm comm,
-                 Profile<NSD> &prof) {
-    util::MPIRootPrintStreamError() << "Not implemented";
-    std::abort();
-    return 0;
-  }
-};
-
 template <int NSD, typename Backend, typename DataType>
 int test_forward(Data<NSD, Backend, DataType> &d,
                  const BenchmarkConfig<NSD> &cfg,
@@ -264,6 +259,19 @@ int test_backward(Data<NSD, Backend, DataType> &d,
   return 0;
 }
 
+template <int NSD, typename DataType>
+struct PoolingTester<NSD, ref::Backend, DataType> {
+  PoolingTester() {}
+  int operator()(Data<NSD, ref::Backend, DataType> &d,
+                 const BenchmarkConfig<NSD> &cfg, MPI_Comm comm,
+                 Profile<NSD> &prof) {
+    ref::Backend be;
+    test_forward<NSD, ref::Backend, DataType>(d, cfg, comm, be, prof);
+    test_backward<NSD, ref::Backend, DataType>(d, cfg, comm, be, prof);
+    return 0;
+  }
+};
+
 #ifdef DISTCONV_HAS_CUDNN
 template <int NSD, typename DataType>
 struct PoolingTester<NSD, cudnn::BackendCUDNN, DataType> {
@@ -312,11 +320,11 @@ int main(int argc, char *argv[]) {
 
   const int nsd = distconv_benchmark::parse_num_dims(argc, argv);
 
-  if(nsd == 2) {
-    distconv_benchmark::run<2>(argc, argv, pid);
-  } else if(nsd == 3) {
-    distconv_benchmark::run<3>(argc, argv, pid);
-  } else {
+  const bool valid = distconv_benchmark::dispatch_value<
+    distconv_benchmark::NumDimsCases>(nsd, [&](auto nsd_case) {
+      distconv_benchmark::run<decltype(nsd_case)::value>(argc, argv, pid);
+    });
+  if (!valid) {
     util::MPIRootPrintStreamError() << "Invalid --num-dims: " << nsd;
     DISTCONV_CHECK_MPI(MPI_Finalize());
     std::exit(1);
@@ -0,0 +1,309 @@
+#include "benchmark_common.hpp"
+#include "distconv/distconv.hpp"
+#include "distconv/perf_model.hpp"
+#include "distconv/planner.hpp"
+#include "distconv/tensor/halo_exchange_host.hpp"
+#include "distconv/tensor/shuffle_mpi.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/cxxopts.hpp"
+#include "distconv/util/stopwatch.h"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+  Selects the distribution of each layer of a sequence of
+  convolutions with the performance model, and prints the options of
+  distconv_benchmark that run each layer with it.
+
+  Layers are read from a file with one layer per line, given as the
+  --image-size, --filter-size and --strides arguments of
+  distconv_benchmark separated by spaces, e.g.:
+
+    32,64,56,56 64,3,3 1,1
+
+  Lines starting with # are ignored. With --validate, the halo
+  exchanges and the shuffles between layers of the plan are timed on
+  the host and reported next to their predictions. Convolutions and
+  channel/filter collectives are not timed as the host has no
+  convolution backend.
+ */
+
+using DataType = float;
+using namespace distconv;
+using distconv::tensor::Shape;
+
+namespace distconv_benchmark {
+
+using Allocator = tensor::BaseAllocator;
+using HostTensor = tensor::Tensor<DataType, tensor::LocaleMPI, Allocator>;
+using HaloExchange = tensor::HaloExchangeHost<DataType>;
+
+struct PlannerConfig {
+  std::string layer_file;
+  int num_procs;
+  std::string cache_path;
+  bool validate;
+  int warming_up_count;
+  int run_count;
+};
+
+inline std::vector<perf_model::ConvLayer> read_layers(
+    const std::string &path) {
+  std::ifstream ifs(path);
+  if (!ifs) {
+    util::MPIRootPrintStreamError() << "Failed to open " << path;
+    std::abort();
+  }
+  std::vector<perf_model::ConvLayer> layers;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line);
+    std::string image, filter, strides;
+    if (line.empty() || line[0] == '#' || !(iss >> image >> filter)) {
+      continue;
+    }
+    const auto image_size = util::split_spaced_array<int>(image);
+    const auto filter_size = util::split_spaced_array<int>(filter);
+    assert_always(image_size.size() > 2);
+    assert_eq(filter_size.size() + 1, image_size.size());
+    perf_model::ConvLayer layer;
+    layer.num_samples = image_size[0];
+    layer.num_channels = image_size[1];
+    layer.num_filters = filter_size[0];
+    layer.spatial = util::reverse(
+        int_vector(image_size.begin() + 2, image_size.end()));
+    layer.filter = util::reverse(
+        int_vector(filter_size.begin() + 1, filter_size.end()));
+    if (iss >> strides) {
+      layer.strides = util::reverse(util::split_spaced_array<int>(strides));
+    } else {
+      layer.strides = int_vector(layer.spatial.size(), 1);
+    }
+    assert_eq(layer.strides.size(), layer.spatial.size());
+    // Padded as distconv_benchmark does by default
+    for (int k: layer.filter) layer.pads.push_back((k - 1) / 2);
+    layers.push_back(layer);
+  }
+  return layers;
+}
+
+inline Shape get_input_shape(const perf_model::ConvLayer &layer) {
+  Shape shape(layer.spatial);
+  shape.push_back(layer.num_channels);
+  shape.push_back(layer.num_samples);
+  return shape;
+}
+
+inline Shape get_output_shape(const perf_model::ConvLayer &layer) {
+  Shape shape(layer.get_output_spatial());
+  shape.push_back(layer.num_filters);
+  shape.push_back(layer.num_samples);
+  return shape;
+}
+
+// Formats the decomposition as the options of distconv_benchmark
+inline std::string get_benchmark_options(
+    const perf_model::ConvDecomposition &d) {
+  std::stringstream ss;
+  ss << "--proc-size " << d.p_n << "," << d.p_c * d.p_f << ","
+     << util::join_array(util::reverse(d.p_s), ",");
+  if (d.chanfilt_algo != ChannelParallelismAlgorithm::NONE) {
+    ss << " --chanfilt-algo " << d.chanfilt_algo;
+  }
+  if (d.chanfilt_algo == ChannelParallelismAlgorithm::W) {
+    ss << " --filter-dim " << d.p_f;
+  }
+  return ss.str();
+}
+
+template <typename Func>
+inline float time_median(const PlannerConfig &cfg, MPI_Comm comm,
+                         Func f) {
+  for (int i = 0; i < cfg.warming_up_count; ++i) {
+    f();
+  }
+  std::vector<float> times;
+  for (int i = 0; i < cfg.run_count; ++i) {
+    util::stopwatch_t st;
+    DISTCONV_CHECK_MPI(MPI_Barrier(comm));
+    util::stopwatch_start(&st);
+    f();
+    float t = util::stopwatch_stop(&st);
+    // The slowest rank determines the time
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_FLOAT,
+                                     MPI_MAX, comm));
+    times.push_back(t);
+  }
+  return get_median(times);
+}
+
+// Halo exchanges of the input in forward and of the output gradients
+// in backward, in milliseconds
+inline float measure_halo_exchange(const PlannerConfig &cfg,
+                                   const perf_model::ConvLayer &layer,
+                                   const perf_model::LayerPlan &plan,
+                                   MPI_Comm comm) {
+  tensor::LocaleMPI loc(comm);
+  HostTensor input(get_input_shape(layer), loc, plan.input_dist);
+  HostTensor d_output(get_output_shape(layer), loc, plan.d_output_dist);
+  assert0(input.allocate());
+  assert0(d_output.allocate());
+  HaloExchange input_hx(input);
+  HaloExchange d_output_hx(d_output);
+  return time_median(cfg, comm, [&]() {
+    input_hx.exchange(false, tensor::HaloExchangeAccumOp::ID);
+    d_output_hx.exchange();
+  });
+}
+
+// Shuffles of the output of the previous layer to the input of the
+// layer and back, in milliseconds
+inline float measure_shuffle(const PlannerConfig &cfg,
+                             const perf_model::ConvLayer &prev_layer,
+                             const perf_model::LayerPlan &prev_plan,
+                             const perf_model::LayerPlan &plan,
+                             MPI_Comm comm) {
+  tensor::LocaleMPI loc(comm);
+  const auto shape = get_output_shape(prev_layer);
+  HostTensor src(shape, loc, prev_plan.output_dist);
+  HostTensor dst(shape, loc,
+                 plan.input_dist.get_non_overlapped_distribution());
+  assert0(src.allocate());
+  assert0(dst.allocate());
+  using Shuffler = tensor::TensorMPIShuffler<DataType, Allocator>;
+  auto src_buf = static_cast<DataType*>(
+      util::aligned_malloc(Shuffler::get_buf_size(src)));
+  auto dst_buf = static_cast<DataType*>(
+      util::aligned_malloc(Shuffler::get_buf_size(dst)));
+  float t;
+  {
+    Shuffler shfl(src, dst, src_buf, dst_buf);
+    t = time_median(cfg, comm, [&]() {
+      shfl.shuffle_forward(src.get_base_ptr(), dst.get_base_ptr());
+      shfl.shuffle_backward(dst.get_base_ptr(), src.get_base_ptr());
+    });
+  }
+  free(src_buf);
+  free(dst_buf);
+  return t;
+}
+
+inline void validate(const PlannerConfig &cfg,
+                     const std::vector<perf_model::ConvLayer> &layers,
+                     const std::vector<perf_model::LayerPlan> &plans,
+                     MPI_Comm comm) {
+  int pid;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &pid));
+  if (pid == 0) {
+    std::cout << "layer predicted_halo_ms measured_halo_ms "
+              << "predicted_shuffle_ms measured_shuffle_ms" << std::endl;
+  }
+  for (size_t i = 0; i < layers.size(); ++i) {
+    const float halo = measure_halo_exchange(cfg, layers[i], plans[i], comm);
+    float shuffle = 0;
+    if (i > 0 && plans[i].shuffle_time > 0) {
+      if (get_output_shape(layers[i - 1]) != get_input_shape(layers[i])) {
+        util::MPIRootPrintStreamWarning()
+            << "Input of layer " << i
+            << " does not match the output of the previous layer";
+      } else {
+        shuffle = measure_shuffle(cfg, layers[i - 1], plans[i - 1],
+                                  plans[i], comm);
+      }
+    }
+    if (pid == 0) {
+      std::cout << i << " " << plans[i].time.halo_exchange * 1000 << " "
+                << halo << " " << plans[i].shuffle_time * 1000 << " "
+                << shuffle << std::endl;
+    }
+  }
+}
+
+inline PlannerConfig process_opt(int argc, char *argv[], int pid, int np) {
+  cxxopts::Options cmd_opts(argv[0], "Convolution Distribution Planner");
+  cmd_opts.add_options()
+      ("l,layers", "File of layers to plan",
+       cxxopts::value<std::string>())
+      ("p,num-procs", "Number of processes to plan for "
+       "(default: the number of MPI processes)",
+       cxxopts::value<int>()->default_value("0"))
+      ("cache", "Performance model cache file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("validate", "Time the halo exchanges and shuffles of the plan")
+      ("r,num-runs", "Number of runs of validation",
+       cxxopts::value<int>()->default_value("5"))
+      ("num-warmup-runs", "Number of warming-up runs of validation",
+       cxxopts::value<int>()->default_value("2"))
+      ("help", "Print help");
+  auto result = cmd_opts.parse(argc, argv);
+  if (result.count("help") || !result.count("layers")) {
+    if (pid == 0) {
+      std::cout << cmd_opts.help() << "\n";
+    }
+    DISTCONV_CHECK_MPI(MPI_Finalize());
+    std::exit(0);
+  }
+  PlannerConfig cfg;
+  cfg.layer_file = result["layers"].as<std::string>();
+  cfg.num_procs = result["num-procs"].as<int>();
+  if (cfg.num_procs == 0) cfg.num_procs = np;
+  cfg.cache_path = result["cache"].as<std::string>();
+  cfg.validate = result.count("validate") > 0;
+  cfg.run_count = result["num-runs"].as<int>();
+  cfg.warming_up_count = result["num-warmup-runs"].as<int>();
+  if (cfg.validate && cfg.num_procs != np) {
+    util::MPIRootPrintStreamWarning()
+        << "Validation requires planning for " << np << " processes";
+    cfg.validate = false;
+  }
+  return cfg;
+}
+
+inline void run(const PlannerConfig &cfg, MPI_Comm comm) {
+  int pid;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &pid));
+  const auto layers = read_layers(cfg.layer_file);
+  const auto m = perf_model::load_or_calibrate(comm, cfg.cache_path);
+  const auto plans = perf_model::plan_convolutions(m, layers,
+                                                   cfg.num_procs);
+  if (pid == 0) {
+    std::cout << "Machine parameters: " << m << std::endl;
+    double total = 0;
+    for (size_t i = 0; i < plans.size(); ++i) {
+      const auto &p = plans[i];
+      std::cout << "Layer " << i << ": "
+                << get_benchmark_options(p.decomp) << "\n"
+                << "  Predicted " << p.time << ", shuffle: "
+                << p.shuffle_time << "\n"
+                << "  Input distribution: " << p.input_dist << "\n"
+                << "  Filter distribution: " << p.filter_dist << "\n"
+                << "  Output distribution: " << p.output_dist << "\n";
+      total += p.get_total();
+    }
+    std::cout << "Predicted total time: " << total << std::endl;
+  }
+  if (cfg.validate) {
+    validate(cfg, layers, plans, comm);
+  }
+}
+
+} // namespace distconv_benchmark
+
+int main(int argc, char *argv[]) {
+  DISTCONV_CHECK_MPI(MPI_Init(&argc, &argv));
+  int pid;
+  int np;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &pid));
+  DISTCONV_CHECK_MPI(MPI_Comm_size(MPI_COMM_WORLD, &np));
+  auto cfg = distconv_benchmark::process_opt(argc, argv, pid, np);
+  distconv_benchmark::run(cfg, MPI_COMM_WORLD);
+  DISTCONV_CHECK_MPI(MPI_Finalize());
+  return 0;
+}
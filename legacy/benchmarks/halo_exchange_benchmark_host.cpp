@@ -0,0 +1,532 @@
+#include "benchmark_common.hpp"
+#include "distconv_benchmark_common.hpp"
+#include "distconv/distconv.hpp"
+#include "distconv/tensor/halo_exchange_host.hpp"
+#include "distconv/tensor/halo_exchange_host_concurrent.hpp"
+#include "distconv/tensor/halo_exchange_host_mpi.hpp"
+#include "distconv/tensor/halo_exchange_host_shm.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/cxxopts.hpp"
+#include "distconv/util/stopwatch.h"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+  Sweeps the host halo exchange methods over halo widths, tensor
+  sizes, dimensionalities, spatial process grids and accumulation
+  ops. Each row reports the median over the runs of the slowest rank
+  for the exchange alone, a synthetic interior stencil alone, and
+  both of them overlapped by running the exchange in a separate
+  thread. The hidden fraction is the share of the exchange time that
+  is saved by the overlap.
+
+  Methods:
+  - mpi-blocking: MPI_Sendrecv per side
+  - mpi: nonblocking point-to-point MPI
+  - persistent: persistent point-to-point MPI requests set up at the
+    first exchange
+  - neighbor: MPI_Neighbor_alltoallw per dimension
+  - shm: direct copies through an MPI shared-memory window
+  - concurrent: nonblocking point-to-point MPI with all face, edge
+    and corner neighbors in one round
+  - concurrent-neighbor: a single MPI_Neighbor_alltoallw over the
+    face, edge and corner neighbors
+ */
+
+using DataType = float;
+using namespace distconv;
+using distconv::tensor::Shape;
+
+namespace distconv_benchmark {
+
+using HostTensor = tensor::Tensor<DataType, tensor::LocaleMPI,
+                                  tensor::BaseAllocator>;
+using HaloExchange = tensor::HaloExchangeHost<DataType>;
+using tensor::HaloExchangeAccumOp;
+
+struct SweepConfig {
+  std::vector<std::string> methods;
+  std::vector<int> num_dims;
+  std::vector<int> sizes;
+  std::vector<int> widths;
+  int num_samples;
+  int num_channels;
+  int warming_up_count;
+  int run_count;
+  bool overlap;
+  bool verify;
+  std::string output_file;
+  std::string results_file;
+};
+
+struct Result {
+  float exchange_time;
+  float compute_time;
+  float overlapped_time;
+  size_t bytes_per_rank;
+};
+
+inline std::unique_ptr<HaloExchange> make_halo_exchange(
+    const std::string &method, HostTensor &t) {
+  if (method == "mpi-blocking") {
+    return std::make_unique<tensor::HaloExchangeHostBlockingMPI<DataType>>(t);
+  } else if (method == "mpi") {
+    return std::make_unique<HaloExchange>(t);
+  } else if (method == "persistent") {
+    return std::make_unique<tensor::HaloExchangeHostPersistent<DataType>>(t);
+  } else if (method == "neighbor") {
+    return std::make_unique<tensor::HaloExchangeHostNeighbor<DataType>>(t);
+  } else if (method == "shm") {
+    return std::make_unique<tensor::HaloExchangeHostSHM<DataType>>(t);
+  } else if (method == "concurrent") {
+    return std::make_unique<tensor::HaloExchangeHostConcurrent<DataType>>(t);
+  } else if (method == "concurrent-neighbor") {
+    return std::make_unique<
+      tensor::HaloExchangeHostConcurrentNeighbor<DataType>>(t);
+  }
+  util::MPIRootPrintStreamError() << "Unknown method: " << method;
+  std::abort();
+}
+
+// Returns all the ordered factorizations of np into n factors
+inline std::vector<std::vector<int>> get_grids(int np, int n) {
+  if (n == 1) return {{np}};
+  std::vector<std::vector<int>> grids;
+  for (int f = 1; f <= np; ++f) {
+    if (np % f) continue;
+    for (auto &g: get_grids(np / f, n - 1)) {
+      g.insert(g.begin(), f);
+      grids.push_back(g);
+    }
+  }
+  return grids;
+}
+
+// Sets every element, including halos, to a value unique to the
+// rank and the element.
+inline void init_tensor(HostTensor &t) {
+  const index_t size = t.get_local_pitched_size();
+  const index_t base = size * t.get_locale().get_rank();
+  DataType *buf = t.get_buffer();
+  for (index_t i = 0; i < size; ++i) {
+    buf[i] = (DataType)((base + i) % 1024);
+  }
+}
+
+// Number of bytes this rank sends in one exchange
+inline size_t get_send_bytes(const HostTensor &t) {
+  if (t.get_local_size() == 0) return 0;
+  size_t bytes = 0;
+  const auto &locale_shape = t.get_distribution().get_locale_shape();
+  const auto proc_idx = t.get_proc_index();
+  for (int i = 0; i < t.get_num_dims(); ++i) {
+    const int w = t.get_halo_width(i);
+    if (w == 0 || locale_shape[i] == 1) continue;
+    auto halo_shape = t.get_local_real_shape();
+    halo_shape[i] = w;
+    int num_peers = 0;
+    if (proc_idx[i] > 0) ++num_peers;
+    if (proc_idx[i] + 1 < locale_shape[i] &&
+        t.get_dimension_rank_offset(i, proc_idx[i] + 1) != t.get_shape()[i]) {
+      ++num_peers;
+    }
+    bytes += halo_shape.get_size() * sizeof(DataType) * num_peers;
+  }
+  return bytes;
+}
+
+/*
+  Applies a 3-point stencil along each spatial dimension to the
+  interior elements that neither read halos nor are updated by
+  reverse exchanges. This stands in for the computation overlapped
+  with halo exchanges.
+ */
+inline void compute_interior(const HostTensor &t, DataType *out) {
+  if (t.get_local_size() == 0) return;
+  const int nd = t.get_num_dims();
+  const int nsd = nd - 2;
+  const auto real_shape = t.get_local_real_shape();
+  const auto pitch = t.get_pitch();
+  const DataType *in = t.get_buffer();
+  Shape interior_shape = t.get_local_shape();
+  IndexVector interior_offset(nd, 0);
+  for (int i = 0; i < nsd; ++i) {
+    const index_t w = t.get_halo_width(i);
+    const index_t margin = w + 1;
+    interior_offset[i] = w + margin;
+    interior_shape[i] = interior_shape[i] > margin * 2 ?
+        interior_shape[i] - margin * 2 : 0;
+  }
+  if (interior_shape.get_size() == 0) return;
+  std::vector<index_t> strides(nsd, 1);
+  for (int i = 1; i < nsd; ++i) {
+    strides[i] = i == 1 ? pitch : strides[i - 1] * real_shape[i - 1];
+  }
+  for (auto it = interior_shape.index_begin();
+       it != interior_shape.index_end(); ++it) {
+    IndexVector idx(*it);
+    for (int i = 0; i < nd; ++i) idx[i] += interior_offset[i];
+    const index_t offset = get_offset(idx, real_shape, pitch);
+    DataType v = in[offset] * (1 - 2 * nsd);
+    for (int i = 0; i < nsd; ++i) {
+      v += in[offset - strides[i]] + in[offset + strides[i]];
+    }
+    out[offset] = v;
+  }
+}
+
+inline int compare_tensors(const HostTensor &t, const HostTensor &ref) {
+  int num_errors = 0;
+  const index_t size = t.get_local_pitched_size();
+  for (index_t i = 0; i < size; ++i) {
+    if (t.get_buffer()[i] != ref.get_buffer()[i]) ++num_errors;
+  }
+  return num_errors;
+}
+
+/*
+  Compares only the elements that the concurrent exchanges are
+  defined to update as the per-dimension exchange: the elements
+  inside the global tensor in forward exchanges, and the interior
+  elements in reverse exchanges.
+ */
+inline int compare_tensors_in_domain(const HostTensor &t,
+                                     const HostTensor &ref,
+                                     bool is_reverse) {
+  if (t.get_local_size() == 0) return 0;
+  const int nd = t.get_num_dims();
+  const auto real_shape = t.get_local_real_shape();
+  const auto pitch = t.get_pitch();
+  int num_errors = 0;
+  for (auto it = real_shape.index_begin(); it != real_shape.index_end();
+       ++it) {
+    const auto &idx = *it;
+    bool compared = true;
+    for (int i = 0; i < nd; ++i) {
+      const long halo = t.get_halo_width(i);
+      const long local_idx = (long)idx[i] - halo;
+      const long global_idx = (long)t.get_global_index(i, 0) + local_idx;
+      if (is_reverse) {
+        compared &= local_idx >= 0 &&
+            local_idx < (long)t.get_local_shape()[i];
+      } else {
+        compared &= global_idx >= 0 && global_idx < (long)t.get_shape()[i];
+      }
+    }
+    if (!compared) continue;
+    const index_t offset = get_offset(idx, real_shape, pitch);
+    if (t.get_buffer()[offset] != ref.get_buffer()[offset]) ++num_errors;
+  }
+  return num_errors;
+}
+
+// Checks the exchange against the nonblocking MPI exchange
+inline int verify(const std::string &method, const Shape &shape,
+                  const tensor::Distribution &dist, bool is_reverse,
+                  HaloExchangeAccumOp op, MPI_Comm comm) {
+  tensor::LocaleMPI loc(comm);
+  HostTensor t(shape, loc, dist);
+  HostTensor ref(shape, loc, dist);
+  assert0(t.allocate());
+  assert0(ref.allocate());
+  init_tensor(t);
+  init_tensor(ref);
+  auto hx = make_halo_exchange(method, t);
+  HaloExchange ref_hx(ref);
+  hx->exchange(is_reverse, op);
+  ref_hx.exchange(is_reverse, op);
+  const bool is_concurrent = method.rfind("concurrent", 0) == 0;
+  int num_errors = is_concurrent ?
+      compare_tensors_in_domain(t, ref, is_reverse) :
+      compare_tensors(t, ref);
+  DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &num_errors, 1, MPI_INT,
+                                   MPI_SUM, comm));
+  return num_errors;
+}
+
+inline void run_case(const SweepConfig &cfg, const std::string &method,
+                     const Shape &shape, const tensor::Distribution &dist,
+                     bool is_reverse, HaloExchangeAccumOp op,
+                     MPI_Comm comm, Result &res,
+                     BenchmarkResults::Record *rec) {
+  tensor::LocaleMPI loc(comm);
+  HostTensor t(shape, loc, dist);
+  assert0(t.allocate());
+  init_tensor(t);
+  auto hx = make_halo_exchange(method, t);
+  std::vector<DataType> scratch(t.get_local_pitched_size());
+
+  for (int i = 0; i < cfg.warming_up_count; ++i) {
+    hx->exchange(is_reverse, op);
+  }
+
+  std::vector<float> exchange_time, compute_time, overlapped_time;
+  std::vector<float> local_times[3];
+  for (int i = 0; i < cfg.run_count; ++i) {
+    float times[3] = {0, 0, 0};
+    util::stopwatch_t st;
+
+    DISTCONV_CHECK_MPI(MPI_Barrier(comm));
+    util::stopwatch_start(&st);
+    hx->exchange(is_reverse, op);
+    times[0] = util::stopwatch_stop(&st);
+
+    util::stopwatch_start(&st);
+    compute_interior(t, scratch.data());
+    times[1] = util::stopwatch_stop(&st);
+
+    if (cfg.overlap) {
+      DISTCONV_CHECK_MPI(MPI_Barrier(comm));
+      util::stopwatch_start(&st);
+      std::thread comm_thread([&]() { hx->exchange(is_reverse, op); });
+      compute_interior(t, scratch.data());
+      comm_thread.join();
+      times[2] = util::stopwatch_stop(&st);
+    }
+
+    for (int j = 0; j < 3; ++j) local_times[j].push_back(times[j]);
+    // The slowest rank determines the time
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, times, 3, MPI_FLOAT,
+                                     MPI_MAX, comm));
+    exchange_time.push_back(times[0]);
+    compute_time.push_back(times[1]);
+    overlapped_time.push_back(times[2]);
+  }
+
+  res.exchange_time = get_median(exchange_time);
+  res.compute_time = get_median(compute_time);
+  res.overlapped_time = get_median(overlapped_time);
+  unsigned long bytes = get_send_bytes(t);
+  unsigned long max_bytes = 0;
+  DISTCONV_CHECK_MPI(MPI_Allreduce(&bytes, &max_bytes, 1, MPI_UNSIGNED_LONG,
+                                   MPI_MAX, comm));
+  res.bytes_per_rank = max_bytes;
+
+  if (rec) {
+    rec->add_timings("exchange", local_times[0])
+        .add_timings("compute", local_times[1]);
+    if (cfg.overlap) {
+      rec->add_timings("overlapped", local_times[2]);
+    }
+  }
+}
+
+// Achieved bandwidth in GB/s for the given bytes moved in milliseconds
+inline double get_gbps(size_t bytes, float time) {
+  return time > 0 ? bytes / (time * 1e-3) / 1e9 : 0;
+}
+
+inline void print_header(std::ostream &os) {
+  os << "method op nd shape grid width bytes_per_rank exchange_ms "
+     << "compute_ms overlapped_ms exchange_gbps hidden_fraction"
+     << std::endl;
+}
+
+inline void print_row(std::ostream &os, const SweepConfig &cfg,
+                      const std::string &method, const std::string &op,
+                      const Shape &shape, const std::vector<int> &grid,
+                      int width, const Result &res) {
+  os << method << " " << op << " " << shape.num_dims() << " "
+     << util::join_array(shape, "x") << " "
+     << util::join_array(grid, "x") << " "
+     << width << " " << res.bytes_per_rank << " "
+     << res.exchange_time << " " << res.compute_time << " ";
+  if (cfg.overlap) {
+    float hidden = res.exchange_time > 0 ?
+        (res.exchange_time + res.compute_time - res.overlapped_time)
+        / res.exchange_time : 0;
+    hidden = std::min(std::max(hidden, 0.0f), 1.0f);
+    os << res.overlapped_time << " "
+       << get_gbps(res.bytes_per_rank, res.exchange_time) << " "
+       << hidden;
+  } else {
+    os << "NA " << get_gbps(res.bytes_per_rank, res.exchange_time)
+       << " NA";
+  }
+  os << std::endl;
+}
+
+inline SweepConfig process_opt(int argc, char *argv[], int pid) {
+  cxxopts::Options cmd_opts(argv[0], "Host Halo Exchange Benchmark");
+  cmd_opts.add_options()
+      ("methods", "Comma-separated halo exchange methods of "
+       "mpi-blocking, mpi, persistent, neighbor, shm, concurrent and "
+       "concurrent-neighbor, or all of them",
+       cxxopts::value<std::string>()->default_value("all"))
+      ("num-dims", "Comma-separated numbers of spatial dimensions",
+       cxxopts::value<std::string>()->default_value("2,3"))
+      ("sizes", "Comma-separated spatial sizes",
+       cxxopts::value<std::string>()->default_value("32,64"))
+      ("widths", "Comma-separated halo widths",
+       cxxopts::value<std::string>()->default_value("1,2"))
+      ("n,num-samples", "Number of samples",
+       cxxopts::value<int>()->default_value("4"))
+      ("c,num-channels", "Number of channels",
+       cxxopts::value<int>()->default_value("8"))
+      ("r,num-runs", "Number of runs",
+       cxxopts::value<int>()->default_value("5"))
+      ("num-warmup-runs", "Number of warming-up runs",
+       cxxopts::value<int>()->default_value("2"))
+      ("no-overlap", "Skip measuring overlapped exchanges")
+      ("no-verify", "Skip checking the exchanged halos")
+      ("o,output-file", "Also write the results to this file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("results-file", "Save results to a JSON or CSV (*.csv) file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("help", "Print help");
+  auto result = cmd_opts.parse(argc, argv);
+  if (result.count("help")) {
+    if (pid == 0) {
+      std::cout << cmd_opts.help() << "\n";
+    }
+    DISTCONV_CHECK_MPI(MPI_Finalize());
+    std::exit(0);
+  }
+  SweepConfig cfg;
+  const auto methods = result["methods"].as<std::string>();
+  if (methods == "all") {
+    cfg.methods = {"mpi-blocking", "mpi", "persistent", "neighbor", "shm",
+                   "concurrent", "concurrent-neighbor"};
+  } else {
+    cfg.methods = util::split_spaced_array<std::string>(methods);
+  }
+  cfg.num_dims = util::split_spaced_array<int>(
+      result["num-dims"].as<std::string>());
+  cfg.sizes = util::split_spaced_array<int>(
+      result["sizes"].as<std::string>());
+  cfg.widths = util::split_spaced_array<int>(
+      result["widths"].as<std::string>());
+  cfg.num_samples = result["num-samples"].as<int>();
+  cfg.num_channels = result["num-channels"].as<int>();
+  cfg.run_count = result["num-runs"].as<int>();
+  cfg.warming_up_count = result["num-warmup-runs"].as<int>();
+  cfg.overlap = result.count("no-overlap") == 0;
+  cfg.verify = result.count("no-verify") == 0;
+  cfg.output_file = result["output-file"].as<std::string>();
+  cfg.results_file = result["results-file"].as<std::string>();
+  return cfg;
+}
+
+inline int run(const SweepConfig &cfg, MPI_Comm comm) {
+  int pid;
+  int np;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &pid));
+  DISTCONV_CHECK_MPI(MPI_Comm_size(comm, &np));
+
+  std::ofstream ofs;
+  if (pid == 0) {
+    print_header(std::cout);
+    if (!cfg.output_file.empty()) {
+      ofs.open(cfg.output_file);
+      print_header(ofs);
+    }
+  }
+
+  // Forward exchanges copy halos, whereas reverse exchanges
+  // accumulate them as in backward convolutions.
+  const std::vector<std::pair<std::string, HaloExchangeAccumOp>> ops = {
+    {"ID", HaloExchangeAccumOp::ID}, {"SUM", HaloExchangeAccumOp::SUM}};
+
+  BenchmarkResults results("halo_exchange_benchmark_host", comm);
+  int num_failures = 0;
+  for (int nsd: cfg.num_dims) {
+    for (int size: cfg.sizes) {
+      Shape shape(nsd, size);
+      shape.push_back(cfg.num_channels);
+      shape.push_back(cfg.num_samples);
+      for (const auto &grid: get_grids(np, nsd)) {
+        Shape proc_shape(nsd + 2, 1);
+        for (int i = 0; i < nsd; ++i) {
+          proc_shape[i] = grid[i];
+        }
+        const int min_local_size =
+            size / *std::max_element(grid.begin(), grid.end());
+        for (int width: cfg.widths) {
+          // Halos must not be wider than the local tensors
+          if (width > min_local_size) {
+            util::MPIRootPrintStreamInfo()
+                << "Skipping width " << width << " of " << shape
+                << " with grid " << util::join_array(grid, "x");
+            continue;
+          }
+          IntVector overlap(nsd + 2, 0);
+          for (int i = 0; i < nsd; ++i) {
+            overlap[i] = grid[i] > 1 ? width : 0;
+          }
+          auto dist = tensor::Distribution::make_overlapped_distribution(
+              proc_shape, overlap);
+          for (const auto &method: cfg.methods) {
+            for (const auto &op: ops) {
+              const bool is_reverse = op.second == HaloExchangeAccumOp::SUM;
+              if (cfg.verify) {
+                int num_errors = verify(method, shape, dist, is_reverse,
+                                        op.second, comm);
+                if (num_errors) {
+                  util::MPIRootPrintStreamError()
+                      << num_errors << " errors with " << method << " "
+                      << op.first << " of " << shape << " with grid "
+                      << util::join_array(grid, "x");
+                  ++num_failures;
+                }
+              }
+              BenchmarkResults::Record *rec = nullptr;
+              if (!cfg.results_file.empty()) {
+                rec = &results.add_record();
+                rec->set_config("method", method)
+                    .set_config("op", op.first)
+                    .set_config("shape", util::join_array(shape, "x"))
+                    .set_config("grid", grid)
+                    .set_config("width", width)
+                    .set_config("num_runs", cfg.run_count);
+              }
+              Result res;
+              run_case(cfg, method, shape, dist, is_reverse, op.second,
+                       comm, res, rec);
+              if (pid == 0) {
+                print_row(std::cout, cfg, method, op.first, shape, grid,
+                          width, res);
+                if (ofs.is_open()) {
+                  print_row(ofs, cfg, method, op.first, shape, grid,
+                            width, res);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  if (!cfg.results_file.empty()) {
+    results.write(cfg.results_file);
+  }
+  return num_failures;
+}
+
+} // namespace distconv_benchmark
+
+int main(int argc, char *argv[]) {
+  // The overlapped exchanges call MPI from a thread other than the
+  // main thread
+  int provided;
+  DISTCONV_CHECK_MPI(MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED,
+                                     &provided));
+  int pid;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &pid));
+  auto cfg = distconv_benchmark::process_opt(argc, argv, pid);
+  if (cfg.overlap && provided < MPI_THREAD_SERIALIZED) {
+    util::MPIRootPrintStreamWarning()
+        << "MPI_THREAD_SERIALIZED not supported; skipping overlapped "
+        << "exchanges";
+    cfg.overlap = false;
+  }
+  int num_failures = distconv_benchmark::run(cfg, MPI_COMM_WORLD);
+  DISTCONV_CHECK_MPI(MPI_Finalize());
+  return num_failures == 0 ? 0 : 1;
+}
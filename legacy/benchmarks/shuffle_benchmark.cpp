@@ -35,6 +35,7 @@ namespace distconv_benchmark {
 template <int NSD>
 class Profile {
  public:
+  static constexpr char name[] = "shuffle_benchmark";
   std::vector<float> fwd_time;
   std::vector<float> bwd_time;
   distconv_benchmark::BenchmarkConfig<NSD> m_cfg;
@@ -55,6 +56,14 @@ class Profile {
     return os;
   }
 
+  void record_timings(BenchmarkResults::Record &rec) const {
+    rec.add_timings("fwd", fwd_time);
+    // Backward shuffles are not measured on the host
+    if (bwd_time.size() > 0) {
+      rec.add_timings("bwd", bwd_time);
+    }
+  }
+
   void print_summary(std::ostream &os) const {
     if (fwd_time.size() > 0) {
       std::cout << m_cfg.shuffle_method
@@ -374,6 +383,14 @@ int run_test(const distconv_benchmark::BenchmarkConfig<NSD> &cfg, MPI_Comm comm)
   test_shuffler<NSD>(d, cfg, comm, prof);
   dump_prof(prof, pid, cfg);
 
+  if (!cfg.results_file.empty()) {
+    BenchmarkResults results(Profile<NSD>::name, comm);
+    auto &rec = results.add_record();
+    cfg.record_config(rec);
+    prof.record_timings(rec);
+    results.write(cfg.results_file);
+  }
+
   if (cfg.dump_output) {
     dump_tensor(d.spatial, "output_spatial_tensor", true);
     dump_tensor(d.output_sample, "output_sample_tensor", true);
@@ -429,11 +446,11 @@ int main(int argc, char *argv[]) {
 
   const int nsd = distconv_benchmark::parse_num_dims(argc, argv);
 
-  if(nsd == 2) {
-    distconv_benchmark::run<2>(argc, argv, pid, np);
-  } else if(nsd == 3) {
-    distconv_benchmark::run<3>(argc, argv, pid, np);
-  } else {
+  const bool valid = distconv_benchmark::dispatch_value<
+    distconv_benchmark::NumDimsCases>(nsd, [&](auto nsd_case) {
+      distconv_benchmark::run<decltype(nsd_case)::value>(argc, argv, pid, np);
+    });
+  if (!valid) {
     util::MPIRootPrintStreamError()
         << "Invalid --num-dims: " << nsd;
     DISTCONV_CHECK_MPI(MPI_Finalize());
@@ -0,0 +1,462 @@
+#include "benchmark_common.hpp"
+#include "distconv_benchmark_common.hpp"
+#include "distconv/distconv.hpp"
+#include "distconv/tensor/shuffle_mpi.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/cxxopts.hpp"
+#include "distconv/util/stopwatch.h"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+  Sweeps TensorMPIShuffler<DataType, BaseAllocator> over tensor sizes,
+  dimensionalities and pairs of source/destination process grids. The
+  pack, transfer and unpack phases are timed separately. Each row
+  reports the median over the runs of the slowest rank in each phase.
+  With --persistent, the shuffler sets up persistent requests at the
+  first shuffle, which is one of the warming-up runs.
+ */
+
+using DataType = float;
+using namespace distconv;
+using distconv::tensor::Shape;
+
+namespace distconv_benchmark {
+
+using Allocator = tensor::BaseAllocator;
+using HostTensor = tensor::Tensor<DataType, tensor::LocaleMPI, Allocator>;
+
+// Accumulates the elapsed time of each shuffle phase.
+class TimedShuffler: public tensor::TensorMPIShuffler<DataType, Allocator> {
+  using Base = tensor::TensorMPIShuffler<DataType, Allocator>;
+ public:
+  using Base::Base;
+
+  float pack_time = 0;
+  float transfer_time = 0;
+  float unpack_time = 0;
+
+  void reset_times() {
+    pack_time = 0;
+    transfer_time = 0;
+    unpack_time = 0;
+  }
+
+  // Number of bytes this rank sends to other ranks
+  size_t get_remote_send_bytes(bool is_forward) const {
+    const int *counts = m_helper.get_send_counts(is_forward);
+    const int rank = m_helper.m_loc.get_rank();
+    size_t bytes = 0;
+    for (int i = 0; i < m_helper.m_loc.get_size(); ++i) {
+      if (i != rank) bytes += counts[i] * sizeof(DataType);
+    }
+    return bytes;
+  }
+
+ protected:
+  void pack_send_buf(const DataType *src, DataType *send_buf,
+                     bool is_forward) override {
+    util::stopwatch_t st;
+    util::stopwatch_start(&st);
+    Base::pack_send_buf(src, send_buf, is_forward);
+    pack_time += util::stopwatch_stop(&st);
+  }
+
+  void transfer(const std::shared_ptr<DataType> &send_buf,
+                std::shared_ptr<DataType> &recv_buf,
+                bool is_forward) override {
+    util::stopwatch_t st;
+    util::stopwatch_start(&st);
+    Base::transfer(send_buf, recv_buf, is_forward);
+    transfer_time += util::stopwatch_stop(&st);
+  }
+
+  void unpack_recv_buf(DataType *dst, DataType *recv_buf,
+                       bool is_forward) override {
+    util::stopwatch_t st;
+    util::stopwatch_start(&st);
+    Base::unpack_recv_buf(dst, recv_buf, is_forward);
+    unpack_time += util::stopwatch_stop(&st);
+  }
+};
+
+struct SweepConfig {
+  std::vector<int> num_dims;
+  std::vector<int> sizes;
+  int num_samples;
+  int num_channels;
+  std::vector<std::pair<std::string, std::string>> layouts;
+  int warming_up_count;
+  int run_count;
+  bool verify;
+  bool persistent;
+  std::string output_file;
+  std::string results_file;
+};
+
+struct Result {
+  float pack_time;
+  float transfer_time;
+  float unpack_time;
+  float total_time;
+  size_t bytes_per_rank;
+  size_t total_bytes;
+};
+
+// Splits np into n factors as evenly as possible. Larger factors come
+// last so that they are assigned to the outer dimensions.
+inline std::vector<int> factorize(int np, int n) {
+  std::vector<int> primes;
+  for (int p = 2; np > 1; ) {
+    if (np % p == 0) {
+      primes.push_back(p);
+      np /= p;
+    } else {
+      ++p;
+    }
+  }
+  std::vector<int> factors(n, 1);
+  for (auto it = primes.rbegin(); it != primes.rend(); ++it) {
+    *std::min_element(factors.begin(), factors.end()) *= *it;
+  }
+  std::sort(factors.begin(), factors.end());
+  return factors;
+}
+
+/*
+  Returns the distribution of the given layout:
+  - sample: the sample dimension
+  - channel: the channel dimension
+  - spatial: all the spatial dimensions
+  - spatial-outer: the spatial dimensions except for the innermost
+    one, e.g., 2D splits of 3D tensors
+ */
+inline bool make_layout(const std::string &layout, const Shape &shape,
+                        int np, tensor::Distribution &dist) {
+  const int nd = shape.num_dims();
+  const int nsd = nd - 2;
+  Shape proc_shape(nd, 1);
+  if (layout == "sample") {
+    dist = make_strided_sample_distribution(nd, shape[-1], np);
+    return shape[-1] >= (index_t)np || np % shape[-1] == 0;
+  } else if (layout == "channel") {
+    proc_shape[-2] = np;
+  } else if (layout == "spatial" || layout == "spatial-outer") {
+    const int first_dim = layout == "spatial" ? 0 : 1;
+    if (first_dim >= nsd) return false;
+    auto factors = factorize(np, nsd - first_dim);
+    for (int i = first_dim; i < nsd; ++i) {
+      proc_shape[i] = factors[i - first_dim];
+    }
+  } else {
+    util::MPIRootPrintStreamError() << "Unknown layout: " << layout;
+    std::abort();
+  }
+  for (int i = 0; i < nd; ++i) {
+    if (proc_shape[i] > shape[i]) return false;
+  }
+  dist = tensor::Distribution::make_distribution(proc_shape);
+  return true;
+}
+
+inline void init_tensor(HostTensor &t) {
+  const auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin(); it != local_shape.index_end();
+       ++it) {
+    t.set(*it, t.get_global_offset(*it));
+  }
+}
+
+inline int check_tensor(const HostTensor &t) {
+  int num_errors = 0;
+  if (!t.is_split_root()) return 0;
+  const auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin(); it != local_shape.index_end();
+       ++it) {
+    if (t.get(*it) != (DataType)t.get_global_offset(*it)) {
+      ++num_errors;
+    }
+  }
+  return num_errors;
+}
+
+inline int run_case(const SweepConfig &cfg, const Shape &shape,
+                    const tensor::Distribution &src_dist,
+                    const tensor::Distribution &dst_dist,
+                    MPI_Comm comm, Result &res,
+                    BenchmarkResults::Record *rec) {
+  tensor::LocaleMPI loc(comm);
+  HostTensor src(shape, loc, src_dist);
+  HostTensor dst(shape, loc, dst_dist);
+  assert0(src.allocate());
+  assert0(dst.allocate());
+  init_tensor(src);
+  dst.zero();
+
+  auto src_buf = static_cast<DataType*>(
+      util::aligned_malloc(TimedShuffler::get_buf_size(src)));
+  auto dst_buf = static_cast<DataType*>(
+      util::aligned_malloc(TimedShuffler::get_buf_size(dst)));
+  TimedShuffler shfl(src, dst, src_buf, dst_buf, cfg.persistent);
+
+  for (int i = 0; i < cfg.warming_up_count; ++i) {
+    shfl.shuffle_forward(src.get_base_ptr(), dst.get_base_ptr());
+  }
+
+  int num_errors = 0;
+  if (cfg.verify) {
+    if (cfg.warming_up_count == 0) {
+      shfl.shuffle_forward(src.get_base_ptr(), dst.get_base_ptr());
+    }
+    num_errors = check_tensor(dst);
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &num_errors, 1, MPI_INT,
+                                     MPI_SUM, comm));
+  }
+
+  std::vector<float> pack_time, transfer_time, unpack_time, total_time;
+  std::vector<float> local_times[4];
+  for (int i = 0; i < cfg.run_count; ++i) {
+    shfl.reset_times();
+    DISTCONV_CHECK_MPI(MPI_Barrier(comm));
+    util::stopwatch_t st;
+    util::stopwatch_start(&st);
+    shfl.shuffle_forward(src.get_base_ptr(), dst.get_base_ptr());
+    float times[4] = {shfl.pack_time, shfl.transfer_time, shfl.unpack_time,
+                      util::stopwatch_stop(&st)};
+    for (int j = 0; j < 4; ++j) local_times[j].push_back(times[j]);
+    // The slowest rank determines the time of each phase
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, times, 4, MPI_FLOAT,
+                                     MPI_MAX, comm));
+    pack_time.push_back(times[0]);
+    transfer_time.push_back(times[1]);
+    unpack_time.push_back(times[2]);
+    total_time.push_back(times[3]);
+  }
+
+  res.pack_time = get_median(pack_time);
+  res.transfer_time = get_median(transfer_time);
+  res.unpack_time = get_median(unpack_time);
+  res.total_time = get_median(total_time);
+  unsigned long bytes = shfl.get_remote_send_bytes(true);
+  unsigned long max_bytes = 0;
+  unsigned long total_bytes = 0;
+  DISTCONV_CHECK_MPI(MPI_Allreduce(&bytes, &max_bytes, 1, MPI_UNSIGNED_LONG,
+                                   MPI_MAX, comm));
+  DISTCONV_CHECK_MPI(MPI_Allreduce(&bytes, &total_bytes, 1,
+                                   MPI_UNSIGNED_LONG, MPI_SUM, comm));
+  res.bytes_per_rank = max_bytes;
+  res.total_bytes = total_bytes;
+
+  if (rec) {
+    rec->add_timings("pack", local_times[0])
+        .add_timings("transfer", local_times[1])
+        .add_timings("unpack", local_times[2])
+        .add_timings("total", local_times[3]);
+  }
+
+  free(src_buf);
+  free(dst_buf);
+  return num_errors;
+}
+
+// Achieved bandwidth in GB/s for the given bytes moved in milliseconds
+inline double get_gbps(size_t bytes, float time) {
+  return time > 0 ? bytes / (time * 1e-3) / 1e9 : 0;
+}
+
+inline void print_header(std::ostream &os) {
+  os << "nd shape src dst src_grid dst_grid bytes_per_rank total_bytes "
+     << "pack_ms transfer_ms unpack_ms total_ms transfer_gbps total_gbps"
+     << std::endl;
+}
+
+inline void print_row(std::ostream &os, const Shape &shape,
+                      const std::string &src, const std::string &dst,
+                      const tensor::Distribution &src_dist,
+                      const tensor::Distribution &dst_dist,
+                      const Result &res) {
+  os << shape.num_dims() << " "
+     << util::join_array(shape, "x") << " "
+     << src << " " << dst << " "
+     << util::join_array(src_dist.get_locale_shape(), "x") << " "
+     << util::join_array(dst_dist.get_locale_shape(), "x") << " "
+     << res.bytes_per_rank << " " << res.total_bytes << " "
+     << res.pack_time << " " << res.transfer_time << " "
+     << res.unpack_time << " " << res.total_time << " "
+     << get_gbps(res.bytes_per_rank, res.transfer_time) << " "
+     << get_gbps(res.bytes_per_rank, res.total_time)
+     << std::endl;
+}
+
+inline std::vector<int> parse_int_list(const std::string &s) {
+  std::vector<int> v;
+  std::stringstream ss(s);
+  std::string tok;
+  while (std::getline(ss, tok, ',')) {
+    v.push_back(std::stoi(tok));
+  }
+  return v;
+}
+
+// Parses a comma-separated list of src:dst layout pairs
+inline std::vector<std::pair<std::string, std::string>> parse_layouts(
+    const std::string &s) {
+  std::vector<std::pair<std::string, std::string>> v;
+  std::stringstream ss(s);
+  std::string tok;
+  while (std::getline(ss, tok, ',')) {
+    auto pos = tok.find(':');
+    if (pos == std::string::npos) {
+      util::MPIRootPrintStreamError() << "Invalid layout pair: " << tok;
+      std::abort();
+    }
+    v.emplace_back(tok.substr(0, pos), tok.substr(pos + 1));
+  }
+  return v;
+}
+
+inline SweepConfig process_opt(int argc, char *argv[], int pid) {
+  cxxopts::Options cmd_opts(argv[0], "Host Tensor Shuffle Benchmark");
+  cmd_opts.add_options()
+      ("num-dims", "Comma-separated numbers of spatial dimensions",
+       cxxopts::value<std::string>()->default_value("2,3"))
+      ("sizes", "Comma-separated spatial sizes",
+       cxxopts::value<std::string>()->default_value("16,32,64"))
+      ("n,num-samples", "Number of samples",
+       cxxopts::value<int>()->default_value("8"))
+      ("c,num-channels", "Number of channels",
+       cxxopts::value<int>()->default_value("16"))
+      ("layouts", "Comma-separated src:dst layout pairs of "
+       "sample, channel, spatial and spatial-outer",
+       cxxopts::value<std::string>()->default_value(
+           "sample:spatial,spatial:sample,spatial:channel,"
+           "channel:spatial,sample:channel,spatial-outer:spatial,"
+           "spatial:spatial-outer"))
+      ("r,num-runs", "Number of runs",
+       cxxopts::value<int>()->default_value("5"))
+      ("num-warmup-runs", "Number of warming-up runs",
+       cxxopts::value<int>()->default_value("2"))
+      ("no-verify", "Skip checking the shuffled tensors")
+      ("persistent", "Use persistent MPI requests")
+      ("o,output-file", "Also write the results to this file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("results-file", "Save results to a JSON or CSV (*.csv) file",
+       cxxopts::value<std::string>()->default_value(""))
+      ("help", "Print help");
+  auto result = cmd_opts.parse(argc, argv);
+  if (result.count("help")) {
+    if (pid == 0) {
+      std::cout << cmd_opts.help() << "\n";
+    }
+    finalize_comm();
+    std::exit(0);
+  }
+  SweepConfig cfg;
+  cfg.num_dims = parse_int_list(result["num-dims"].as<std::string>());
+  cfg.sizes = parse_int_list(result["sizes"].as<std::string>());
+  cfg.num_samples = result["num-samples"].as<int>();
+  cfg.num_channels = result["num-channels"].as<int>();
+  cfg.layouts = parse_layouts(result["layouts"].as<std::string>());
+  cfg.run_count = result["num-runs"].as<int>();
+  cfg.warming_up_count = result["num-warmup-runs"].as<int>();
+  cfg.verify = result.count("no-verify") == 0;
+  cfg.persistent = result.count("persistent") > 0;
+  cfg.output_file = result["output-file"].as<std::string>();
+  cfg.results_file = result["results-file"].as<std::string>();
+  return cfg;
+}
+
+inline int run(const SweepConfig &cfg, MPI_Comm comm) {
+  int pid;
+  int np;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &pid));
+  DISTCONV_CHECK_MPI(MPI_Comm_size(comm, &np));
+
+  std::ofstream ofs;
+  if (pid == 0) {
+    print_header(std::cout);
+    if (!cfg.output_file.empty()) {
+      ofs.open(cfg.output_file);
+      print_header(ofs);
+    }
+  }
+
+  BenchmarkResults results("shuffle_benchmark_host", comm);
+  int num_failures = 0;
+  for (int nsd: cfg.num_dims) {
+    for (int size: cfg.sizes) {
+      Shape shape(nsd, size);
+      shape.push_back(cfg.num_channels);
+      shape.push_back(cfg.num_samples);
+      for (const auto &layout: cfg.layouts) {
+        tensor::Distribution src_dist, dst_dist;
+        if (!make_layout(layout.first, shape, np, src_dist) ||
+            !make_layout(layout.second, shape, np, dst_dist)) {
+          util::MPIRootPrintStreamInfo()
+              << "Skipping " << layout.first << " to " << layout.second
+              << " of " << shape << " with " << np << " processes";
+          continue;
+        }
+        if (src_dist == dst_dist) {
+          util::MPIRootPrintStreamInfo()
+              << "Skipping " << layout.first << " to " << layout.second
+              << " of " << shape << " as both use the same distribution";
+          continue;
+        }
+        BenchmarkResults::Record *rec = nullptr;
+        if (!cfg.results_file.empty()) {
+          rec = &results.add_record();
+          rec->set_config("shape", util::join_array(shape, "x"))
+              .set_config("src", layout.first)
+              .set_config("dst", layout.second)
+              .set_config("src_grid",
+                          util::join_array(src_dist.get_locale_shape(), "x"))
+              .set_config("dst_grid",
+                          util::join_array(dst_dist.get_locale_shape(), "x"))
+              .set_config("persistent", cfg.persistent)
+              .set_config("num_runs", cfg.run_count);
+        }
+        Result res;
+        int num_errors = run_case(cfg, shape, src_dist, dst_dist, comm, res,
+                                  rec);
+        if (num_errors) {
+          util::MPIRootPrintStreamError()
+              << num_errors << " errors in shuffling " << shape << " from "
+              << layout.first << " to " << layout.second;
+          ++num_failures;
+        }
+        if (pid == 0) {
+          print_row(std::cout, shape, layout.first, layout.second,
+                    src_dist, dst_dist, res);
+          if (ofs.is_open()) {
+            print_row(ofs, shape, layout.first, layout.second,
+                      src_dist, dst_dist, res);
+          }
+        }
+      }
+    }
+  }
+  if (!cfg.results_file.empty()) {
+    results.write(cfg.results_file);
+  }
+  return num_failures;
+}
+
+} // namespace distconv_benchmark
+
+int main(int argc, char *argv[]) {
+  distconv_benchmark::initialize_comm(argc, argv);
+  int pid;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(MPI_COMM_WORLD, &pid));
+  auto cfg = distconv_benchmark::process_opt(argc, argv, pid);
+  int num_failures = distconv_benchmark::run(cfg, MPI_COMM_WORLD);
+  distconv_benchmark::finalize_comm();
+  return num_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "distconv/tensor/tensor_file.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+
+#include <mpi.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+  Asynchronous checkpoint/restart of distributed tensors.
+
+  Each registered tensor is stored in the chunked tensor file format
+  of tensor_file.hpp with one chunk per partition. Checkpoints
+  alternate between two slots of files, and a manifest records the
+  step and the slot of the last complete checkpoint, so that a failure
+  while writing leaves the previous checkpoint intact.
+
+  Saving takes a snapshot of the local partitions in host memory, and
+  the snapshot is written by a background thread with POSIX I/O, so
+  the tensors can be updated as soon as save returns. With delta
+  writes, chunks whose checksums match the ones recorded in the slot
+  file are not rewritten. Restarting reads the files with
+  TensorFile::read, so tensors can be distributed differently from
+  when they were saved.
+ */
+
+namespace distconv {
+
+class Checkpoint {
+ public:
+  /**
+     Open the checkpoint directory. Collective over comm.
+   */
+  Checkpoint(MPI_Comm comm, const std::string &dir, bool delta=true);
+  // Waits for a pending save, which is collective
+  ~Checkpoint();
+
+  Checkpoint(const Checkpoint &) = delete;
+  Checkpoint &operator=(const Checkpoint &) = delete;
+
+  /**
+     Register a tensor under a name. The tensor must outlive this
+     object. Its partitions are saved as the chunks of the file, so
+     wait returns an error unless they have the default local shapes,
+     e.g., when they are requested by a LoadBalancer.
+   */
+  template <typename DataType, typename Allocator>
+  void add(const std::string &name,
+           tensor::Tensor<DataType, tensor::LocaleMPI, Allocator> &t) {
+    // Chunks are contiguous boxes of the tensor
+    assert_always(!t.get_distribution().is_cyclic());
+    Entry e;
+    e.name = name;
+    e.snapshot = [&t]() {
+      Snapshot s;
+      s.data_type = tensor::TensorFileDataType<DataType>::value;
+      s.element_size = sizeof(DataType);
+      s.shape = t.get_shape();
+      s.chunk_grid = t.get_distribution().get_split_shape();
+      s.has_chunk = t.get_local_size() > 0 && t.is_split_root();
+      s.valid = true;
+      if (t.is_split_root()) {
+        for (int i = 0; i < s.shape.num_dims(); ++i) {
+          s.valid &= t.get_local_shape()[i] ==
+              tensor::internal::get_chunk_size(s.shape[i], s.chunk_grid[i],
+                                               t.get_split_index()[i]);
+        }
+      }
+      s.chunk = 0;
+      s.ptr = nullptr;
+      s.bytes = 0;
+      if (s.has_chunk) {
+        s.chunk = tensor::get_offset(t.get_split_index(), s.chunk_grid);
+        auto buf = std::make_shared<std::vector<DataType>>(
+            tensor::internal::pack_local_interior(t));
+        s.ptr = buf->data();
+        s.bytes = buf->size() * sizeof(DataType);
+        s.holder = buf;
+      }
+      return s;
+    };
+    e.restore = [&t](const tensor::TensorFile &f) {
+      return f.read(t, true);
+    };
+    m_entries.push_back(e);
+  }
+
+  /**
+     Take a snapshot of the registered tensors and start writing it in
+     the background. Waits for the previous save first. Collective.
+   */
+  void save(int step);
+
+  /**
+     Wait for the pending save and record it as the last
+     checkpoint. Returns non-zero if any process failed to write.
+     Collective.
+   */
+  int wait();
+
+  /**
+     Load the registered tensors from the last checkpoint. Returns its
+     step, or -1 if there is no checkpoint or loading fails.
+     Collective.
+   */
+  int restore();
+
+  // Step of the last complete checkpoint, or -1
+  int get_last_step() const {
+    return m_step;
+  }
+
+  // Number of chunks of this process skipped by the last delta write
+  int get_num_skipped_chunks() const {
+    return m_num_skipped_chunks;
+  }
+
+ private:
+  struct Snapshot {
+    uint32_t data_type;
+    uint32_t element_size;
+    tensor::Shape shape;
+    tensor::Shape chunk_grid;
+    // Whether this process writes a chunk
+    bool has_chunk;
+    // Whether the local partition has the shape of its chunk
+    bool valid;
+    index_t chunk;
+    const void *ptr;
+    size_t bytes;
+    std::shared_ptr<const void> holder;
+  };
+
+  struct Entry {
+    std::string name;
+    std::function<Snapshot()> snapshot;
+    std::function<int(const tensor::TensorFile &)> restore;
+  };
+
+  MPI_Comm m_comm;
+  int m_rank;
+  std::string m_dir;
+  bool m_delta;
+  std::vector<Entry> m_entries;
+  int m_step;
+  int m_slot;
+  int m_pending_step;
+  int m_pending_slot;
+  int m_num_skipped_chunks;
+  int m_pending_num_skipped_chunks;
+  std::future<int> m_future;
+
+  std::string get_path(const std::string &name, int slot) const;
+  std::string get_manifest_path() const;
+  bool prepare_file(const Snapshot &s, const std::string &path) const;
+  int write_snapshots(const std::vector<Snapshot> &snapshots,
+                      const std::vector<int> &reuse, int slot,
+                      int &num_skipped) const;
+};
+
+} // namespace distconv
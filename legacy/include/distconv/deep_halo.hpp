@@ -0,0 +1,256 @@
+#pragma once
+
+#include "distconv/base.hpp"
+#include "distconv/distconv.hpp"
+#include "distconv/tensor/halo_exchange_host.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/*
+  Deep-halo execution of chains of convolutions on host tensors.
+
+  Spatially partitioned convolutions usually exchange halos of width
+  (k-1)/2 before each layer. In deep-halo mode, the layers are grouped
+  into segments of depth layers. The input of a segment gets a halo
+  as wide as the sum of the halo widths of its layers, and the halo is
+  exchanged once. Each layer of the segment then computes its output
+  over the local region extended by the halo width still needed by
+  the following layers, so that the extension shrinks to zero at the
+  last layer of the segment. The redundant computation of the borders
+  replaces depth - 1 halo exchanges.
+
+  Layers are stride-1 convolutions with odd filter sizes and zero
+  padding that keeps the spatial shape, computed with the reference
+  kernel of ref::apply over the extended regions. Elements outside the
+  global tensor are kept zero, which provides the padding of the
+  following layers. Pooling layers are not supported as max and
+  no-pad average pooling exclude the padding rather than taking it as
+  zero. Only spatial and sample parallelism is supported.
+ */
+
+namespace distconv {
+
+template <typename DataType>
+class DeepHaloConvolutionChain {
+ public:
+  using TensorType = tensor::Tensor<DataType, tensor::LocaleMPI,
+                                    tensor::BaseAllocator>;
+  using HaloExchange = tensor::HaloExchangeHost<DataType>;
+
+  /**
+     @param locale Processes of the tensors.
+     @param proc_shape Process grid of the activations.
+     @param shape Shape of the input.
+     @param num_filters Number of output channels of each layer.
+     @param filter_dims Spatial filter dimensions of each layer.
+     @param depth Number of layers per halo exchange.
+   */
+  DeepHaloConvolutionChain(const tensor::LocaleMPI &locale,
+                           const tensor::Shape &proc_shape,
+                           const tensor::Shape &shape,
+                           const int_vector &num_filters,
+                           const std::vector<int_vector> &filter_dims,
+                           int depth):
+      m_num_layers(num_filters.size()), m_depth(depth), m_flops(0) {
+    const int nd = shape.num_dims();
+    const int nsd = nd - 2;
+    assert_always(m_num_layers > 0);
+    assert_always(depth > 0);
+    assert_eq((int)filter_dims.size(), m_num_layers);
+    assert_eq(proc_shape.num_dims(), nd);
+    // Channels are not partitioned
+    assert_eq(proc_shape[-2], 1);
+
+    // Halo widths of each layer
+    std::vector<IntVector> radii;
+    for (const auto &f: filter_dims) {
+      assert_eq((int)f.size(), nsd);
+      IntVector r(nd, 0);
+      for (int i = 0; i < nsd; ++i) {
+        assert_always(f[i] % 2 == 1);
+        r[i] = proc_shape[i] > 1 ? (f[i] - 1) / 2 : 0;
+      }
+      radii.push_back(r);
+    }
+
+    // Activation l is the input of layer l, and its halo covers the
+    // remaining layers of the segment that starts at layer l.
+    for (int l = 0; l <= m_num_layers; ++l) {
+      IntVector overlap(nd, 0);
+      const int seg_end = std::min((l / depth + 1) * depth, m_num_layers);
+      for (int m = l; m < seg_end; ++m) {
+        overlap = overlap + radii[m];
+      }
+      auto act_shape = shape;
+      if (l > 0) act_shape[-2] = num_filters[l - 1];
+      auto dist = tensor::Distribution::make_overlapped_distribution(
+          proc_shape, overlap);
+      m_activations.emplace_back(act_shape, locale, dist);
+      auto &t = m_activations.back();
+      assert0(t.allocate());
+      t.zero();
+      if (l % depth == 0 && l < m_num_layers) {
+        // Halos come only from immediate neighbors
+        for (int i = 0; i < nsd; ++i) {
+          if (overlap[i] > 0 &&
+              act_shape[i] / proc_shape[i] < (index_t)overlap[i]) {
+            util::MPIRootPrintStreamError()
+                << "Halo of width " << overlap[i] << " at dimension " << i
+                << " is wider than local tensors of " << act_shape;
+            std::abort();
+          }
+        }
+      }
+    }
+
+    for (int l = 0; l < m_num_layers; ++l) {
+      const auto &x = m_activations[l];
+      const auto &y = m_activations[l + 1];
+      // The last layer of a segment computes the interior only, and
+      // its halo is exchanged by the next segment.
+      const bool seg_last = (l + 1) % depth == 0 || l + 1 == m_num_layers;
+      m_extensions.push_back(seg_last ? IntVector(nd, 0)
+                             : y.get_halo_width());
+      if (l % depth == 0) {
+        m_halo_xch.emplace_back(new HaloExchange(m_activations[l]));
+      }
+      index_t filter_size = x.get_shape()[-2] * y.get_shape()[-2];
+      for (int i = 0; i < nsd; ++i) filter_size *= filter_dims[l][i];
+      m_filters.emplace_back(filter_size, DataType(0));
+      m_flops += 2.0 * get_region_size(y, m_extensions.back())
+          * filter_size * y.get_local_shape()[-1];
+    }
+
+    // Replicated views of the filters
+    for (int l = 0; l < m_num_layers; ++l) {
+      tensor::Shape filter_shape(filter_dims[l]);
+      filter_shape.push_back(m_activations[l].get_shape()[-2]);
+      filter_shape.push_back(m_activations[l + 1].get_shape()[-2]);
+      m_filter_tensors.emplace_back(
+          filter_shape, locale,
+          tensor::Distribution::make_shared_distribution(proc_shape));
+      assert0(tensor::View(m_filter_tensors.back(), m_filters[l].data()));
+    }
+  }
+
+  int get_num_layers() const {
+    return m_num_layers;
+  }
+
+  int get_depth() const {
+    return m_depth;
+  }
+
+  // Number of halo exchanges per forward pass
+  int get_num_exchanges() const {
+    return m_halo_xch.size();
+  }
+
+  // Floating-point operations of this process per forward pass,
+  // including the redundant borders
+  double get_flops() const {
+    return m_flops;
+  }
+
+  /**
+     Input of the chain. Only the local interior needs to be set.
+   */
+  TensorType &get_input() {
+    return m_activations.front();
+  }
+
+  const TensorType &get_output() const {
+    return m_activations.back();
+  }
+
+  /**
+     Filter of a layer, which is replicated at all processes. Its
+     layout is the same as that of filter tensors, i.e., the spatial
+     dimensions followed by input and output channels.
+   */
+  std::vector<DataType> &get_filter(int layer) {
+    return m_filters[layer];
+  }
+
+  void forward() {
+    for (int l = 0; l < m_num_layers; ++l) {
+      if (l % m_depth == 0) {
+        m_halo_xch[l / m_depth]->exchange();
+      }
+      convolve(m_activations[l], m_filter_tensors[l], m_activations[l + 1],
+               m_extensions[l]);
+    }
+  }
+
+  /**
+     Computes y from x over the local interior of y extended by ext on
+     both sides of each spatial dimension. Elements of x outside its
+     local buffer are treated as zero, and elements of y outside the
+     global tensor are not written.
+   */
+  static void convolve(const TensorType &x, const TensorType &filter,
+                       TensorType &y, const IntVector &ext) {
+    if (y.get_local_size() == 0) return;
+    const int nd = x.get_num_dims();
+    const int nsd = nd - 2;
+
+    // Output region in the local indices of y
+    IntVector begin(nsd, 0), end(nsd, 0);
+    for (int i = 0; i < nsd; ++i) {
+      const long offset = y.get_global_index(i, 0);
+      begin[i] = std::max<long>(-ext[i], -offset);
+      end[i] = std::min<long>(y.get_local_shape()[i] + ext[i],
+                              y.get_shape()[i] - offset);
+      if (end[i] <= begin[i]) return;
+    }
+
+    // Paddings are unused as the region is given
+    const int_vector paddings(nsd, 0), strides(nsd, 1);
+    const index_t num_c = x.get_local_shape()[-2];
+    const index_t num_k = y.get_local_shape()[-2];
+    const index_t num_n = y.get_local_shape()[-1];
+#pragma omp parallel for collapse(2)
+    for (index_t n = 0; n < num_n; ++n) {
+      for (index_t k = 0; k < num_k; ++k) {
+        for (index_t c = 0; c < num_c; ++c) {
+          ref::apply<TensorType>(1, x, n, c, filter, k, c, false,
+                                 c == 0 ? 0 : 1, y, n, k, paddings, strides,
+                                 true, begin, end);
+        }
+      }
+    }
+  }
+
+ protected:
+  int m_num_layers;
+  int m_depth;
+  // Not resized after construction as halo exchanges refer to the
+  // activations
+  std::vector<TensorType> m_activations;
+  std::vector<std::unique_ptr<HaloExchange>> m_halo_xch;
+  std::vector<std::vector<DataType>> m_filters;
+  std::vector<TensorType> m_filter_tensors;
+  std::vector<IntVector> m_extensions;
+  double m_flops;
+
+  // Number of spatial positions computed for the local tensor
+  static index_t get_region_size(const TensorType &y, const IntVector &ext) {
+    if (y.get_local_size() == 0) return 0;
+    index_t size = 1;
+    for (int i = 0; i < y.get_num_dims() - 2; ++i) {
+      const long offset = y.get_global_index(i, 0);
+      const long lo = std::max<long>(-ext[i], -offset);
+      const long hi = std::min<long>(y.get_local_shape()[i] + ext[i],
+                                     y.get_shape()[i] - offset);
+      size *= std::max<long>(hi - lo, 0);
+    }
+    return size;
+  }
+};
+
+} // namespace distconv
@@ -7,6 +7,7 @@
 #include "distconv/tensor/tensor_base.hpp"
 #include "distconv/tensor/tensor.hpp"
 #include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/tensor/tensor_mpi_io.hpp"
 
 namespace distconv {
 
@@ -595,6 +596,11 @@ inline int dump_tensor(
         << "Dumping " << t_mpi << " to " << file_path;
   }
 
+  // Binary dumps are written in parallel by all processes
+  if (binary) {
+    return tensor::Dump(t_mpi, file_path);
+  }
+
   using TensorProcType = tensor::Tensor<DataType,
                                         tensor::LocaleProcess,
                                         tensor::BaseAllocator>;
@@ -616,14 +622,9 @@ inline int dump_tensor(
   }
   if (t_mpi.get_locale().get_rank() == 0) {
     std::ofstream out;
-    if (!binary) {
-      out.open(file_path, std::ios::out | std::ios::trunc);
-      for (index_t i = 0; i < t_mpi.get_size(); ++i) {
-        out << buf[i] << std::endl;
-      }
-    } else {
-      out.open(file_path, std::ios::out | std::ios::trunc | std::ios::binary);
-      out.write((char *)buf, t_mpi.get_size() * sizeof(DataType));
+    out.open(file_path, std::ios::out | std::ios::trunc);
+    for (index_t i = 0; i < t_mpi.get_size(); ++i) {
+      out << buf[i] << std::endl;
     }
     out.close();
   }
@@ -631,6 +632,20 @@ inline int dump_tensor(
   return 0;
 }
 
+// Reads a tensor from a binary dump. The tensor may be distributed
+// differently from the dumped one.
+template <typename DataType, typename Alloccator>
+inline int load_tensor(
+    tensor::Tensor<DataType, tensor::LocaleMPI, Alloccator> &t_mpi,
+    std::string file_path) {
+  file_path += ".out";
+  if (t_mpi.get_locale().get_rank() == 0) {
+    util::MPIPrintStreamDebug()
+        << "Loading " << t_mpi << " from " << file_path;
+  }
+  return tensor::Load(t_mpi, file_path);
+}
+
 template <typename DataType, typename Alloccator>
 inline int dump_local_tensor(
     const tensor::Tensor<DataType, tensor::LocaleMPI, Alloccator> &t_mpi,
@@ -674,6 +689,8 @@ inline int dump_local_tensor(
 
 // Reference backend
 #include "distconv/ref/backend.hpp"
+#include "distconv/ref/batchnorm.hpp"
+#include "distconv/ref/pooling.hpp"
 
 #ifdef DISTCONV_HAS_CUDNN
 #include "distconv/dnn_backend/backend.hpp"
@@ -2,6 +2,7 @@
 
 #include "distconv/dnn_backend/backend.hpp"
 #include "distconv/distconv.hpp"
+#include "distconv/perf_model.hpp"
 #include "distconv/runtime_gpu.hpp"
 #include "distconv/tensor/halo_exchange_cuda.hpp"
 #include "distconv/tensor/halo_exchange_cuda_al.hpp"
@@ -19,6 +20,7 @@
 
 #include <Al.hpp>
 
+#include <algorithm>
 #include <memory>
 
 namespace distconv
@@ -289,6 +291,13 @@ public:
         // empty.
         setup_halo_xch(input, d_output);
 
+        // Calibration of the performance model is collective, so it is
+        // also done by processes with empty tensors.
+        if (m_chanfilt_algo == ChannelParallelismAlgorithm::AUTO)
+        {
+            perf_model::get_machine_params(input.get_locale().get_comm());
+        }
+
         if (input.get_local_size() == 0 || output.get_local_size() == 0)
         {
             util::MPIPrintStreamInfo() << "Empty tensor detected";
@@ -297,7 +306,8 @@ public:
             return;
         }
 
-        select_chanfilt_algorithm(input, filter, output);
+        select_chanfilt_algorithm(
+            input, filter, output, strides, pads, num_groups);
 
         m_skip_bp_data = skip_bp_data;
         m_deconv = deconv;
@@ -3009,7 +3019,10 @@ protected:
     void select_chanfilt_algorithm(
         const tensor::Tensor<DataType, LocaleMPI, Allocator>& input,
         const tensor::Tensor<DataType, LocaleMPI, Allocator>& filter,
-        const tensor::Tensor<DataType, LocaleMPI, Allocator>& output)
+        const tensor::Tensor<DataType, LocaleMPI, Allocator>& output,
+        const int_vector& strides,
+        const int_vector& pads,
+        int num_groups)
     {
         if (input.get_distribution().get_split_shape()[-2] == 1)
         {
@@ -3025,8 +3038,44 @@ protected:
         }
         if (m_chanfilt_algo == ChannelParallelismAlgorithm::AUTO)
         {
-            // Force this for now.
-            m_chanfilt_algo = ChannelParallelismAlgorithm::X;
+            const auto& filter_split = filter.get_distribution().get_split_shape();
+            if (filter_split[-2] > 1 && filter_split[-1] > 1)
+            {
+                // Only the stationary-weight algorithm supports filters
+                // partitioned along both channels and filters.
+                m_chanfilt_algo = ChannelParallelismAlgorithm::W;
+                return;
+            }
+            const auto& input_split = input.get_distribution().get_split_shape();
+            const auto& output_split =
+                output.get_distribution().get_split_shape();
+            perf_model::ConvLayer layer;
+            layer.num_samples = input.get_shape()[-1];
+            layer.num_channels = input.get_shape()[-2];
+            layer.num_filters = output.get_shape()[-2];
+            layer.num_groups = num_groups;
+            layer.word_size = sizeof(DataType);
+            perf_model::ConvDecomposition decomp;
+            decomp.p_n = input_split[-1];
+            // The model takes p_c * p_f processes in the channel/filter
+            // group, which the input and output are both split over.
+            decomp.p_f = output_split[-2];
+            decomp.p_c = std::max((int) input_split[-2] / decomp.p_f, 1);
+            for (int i = 0; i < m_num_spatial_dims; ++i)
+            {
+                layer.spatial.push_back(input.get_shape()[i]);
+                layer.filter.push_back(filter.get_shape()[i]);
+                layer.strides.push_back(strides[i]);
+                layer.pads.push_back(pads[i]);
+                decomp.p_s.push_back(input_split[i]);
+            }
+            m_chanfilt_algo = perf_model::select_chanfilt_algorithm(
+                perf_model::get_machine_params(input.get_locale().get_comm()),
+                layer,
+                decomp);
+            util::MPIRootPrintStreamInfo()
+                << "Selected channel/filter parallelism algorithm: "
+                << m_chanfilt_algo;
         }
     }
 
@@ -3157,4 +3206,10 @@ protected:
     }
 };
 
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/instantiation.cpp
+extern template class Convolution<BackendDNNLib, float>;
+extern template class Convolution<BackendDNNLib, double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
 } // namespace distconv
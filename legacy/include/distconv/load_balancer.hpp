@@ -0,0 +1,157 @@
+#pragma once
+
+#include "distconv/tensor/tensor_mpi.hpp"
+
+#include <mpi.h>
+
+#include <vector>
+
+/*
+  Throughput-weighted partitioning of a tensor dimension.
+
+  Distributed dimensions are split evenly by default, which leaves the
+  faster processes waiting when nodes differ in speed. LoadBalancer
+  measures the iteration time of each process over a window of
+  iterations and sizes the splits of one dimension in proportion to
+  their throughput. The new sizes are given to tensors as requested
+  local shapes, and existing tensors are moved to them with
+  CopyByShuffle.
+
+  A new partitioning is adopted only if it is predicted to shorten the
+  iteration time by more than a threshold, so measurement noise does
+  not make the partitioning oscillate.
+ */
+
+namespace distconv {
+
+class LoadBalancer {
+ public:
+  /**
+     @param locale Processes of the tensors to balance.
+     @param dist Distribution of the tensors to balance.
+     @param dim Dimension to partition.
+     @param size Global size of the dimension.
+     @param block_size Split sizes are multiples of this, except for
+     the last split, which also takes the remainder.
+     @param window Number of iterations measured before each
+     rebalancing.
+     @param threshold Minimum relative reduction of the predicted
+     iteration time to change the partitioning.
+   */
+  LoadBalancer(const tensor::LocaleMPI &locale,
+               const tensor::Distribution &dist,
+               int dim, index_t size, index_t block_size=1,
+               int window=10, double threshold=0.1);
+
+  /**
+     Record the time this process spent on one iteration with the
+     current partitioning.
+   */
+  void record(double seconds);
+
+  bool is_window_complete() const {
+    return m_num_samples >= m_window;
+  }
+
+  /**
+     Recompute the partitioning from the measurements of the last
+     window and start a new window. Returns true if the partitioning
+     has changed. Collective once the window is complete, and returns
+     false without communication otherwise.
+   */
+  bool rebalance();
+
+  /**
+     Size of the dimension at each split.
+   */
+  const std::vector<index_t> &get_split_sizes() const {
+    return m_sizes;
+  }
+
+  /**
+     Size of the dimension at the split of this process.
+   */
+  index_t get_local_size() const {
+    return m_sizes[m_split_idx];
+  }
+
+  /**
+     Elements of the dimension processed per second by each split in
+     the last complete window, or empty if there is none.
+   */
+  const std::vector<double> &get_split_throughputs() const {
+    return m_throughputs;
+  }
+
+  /**
+     Requested local shape that gives t the current partitioning.
+   */
+  template <typename TensorType>
+  tensor::Shape get_requested_local_shape(const TensorType &t) const {
+    auto shape = t.get_requested_local_shape();
+    shape[m_dim] = get_local_size();
+    return shape;
+  }
+
+  /**
+     Whether t is partitioned as this object. Local.
+   */
+  template <typename TensorType>
+  bool is_balanced(const TensorType &t) const {
+    const auto &dist = t.get_distribution();
+    const index_t num_ranks_per_split = dist.get_num_ranks_per_split(m_dim);
+    for (size_t i = 0; i < m_sizes.size(); ++i) {
+      if (t.get_remote_dimension(m_dim, i * num_ranks_per_split) !=
+          m_sizes[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+     Move t to the current partitioning. Halo regions are not
+     copied. Collective over the locale of t.
+   */
+  template <typename DataType, typename Allocator,
+            typename StreamType=tensor::DefaultStream>
+  int apply(tensor::Tensor<DataType, tensor::LocaleMPI, Allocator> &t,
+            StreamType stream=tensor::DefaultStream::value) const {
+    using TensorType = tensor::Tensor<DataType, tensor::LocaleMPI, Allocator>;
+    if (is_balanced(t)) return 0;
+    TensorType t_new(t.get_shape(), t.get_locale(), t.get_distribution(),
+                     get_requested_local_shape(t),
+                     t.get_requested_local_block());
+    if (t_new.allocate()) return -1;
+    int ret = tensor::internal::CopyByShuffle(t_new, t, stream);
+    if (ret) return ret;
+    t = t_new;
+    return 0;
+  }
+
+  /**
+     Split size elements into parts proportional to weights. Each part
+     is a multiple of block_size with at least min_blocks blocks, and
+     the last part also takes the remainder of the block size.
+   */
+  static std::vector<index_t> partition(index_t size,
+                                        const std::vector<double> &weights,
+                                        index_t block_size,
+                                        index_t min_blocks=1);
+
+ private:
+  MPI_Comm m_comm;
+  int m_dim;
+  index_t m_size;
+  index_t m_block_size;
+  index_t m_min_blocks;
+  int m_window;
+  double m_threshold;
+  index_t m_split_idx;
+  std::vector<index_t> m_sizes;
+  std::vector<double> m_throughputs;
+  int m_num_samples;
+  double m_elapsed;
+};
+
+} // namespace distconv
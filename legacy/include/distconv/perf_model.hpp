@@ -0,0 +1,129 @@
+#pragma once
+
+#include "distconv/base.hpp"
+
+#include <mpi.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+  Analytic performance model of distributed convolutions.
+
+  Communication follows the alpha-beta model with separate parameters
+  for intra- and inter-node links, and computation is charged gamma
+  seconds per floating-point operation. The parameters are calibrated
+  on the current machine with MPI ping-pongs and a GEMM probe, and are
+  cached on disk so that only the first run pays for calibration.
+ */
+
+namespace distconv {
+namespace perf_model {
+
+struct LinkParams {
+  // Latency in seconds
+  double alpha;
+  // Inverse bandwidth in seconds per byte
+  double beta;
+};
+
+struct MachineParams {
+  LinkParams intra;
+  LinkParams inter;
+  // Seconds per floating-point operation
+  double gamma;
+  int procs_per_node;
+};
+
+std::ostream &operator<<(std::ostream &os, const MachineParams &p);
+
+// Measures the parameters. This is collective over comm.
+MachineParams calibrate(MPI_Comm comm);
+
+// Reads the parameters from the cache if it has an entry for the
+// number of processes per node, and calibrates and updates the cache
+// otherwise. The default path is $DISTCONV_PERF_MODEL_CACHE or
+// $HOME/.distconv_perf_model. This is collective over comm.
+MachineParams load_or_calibrate(MPI_Comm comm,
+                                const std::string &cache_path="");
+
+// Returns the parameters of comm, loaded or calibrated at the first
+// call with comm. They are cached as an attribute of comm and freed
+// with it. This is collective at the first call.
+const MachineParams &get_machine_params(MPI_Comm comm);
+
+/*
+  Shape of a convolution layer. Spatial dimensions are ordered from
+  the innermost one as in tensor shapes.
+ */
+struct ConvLayer {
+  int num_samples;
+  int num_channels;
+  int num_filters;
+  int_vector spatial;
+  int_vector filter;
+  int_vector strides;
+  // Padding of each side. Dimensions without it are not padded.
+  int_vector pads;
+  int num_groups = 1;
+  size_t word_size = sizeof(float);
+
+  int_vector get_output_spatial() const;
+  // Floating-point operations of the forward convolution
+  double get_flops() const;
+};
+
+/*
+  Process decomposition of a convolution layer. Channels and filters
+  are split over p_c and p_f processes with the given algorithm.
+ */
+struct ConvDecomposition {
+  int p_n = 1;
+  int_vector p_s;
+  int p_c = 1;
+  int p_f = 1;
+  ChannelParallelismAlgorithm chanfilt_algo =
+      ChannelParallelismAlgorithm::NONE;
+
+  int get_num_procs() const;
+};
+
+std::ostream &operator<<(std::ostream &os, const ConvDecomposition &d);
+
+// Predicted time in seconds of a forward and backward pass of a layer
+struct LayerTime {
+  double compute = 0;
+  double halo_exchange = 0;
+  double chanfilt = 0;
+  double allreduce = 0;
+
+  double get_total() const {
+    return compute + halo_exchange + chanfilt + allreduce;
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const LayerTime &t);
+
+// Collectives over p processes of the given number of bytes in
+// total. inter_node selects the link parameters.
+double allreduce_time(const MachineParams &m, int p, size_t bytes,
+                      bool inter_node, size_t word_size=sizeof(float));
+double allgather_time(const MachineParams &m, int p, size_t bytes,
+                      bool inter_node);
+double reduce_scatter_time(const MachineParams &m, int p, size_t bytes,
+                           bool inter_node, size_t word_size=sizeof(float));
+double send_recv_time(const MachineParams &m, size_t bytes,
+                      bool inter_node);
+
+LayerTime predict_conv(const MachineParams &m, const ConvLayer &layer,
+                       const ConvDecomposition &d);
+
+// Returns the channel/filter parallelism algorithm with the smallest
+// predicted time, considering only X when spatial halos are required.
+ChannelParallelismAlgorithm select_chanfilt_algorithm(
+    const MachineParams &m, const ConvLayer &layer,
+    const ConvDecomposition &d);
+
+} // namespace perf_model
+} // namespace distconv
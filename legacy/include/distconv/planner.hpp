@@ -0,0 +1,90 @@
+#pragma once
+
+#include "distconv/base.hpp"
+#include "distconv/perf_model.hpp"
+#include "distconv/tensor/distribution.hpp"
+
+#include <iostream>
+#include <vector>
+
+/*
+  Selection of per-layer distributions of a sequence of convolutions.
+
+  Each layer may use any decomposition of the processes over the
+  sample, spatial, channel and filter dimensions. The cost of a
+  decomposition is the time predicted by the performance model, and
+  switching decompositions between consecutive layers additionally
+  costs shuffling the activations and their gradients. The plan with
+  the smallest total time is found by dynamic programming over the
+  layers.
+ */
+
+namespace distconv {
+namespace perf_model {
+
+struct LayerPlan {
+  ConvDecomposition decomp;
+  LayerTime time;
+  // Time to shuffle the input from the output distribution of the
+  // previous layer and the input gradients back
+  double shuffle_time = 0;
+  tensor::Distribution input_dist;
+  tensor::Distribution filter_dist;
+  tensor::Distribution output_dist;
+  tensor::Distribution d_output_dist;
+
+  double get_total() const {
+    return time.get_total() + shuffle_time;
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const LayerPlan &p);
+
+// Returns the decompositions of layer over num_procs processes. Split
+// spatial dimensions must keep local sizes at least as large as the
+// filter so that halos come only from immediate neighbors.
+std::vector<ConvDecomposition> get_decompositions(const ConvLayer &layer,
+                                                  int num_procs);
+
+// Predicted time of shuffling the output of layer from src to dst in
+// forward and of its gradients in backward
+double shuffle_time(const MachineParams &m, const ConvLayer &layer,
+                    const ConvDecomposition &src,
+                    const ConvDecomposition &dst);
+
+// Returns the plan of each layer. The input of each layer must be the
+// output of the previous one.
+std::vector<LayerPlan> plan_convolutions(const MachineParams &m,
+                                         const std::vector<ConvLayer> &layers,
+                                         int num_procs);
+
+// Predicted time of the forward pass of a chain of num_layers layers
+// of the same shape in deep-halo mode, where the input of every depth
+// layers has a halo covering all of them and the borders of the
+// intermediate outputs are computed redundantly. Layers must keep
+// the spatial shape, and depth 1 is the usual per-layer halo
+// exchange.
+LayerTime predict_deep_halo_chain(const MachineParams &m,
+                                  const ConvLayer &layer,
+                                  const ConvDecomposition &d,
+                                  int num_layers, int depth);
+
+// Returns the depth with the smallest predicted time among those
+// whose halos come only from immediate neighbors
+int plan_deep_halo_depth(const MachineParams &m, const ConvLayer &layer,
+                         const ConvDecomposition &d, int num_layers);
+
+// Distributions of the tensors of a layer as created by
+// create_input_tensor, create_filter_tensor,
+// create_convolution_output_tensor and
+// create_convolution_d_output_tensor
+tensor::Distribution make_input_distribution(const ConvLayer &layer,
+                                             const ConvDecomposition &d);
+tensor::Distribution make_filter_distribution(const ConvDecomposition &d);
+tensor::Distribution make_output_distribution(const ConvLayer &layer,
+                                              const ConvDecomposition &d);
+tensor::Distribution make_d_output_distribution(const ConvLayer &layer,
+                                                const ConvDecomposition &d);
+
+} // namespace perf_model
+} // namespace distconv
@@ -2,6 +2,10 @@
 
 #include "distconv/base.hpp"
 #include "distconv/layers.hpp"
+#include "distconv/tensor/halo_exchange_host.hpp"
+
+#include <memory>
+#include <vector>
 
 namespace distconv {
 namespace ref {
@@ -12,8 +16,55 @@ class Backend {
   std::string get_name() const {
     return std::string("Ref");
   }
+  // All computations are synchronous
+  void wait() {}
 };
 
+// Element strides of the local buffer of a tensor
+template <typename Tensor>
+std::vector<long> get_local_strides(const Tensor &t) {
+  const auto real_shape = t.get_local_real_shape();
+  std::vector<long> strides(t.get_num_dims(), 1);
+  for (int i = 1; i < t.get_num_dims(); ++i) {
+    strides[i] = i == 1 ? t.get_pitch() : strides[i - 1] * real_shape[i - 1];
+  }
+  return strides;
+}
+
+// Local offset of the first spatial element of channel c of sample n
+template <typename Tensor>
+index_t get_channel_offset(const Tensor &t, index_t c, index_t n,
+                           bool idx_include_halo=false) {
+  IndexVector idx(t.get_num_dims(), 0);
+  idx[-2] = c;
+  idx[-1] = n;
+  return t.get_local_offset(idx, idx_include_halo);
+}
+
+/*
+  Sweep of dimension dim over the output region [y_begin, y_end) of
+  the local indices of y, which may extend into its halo. Each output
+  element is computed from the filter window of x centered at the same
+  local index, so the halo of x takes the place of the padding, and
+  elements beyond its halo are zero. y_offset is the local index of y
+  at the start of the sweep.
+ */
+template <typename Tensor>
+void get_region_sweep(const Tensor &x, const Tensor &filter, int dim,
+                      const IntVector &y_begin, const IntVector &y_end,
+                      long &padding, index_t &sweep_len, long &y_offset) {
+  assert_always(y_begin[dim] <= y_end[dim]);
+  padding = (long)(filter.get_local_shape()[dim] - 1) / 2
+      - x.get_halo_width(dim) - y_begin[dim];
+  sweep_len = y_end[dim] - y_begin[dim];
+  y_offset = y_begin[dim];
+}
+
+/*
+  Elements are accessed through the strides of the local buffers
+  rather than Tensor::get and Tensor::set, which are too slow for the
+  inner loops.
+ */
 template <typename Tensor>
 void apply4d(typename Tensor::data_type alpha,
              const Tensor &x,
@@ -26,8 +77,9 @@ void apply4d(typename Tensor::data_type alpha,
              index_t y_n, index_t y_k,
              int_vector paddings, // DWH
              int_vector strides, // DWH
-             bool expand_halo) {
-  using Array4 = tensor::Array<4>;
+             bool expand_halo,
+             const IntVector &y_begin, // DWH
+             const IntVector &y_end) { // DWH
   using DataType = typename Tensor::data_type;
   auto shape = expand_halo ? x.get_local_real_shape() :
       x.get_local_shape();
@@ -36,49 +88,50 @@ void apply4d(typename Tensor::data_type alpha,
   auto f_shape = filter.get_local_shape();
   index_t fh_len = f_shape[1];
   index_t fw_len = f_shape[0];
-  const int padding_h = paddings[1];
-  const int padding_w = paddings[0];
+  long padding_h = paddings[1];
+  long padding_w = paddings[0];
   index_t h_sweep_len = h_len + padding_h * 2 - fh_len + 1;
   index_t w_sweep_len = w_len + padding_w * 2 - fw_len + 1;
+  // Offsets of the output indices from the sweep
+  long y_h = 0;
+  long y_w = 0;
+  if (y_begin.length() > 0) {
+    get_region_sweep(x, filter, 1, y_begin, y_end, padding_h,
+                     h_sweep_len, y_h);
+    get_region_sweep(x, filter, 0, y_begin, y_end, padding_w,
+                     w_sweep_len, y_w);
+  }
+  const auto x_st = get_local_strides(x);
+  const auto f_st = get_local_strides(filter);
+  const auto y_st = get_local_strides(y);
+  const DataType *x_buf = x.get_const_buffer()
+      + get_channel_offset(x, x_c, x_n, expand_halo);
+  const DataType *f_buf = filter.get_const_buffer()
+      + get_channel_offset(filter, f_c, f_k);
+  DataType *y_buf = y.get_buffer() + get_channel_offset(y, y_k, y_n);
   for (index_t h = 0; h < h_sweep_len; ++h) {
     for (index_t w = 0; w < w_sweep_len; ++w) {
       DataType acc = 0.0;
       for (index_t i = 0; i < fh_len; ++i) {
         for (index_t j = 0; j < fw_len; ++j) {
-          Array4 x_idx = {w + j, h+ i, x_c, x_n};
-#if 0
-          util::PrintStreamDebug()
-              << "idx: " << idx << "\n";
-#endif
-          DataType xi;
+          const long x_h = (long)(h + i) - padding_h;
+          const long x_w = (long)(w + j) - padding_w;
           // if idx is in the padded area, value of 0 is used
-          if (x_idx[1] < (index_t)padding_h
-              || x_idx[1] >= h_len + padding_h
-              || x_idx[0] < (index_t)padding_w
-              || x_idx[0] >= w_len + padding_w) {
-            xi = 0.0;
-          } else {
-            x_idx[0] -= padding_w;
-            x_idx[1] -= padding_h;
-            xi = x.get(x_idx.get_vector(),
-                       expand_halo);
+          if (x_h < 0 || x_h >= (long)h_len
+              || x_w < 0 || x_w >= (long)w_len) {
+            continue;
           }
+          const DataType xi = x_buf[x_w * x_st[0] + x_h * x_st[1]];
           index_t f_w = rotate ? fw_len - j - 1 : j;
           index_t f_h = rotate ? fh_len - i - 1 : i;
-          IndexVector f_idx({f_w, f_h, f_c, f_k});
-          DataType fi = filter.get(f_idx);
+          const DataType fi = f_buf[f_w * f_st[0] + f_h * f_st[1]];
           acc = acc + xi * fi;
         }
       }
       // save acc to the output tensor
-      IndexVector y_idx({w, h, y_k, y_n});
-      acc = acc * alpha + y.get(y_idx) * beta;
-#if 0
-      util::PrintStreamDebug()
-          << "output at " << y_idx << ": "
-          << acc << "\n";
-#endif
-      y.set(y_idx, acc);
+      DataType &yi = y_buf[((long)w + y_w) * y_st[0]
+                           + ((long)h + y_h) * y_st[1]];
+      yi = acc * alpha + yi * beta;
     }
   }
 }
@@ -95,8 +148,9 @@ void apply5d(typename Tensor::data_type alpha,
              index_t y_n, index_t y_k,
              int_vector paddings, // DWH
              int_vector strides, // DWH
-             bool expand_halo) {
-  using Array5 = tensor::Array<5>;
+             bool expand_halo,
+             const IntVector &y_begin, // DWH
+             const IntVector &y_end) { // DWH
   using DataType = typename Tensor::data_type;
   auto shape = expand_halo ? x.get_local_real_shape() :
       x.get_local_shape();
@@ -107,12 +161,32 @@ void apply5d(typename Tensor::data_type alpha,
   index_t fh_len = f_shape[2];
   index_t fw_len = f_shape[1];
   index_t fd_len = f_shape[0];
-  const int padding_h = paddings[2];
-  const int padding_w = paddings[1];
-  const int padding_d = paddings[0];
+  long padding_h = paddings[2];
+  long padding_w = paddings[1];
+  long padding_d = paddings[0];
   index_t h_sweep_len = h_len + padding_h * 2 - fh_len + 1;
   index_t w_sweep_len = w_len + padding_w * 2 - fw_len + 1;
   index_t d_sweep_len = d_len + padding_d * 2 - fd_len + 1;
+  // Offsets of the output indices from the sweep
+  long y_h = 0;
+  long y_w = 0;
+  long y_d = 0;
+  if (y_begin.length() > 0) {
+    get_region_sweep(x, filter, 2, y_begin, y_end, padding_h,
+                     h_sweep_len, y_h);
+    get_region_sweep(x, filter, 1, y_begin, y_end, padding_w,
+                     w_sweep_len, y_w);
+    get_region_sweep(x, filter, 0, y_begin, y_end, padding_d,
+                     d_sweep_len, y_d);
+  }
+  const auto x_st = get_local_strides(x);
+  const auto f_st = get_local_strides(filter);
+  const auto y_st = get_local_strides(y);
+  const DataType *x_buf = x.get_const_buffer()
+      + get_channel_offset(x, x_c, x_n, expand_halo);
+  const DataType *f_buf = filter.get_const_buffer()
+      + get_channel_offset(filter, f_c, f_k);
+  DataType *y_buf = y.get_buffer() + get_channel_offset(y, y_k, y_n);
 
   for (index_t h = 0; h < h_sweep_len; ++h) {
     for (index_t w = 0; w < w_sweep_len; ++w) {
@@ -121,45 +195,31 @@ void apply5d(typename Tensor::data_type alpha,
         for (index_t i = 0; i < fh_len; ++i) {
           for (index_t j = 0; j < fw_len; ++j) {
             for (index_t k = 0; k < fd_len; ++k) {
-              Array5 x_idx = {d + k, w + j, h + i, x_c, x_n};
-#if 0
-              util::PrintStreamDebug()
-                  << "idx: " << idx << "\n";
-#endif
-              DataType xi;
+              const long x_h = (long)(h + i) - padding_h;
+              const long x_w = (long)(w + j) - padding_w;
+              const long x_d = (long)(d + k) - padding_d;
               // if idx is in the padded area, value of 0 is used
-              if (x_idx[2] < (index_t)padding_h
-                  || x_idx[2] >= h_len + padding_h
-                  || x_idx[1] < (index_t)padding_w
-                  || x_idx[1] >= w_len + padding_w
-                  || x_idx[0] < (index_t)padding_d
-                  || x_idx[0] >= d_len + padding_d) {
-                xi = 0.0;
-              } else {
-                x_idx[0] -= padding_d;
-                x_idx[1] -= padding_w;
-                x_idx[2] -= padding_h;
-                xi = x.get(x_idx.get_vector(),
-                           expand_halo);
+              if (x_h < 0 || x_h >= (long)h_len
+                  || x_w < 0 || x_w >= (long)w_len
+                  || x_d < 0 || x_d >= (long)d_len) {
+                continue;
               }
+              const DataType xi = x_buf[x_d * x_st[0] + x_w * x_st[1]
+                                        + x_h * x_st[2]];
               index_t f_d = rotate ? fd_len - k - 1 : k;
               index_t f_w = rotate ? fw_len - j - 1 : j;
               index_t f_h = rotate ? fh_len - i - 1 : i;
-              IndexVector f_idx({f_d, f_w, f_h, f_c, f_k});
-              DataType fi = filter.get(f_idx);
+              const DataType fi = f_buf[f_d * f_st[0] + f_w * f_st[1]
+                                        + f_h * f_st[2]];
               acc = acc + xi * fi;
             }
           }
         }
         // save acc to the output tensor
-        IndexVector y_idx({d, w, h, y_k, y_n});
-        acc = acc * alpha + y.get(y_idx) * beta;
-#if 0
-        util::PrintStreamDebug()
-            << "output at " << y_idx << ": "
-            << acc << "\n";
-#endif
-        y.set(y_idx, acc);
+        DataType &yi = y_buf[((long)d + y_d) * y_st[0]
+                             + ((long)w + y_w) * y_st[1]
+                             + ((long)h + y_h) * y_st[2]];
+        yi = acc * alpha + yi * beta;
       }
     }
   }
@@ -177,17 +237,21 @@ void apply(typename Tensor::data_type alpha,
            index_t y_n, index_t y_k,
            int_vector paddings, // DWH
            int_vector strides, // DWH
-           bool expand_halo) {
+           bool expand_halo,
+           // Output region in local indices of y. The whole sweep of x
+           // is computed if empty.
+           const IntVector &y_begin=IntVector(), // DWH
+           const IntVector &y_end=IntVector()) { // DWH
   switch (x.get_num_dims()) {
     case 4:
       apply4d(alpha, x, x_n, x_c, filter, f_k, f_c,
               rotate, beta, y, y_n, y_k, paddings, strides,
-              expand_halo);
+              expand_halo, y_begin, y_end);
       break;
     case 5:
       apply5d(alpha, x, x_n, x_c, filter, f_k, f_c,
               rotate, beta, y, y_n, y_k, paddings, strides,
-              expand_halo);
+              expand_halo, y_begin, y_end);
       break;
     default:
       util::PrintStreamError() << "Invalid tensor dimension: "
@@ -200,12 +264,19 @@ void apply(typename Tensor::data_type alpha,
 
 template <typename DataType>
 class Convolution<ref::Backend, DataType> {
+  using HaloExchange = tensor::HaloExchangeHost<DataType>;
  public:
   Convolution(ref::Backend &be,
               int num_dims,
               HaloExchangeMethod m=HaloExchangeMethod::MPI,
               bool overlap_halo_exchange=false,
-              bool enable_profiling=false): m_be(be), m_num_dims(num_dims) {}
+              bool enable_profiling=false): m_be(be), m_num_dims(num_dims) {
+    if (m != HaloExchangeMethod::MPI) {
+      util::MPIRootPrintStreamWarning()
+          << "Reference convolution only supports MPI halo exchange; "
+          << "ignoring " << m;
+    }
+  }
 
   template <typename Tensor>
   void setup(const Tensor &input,
@@ -254,7 +325,9 @@ class Convolution<ref::Backend, DataType> {
       paddings.push_back(p);
       strides.push_back(0);
     }
-    // Note halo exchange not implemented
+    if (!skip_halo_exchange) {
+      exchange_halo(input, m_halo_xch_input);
+    }
     for (index_t n = 0; n < input.get_local_shape()[3]; ++n) {
       for (index_t k = 0; k < output.get_local_shape()[2]; ++k) {
         for (index_t c = 0; c < input.get_local_shape()[2]; ++c) {
@@ -270,20 +343,42 @@ class Convolution<ref::Backend, DataType> {
     return 0;
   }
 
+  // Bias tensors are shared by all processes, so they are indexed by
+  // the global channel.
+  template <typename TensorType>
+  h2::Expected<void> try_apply_bias(
+      typename TensorType::data_type alpha,
+      TensorType &bias,
+      typename TensorType::data_type beta,
+      TensorType &output) {
+    if (H2_UNLIKELY(bias.get_local_size() == 0)) {
+      return H2_UNEXPECTED(InvalidArgument, "Empty bias tensor");
+    }
+    const int channel_dim = get_channel_dim();
+    auto local_shape = output.get_local_shape();
+    IndexVector bias_idx(output.get_num_dims(), 0);
+    for (auto it = local_shape.index_begin();
+         it != local_shape.index_end(); ++it) {
+      bias_idx[channel_dim] = output.get_global_index(
+          channel_dim, (*it)[channel_dim]);
+      output.set(*it, alpha * bias.get(bias_idx) + beta * output.get(*it));
+    }
+    return {};
+  }
+
   template <typename TensorType>
   int apply_bias(
       typename TensorType::data_type alpha,
       TensorType &bias,
       typename TensorType::data_type beta,
       TensorType &output) {
-    util::MPIPrintStreamError() << "Not implemented.\n";
-    return 1;
+    return util::to_status(try_apply_bias(alpha, bias, beta, output));
   }
 
   template <typename Tensor>
   int backward_data_exchange_halo(Tensor &d_output) {
-    util::MPIPrintStreamError() << "Not implemented.\n";
-    return 1;
+    exchange_halo(d_output, m_halo_xch_d_output);
+    return 0;
   }
 
   template <typename Tensor>
@@ -296,8 +391,6 @@ class Convolution<ref::Backend, DataType> {
       bool skip_halo_exchange=false,
       bool skip_chanfilt_comm=false,
       bool dump_profile=false) {
-    // Note halo exchange not implemented
-
     const auto &dist = d_output.get_distribution();
     int_vector paddings, strides;
     for(auto i = 0; i < m_num_dims; i++) {
@@ -307,6 +400,9 @@ class Convolution<ref::Backend, DataType> {
       paddings.push_back(p);
       strides.push_back(0);
     }
+    if (!skip_halo_exchange) {
+      exchange_halo(d_output, m_halo_xch_d_output);
+    }
 
     for (index_t n = 0; n < d_output.get_local_shape()[3]; ++n) {
       for (index_t k = 0; k < d_output.get_local_shape()[2]; ++k) {
@@ -364,6 +460,41 @@ class Convolution<ref::Backend, DataType> {
     return 0;
   }
 
+  template <typename Tensor>
+  h2::Expected<void> try_backward_bias(
+      typename Tensor::data_type alpha,
+      Tensor &d_output,
+      typename Tensor::data_type beta,
+      Tensor &bias_gradient,
+      bool reduce=true) {
+    if (H2_UNLIKELY(bias_gradient.get_local_size() == 0)) {
+      return H2_UNEXPECTED(InvalidArgument, "Empty bias gradient tensor");
+    }
+    const int channel_dim = get_channel_dim();
+    std::vector<DataType> sums(bias_gradient.get_shape()[channel_dim], 0);
+    auto local_shape = d_output.get_local_shape();
+    for (auto it = local_shape.index_begin();
+         it != local_shape.index_end(); ++it) {
+      sums[d_output.get_global_index(channel_dim, (*it)[channel_dim])] +=
+          d_output.get(*it);
+    }
+    IndexVector bias_idx(bias_gradient.get_num_dims(), 0);
+    for (index_t k = 0; k < (index_t)sums.size(); ++k) {
+      bias_idx[channel_dim] = k;
+      bias_gradient.set(bias_idx, alpha * sums[k] +
+                        beta * bias_gradient.get(bias_idx));
+    }
+    if (reduce) {
+      DISTCONV_CHECK_MPI(MPI_Allreduce(
+          MPI_IN_PLACE, bias_gradient.get_buffer(),
+          bias_gradient.get_size(),
+          util::get_mpi_data_type<DataType>(),
+          MPI_SUM, bias_gradient.get_locale().get_comm()));
+    }
+    return {};
+  }
+
+  // No profile is recorded by the reference backend
   template <typename Tensor>
   int backward_bias(
       typename Tensor::data_type alpha,
@@ -371,9 +502,9 @@ class Convolution<ref::Backend, DataType> {
       typename Tensor::data_type beta,
       Tensor &bias_gradient,
       bool reduce=true,
-      bool dump_profile=false) {
-    util::MPIPrintStreamError() << "Not implemented.\n";
-    return 1;
+      bool /*dump_profile*/=false) {
+    return util::to_status(try_backward_bias(alpha, d_output, beta,
+                                             bias_gradient, reduce));
   }
 
   // Wait for asynchronous tasks
@@ -391,11 +522,29 @@ class Convolution<ref::Backend, DataType> {
   ref::Backend m_be;
   int m_num_dims;
   int_vector m_strides;
+  std::unique_ptr<HaloExchange> m_halo_xch_input;
+  std::unique_ptr<HaloExchange> m_halo_xch_d_output;
 
   bool has_halo(const tensor::Distribution &dist, int dim) {
     return dist.is_distributed(dim) && dist.get_overlap(dim);
   }
 
+  // The halo exchange object is created at the first use as the
+  // tensors passed to setup are immutable.
+  template <typename Tensor>
+  void exchange_halo(Tensor &t, std::unique_ptr<HaloExchange> &xch) {
+    if (xch == nullptr) {
+      xch.reset(new HaloExchange(t));
+    }
+    xch->exchange();
+  }
+
 };
 
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/instantiation.cpp
+extern template class Convolution<ref::Backend, float>;
+extern template class Convolution<ref::Backend, double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
 } // namespace distconv
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "distconv/base.hpp"
+#include "distconv/layers.hpp"
+#include "distconv/ref/backend.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <cmath>
+
+namespace distconv {
+
+template <typename DataType>
+class BatchNormalization<ref::Backend, DataType> {
+ public:
+  BatchNormalization(ref::Backend &be,
+                     int num_dims,
+                     DataType decay,
+                     DataType epsilon,
+                     bool global_stats,
+                     BatchnormImpl impl=BatchnormImpl::MPI):
+      m_be(be), m_num_dims(num_dims), m_decay(decay), m_epsilon(epsilon),
+      m_global_stats(global_stats) {
+    if (impl != BatchnormImpl::MPI) {
+      util::MPIRootPrintStreamWarning()
+          << "Reference batchnorm only supports MPI; ignoring " << impl;
+    }
+  }
+
+  template <typename Tensor>
+  int forward_stage1(const Tensor &input, Tensor &mean, Tensor &var,
+                     bool is_training) {
+    set_num_samples(input.get_local_shape()[-1]);
+    if (!is_training) return 0;
+    const index_t num_channels = mean.get_local_size();
+    DataType *sums = mean.get_buffer();
+    DataType *sqsums = var.get_buffer();
+    std::fill(sums, sums + num_channels, DataType(0));
+    std::fill(sqsums, sqsums + num_channels, DataType(0));
+    if (input.get_local_size() == 0) return 0;
+    const auto shape = input.get_local_shape();
+    for (auto it = shape.index_begin(); it != shape.index_end(); ++it) {
+      const DataType x = input.get(*it);
+      const index_t c = (*it)[-2];
+      sums[c] += x;
+      sqsums[c] += x * x;
+    }
+    return 0;
+  }
+
+  template <typename Tensor>
+  int forward_allreduce(Tensor &mean, Tensor &var, bool is_training) {
+    if (!is_training || !m_global_stats) return 0;
+    allreduce(mean, var);
+    return 0;
+  }
+
+  template <typename Tensor>
+  int forward_stage2(const Tensor &input,
+                     Tensor &mean,
+                     Tensor &var,
+                     Tensor &running_mean,
+                     Tensor &running_var,
+                     Tensor &scale,
+                     Tensor &bias,
+                     Tensor &output,
+                     bool is_training) {
+    if (is_training) {
+      auto stat_shape = m_global_stats ?
+          input.get_shape() : input.get_local_shape();
+      // Number of elements per channel. Note that the channel
+      // dimension is assumed to be at the second to last dimension.
+      index_t num_per_sum = stat_shape.get_size() / stat_shape[-2];
+      sums_to_statistics(num_per_sum, mean, var, running_mean, running_var);
+      batch_normalization(input, mean, var, scale, bias, output);
+    } else {
+      batch_normalization(input, running_mean, running_var, scale, bias,
+                          output);
+    }
+    return 0;
+  }
+
+  template <typename Tensor>
+  int forward(const Tensor &input,
+              Tensor &mean,
+              Tensor &var,
+              Tensor &running_mean,
+              Tensor &running_var,
+              Tensor &scale,
+              Tensor &bias,
+              Tensor &output,
+              bool is_training) {
+    forward_stage1(input, mean, var, is_training);
+    forward_allreduce(mean, var, is_training);
+    forward_stage2(input, mean, var, running_mean, running_var,
+                   scale, bias, output, is_training);
+    return 0;
+  }
+
+  template <typename Tensor>
+  int backward_stage1(const Tensor &input,
+                      const Tensor &d_output,
+                      const Tensor &mean,
+                      const Tensor &var,
+                      const Tensor &scale,
+                      Tensor &scale_gradient,
+                      Tensor &bias_gradient,
+                      Tensor &mean_gradient,
+                      Tensor &var_gradient) {
+    set_num_samples(input.get_local_shape()[-1]);
+    const index_t num_channels = mean.get_local_size();
+    DataType *dscale = scale_gradient.get_buffer();
+    DataType *dbias = bias_gradient.get_buffer();
+    DataType *dmean = mean_gradient.get_buffer();
+    DataType *dvar = var_gradient.get_buffer();
+    std::fill(dscale, dscale + num_channels, DataType(0));
+    std::fill(dbias, dbias + num_channels, DataType(0));
+    std::fill(dmean, dmean + num_channels, DataType(0));
+    std::fill(dvar, dvar + num_channels, DataType(0));
+    if (input.get_local_size() == 0) return 0;
+    const auto shape = input.get_local_shape();
+    for (auto it = shape.index_begin(); it != shape.index_end(); ++it) {
+      const index_t c = (*it)[-2];
+      const DataType inv_stdev = 1 / std::sqrt(var.get_buffer()[c] + m_epsilon);
+      const DataType dvar_factor = inv_stdev * inv_stdev * inv_stdev / 2;
+      const DataType x = input.get(*it);
+      const DataType xhat = (x - mean.get_buffer()[c]) * inv_stdev;
+      const DataType dy = d_output.get(*it);
+      const DataType dxhat = dy * scale.get_buffer()[c];
+      dscale[c] += dy * xhat;
+      dbias[c] += dy;
+      dmean[c] -= dxhat * inv_stdev;
+      dvar[c] -= dxhat * (x - mean.get_buffer()[c]) * dvar_factor;
+    }
+    return 0;
+  }
+
+  template <typename Tensor>
+  int backward_allreduce(Tensor &scale_gradient,
+                         Tensor &bias_gradient,
+                         Tensor &mean_gradient,
+                         Tensor &var_gradient,
+                         bool skip_weights=false) {
+    if (!m_global_stats) return 0;
+    allreduce(mean_gradient, var_gradient);
+    if (!skip_weights) {
+      allreduce(scale_gradient, bias_gradient);
+    }
+    return 0;
+  }
+
+  template <typename Tensor>
+  int backward_stage2(const Tensor &input,
+                      const Tensor &d_output,
+                      const Tensor &mean,
+                      const Tensor &var,
+                      const Tensor &scale,
+                      const Tensor &mean_gradient,
+                      const Tensor &var_gradient,
+                      Tensor &d_input) {
+    if (input.get_local_size() == 0) return 0;
+    auto stat_shape = m_global_stats ?
+        input.get_shape() : input.get_local_shape();
+    index_t num_per_sum = stat_shape.get_size() / stat_shape[-2];
+    const auto shape = input.get_local_shape();
+    for (auto it = shape.index_begin(); it != shape.index_end(); ++it) {
+      const index_t c = (*it)[-2];
+      const DataType inv_stdev = 1 / std::sqrt(var.get_buffer()[c] + m_epsilon);
+      const DataType dmean_term = mean_gradient.get_buffer()[c] / num_per_sum;
+      const DataType dvar_term =
+          var_gradient.get_buffer()[c] * 2 / (num_per_sum - 1);
+      const DataType x = input.get(*it);
+      const DataType dy = d_output.get(*it);
+      DataType dx = dy * scale.get_buffer()[c] * inv_stdev;
+      dx += dmean_term;
+      dx += dvar_term * (x - mean.get_buffer()[c]);
+      d_input.set(*it, dx);
+    }
+    return 0;
+  }
+
+  template <typename Tensor>
+  int backward(const Tensor &input,
+               const Tensor &d_output,
+               const Tensor &mean,
+               const Tensor &var,
+               const Tensor &scale,
+               Tensor &scale_gradient,
+               Tensor &bias_gradient,
+               Tensor &mean_gradient,
+               Tensor &var_gradient,
+               Tensor &d_input) {
+    backward_stage1(input, d_output, mean, var, scale, scale_gradient,
+                    bias_gradient, mean_gradient, var_gradient);
+    backward_allreduce(scale_gradient, bias_gradient, mean_gradient,
+                       var_gradient);
+    backward_stage2(input, d_output, mean, var, scale, mean_gradient,
+                    var_gradient, d_input);
+    return 0;
+  }
+
+  // n: the number of the current local minibatch samples
+  void set_num_samples(int n) {
+    if (n != m_num_current_samples) {
+      util::MPIPrintStreamDebug() << "Changing number of samples to " << n;
+    }
+    m_num_current_samples = n;
+  }
+
+ protected:
+  ref::Backend &m_be;
+  int m_num_dims;
+  DataType m_decay;
+  DataType m_epsilon;
+  int m_num_current_samples = 0;
+  bool m_global_stats;
+
+  // Allreduces two per-channel tensors at once if they are adjacent
+  // in memory, e.g., views of a single tensor.
+  template <typename Tensor>
+  void allreduce(Tensor &x, Tensor &y) {
+    MPI_Comm comm = x.get_locale().get_comm();
+    auto x_ptr = x.get_buffer();
+    auto y_ptr = y.get_buffer();
+    const int count = x.get_local_pitched_size();
+    assert_eq(count, (int)y.get_local_pitched_size());
+    const auto type = util::get_mpi_data_type<DataType>();
+    if (x_ptr + count == y_ptr) {
+      DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, x_ptr, count * 2, type,
+                                       MPI_SUM, comm));
+    } else if (y_ptr + count == x_ptr) {
+      DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, y_ptr, count * 2, type,
+                                       MPI_SUM, comm));
+    } else {
+      DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, x_ptr, count, type,
+                                       MPI_SUM, comm));
+      DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, y_ptr, count, type,
+                                       MPI_SUM, comm));
+    }
+  }
+
+  template <typename Tensor>
+  void sums_to_statistics(index_t num_per_sum,
+                          Tensor &mean,
+                          Tensor &var,
+                          Tensor &running_mean,
+                          Tensor &running_var) {
+    const index_t num_channels = mean.get_local_size();
+    for (index_t c = 0; c < num_channels; ++c) {
+      DataType &global_mean = mean.get_buffer()[c];
+      DataType &global_var = var.get_buffer()[c];
+      if (num_per_sum == 0) {
+        // Fill global_var with 1. Do the same thing as the
+        // corresponding LBANN code.
+        global_var = DataType(1);
+        continue;
+      }
+      const DataType m = global_mean / num_per_sum;
+      const DataType sqmean = global_var / num_per_sum;
+      DataType v = sqmean - m * m;
+      v = v > DataType(0) ? v : DataType(0);
+      v *= num_per_sum / (num_per_sum - DataType(1));
+      global_mean = m;
+      global_var = v;
+      DataType &rm = running_mean.get_buffer()[c];
+      DataType &rv = running_var.get_buffer()[c];
+      rm = m_decay * rm + (DataType(1) - m_decay) * m;
+      rv = m_decay * rv + (DataType(1) - m_decay) * v;
+    }
+  }
+
+  template <typename Tensor>
+  void batch_normalization(const Tensor &input,
+                           const Tensor &mean,
+                           const Tensor &var,
+                           const Tensor &scale,
+                           const Tensor &bias,
+                           Tensor &output) {
+    if (input.get_local_size() == 0) return;
+    const auto shape = input.get_local_shape();
+    for (auto it = shape.index_begin(); it != shape.index_end(); ++it) {
+      const index_t c = (*it)[-2];
+      const DataType inv_stdev = 1 / std::sqrt(var.get_buffer()[c] + m_epsilon);
+      const DataType xhat = (input.get(*it) - mean.get_buffer()[c]) * inv_stdev;
+      output.set(*it, scale.get_buffer()[c] * xhat + bias.get_buffer()[c]);
+    }
+  }
+};
+
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/instantiation.cpp
+extern template class BatchNormalization<ref::Backend, float>;
+extern template class BatchNormalization<ref::Backend, double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
+} // namespace distconv
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "distconv/base.hpp"
+#include "distconv/layers.hpp"
+#include "distconv/ref/backend.hpp"
+#include "distconv/tensor/halo_exchange_host.hpp"
+
+#include <limits>
+#include <memory>
+
+namespace distconv {
+
+template <typename DataType>
+class Pooling<ref::Backend, DataType> {
+  using HaloExchange = tensor::HaloExchangeHost<DataType>;
+ public:
+  Pooling(ref::Backend &be, int num_dims,
+          HaloExchangeMethod method=HaloExchangeMethod::MPI):
+      m_be(be), m_num_dims(num_dims), m_num_spatial_dims(num_dims - 2) {
+    if (method != HaloExchangeMethod::MPI) {
+      util::MPIRootPrintStreamWarning()
+          << "Reference pooling only supports MPI halo exchange; "
+          << "ignoring " << method;
+    }
+  }
+
+  template <typename Tensor>
+  void setup(Tensor &input,
+             Tensor &output,
+             Tensor &d_input,
+             Tensor &d_output,
+             int_vector windows,
+             int_vector pads,
+             int_vector strides,
+             const std::string &mode) {
+    assert_eq((unsigned int)m_num_spatial_dims, windows.size());
+    assert_eq((unsigned int)m_num_spatial_dims, pads.size());
+    assert_eq((unsigned int)m_num_spatial_dims, strides.size());
+    assert_eq(input.get_distribution(), d_input.get_distribution());
+    if (mode != "MAX" && mode != "AVERAGE" && mode != "AVERAGE_NO_PAD") {
+      util::PrintStreamError()
+          << "No matching pooling mode found for Ref: " << mode;
+      std::abort();
+    }
+    m_windows = windows;
+    m_pads = pads;
+    m_strides = strides;
+    m_mode = mode;
+    m_halo_xch_input.reset(new HaloExchange(input));
+    m_halo_xch_d_input.reset(new HaloExchange(d_input));
+  }
+
+  template <typename Tensor>
+  int forward(typename Tensor::data_type alpha,
+              Tensor &input,
+              typename Tensor::data_type beta,
+              Tensor &output,
+              bool const training=true) {
+    // Halo exchange is required even when the local output is empty
+    // as adjacent processes may need the local data.
+    m_halo_xch_input->exchange();
+    if (output.get_local_size() == 0) {
+      return 0;
+    }
+    const auto out_shape = output.get_local_shape();
+    const index_t num_elms = out_shape.get_size();
+#pragma omp parallel for
+    for (index_t i = 0; i < num_elms; ++i) {
+      const auto out_idx = out_shape.get_index(i);
+      DataType v = m_mode == "MAX" ?
+          std::numeric_limits<DataType>::lowest() : DataType(0);
+      int count = 0;
+      traverse_window(input, output.get_global_index(out_idx),
+                      [&](index_t offset) {
+                        const DataType x = input.get_const_buffer()[offset];
+                        v = m_mode == "MAX" ? std::max(v, x) : v + x;
+                        ++count;
+                      });
+      if (m_mode == "AVERAGE") {
+        v /= get_window_size();
+      } else if (m_mode == "AVERAGE_NO_PAD") {
+        v /= count;
+      }
+      const auto out_offset = output.get_local_offset(out_idx);
+      DataType &y = output.get_buffer()[out_offset];
+      y = alpha * v + (beta == DataType(0) ? DataType(0) : beta * y);
+    }
+    return 0;
+  }
+
+  template <typename Tensor>
+  int backward(typename Tensor::data_type alpha,
+               const Tensor &output,
+               const Tensor &d_output,
+               const Tensor &input,
+               typename Tensor::data_type beta,
+               Tensor &d_input) {
+    if (d_input.get_local_size() == 0) {
+      return 0;
+    }
+    // Gradients are accumulated to the halo region as well, which
+    // is then reduced to the owners of the region.
+    scale_and_clear_halo(d_input, beta);
+    if (d_output.get_local_size() > 0) {
+      const auto out_shape = d_output.get_local_shape();
+      for (auto it = out_shape.index_begin(); it != out_shape.index_end();
+           ++it) {
+        const auto g_idx = d_output.get_global_index(*it);
+        const DataType dy = alpha * d_output.get(*it);
+        if (m_mode == "MAX") {
+          // The gradient goes to the first maximum element in the
+          // window. It is located from the input rather than the
+          // output so that stale outputs do not cause a mismatch.
+          index_t max_offset = 0;
+          bool found = false;
+          traverse_window(input, g_idx, [&](index_t offset) {
+              if (!found || input.get_const_buffer()[offset] >
+                  input.get_const_buffer()[max_offset]) {
+                max_offset = offset;
+                found = true;
+              }
+            });
+          if (found) {
+            d_input.get_buffer()[max_offset] += dy;
+          }
+        } else {
+          int count = 0;
+          traverse_window(input, g_idx, [&](index_t) { ++count; });
+          const DataType dx = dy / (m_mode == "AVERAGE" ?
+                                    get_window_size() : count);
+          traverse_window(input, g_idx, [&](index_t offset) {
+              d_input.get_buffer()[offset] += dx;
+            });
+        }
+      }
+    }
+    m_halo_xch_d_input->exchange(true, tensor::HaloExchangeAccumOp::SUM);
+    return 0;
+  }
+
+  void set_num_samples(int n) {}
+
+  // Wait for asynchronous tasks
+  void wait() {}
+
+ private:
+  ref::Backend &m_be;
+  const int m_num_dims;
+  const int m_num_spatial_dims;
+  int_vector m_windows;
+  int_vector m_pads;
+  int_vector m_strides;
+  std::string m_mode;
+  std::unique_ptr<HaloExchange> m_halo_xch_input;
+  std::unique_ptr<HaloExchange> m_halo_xch_d_input;
+
+  int get_window_size() const {
+    int s = 1;
+    for (auto w: m_windows) s *= w;
+    return s;
+  }
+
+  /*
+    Calls f with the local offset of each input element in the window
+    of the output element at global index out_idx. Elements in the
+    padding region are skipped. The offset may point to the halo
+    region of the input tensor.
+   */
+  template <typename Tensor, typename F>
+  void traverse_window(const Tensor &input, const IndexVector &out_idx,
+                       F &&f) const {
+    const auto &global_shape = input.get_shape();
+    const auto base = input.get_global_index();
+    const int window_size = get_window_size();
+    for (int w = 0; w < window_size; ++w) {
+      IndexVector local_idx(m_num_dims, 0);
+      bool in_padding = false;
+      int wi = w;
+      for (int i = 0; i < m_num_dims; ++i) {
+        long g = out_idx[i];
+        if (i < m_num_spatial_dims) {
+          g = g * m_strides[i] - m_pads[i] + wi % m_windows[i];
+          wi /= m_windows[i];
+        }
+        if (g < 0 || g >= (long)global_shape[i]) {
+          in_padding = true;
+          break;
+        }
+        local_idx[i] = g - base[i] + input.get_halo_width(i);
+      }
+      if (in_padding) continue;
+      f(input.get_local_offset(local_idx, true));
+    }
+  }
+
+  template <typename Tensor>
+  void scale_and_clear_halo(Tensor &t, typename Tensor::data_type beta) {
+    const auto real_shape = t.get_local_real_shape();
+    const auto &halo = t.get_halo_width();
+    for (auto it = real_shape.index_begin(); it != real_shape.index_end();
+         ++it) {
+      bool is_halo = false;
+      for (int i = 0; i < m_num_dims; ++i) {
+        is_halo |= (*it)[i] < (index_t)halo[i] ||
+            (*it)[i] >= real_shape[i] - halo[i];
+      }
+      DataType &x = t.get_buffer()[t.get_local_offset(*it, true)];
+      x = (is_halo || beta == DataType(0)) ? DataType(0) : beta * x;
+    }
+  }
+};
+
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/instantiation.cpp
+extern template class Pooling<ref::Backend, float>;
+extern template class Pooling<ref::Backend, double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
+} // namespace distconv
@@ -91,6 +91,23 @@ class Distribution {
     return make_overlapped_distribution(Shape(locale_shape), IntVector(overlap));
   }
 
+  // Blocks of block_size[i] elements are dealt round-robin to the
+  // splits of dimension i. A zero block size keeps the dimension
+  // block-partitioned.
+  static Distribution make_block_cyclic_distribution(
+      const Shape &locale_shape, const Shape &block_size) {
+    int nd = locale_shape.num_dims();
+    return Distribution(locale_shape, locale_shape, IntVector(nd, 0),
+                        block_size);
+  }
+
+  static Distribution make_block_cyclic_distribution(
+      std::initializer_list<int> locale_shape,
+      std::initializer_list<int> block_size) {
+    return make_block_cyclic_distribution(Shape(locale_shape),
+                                          Shape(block_size));
+  }
+
   int num_dims() const {
     return m_locale_shape.num_dims();
   }
@@ -174,6 +191,62 @@ class Distribution {
     return m_block_size[dim];
   }
 
+  void set_block_size(const Shape &block_size) {
+    m_block_size = block_size;
+    sanity_check_shapes();
+  }
+
+  bool is_cyclic(int dim) const {
+    return is_distributed(dim) && get_block_size(dim) > 0;
+  }
+
+  bool is_cyclic() const {
+    for (int i = 0; i < num_dims(); ++i) {
+      if (is_cyclic(i)) return true;
+    }
+    return false;
+  }
+
+  // Index arithmetic of block-cyclic dimensions. Splits are numbered
+  // along the dimension, and local indices of a split are ordered
+  // the same way as their global indices.
+
+  // Returns the split that owns global_idx.
+  index_t get_cyclic_owner(int dim, index_t global_idx) const {
+    return (global_idx / get_block_size(dim)) % m_split_shape[dim];
+  }
+
+  // Returns the local index of global_idx within its owner.
+  index_t get_cyclic_local_index(int dim, index_t global_idx) const {
+    const index_t bsize = get_block_size(dim);
+    return global_idx / (bsize * m_split_shape[dim]) * bsize
+        + global_idx % bsize;
+  }
+
+  // Returns the global index of local_idx at split split_idx.
+  index_t get_cyclic_global_index(int dim, index_t split_idx,
+                                  index_t local_idx) const {
+    const index_t bsize = get_block_size(dim);
+    return (local_idx / bsize * m_split_shape[dim] + split_idx) * bsize
+        + local_idx % bsize;
+  }
+
+  // Returns the number of elements split_idx owns out of dim_size.
+  index_t get_cyclic_local_size(int dim, index_t dim_size,
+                                index_t split_idx) const {
+    const index_t bsize = get_block_size(dim);
+    const index_t num_splits = m_split_shape[dim];
+    const index_t num_full_blocks = dim_size / bsize;
+    const index_t last_owner = num_full_blocks % num_splits;
+    index_t size = (num_full_blocks / num_splits
+                    + (split_idx < last_owner ? 1 : 0)) * bsize;
+    // The trailing partial block goes to the next split in turn.
+    if (split_idx == last_owner) {
+      size += dim_size % bsize;
+    }
+    return size;
+  }
+
   void set_overlap(int dim, int o) {
     m_overlap[dim] = o;
     return;
@@ -263,6 +336,9 @@ class Distribution {
       }
       ss << m_split_shape[i] << "/" << m_locale_shape[i]
          << ":" << m_overlap[i];
+      if (is_cyclic(i)) {
+        ss << "@" << m_block_size[i];
+      }
     }
     ss << ")";
     return os << ss.str();
@@ -0,0 +1,338 @@
+#pragma once
+
+#include "distconv/base.hpp"
+#include "distconv/tensor/halo_exchange.hpp"
+#include "distconv/tensor/memory.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace distconv {
+namespace tensor {
+
+// Host halo exchanges communicate with plain MPI on the communicator
+// of the tensor. This stands in for the Aluminum backend parameter.
+struct HostMPIBackend {};
+
+namespace internal {
+
+template <typename DataType>
+inline void accumulate_halo(DataType *dst, const DataType *src, index_t len,
+                            HaloExchangeAccumOp op) {
+  switch (op) {
+    case HaloExchangeAccumOp::ID:
+      std::memcpy(dst, src, len * sizeof(DataType));
+      break;
+    case HaloExchangeAccumOp::SUM:
+      for (index_t i = 0; i < len; ++i) dst[i] += src[i];
+      break;
+    case HaloExchangeAccumOp::MAX:
+      for (index_t i = 0; i < len; ++i) dst[i] = std::max(dst[i], src[i]);
+      break;
+    case HaloExchangeAccumOp::MIN:
+      for (index_t i = 0; i < len; ++i) dst[i] = std::min(dst[i], src[i]);
+      break;
+    default:
+      assert_always(0 && "Unknown accumulation op type");
+  }
+}
+
+} // namespace internal
+
+template <typename DataType, typename AlBackend>
+class HaloExchange<DataType, BaseAllocator, AlBackend> {
+ public:
+  using TensorType = Tensor<DataType, LocaleMPI, BaseAllocator>;
+
+  HaloExchange(TensorType &tensor): m_tensor(tensor), m_peers(-1) {
+    bool exchange_req = false;
+    for (int i = 0; i < tensor.get_num_dims(); ++i) {
+      exchange_req |= is_exchange_required(i);
+    }
+    if (exchange_req) {
+      // Does not work for shared tensors yet
+      assert_always(!tensor.get_distribution().is_shared());
+      set_peer_ranks();
+    }
+  }
+
+  HaloExchange(const HaloExchange &x): HaloExchange(x.m_tensor) {
+    m_peers = x.m_peers;
+  }
+
+  virtual ~HaloExchange() {}
+
+  /*
+    Exchanges halos of all dimensions one after another. As each
+    halo includes the halo regions of the preceding dimensions,
+    corner and edge regions are transferred as well.
+
+    is_reverse: send the halo regions to the owners of the
+    corresponding interior regions, e.g., to accumulate partial
+    gradients with HaloExchangeAccumOp::SUM.
+   */
+  virtual void exchange(const IntVector &widths_rhs_send,
+                        const IntVector &widths_rhs_recv,
+                        const IntVector &widths_lhs_send,
+                        const IntVector &widths_lhs_recv,
+                        bool is_reverse,
+                        HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) {
+    for (int i = 0; i < m_tensor.get_num_dims(); ++i) {
+      exchange(i, widths_rhs_send[i], widths_rhs_recv[i],
+               widths_lhs_send[i], widths_lhs_recv[i],
+               is_reverse, op);
+    }
+  }
+
+  virtual void exchange(bool is_reverse=false,
+                        HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) {
+    exchange(m_tensor.get_halo_width(), m_tensor.get_halo_width(),
+             m_tensor.get_halo_width(), m_tensor.get_halo_width(),
+             is_reverse, op);
+  }
+
+  virtual void exchange(int dim,
+                        int width_rhs_send, int width_rhs_recv,
+                        int width_lhs_send, int width_lhs_recv,
+                        bool is_reverse,
+                        HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) {
+    const int tag = 0;
+
+    if (!is_exchange_required(dim, width_rhs_send, width_rhs_recv,
+                              width_lhs_send, width_lhs_recv)) {
+      return;
+    }
+    // Block-cyclic dimensions have no halo regions. Exchanges along
+    // the other dimensions work as is since neighbors hold the same
+    // blocks.
+    assert_always(!m_tensor.get_distribution().is_cyclic(dim));
+
+    MPI_Comm comm = m_tensor.get_locale().get_comm();
+    MPI_Request send_req[2];
+    MPI_Request recv_req[2];
+    int num_send_requests = 0;
+    int num_recv_requests = 0;
+    ensure_halo_buffers(dim);
+
+    for (auto side: SIDES) {
+      if (get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int width_recv = side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      if (width_recv > 0) {
+        size_t halo_bytes = get_halo_size(dim, width_recv) * sizeof(DataType);
+        DISTCONV_CHECK_MPI(MPI_Irecv(
+            get_recv_buffer(dim, side), halo_bytes, MPI_BYTE,
+            get_peer(dim, side), tag, comm, &recv_req[num_recv_requests]));
+        ++num_recv_requests;
+      }
+    }
+
+    for (auto side: SIDES) {
+      if (get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int width_send = side == Side::RHS
+          ? width_rhs_send : width_lhs_send;
+      if (width_send > 0) {
+        pack_dim(dim, side, width_send, get_send_buffer(dim, side),
+                 is_reverse);
+        size_t halo_bytes = get_halo_size(dim, width_send) * sizeof(DataType);
+        DISTCONV_CHECK_MPI(MPI_Isend(
+            get_send_buffer(dim, side), halo_bytes, MPI_BYTE,
+            get_peer(dim, side), tag, comm, &send_req[num_send_requests]));
+        ++num_send_requests;
+      }
+    }
+
+    if (num_recv_requests > 0) {
+      DISTCONV_CHECK_MPI(MPI_Waitall(
+          num_recv_requests, recv_req, MPI_STATUSES_IGNORE));
+    }
+
+    unpack(dim, width_rhs_recv, width_lhs_recv, is_reverse, op);
+
+    if (num_send_requests > 0) {
+      DISTCONV_CHECK_MPI(MPI_Waitall(
+          num_send_requests, send_req, MPI_STATUSES_IGNORE));
+    }
+  }
+
+ protected:
+  TensorType &m_tensor;
+  BoundaryAttributesV<Memory<BaseAllocator>> m_halo_send;
+  BoundaryAttributesV<Memory<BaseAllocator>> m_halo_recv;
+  BoundaryAttributesV<int> m_peers;
+
+  int &get_peer(int dim, Side side) {
+    return m_peers(dim, side);
+  }
+
+  size_t get_halo_size(int dim, int width) const {
+    auto local_real_shape = m_tensor.get_local_real_shape();
+    local_real_shape[dim] = width;
+    return local_real_shape.get_size();
+  }
+
+  size_t get_halo_size(int dim) const {
+    return get_halo_size(dim, m_tensor.get_halo_width(dim));
+  }
+
+  void *get_send_buffer(int dim, Side side) {
+    return m_halo_send(dim, side).get();
+  }
+
+  void *get_recv_buffer(int dim, Side side) {
+    return m_halo_recv(dim, side).get();
+  }
+
+  void ensure_halo_buffers(int dim) {
+    size_t s = get_halo_size(dim) * sizeof(DataType);
+    assert_always(s > 0);
+    for (auto side: SIDES) {
+      if (get_peer(dim, side) == MPI_PROC_NULL) continue;
+      if (m_halo_send(dim, side).is_null()) {
+        m_halo_send(dim, side).allocate(s);
+        std::memset(m_halo_send(dim, side).get(), 0, s);
+      }
+      if (m_halo_recv(dim, side).is_null()) {
+        m_halo_recv(dim, side).allocate(s);
+        std::memset(m_halo_recv(dim, side).get(), 0, s);
+      }
+    }
+  }
+
+  bool is_exchange_required(int dim,
+                            int width_rhs_send, int width_rhs_recv,
+                            int width_lhs_send, int width_lhs_recv) const {
+    const auto &dist = m_tensor.get_distribution();
+    return dist.is_distributed(dim) &&
+        dist.get_split_shape()[dim] > 1 &&
+        (width_rhs_send > 0 || width_rhs_recv > 0 ||
+         width_lhs_send > 0 || width_lhs_recv > 0) &&
+        (m_tensor.get_local_size() > 0);
+  }
+
+  bool is_exchange_required(int dim) const {
+    int halo_width = m_tensor.get_halo_width(dim);
+    return is_exchange_required(dim, halo_width, halo_width,
+                                halo_width, halo_width);
+  }
+
+  int find_peer_rank(int dim, Side side) const {
+    if (!is_exchange_required(dim)) {
+      return MPI_PROC_NULL;
+    }
+
+    const auto &locale_shape = m_tensor.get_distribution().get_locale_shape();
+    auto proc_idx = m_tensor.get_proc_index();
+    int peer_dim_idx = proc_idx[dim] + (side == Side::RHS ? 1 : -1);
+
+    // processes located at either edge
+    if (peer_dim_idx < 0 || peer_dim_idx >= (int)locale_shape[dim]) {
+      return MPI_PROC_NULL;
+    }
+
+    // if the next tensor size is empty, do not send
+    if (m_tensor.get_dimension_rank_offset(dim, peer_dim_idx)
+        == m_tensor.get_shape()[dim]) {
+      return MPI_PROC_NULL;
+    }
+
+    proc_idx[dim] = peer_dim_idx;
+    return get_offset(proc_idx, locale_shape);
+  }
+
+  void set_peer_ranks() {
+    apply_to_sides(m_tensor.get_num_dims(), [&](int dim, Side side) {
+        get_peer(dim, side) = find_peer_rank(dim, side);
+      });
+  }
+
+  // Returns the first index of the halo region of the given width at
+  // the given side, where inner designates the interior region that
+  // is sent to the peer in a forward exchange.
+  index_t get_halo_begin(int dim, Side side, int width, bool inner) const {
+    const index_t halo = m_tensor.get_halo_width(dim);
+    const index_t len = m_tensor.get_local_shape()[dim];
+    if (side == Side::RHS) {
+      return inner ? halo + len - width : halo + len;
+    } else {
+      return inner ? halo : halo - width;
+    }
+  }
+
+  /*
+    Copies the region between the tensor and a contiguous buffer.
+    The region is traversed as rows along the innermost dimension,
+    which are contiguous both in the tensor and in the buffer.
+   */
+  void pack_or_unpack(int dim, Side side, int width, void *buf,
+                      bool is_pack, bool is_reverse,
+                      HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) {
+    if (width == 0) return;
+    const bool inner = (is_pack && !is_reverse) || (!is_pack && is_reverse);
+    const int num_dims = m_tensor.get_num_dims();
+    const auto real_shape = m_tensor.get_local_real_shape();
+    auto region_shape = real_shape;
+    region_shape[dim] = width;
+    IndexVector region_offset(num_dims, 0);
+    region_offset[dim] = get_halo_begin(dim, side, width, inner);
+
+    const index_t row_len = region_shape[0];
+    const index_t num_rows = region_shape.get_size() / row_len;
+    const index_t pitch = m_tensor.get_pitch();
+    DataType *tensor_buf = m_tensor.get_buffer();
+    DataType *halo_buf = static_cast<DataType*>(buf);
+
+#pragma omp parallel for
+    for (index_t row = 0; row < num_rows; ++row) {
+      IndexVector idx(region_offset);
+      index_t r = row;
+      for (int i = 1; i < num_dims; ++i) {
+        idx[i] += r % region_shape[i];
+        r /= region_shape[i];
+      }
+      DataType *t = tensor_buf + get_offset(idx, real_shape, pitch);
+      DataType *h = halo_buf + row * row_len;
+      if (is_pack) {
+        std::memcpy(h, t, row_len * sizeof(DataType));
+      } else {
+        internal::accumulate_halo(t, h, row_len, op);
+      }
+    }
+  }
+
+  void pack_dim(int dim, Side side, int width, void *buf, bool is_reverse) {
+    pack_or_unpack(dim, side, width, buf, true, is_reverse);
+  }
+
+  void unpack_dim(int dim, Side side, int width, void *buf, bool is_reverse,
+                  HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) {
+    pack_or_unpack(dim, side, width, buf, false, is_reverse, op);
+  }
+
+  void unpack(int dim, int width_rhs_recv, int width_lhs_recv,
+              bool is_reverse,
+              HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) {
+    for (auto side: SIDES) {
+      if (get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int width_recv = side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      if (width_recv == 0) continue;
+      unpack_dim(dim, side, width_recv, get_recv_buffer(dim, side),
+                 is_reverse, op);
+    }
+  }
+};
+
+template <typename DataType>
+using HaloExchangeHost = HaloExchange<DataType, BaseAllocator, HostMPIBackend>;
+
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class HaloExchange<float, BaseAllocator, HostMPIBackend>;
+extern template class HaloExchange<double, BaseAllocator, HostMPIBackend>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
+} // namespace tensor
+} // namespace distconv
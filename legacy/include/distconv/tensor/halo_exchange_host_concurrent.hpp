@@ -0,0 +1,445 @@
+#pragma once
+
+#include "distconv/tensor/halo_exchange_host.hpp"
+
+#include <vector>
+
+namespace distconv {
+namespace tensor {
+
+/*
+  Exchanges the halos of all dimensions in a single round. Instead of
+  relaying edge and corner regions through successive per-dimension
+  exchanges, each process posts the messages of all its face, edge
+  and corner neighbors, i.e., up to 3^ND - 1 of them, at once with
+  nonblocking point-to-point MPI. The latency of an exchange is thus
+  that of one message rather than one per dimension. Exchanges of the
+  full halo widths reuse persistent requests.
+
+  Halo regions filled by the per-dimension exchange are filled with
+  the same values. Regions outside the global tensor, which the
+  per-dimension exchange fills with the halos of neighbors, are left
+  unchanged, and reverse exchanges only update the interior regions.
+
+  The per-dimension exchange is still available and works as in
+  HaloExchangeHost.
+ */
+template <typename DataType>
+class HaloExchangeHostConcurrent: public HaloExchangeHost<DataType> {
+  using TensorType = typename HaloExchangeHost<DataType>::TensorType;
+ public:
+  HaloExchangeHostConcurrent(TensorType &tensor):
+      HaloExchangeHost<DataType>(tensor) {
+    set_neighbors();
+  }
+  // Requests are not shared with x
+  HaloExchangeHostConcurrent(const HaloExchangeHostConcurrent &x):
+      HaloExchangeHost<DataType>(x) {
+    set_neighbors();
+  }
+
+  virtual ~HaloExchangeHostConcurrent() {
+    for (auto &req: m_send_req) {
+      DISTCONV_CHECK_MPI(MPI_Request_free(&req));
+    }
+    for (auto &req: m_recv_req) {
+      DISTCONV_CHECK_MPI(MPI_Request_free(&req));
+    }
+  }
+
+  // Number of face, edge and corner neighbors of this process
+  int get_num_neighbors() const {
+    return m_neighbors.size();
+  }
+
+  using HaloExchangeHost<DataType>::exchange;
+
+  void exchange(const IntVector &widths_rhs_send,
+                const IntVector &widths_rhs_recv,
+                const IntVector &widths_lhs_send,
+                const IntVector &widths_lhs_recv,
+                bool is_reverse,
+                HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) override {
+    const int tag = 0;
+    const int nn = m_neighbors.size();
+    if (nn == 0) return;
+    // Exchanges of the full halo widths use persistent requests
+    const bool persistent = is_full_width(widths_rhs_send, widths_rhs_recv,
+                                          widths_lhs_send, widths_lhs_recv);
+    if (persistent && m_send_req.empty()) {
+      init_requests();
+    }
+    MPI_Comm comm = this->m_tensor.get_locale().get_comm();
+    std::vector<MPI_Request> recv_req, send_req;
+    for (int i = 0; i < nn; ++i) {
+      const size_t bytes = get_region_size(m_neighbors[i], false,
+                                           widths_rhs_recv, widths_lhs_recv)
+          * sizeof(DataType);
+      if (bytes == 0) continue;
+      recv_req.push_back(persistent ? m_recv_req[i] : MPI_REQUEST_NULL);
+      if (persistent) {
+        DISTCONV_CHECK_MPI(MPI_Start(&recv_req.back()));
+      } else {
+        DISTCONV_CHECK_MPI(MPI_Irecv(
+            m_recv_bufs[i].get(), bytes, MPI_BYTE, m_neighbors[i].rank, tag,
+            comm, &recv_req.back()));
+      }
+    }
+    for (int i = 0; i < nn; ++i) {
+      const size_t bytes = pack(m_neighbors[i], m_send_bufs[i].get(),
+                                widths_rhs_send, widths_lhs_send,
+                                is_reverse) * sizeof(DataType);
+      if (bytes == 0) continue;
+      send_req.push_back(persistent ? m_send_req[i] : MPI_REQUEST_NULL);
+      if (persistent) {
+        DISTCONV_CHECK_MPI(MPI_Start(&send_req.back()));
+      } else {
+        DISTCONV_CHECK_MPI(MPI_Isend(
+            m_send_bufs[i].get(), bytes, MPI_BYTE, m_neighbors[i].rank, tag,
+            comm, &send_req.back()));
+      }
+    }
+    // Accumulations from the neighbors must not race with each other
+    // as their regions overlap in reverse exchanges
+    DISTCONV_CHECK_MPI(MPI_Waitall(recv_req.size(), recv_req.data(),
+                                   MPI_STATUSES_IGNORE));
+    for (int i = 0; i < nn; ++i) {
+      unpack(m_neighbors[i], m_recv_bufs[i].get(), widths_rhs_recv,
+             widths_lhs_recv, is_reverse, op);
+    }
+    DISTCONV_CHECK_MPI(MPI_Waitall(send_req.size(), send_req.data(),
+                                   MPI_STATUSES_IGNORE));
+  }
+
+ protected:
+  struct Neighbor {
+    // Direction of the neighbor, -1, 0 or 1 at each dimension
+    std::vector<int> offset;
+    int rank;
+  };
+
+  std::vector<Neighbor> m_neighbors;
+  std::vector<Memory<BaseAllocator>> m_send_bufs;
+  std::vector<Memory<BaseAllocator>> m_recv_bufs;
+  // Persistent requests of each neighbor, set up at the first
+  // exchange of the full halo widths
+  std::vector<MPI_Request> m_send_req;
+  std::vector<MPI_Request> m_recv_req;
+
+  bool is_full_width(const IntVector &widths_rhs_send,
+                     const IntVector &widths_rhs_recv,
+                     const IntVector &widths_lhs_send,
+                     const IntVector &widths_lhs_recv) const {
+    const auto &w = this->m_tensor.get_halo_width();
+    return widths_rhs_send == w && widths_rhs_recv == w &&
+        widths_lhs_send == w && widths_lhs_recv == w;
+  }
+
+  void init_requests() {
+    const int tag = 0;
+    MPI_Comm comm = this->m_tensor.get_locale().get_comm();
+    const auto &w = this->m_tensor.get_halo_width();
+    for (size_t i = 0; i < m_neighbors.size(); ++i) {
+      const size_t bytes = get_region_size(m_neighbors[i], false, w, w)
+          * sizeof(DataType);
+      m_send_req.push_back(MPI_REQUEST_NULL);
+      m_recv_req.push_back(MPI_REQUEST_NULL);
+      DISTCONV_CHECK_MPI(MPI_Send_init(
+          m_send_bufs[i].get(), bytes, MPI_BYTE, m_neighbors[i].rank, tag,
+          comm, &m_send_req.back()));
+      DISTCONV_CHECK_MPI(MPI_Recv_init(
+          m_recv_bufs[i].get(), bytes, MPI_BYTE, m_neighbors[i].rank, tag,
+          comm, &m_recv_req.back()));
+    }
+  }
+
+  // Neighbors are ordered by their offsets with the first dimension
+  // moving fastest
+  void set_neighbors() {
+    const int nd = this->m_tensor.get_num_dims();
+    // Peers are not set unless some dimension is exchanged
+    bool exchange_req = false;
+    for (int i = 0; i < nd; ++i) {
+      exchange_req |= this->is_exchange_required(i);
+    }
+    if (!exchange_req) return;
+    std::vector<int> offset(nd, -1);
+    while (true) {
+      bool is_self = true;
+      bool valid = true;
+      for (int i = 0; i < nd; ++i) {
+        if (offset[i] == 0) continue;
+        is_self = false;
+        const Side side = offset[i] > 0 ? Side::RHS : Side::LHS;
+        valid &= this->get_peer(i, side) != MPI_PROC_NULL;
+      }
+      if (!is_self && valid) {
+        auto proc_idx = this->m_tensor.get_proc_index();
+        for (int i = 0; i < nd; ++i) proc_idx[i] += offset[i];
+        m_neighbors.push_back({offset, (int)get_offset(
+            proc_idx, this->m_tensor.get_distribution().get_locale_shape())});
+      }
+      int i = 0;
+      for (; i < nd && offset[i] == 1; ++i) offset[i] = -1;
+      if (i == nd) break;
+      ++offset[i];
+    }
+    const auto w = this->m_tensor.get_halo_width();
+    for (const auto &n: m_neighbors) {
+      const size_t s = get_region_size(n, false, w, w) * sizeof(DataType);
+      m_send_bufs.emplace_back();
+      m_recv_bufs.emplace_back();
+      m_send_bufs.back().allocate(s);
+      m_recv_bufs.back().allocate(s);
+    }
+  }
+
+  /*
+    Returns the region exchanged with the neighbor. inner designates
+    the interior region that is sent in a forward exchange, and
+    otherwise the halo region. Dimensions without exchanges cover
+    their halos as well, as in the per-dimension exchange.
+   */
+  void get_region(const Neighbor &n, bool inner,
+                  const IntVector &widths_rhs, const IntVector &widths_lhs,
+                  Shape &shape, IndexVector &begin) {
+    const int nd = this->m_tensor.get_num_dims();
+    shape = this->m_tensor.get_local_real_shape();
+    begin = IndexVector(nd, 0);
+    for (int i = 0; i < nd; ++i) {
+      const Side side = n.offset[i] > 0 ? Side::RHS : Side::LHS;
+      if (n.offset[i] != 0) {
+        const int width = side == Side::RHS ? widths_rhs[i] : widths_lhs[i];
+        shape[i] = width;
+        begin[i] = this->get_halo_begin(i, side, width, inner);
+      } else if (this->get_peer(i, Side::RHS) != MPI_PROC_NULL ||
+                 this->get_peer(i, Side::LHS) != MPI_PROC_NULL) {
+        shape[i] = this->m_tensor.get_local_shape()[i];
+        begin[i] = this->m_tensor.get_halo_width(i);
+      }
+    }
+  }
+
+  size_t get_region_size(const Neighbor &n, bool inner,
+                         const IntVector &widths_rhs,
+                         const IntVector &widths_lhs) {
+    Shape shape;
+    IndexVector begin;
+    get_region(n, inner, widths_rhs, widths_lhs, shape, begin);
+    return shape.get_size();
+  }
+
+  // Copies the region between the tensor and a contiguous buffer
+  // row by row. Returns the number of elements.
+  size_t pack_or_unpack(const Shape &shape, const IndexVector &begin,
+                        DataType *buf, bool is_pack,
+                        HaloExchangeAccumOp op) {
+    const index_t size = shape.get_size();
+    if (size == 0) return 0;
+    const int nd = this->m_tensor.get_num_dims();
+    const auto real_shape = this->m_tensor.get_local_real_shape();
+    const index_t pitch = this->m_tensor.get_pitch();
+    const index_t row_len = shape[0];
+    const index_t num_rows = size / row_len;
+    DataType *tensor_buf = this->m_tensor.get_buffer();
+#pragma omp parallel for
+    for (index_t row = 0; row < num_rows; ++row) {
+      IndexVector idx(begin);
+      index_t r = row;
+      for (int i = 1; i < nd; ++i) {
+        idx[i] += r % shape[i];
+        r /= shape[i];
+      }
+      DataType *t = tensor_buf + get_offset(idx, real_shape, pitch);
+      DataType *h = buf + row * row_len;
+      if (is_pack) {
+        std::memcpy(h, t, row_len * sizeof(DataType));
+      } else {
+        internal::accumulate_halo(t, h, row_len, op);
+      }
+    }
+    return size;
+  }
+
+  size_t pack(const Neighbor &n, void *buf, const IntVector &widths_rhs,
+              const IntVector &widths_lhs, bool is_reverse) {
+    Shape shape;
+    IndexVector begin;
+    get_region(n, !is_reverse, widths_rhs, widths_lhs, shape, begin);
+    return pack_or_unpack(shape, begin, static_cast<DataType*>(buf), true,
+                          HaloExchangeAccumOp::ID);
+  }
+
+  size_t unpack(const Neighbor &n, void *buf, const IntVector &widths_rhs,
+                const IntVector &widths_lhs, bool is_reverse,
+                HaloExchangeAccumOp op) {
+    Shape shape;
+    IndexVector begin;
+    get_region(n, is_reverse, widths_rhs, widths_lhs, shape, begin);
+    return pack_or_unpack(shape, begin, static_cast<DataType*>(buf), false,
+                          op);
+  }
+};
+
+/*
+  Exchanges the halos of all dimensions with a single
+  MPI_Neighbor_alltoallw. Cartesian communicators only connect face
+  neighbors, so the neighborhood is a distributed graph of the face,
+  edge and corner neighbors of each process. With MPI-4, exchanges of
+  the full halo widths reuse a persistent collective.
+ */
+template <typename DataType>
+class HaloExchangeHostConcurrentNeighbor:
+      public HaloExchangeHostConcurrent<DataType> {
+  using TensorType = typename HaloExchangeHost<DataType>::TensorType;
+ public:
+  HaloExchangeHostConcurrentNeighbor(TensorType &tensor):
+      HaloExchangeHostConcurrent<DataType>(tensor) {
+    create_graph_comm();
+  }
+  HaloExchangeHostConcurrentNeighbor(
+      const HaloExchangeHostConcurrentNeighbor &x):
+      HaloExchangeHostConcurrent<DataType>(x) {
+    create_graph_comm();
+  }
+
+  virtual ~HaloExchangeHostConcurrentNeighbor() {
+#if MPI_VERSION >= 4
+    if (m_coll_req != MPI_REQUEST_NULL) {
+      DISTCONV_CHECK_MPI(MPI_Request_free(&m_coll_req));
+    }
+#endif // MPI_VERSION >= 4
+    if (m_graph_comm != MPI_COMM_NULL) {
+      DISTCONV_CHECK_MPI(MPI_Comm_free(&m_graph_comm));
+    }
+  }
+
+  using HaloExchangeHostConcurrent<DataType>::exchange;
+
+  void exchange(const IntVector &widths_rhs_send,
+                const IntVector &widths_rhs_recv,
+                const IntVector &widths_lhs_send,
+                const IntVector &widths_lhs_recv,
+                bool is_reverse,
+                HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) override {
+    // All processes join the collective, including those without
+    // neighbors
+    if (m_graph_comm == MPI_COMM_NULL) return;
+    const auto &neighbors = this->m_neighbors;
+    const int nn = neighbors.size();
+    for (int i = 0; i < nn; ++i) {
+      m_send_counts[i] = this->pack(
+          neighbors[i], this->m_send_bufs[i].get(), widths_rhs_send,
+          widths_lhs_send, is_reverse) * sizeof(DataType);
+      m_recv_counts[i] = this->get_region_size(
+          neighbors[i], false, widths_rhs_recv, widths_lhs_recv)
+          * sizeof(DataType);
+    }
+#if MPI_VERSION >= 4
+    // The persistent collective uses its own arrays with the counts of
+    // the full halo widths, so the counts above are only scratch for
+    // the blocking collective
+    if (this->is_full_width(widths_rhs_send, widths_rhs_recv,
+                            widths_lhs_send, widths_lhs_recv)) {
+      if (m_coll_req == MPI_REQUEST_NULL) {
+        init_coll_request();
+      }
+      DISTCONV_CHECK_MPI(MPI_Start(&m_coll_req));
+      DISTCONV_CHECK_MPI(MPI_Wait(&m_coll_req, MPI_STATUS_IGNORE));
+    } else
+#endif // MPI_VERSION >= 4
+    {
+      DISTCONV_CHECK_MPI(MPI_Neighbor_alltoallw(
+          MPI_BOTTOM, m_send_counts.data(), m_send_displs.data(),
+          m_types.data(), MPI_BOTTOM, m_recv_counts.data(),
+          m_recv_displs.data(), m_types.data(), m_graph_comm));
+    }
+    for (int i = 0; i < nn; ++i) {
+      this->unpack(neighbors[i], this->m_recv_bufs[i].get(),
+                   widths_rhs_recv, widths_lhs_recv, is_reverse, op);
+    }
+  }
+
+ protected:
+  MPI_Comm m_graph_comm = MPI_COMM_NULL;
+  std::vector<int> m_send_counts;
+  std::vector<int> m_recv_counts;
+  std::vector<MPI_Aint> m_send_displs;
+  std::vector<MPI_Aint> m_recv_displs;
+  std::vector<MPI_Datatype> m_types;
+#if MPI_VERSION >= 4
+  // Bound to the persistent collective, so these must not be modified
+  // until the request is freed
+  std::vector<int> m_coll_send_counts;
+  std::vector<int> m_coll_recv_counts;
+  std::vector<MPI_Aint> m_coll_send_displs;
+  std::vector<MPI_Aint> m_coll_recv_displs;
+  std::vector<MPI_Datatype> m_coll_types;
+  MPI_Request m_coll_req = MPI_REQUEST_NULL;
+
+  void init_coll_request() {
+    const auto &w = this->m_tensor.get_halo_width();
+    m_coll_send_counts.clear();
+    for (const auto &n: this->m_neighbors) {
+      m_coll_send_counts.push_back(
+          this->get_region_size(n, false, w, w) * sizeof(DataType));
+    }
+    m_coll_recv_counts = m_coll_send_counts;
+    m_coll_send_displs = m_send_displs;
+    m_coll_recv_displs = m_recv_displs;
+    m_coll_types = m_types;
+    DISTCONV_CHECK_MPI(MPI_Neighbor_alltoallw_init(
+        MPI_BOTTOM, m_coll_send_counts.data(), m_coll_send_displs.data(),
+        m_coll_types.data(), MPI_BOTTOM, m_coll_recv_counts.data(),
+        m_coll_recv_displs.data(), m_coll_types.data(), m_graph_comm,
+        MPI_INFO_NULL, &m_coll_req));
+  }
+#endif // MPI_VERSION >= 4
+
+  // Unlike the peers, this does not depend on the local tensor, so
+  // all processes agree on it.
+  bool is_exchanged() const {
+    const auto &dist = this->m_tensor.get_distribution();
+    for (int i = 0; i < this->m_tensor.get_num_dims(); ++i) {
+      if (dist.is_distributed(i) && dist.get_split_shape()[i] > 1 &&
+          this->m_tensor.get_halo_width(i) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void create_graph_comm() {
+    if (!is_exchanged()) return;
+    const int nn = this->m_neighbors.size();
+    m_send_counts.assign(nn, 0);
+    m_recv_counts.assign(nn, 0);
+    m_send_displs.assign(nn, 0);
+    m_recv_displs.assign(nn, 0);
+    m_types.assign(nn, MPI_BYTE);
+    for (int i = 0; i < nn; ++i) {
+      DISTCONV_CHECK_MPI(MPI_Get_address(this->m_send_bufs[i].get(),
+                                         &m_send_displs[i]));
+      DISTCONV_CHECK_MPI(MPI_Get_address(this->m_recv_bufs[i].get(),
+                                         &m_recv_displs[i]));
+    }
+    std::vector<int> ranks;
+    for (const auto &n: this->m_neighbors) ranks.push_back(n.rank);
+    DISTCONV_CHECK_MPI(MPI_Dist_graph_create_adjacent(
+        this->m_tensor.get_locale().get_comm(),
+        ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+        ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+        MPI_INFO_NULL, 0, &m_graph_comm));
+  }
+};
+
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class HaloExchangeHostConcurrent<float>;
+extern template class HaloExchangeHostConcurrent<double>;
+extern template class HaloExchangeHostConcurrentNeighbor<float>;
+extern template class HaloExchangeHostConcurrentNeighbor<double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
+} // namespace tensor
+} // namespace distconv
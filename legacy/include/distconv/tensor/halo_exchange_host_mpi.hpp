@@ -0,0 +1,324 @@
+#pragma once
+
+#include "distconv/tensor/halo_exchange_host.hpp"
+
+#include <vector>
+
+namespace distconv {
+namespace tensor {
+
+// Exchanges the halo of each side in turn with blocking MPI_Sendrecv.
+template <typename DataType>
+class HaloExchangeHostBlockingMPI: public HaloExchangeHost<DataType> {
+  using TensorType = typename HaloExchangeHost<DataType>::TensorType;
+ public:
+  HaloExchangeHostBlockingMPI(TensorType &tensor):
+      HaloExchangeHost<DataType>(tensor) {}
+  HaloExchangeHostBlockingMPI(const HaloExchangeHostBlockingMPI &x):
+      HaloExchangeHost<DataType>(x) {}
+
+  virtual ~HaloExchangeHostBlockingMPI() {}
+
+  using HaloExchangeHost<DataType>::exchange;
+
+  void exchange(int dim,
+                int width_rhs_send, int width_rhs_recv,
+                int width_lhs_send, int width_lhs_recv,
+                bool is_reverse,
+                HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) override {
+    const int tag = 0;
+
+    if (!this->is_exchange_required(dim, width_rhs_send, width_rhs_recv,
+                                    width_lhs_send, width_lhs_recv)) {
+      return;
+    }
+
+    MPI_Comm comm = this->m_tensor.get_locale().get_comm();
+    this->ensure_halo_buffers(dim);
+
+    // Sends to the peer at one side while receiving from the peer at
+    // the other side
+    for (auto side: SIDES) {
+      const Side recv_side = side == Side::RHS ? Side::LHS : Side::RHS;
+      const int width_send = side == Side::RHS
+          ? width_rhs_send : width_lhs_send;
+      const int width_recv = recv_side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      const int send_peer = width_send > 0 ?
+          this->get_peer(dim, side) : MPI_PROC_NULL;
+      const int recv_peer = width_recv > 0 ?
+          this->get_peer(dim, recv_side) : MPI_PROC_NULL;
+      if (send_peer != MPI_PROC_NULL) {
+        this->pack_dim(dim, side, width_send,
+                       this->get_send_buffer(dim, side), is_reverse);
+      }
+      const size_t send_bytes = send_peer == MPI_PROC_NULL ? 0 :
+          this->get_halo_size(dim, width_send) * sizeof(DataType);
+      const size_t recv_bytes = recv_peer == MPI_PROC_NULL ? 0 :
+          this->get_halo_size(dim, width_recv) * sizeof(DataType);
+      DISTCONV_CHECK_MPI(MPI_Sendrecv(
+          this->get_send_buffer(dim, side), send_bytes, MPI_BYTE,
+          send_peer, tag,
+          this->get_recv_buffer(dim, recv_side), recv_bytes, MPI_BYTE,
+          recv_peer, tag, comm, MPI_STATUS_IGNORE));
+    }
+
+    this->unpack(dim, width_rhs_recv, width_lhs_recv, is_reverse, op);
+  }
+};
+
+/*
+  Nonblocking MPI exchange with persistent requests. The requests of a
+  dimension are set up at its first exchange of the full halo widths,
+  and later exchanges of the same widths only start and complete
+  them, which saves matching and setup of each message. Exchanges of
+  other widths use nonpersistent requests.
+ */
+template <typename DataType>
+class HaloExchangeHostPersistent: public HaloExchangeHost<DataType> {
+  using TensorType = typename HaloExchangeHost<DataType>::TensorType;
+ public:
+  HaloExchangeHostPersistent(TensorType &tensor):
+      HaloExchangeHost<DataType>(tensor),
+      m_send_req(MPI_REQUEST_NULL), m_recv_req(MPI_REQUEST_NULL),
+      m_req_initialized(tensor.get_num_dims(), false) {}
+  // Requests are not shared with x
+  HaloExchangeHostPersistent(const HaloExchangeHostPersistent &x):
+      HaloExchangeHostPersistent(x.m_tensor) {}
+
+  virtual ~HaloExchangeHostPersistent() {
+    apply_to_sides(this->m_tensor.get_num_dims(), [&](int dim, Side side) {
+        if (!m_req_initialized[dim]) return;
+        for (auto *req: {&m_send_req(dim, side), &m_recv_req(dim, side)}) {
+          if (*req != MPI_REQUEST_NULL) {
+            DISTCONV_CHECK_MPI(MPI_Request_free(req));
+          }
+        }
+      });
+  }
+
+  using HaloExchangeHost<DataType>::exchange;
+
+  void exchange(int dim,
+                int width_rhs_send, int width_rhs_recv,
+                int width_lhs_send, int width_lhs_recv,
+                bool is_reverse,
+                HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) override {
+    const int width = this->m_tensor.get_halo_width(dim);
+    if (width_rhs_send != width || width_rhs_recv != width ||
+        width_lhs_send != width || width_lhs_recv != width) {
+      HaloExchangeHost<DataType>::exchange(
+          dim, width_rhs_send, width_rhs_recv, width_lhs_send,
+          width_lhs_recv, is_reverse, op);
+      return;
+    }
+    if (!this->is_exchange_required(dim)) return;
+    if (!m_req_initialized[dim]) {
+      init_requests(dim);
+    }
+
+    MPI_Request recv_req[2];
+    MPI_Request send_req[2];
+    int num_recv_requests = 0;
+    int num_send_requests = 0;
+    for (auto side: SIDES) {
+      if (m_recv_req(dim, side) != MPI_REQUEST_NULL) {
+        recv_req[num_recv_requests++] = m_recv_req(dim, side);
+      }
+    }
+    if (num_recv_requests > 0) {
+      DISTCONV_CHECK_MPI(MPI_Startall(num_recv_requests, recv_req));
+    }
+    for (auto side: SIDES) {
+      if (m_send_req(dim, side) == MPI_REQUEST_NULL) continue;
+      this->pack_dim(dim, side, width, this->get_send_buffer(dim, side),
+                     is_reverse);
+      send_req[num_send_requests] = m_send_req(dim, side);
+      DISTCONV_CHECK_MPI(MPI_Start(&send_req[num_send_requests]));
+      ++num_send_requests;
+    }
+    // Completing persistent requests leaves them inactive rather than
+    // freeing them, so the handles stay valid
+    if (num_recv_requests > 0) {
+      DISTCONV_CHECK_MPI(MPI_Waitall(num_recv_requests, recv_req,
+                                     MPI_STATUSES_IGNORE));
+    }
+    this->unpack(dim, width, width, is_reverse, op);
+    if (num_send_requests > 0) {
+      DISTCONV_CHECK_MPI(MPI_Waitall(num_send_requests, send_req,
+                                     MPI_STATUSES_IGNORE));
+    }
+  }
+
+ protected:
+  BoundaryAttributesV<MPI_Request> m_send_req;
+  BoundaryAttributesV<MPI_Request> m_recv_req;
+  std::vector<bool> m_req_initialized;
+
+  void init_requests(int dim) {
+    const int tag = 0;
+    MPI_Comm comm = this->m_tensor.get_locale().get_comm();
+    this->ensure_halo_buffers(dim);
+    const size_t halo_bytes = this->get_halo_size(dim) * sizeof(DataType);
+    for (auto side: SIDES) {
+      const int peer = this->get_peer(dim, side);
+      if (peer == MPI_PROC_NULL) continue;
+      DISTCONV_CHECK_MPI(MPI_Recv_init(
+          this->get_recv_buffer(dim, side), halo_bytes, MPI_BYTE, peer,
+          tag, comm, &m_recv_req(dim, side)));
+      DISTCONV_CHECK_MPI(MPI_Send_init(
+          this->get_send_buffer(dim, side), halo_bytes, MPI_BYTE, peer,
+          tag, comm, &m_send_req(dim, side)));
+    }
+    m_req_initialized[dim] = true;
+  }
+};
+
+/*
+  Exchanges the halos of each dimension with a neighborhood collective
+  over a one-dimensional Cartesian communicator of the dimension.
+ */
+template <typename DataType>
+class HaloExchangeHostNeighbor: public HaloExchangeHost<DataType> {
+  using TensorType = typename HaloExchangeHost<DataType>::TensorType;
+ public:
+  HaloExchangeHostNeighbor(TensorType &tensor):
+      HaloExchangeHost<DataType>(tensor) {
+    create_dim_comms();
+  }
+  HaloExchangeHostNeighbor(const HaloExchangeHostNeighbor &x):
+      HaloExchangeHost<DataType>(x) {
+    create_dim_comms();
+  }
+
+  virtual ~HaloExchangeHostNeighbor() {
+    for (auto &c: m_dim_comms) {
+      if (c != MPI_COMM_NULL) {
+        DISTCONV_CHECK_MPI(MPI_Comm_free(&c));
+      }
+    }
+  }
+
+  using HaloExchangeHost<DataType>::exchange;
+
+  void exchange(int dim,
+                int width_rhs_send, int width_rhs_recv,
+                int width_lhs_send, int width_lhs_recv,
+                bool is_reverse,
+                HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) override {
+    // Processes with empty local tensors still join the collective
+    if (!is_dim_exchanged(dim, width_rhs_send, width_rhs_recv,
+                          width_lhs_send, width_lhs_recv)) {
+      return;
+    }
+
+    // Peers are not set for processes with empty local tensors
+    const bool has_local = this->is_exchange_required(
+        dim, width_rhs_send, width_rhs_recv, width_lhs_send, width_lhs_recv);
+    if (has_local) {
+      this->ensure_halo_buffers(dim);
+    }
+
+    // Neighbors of a Cartesian dimension are ordered as LHS and RHS
+    int send_counts[2] = {0, 0};
+    int recv_counts[2] = {0, 0};
+    MPI_Aint send_displs[2] = {0, 0};
+    MPI_Aint recv_displs[2] = {0, 0};
+    MPI_Datatype types[2] = {MPI_BYTE, MPI_BYTE};
+    for (auto side: SIDES) {
+      if (!has_local || this->get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int i = side == Side::LHS ? 0 : 1;
+      const int width_send = side == Side::RHS
+          ? width_rhs_send : width_lhs_send;
+      const int width_recv = side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      if (width_send > 0) {
+        this->pack_dim(dim, side, width_send,
+                       this->get_send_buffer(dim, side), is_reverse);
+        send_counts[i] = this->get_halo_size(dim, width_send)
+            * sizeof(DataType);
+        DISTCONV_CHECK_MPI(MPI_Get_address(
+            this->get_send_buffer(dim, side), &send_displs[i]));
+      }
+      if (width_recv > 0) {
+        recv_counts[i] = this->get_halo_size(dim, width_recv)
+            * sizeof(DataType);
+        DISTCONV_CHECK_MPI(MPI_Get_address(
+            this->get_recv_buffer(dim, side), &recv_displs[i]));
+      }
+    }
+
+    DISTCONV_CHECK_MPI(MPI_Neighbor_alltoallw(
+        MPI_BOTTOM, send_counts, send_displs, types,
+        MPI_BOTTOM, recv_counts, recv_displs, types,
+        m_dim_comms[dim]));
+
+    if (has_local) {
+      this->unpack(dim, width_rhs_recv, width_lhs_recv, is_reverse, op);
+    }
+  }
+
+ protected:
+  std::vector<MPI_Comm> m_dim_comms;
+
+  // Unlike is_exchange_required, this does not depend on the local
+  // tensor, so all processes agree on it.
+  bool is_dim_exchanged(int dim,
+                        int width_rhs_send, int width_rhs_recv,
+                        int width_lhs_send, int width_lhs_recv) const {
+    const auto &dist = this->m_tensor.get_distribution();
+    return dist.is_distributed(dim) &&
+        dist.get_split_shape()[dim] > 1 &&
+        (width_rhs_send > 0 || width_rhs_recv > 0 ||
+         width_lhs_send > 0 || width_lhs_recv > 0);
+  }
+
+  bool is_dim_exchanged(int dim) const {
+    const int w = this->m_tensor.get_halo_width(dim);
+    return is_dim_exchanged(dim, w, w, w, w);
+  }
+
+  void create_dim_comms() {
+    const int nd = this->m_tensor.get_num_dims();
+    m_dim_comms.assign(nd, MPI_COMM_NULL);
+    bool exchange_req = false;
+    for (int i = 0; i < nd; ++i) {
+      exchange_req |= is_dim_exchanged(i);
+    }
+    if (!exchange_req) return;
+    const auto &locale_shape =
+        this->m_tensor.get_distribution().get_locale_shape();
+    // Ranks are ordered with the first dimension being the fastest
+    // moving one, whereas MPI orders the last dimension first.
+    std::vector<int> dims(nd);
+    std::vector<int> periods(nd, 0);
+    for (int i = 0; i < nd; ++i) {
+      dims[nd - 1 - i] = locale_shape[i];
+    }
+    MPI_Comm cart_comm;
+    DISTCONV_CHECK_MPI(MPI_Cart_create(
+        this->m_tensor.get_locale().get_comm(), nd, dims.data(),
+        periods.data(), 0, &cart_comm));
+    for (int i = 0; i < nd; ++i) {
+      if (!is_dim_exchanged(i)) continue;
+      std::vector<int> remain_dims(nd, 0);
+      remain_dims[nd - 1 - i] = 1;
+      DISTCONV_CHECK_MPI(MPI_Cart_sub(cart_comm, remain_dims.data(),
+                                      &m_dim_comms[i]));
+    }
+    DISTCONV_CHECK_MPI(MPI_Comm_free(&cart_comm));
+  }
+};
+
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class HaloExchangeHostBlockingMPI<float>;
+extern template class HaloExchangeHostBlockingMPI<double>;
+extern template class HaloExchangeHostNeighbor<float>;
+extern template class HaloExchangeHostNeighbor<double>;
+extern template class HaloExchangeHostPersistent<float>;
+extern template class HaloExchangeHostPersistent<double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
+} // namespace tensor
+} // namespace distconv
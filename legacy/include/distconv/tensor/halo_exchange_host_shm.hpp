@@ -0,0 +1,226 @@
+#pragma once
+
+#include "distconv/tensor/halo_exchange_host.hpp"
+
+#include <vector>
+
+namespace distconv {
+namespace tensor {
+
+/*
+  Exchanges halos through an MPI shared-memory window. Each process
+  packs its halo directly into the receive buffer of its peer, so only
+  zero-byte messages are sent to notify the peer when a buffer can be
+  overwritten and when it is filled. Falls back to the nonblocking MPI
+  exchange when a peer is not on the same node.
+ */
+template <typename DataType>
+class HaloExchangeHostSHM: public HaloExchangeHost<DataType> {
+  using TensorType = typename HaloExchangeHost<DataType>::TensorType;
+ public:
+  HaloExchangeHostSHM(TensorType &tensor):
+      HaloExchangeHost<DataType>(tensor) {
+    setup_window();
+  }
+  HaloExchangeHostSHM(const HaloExchangeHostSHM &x):
+      HaloExchangeHost<DataType>(x) {
+    setup_window();
+  }
+
+  virtual ~HaloExchangeHostSHM() {
+    if (m_win != MPI_WIN_NULL) {
+      DISTCONV_CHECK_MPI(MPI_Win_unlock_all(m_win));
+      DISTCONV_CHECK_MPI(MPI_Win_free(&m_win));
+    }
+    if (m_node_comm != MPI_COMM_NULL) {
+      DISTCONV_CHECK_MPI(MPI_Comm_free(&m_node_comm));
+    }
+  }
+
+  // True if the halos are exchanged through shared memory
+  bool is_shared_memory_used() const {
+    return m_shm_available;
+  }
+
+  using HaloExchangeHost<DataType>::exchange;
+
+  void exchange(int dim,
+                int width_rhs_send, int width_rhs_recv,
+                int width_lhs_send, int width_lhs_recv,
+                bool is_reverse,
+                HaloExchangeAccumOp op=HaloExchangeAccumOp::ID) override {
+    if (!m_shm_available) {
+      HaloExchangeHost<DataType>::exchange(
+          dim, width_rhs_send, width_rhs_recv, width_lhs_send,
+          width_lhs_recv, is_reverse, op);
+      return;
+    }
+
+    if (!this->is_exchange_required(dim, width_rhs_send, width_rhs_recv,
+                                    width_lhs_send, width_lhs_recv)) {
+      return;
+    }
+
+    MPI_Comm comm = this->m_tensor.get_locale().get_comm();
+    MPI_Request requests[4];
+    int num_requests = 0;
+
+    // Tells the peers writing to this process that the receive
+    // buffers are free, and waits for the peers this process writes
+    // to.
+    for (auto side: SIDES) {
+      if (this->get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int width_recv = side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      const int width_send = side == Side::RHS
+          ? width_rhs_send : width_lhs_send;
+      if (width_recv > 0) {
+        DISTCONV_CHECK_MPI(MPI_Isend(
+            nullptr, 0, MPI_BYTE, this->get_peer(dim, side), m_ready_tag,
+            comm, &requests[num_requests++]));
+      }
+      if (width_send > 0) {
+        DISTCONV_CHECK_MPI(MPI_Irecv(
+            nullptr, 0, MPI_BYTE, this->get_peer(dim, side), m_ready_tag,
+            comm, &requests[num_requests++]));
+      }
+    }
+    DISTCONV_CHECK_MPI(MPI_Waitall(num_requests, requests,
+                                   MPI_STATUSES_IGNORE));
+    num_requests = 0;
+
+    for (auto side: SIDES) {
+      if (this->get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int width_send = side == Side::RHS
+          ? width_rhs_send : width_lhs_send;
+      const int width_recv = side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      if (width_recv > 0) {
+        DISTCONV_CHECK_MPI(MPI_Irecv(
+            nullptr, 0, MPI_BYTE, this->get_peer(dim, side), m_done_tag,
+            comm, &requests[num_requests++]));
+      }
+      if (width_send > 0) {
+        this->pack_dim(dim, side, width_send,
+                       m_peer_recv_buffers(dim, side), is_reverse);
+        DISTCONV_CHECK_MPI(MPI_Win_sync(m_win));
+        DISTCONV_CHECK_MPI(MPI_Isend(
+            nullptr, 0, MPI_BYTE, this->get_peer(dim, side), m_done_tag,
+            comm, &requests[num_requests++]));
+      }
+    }
+    DISTCONV_CHECK_MPI(MPI_Waitall(num_requests, requests,
+                                   MPI_STATUSES_IGNORE));
+    DISTCONV_CHECK_MPI(MPI_Win_sync(m_win));
+
+    for (auto side: SIDES) {
+      if (this->get_peer(dim, side) == MPI_PROC_NULL) continue;
+      const int width_recv = side == Side::RHS
+          ? width_rhs_recv : width_lhs_recv;
+      if (width_recv == 0) continue;
+      this->unpack_dim(dim, side, width_recv, m_recv_buffers(dim, side),
+                       is_reverse, op);
+    }
+  }
+
+ protected:
+  static constexpr int m_ready_tag = 1;
+  static constexpr int m_done_tag = 2;
+
+  MPI_Comm m_node_comm = MPI_COMM_NULL;
+  MPI_Win m_win = MPI_WIN_NULL;
+  bool m_shm_available = false;
+  // Receive buffers of this process in the shared window
+  BoundaryAttributesV<void*> m_recv_buffers;
+  // Receive buffers of the peers that this process writes to
+  BoundaryAttributesV<void*> m_peer_recv_buffers;
+
+  // Peers are set only for the dimensions that require exchanges
+  bool has_peer(int dim, Side side) {
+    return this->is_exchange_required(dim) &&
+        this->get_peer(dim, side) != MPI_PROC_NULL;
+  }
+
+  void setup_window() {
+    const int nd = this->m_tensor.get_num_dims();
+    MPI_Comm comm = this->m_tensor.get_locale().get_comm();
+    DISTCONV_CHECK_MPI(MPI_Comm_split_type(
+        comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm));
+
+    // Translates the peer ranks to the ranks in the node communicator
+    MPI_Group group, node_group;
+    DISTCONV_CHECK_MPI(MPI_Comm_group(comm, &group));
+    DISTCONV_CHECK_MPI(MPI_Comm_group(m_node_comm, &node_group));
+    BoundaryAttributesV<int> node_peers(MPI_PROC_NULL);
+    int all_local = 1;
+    apply_to_sides(nd, [&](int dim, Side side) {
+        if (!has_peer(dim, side)) return;
+        int peer = this->get_peer(dim, side);
+        DISTCONV_CHECK_MPI(MPI_Group_translate_ranks(
+            group, 1, &peer, node_group, &node_peers(dim, side)));
+        if (node_peers(dim, side) == MPI_UNDEFINED) all_local = 0;
+      });
+    DISTCONV_CHECK_MPI(MPI_Group_free(&group));
+    DISTCONV_CHECK_MPI(MPI_Group_free(&node_group));
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &all_local, 1, MPI_INT,
+                                     MPI_MIN, comm));
+    m_shm_available = all_local;
+    if (!m_shm_available) {
+      util::MPIRootPrintStreamWarning()
+          << "Not all halo exchange peers share memory; "
+          << "falling back to MPI";
+      return;
+    }
+
+    // The receive buffers are laid out in the order of dimensions
+    // and sides. Their offsets are stored at the head of the segment
+    // so that peers can locate them.
+    std::vector<MPI_Aint> offsets(nd * 2, 0);
+    MPI_Aint size = offsets.size() * sizeof(MPI_Aint);
+    apply_to_sides(nd, [&](int dim, Side side) {
+        if (!has_peer(dim, side)) return;
+        offsets[dim * 2 + static_cast<int>(side)] = size;
+        MPI_Aint bytes = this->get_halo_size(dim) * sizeof(DataType);
+        size += (bytes + 63) / 64 * 64;
+      });
+    void *base;
+    DISTCONV_CHECK_MPI(MPI_Win_allocate_shared(
+        size, 1, MPI_INFO_NULL, m_node_comm, &base, &m_win));
+    DISTCONV_CHECK_MPI(MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win));
+    std::memcpy(base, offsets.data(), offsets.size() * sizeof(MPI_Aint));
+    apply_to_sides(nd, [&](int dim, Side side) {
+        if (!has_peer(dim, side)) return;
+        m_recv_buffers(dim, side) = static_cast<char*>(base) +
+            offsets[dim * 2 + static_cast<int>(side)];
+      });
+    DISTCONV_CHECK_MPI(MPI_Win_sync(m_win));
+    DISTCONV_CHECK_MPI(MPI_Barrier(m_node_comm));
+    DISTCONV_CHECK_MPI(MPI_Win_sync(m_win));
+
+    // This process writes to the receive buffer of the opposite side
+    // of each peer
+    apply_to_sides(nd, [&](int dim, Side side) {
+        if (!has_peer(dim, side)) return;
+        MPI_Aint peer_size;
+        int disp_unit;
+        void *peer_base;
+        DISTCONV_CHECK_MPI(MPI_Win_shared_query(
+            m_win, node_peers(dim, side), &peer_size, &disp_unit,
+            &peer_base));
+        const Side peer_side = side == Side::RHS ? Side::LHS : Side::RHS;
+        const MPI_Aint offset = static_cast<MPI_Aint*>(peer_base)[
+            dim * 2 + static_cast<int>(peer_side)];
+        m_peer_recv_buffers(dim, side) =
+            static_cast<char*>(peer_base) + offset;
+      });
+  }
+};
+
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class HaloExchangeHostSHM<float>;
+extern template class HaloExchangeHostSHM<double>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
+} // namespace tensor
+} // namespace distconv
@@ -4,6 +4,15 @@
 #include <type_traits>
 #include <sstream>
 #include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "distconv/util/util.hpp"
 #include "distconv/tensor/stream.hpp"
@@ -170,25 +179,27 @@ class Memory {
   }
 
   // Allocated object is always non const
-  int allocate(size_t size, size_t ldim=0) {
-    if (size == 0) {
-      std::cerr << "can't allocate empty object\n";
-      return -1;
+  h2::Expected<void> try_allocate(size_t size, size_t ldim=0) {
+    if (H2_UNLIKELY(size == 0)) {
+      return H2_UNEXPECTED(InvalidArgument, "can't allocate empty object");
     }
 
     void *new_ptr = nullptr;
     size_t pitch;
     Allocator::allocate(new_ptr, pitch, size, ldim);
-    if (new_ptr == nullptr) {
-      std::cerr << "allocator returns null\n";
-      return -1;
+    if (H2_UNLIKELY(new_ptr == nullptr)) {
+      return H2_UNEXPECTED(OutOfMemory, "allocator returns null");
     }
 
     nullify();
 
     m_managed_ptr.reset(new_ptr, Allocator::deallocate);
     m_property = std::make_shared<MemoryProperty>(size, ldim, pitch);
-    return 0;
+    return {};
+  }
+
+  int allocate(size_t size, size_t ldim=0) {
+    return util::to_status(try_allocate(size, ldim));
   }
 
   // No use case
@@ -359,6 +370,156 @@ struct Stream<BasePitchedAllocator<ALIGN_SIZE>> {
   static constexpr type default_value = 0;
 };
 
+namespace internal {
+
+// Host copies are split into pieces of about this size, which are
+// copied by separate threads
+constexpr size_t host_copy_piece_size = 256 * 1024;
+// Non-temporal stores are not used for shorter runs, which would only
+// partially fill cache lines
+constexpr size_t host_copy_min_streaming_len = 1024;
+
+/*
+  Copies of at least this many bytes in total bypass the cache with
+  non-temporal stores, as their destinations would evict most of the
+  cache before being read again. The default is meant to be above the
+  last-level cache size and can be set by
+  DISTCONV_COPY_STREAMING_THRESHOLD or
+  set_host_copy_streaming_threshold.
+ */
+inline std::atomic<size_t> &host_copy_streaming_threshold() {
+  static std::atomic<size_t> threshold([]() {
+    auto env = std::getenv("DISTCONV_COPY_STREAMING_THRESHOLD");
+    return env ? (size_t)std::stoull(std::string(env))
+        : (size_t)64 * 1024 * 1024;
+  }());
+  return threshold;
+}
+
+inline size_t get_host_copy_streaming_threshold() {
+  return host_copy_streaming_threshold().load();
+}
+
+inline void set_host_copy_streaming_threshold(size_t threshold) {
+  host_copy_streaming_threshold().store(threshold);
+}
+
+inline void copy_host_bytes(char *dst, const char *src, size_t len,
+                            bool streaming) {
+#ifdef __SSE2__
+  if (streaming && len >= host_copy_min_streaming_len) {
+    // Stores need to be aligned to 16 bytes
+    const size_t head = (16 - reinterpret_cast<std::uintptr_t>(dst) % 16) % 16;
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    len -= head;
+    const size_t num_vecs = len / 16;
+    auto d = reinterpret_cast<__m128i*>(dst);
+    auto s = reinterpret_cast<const __m128i*>(src);
+    for (size_t i = 0; i < num_vecs; ++i) {
+      _mm_stream_si128(d + i, _mm_loadu_si128(s + i));
+    }
+    std::memcpy(dst + num_vecs * 16, src + num_vecs * 16, len % 16);
+    return;
+  }
+#endif
+  std::memcpy(dst, src, len);
+}
+
+/*
+  Copies runs of run_len bytes between host buffers. Runs are indexed
+  by shape, and the offsets of a run are the sums of its index times
+  dst_strides and src_strides in bytes. Dimensions that are contiguous
+  with the runs or with the previous dimension in both buffers are
+  merged first, so that copies between buffers of the same layout
+  become a single run. The runs are then split or grouped into pieces
+  that are copied in parallel. Returns true if non-temporal stores are
+  used.
+ */
+inline bool copy_host_runs(char *dst, const char *src, size_t run_len,
+                           const std::vector<size_t> &shape,
+                           const std::vector<size_t> &dst_strides,
+                           const std::vector<size_t> &src_strides) {
+  std::vector<size_t> s, ds, ss;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] == 0) return false;
+    if (shape[i] == 1) continue;
+    if (s.empty() && dst_strides[i] == run_len &&
+        src_strides[i] == run_len) {
+      run_len *= shape[i];
+    } else if (!s.empty() && dst_strides[i] == ds.back() * s.back() &&
+               src_strides[i] == ss.back() * s.back()) {
+      s.back() *= shape[i];
+    } else {
+      s.push_back(shape[i]);
+      ds.push_back(dst_strides[i]);
+      ss.push_back(src_strides[i]);
+    }
+  }
+  size_t num_runs = 1;
+  for (auto x: s) num_runs *= x;
+  if (run_len == 0) return false;
+  const int nd = s.size();
+#ifdef __SSE2__
+  const bool streaming = run_len >= host_copy_min_streaming_len &&
+      num_runs * run_len >= get_host_copy_streaming_threshold();
+#else
+  const bool streaming = false;
+#endif
+
+  // Long runs are split, and short ones are grouped
+  const size_t pieces_per_run = std::max<size_t>(
+      run_len / host_copy_piece_size, 1);
+  const size_t piece_len = util::ceil(run_len, pieces_per_run);
+  const size_t runs_per_piece = std::max<size_t>(
+      host_copy_piece_size / run_len, 1);
+  const size_t num_pieces = pieces_per_run > 1 ?
+      num_runs * pieces_per_run : util::ceil(num_runs, runs_per_piece);
+
+#pragma omp parallel for schedule(static) if (num_pieces > 1)
+  for (size_t p = 0; p < num_pieces; ++p) {
+    size_t run_begin = p * runs_per_piece;
+    size_t run_end = std::min(run_begin + runs_per_piece, num_runs);
+    size_t begin = 0;
+    size_t len = run_len;
+    if (pieces_per_run > 1) {
+      run_begin = p / pieces_per_run;
+      run_end = run_begin + 1;
+      begin = (p % pieces_per_run) * piece_len;
+      len = std::min(piece_len, run_len - begin);
+    }
+    std::vector<size_t> idx(nd);
+    size_t dst_offset = begin;
+    size_t src_offset = begin;
+    size_t r = run_begin;
+    for (int i = 0; i < nd; ++i) {
+      idx[i] = r % s[i];
+      r /= s[i];
+      dst_offset += idx[i] * ds[i];
+      src_offset += idx[i] * ss[i];
+    }
+    for (size_t run = run_begin; run < run_end; ++run) {
+      copy_host_bytes(dst + dst_offset, src + src_offset, len, streaming);
+      for (int i = 0; i < nd; ++i) {
+        dst_offset += ds[i];
+        src_offset += ss[i];
+        if (++idx[i] < s[i]) break;
+        dst_offset -= ds[i] * s[i];
+        src_offset -= ss[i] * s[i];
+        idx[i] = 0;
+      }
+    }
+#ifdef __SSE2__
+    // Makes the non-temporal stores of this thread visible
+    if (streaming) _mm_sfence();
+#endif
+  }
+  return streaming;
+}
+
+} // namespace internal
+
 // Couldn't support Pitched memory
 //  std::is_same<AllocDst, BasePitchedAllocator<PitchDst>>::value ||
 //  std::is_same<AllocSrc, BasePitchedAllocator<PitchSrc>>::value
@@ -383,15 +544,10 @@ Copy(Memory<AllocDst> &dst, const Memory<AllocSrc> &src,
   // This check should not be necessary, but just for sanity check
   assert_always(dst.get_pitch() != 0);
   assert_always(src.get_pitch() != 0);
-  for (size_t y = 0; y < y_len; ++y) {
-    size_t src_offset = x_src_offset +
-        src.get_pitch() * (y_src_offset + y);
-    size_t dst_offset = x_dst_offset +
-        dst.get_pitch() * (y_dst_offset + y);
-    std::memcpy((char*)dst.get() + dst_offset,
-                (char*)src.get() + src_offset,
-                x_len);
-  }
+  internal::copy_host_runs(
+      (char*)dst.get() + x_dst_offset + dst.get_pitch() * y_dst_offset,
+      (const char*)src.get() + x_src_offset + src.get_pitch() * y_src_offset,
+      x_len, {y_len}, {dst.get_pitch()}, {src.get_pitch()});
   return 0;
 }
 
@@ -42,10 +42,20 @@ class TensorMPIShuffleHelper {
       m_dst_split_root(dst_tensor.is_split_root()),
       m_src_buf(src_buf), m_dst_buf(dst_buf),
       m_src_buf_passed(src_buf != nullptr),
-      m_dst_buf_passed(dst_buf != nullptr) {
-    setup_rank_limits(src_tensor, dst_tensor, m_rank_limits_fwd);
-    setup_rank_limits(dst_tensor, src_tensor, m_rank_limits_bwd);
-    setup_displs(src_tensor, dst_tensor);
+      m_dst_buf_passed(dst_buf != nullptr),
+      m_index_mapped(src_tensor.get_distribution().is_cyclic() ||
+                     dst_tensor.get_distribution().is_cyclic()) {
+    if (m_index_mapped) {
+      setup_index_map(src_tensor, dst_tensor,
+                      m_index_map_fwd, m_index_counts_fwd);
+      setup_index_map(dst_tensor, src_tensor,
+                      m_index_map_bwd, m_index_counts_bwd);
+      setup_displs_by_index_map(src_tensor, dst_tensor);
+    } else {
+      setup_rank_limits(src_tensor, dst_tensor, m_rank_limits_fwd);
+      setup_rank_limits(dst_tensor, src_tensor, m_rank_limits_bwd);
+      setup_displs(src_tensor, dst_tensor);
+    }
 
     int num_ranks = m_loc.get_size();
     for (int pid = 0; pid < num_ranks; ++pid) {
@@ -97,6 +107,19 @@ class TensorMPIShuffleHelper {
   bool m_src_buf_passed;
   bool m_dst_buf_passed;
 
+  // Block-cyclic tensors do not map contiguous local ranges to
+  // destination ranks, so rank limits cannot describe them. Instead,
+  // each local index of each dimension is mapped to the destination
+  // rank index and its position among the elements sent to that
+  // rank. Linearized to a 1D array of pairs.
+  bool m_index_mapped;
+  std::vector<int> m_index_map_fwd;
+  std::vector<int> m_index_map_bwd;
+  // The number of elements sent to each rank index of each
+  // dimension. Linearized to a 1D array.
+  std::vector<int> m_index_counts_fwd;
+  std::vector<int> m_index_counts_bwd;
+
   std::vector<int> m_peers;
 
   int get_num_peers() const {
@@ -180,6 +203,69 @@ class TensorMPIShuffleHelper {
     }
   }
 
+  void setup_index_map(const TensorType &src_tensor,
+                       const TensorType &dst_tensor,
+                       std::vector<int> &index_map,
+                       std::vector<int> &index_counts) {
+    const int num_dims = src_tensor.get_num_dims();
+    for (int i = 0; i < num_dims; ++i) {
+      std::vector<int> counts(dst_tensor.get_locale_shape()[i], 0);
+      // Local indices are in the same order as global indices for
+      // any distribution, so the positions agree with the order in
+      // which the destination rank visits its own local indices.
+      for (index_t j = 0; j < src_tensor.get_local_shape()[i]; ++j) {
+        int dst_rank_idx = find_owning_split_root(
+            dst_tensor, i, src_tensor.get_global_index(i, j));
+        index_map.push_back(dst_rank_idx);
+        index_map.push_back(counts[dst_rank_idx]++);
+      }
+      index_counts.insert(index_counts.end(), counts.begin(), counts.end());
+    }
+  }
+
+  void setup_displs_by_index_map(const TensorType &src_tensor,
+                                 const TensorType &dst_tensor) {
+    int num_ranks = m_loc.get_size();
+    const int num_dims = get_num_dims();
+
+    m_send_counts = std::vector<int>(num_ranks);
+    m_recv_counts = std::vector<int>(num_ranks);
+    m_send_displs = std::vector<int>(num_ranks);
+    m_recv_displs = std::vector<int>(num_ranks);
+
+    // Number of elements exchanged with the rank at rank_idx.
+    auto get_count = [num_dims](const std::vector<int> &index_counts,
+                                const Shape &locale_shape,
+                                const IndexVector &rank_idx) {
+      int count = 1;
+      int counts_idx = 0;
+      for (int i = 0; i < num_dims; ++i) {
+        count *= index_counts[counts_idx + rank_idx[i]];
+        counts_idx += locale_shape[i];
+      }
+      return count;
+    };
+
+    int cur_send_displs = 0;
+    int cur_recv_displs = 0;
+    for (int pid = 0; pid < num_ranks; ++pid) {
+      m_send_displs[pid] = cur_send_displs;
+      m_recv_displs[pid] = cur_recv_displs;
+      const auto dst_pid_idx = m_dst_locale_shape.get_index(pid);
+      m_send_counts[pid] =
+          m_src_split_root &&
+          dst_tensor.get_distribution().is_split_root(dst_pid_idx) ?
+          get_count(m_index_counts_fwd, m_dst_locale_shape, dst_pid_idx) : 0;
+      cur_send_displs += m_send_counts[pid];
+      const auto src_pid_idx = m_src_locale_shape.get_index(pid);
+      m_recv_counts[pid] =
+          m_dst_split_root &&
+          src_tensor.get_distribution().is_split_root(src_pid_idx) ?
+          get_count(m_index_counts_bwd, m_src_locale_shape, src_pid_idx) : 0;
+      cur_recv_displs += m_recv_counts[pid];
+    }
+  }
+
   void setup_displs(const TensorType &src_tensor,
                     const TensorType &dst_tensor) {
     int num_ranks = m_loc.get_size();
@@ -374,6 +460,24 @@ class TensorMPIShuffleHelper {
     return is_forward ? m_rank_limits_bwd.data() : m_rank_limits_fwd.data();
   }
 
+  bool is_index_mapped() const {
+    return m_index_mapped;
+  }
+
+  const int *get_index_map_fwd(bool is_forward) const {
+    return is_forward ? m_index_map_fwd.data() : m_index_map_bwd.data();
+  }
+  const int *get_index_map_bwd(bool is_forward) const {
+    return is_forward ? m_index_map_bwd.data() : m_index_map_fwd.data();
+  }
+
+  const int *get_index_counts_fwd(bool is_forward) const {
+    return is_forward ? m_index_counts_fwd.data() : m_index_counts_bwd.data();
+  }
+  const int *get_index_counts_bwd(bool is_forward) const {
+    return is_forward ? m_index_counts_bwd.data() : m_index_counts_fwd.data();
+  }
+
   const int *get_send_counts(bool is_forward) const {
     return is_forward ? m_send_counts.data() : m_recv_counts.data();
   }
@@ -404,17 +508,39 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
   static constexpr StreamType default_stream = Stream<Allocator>::default_value;
  public:
 
+  /**
+     @param persistent Keep the buffers and set up persistent requests
+     to the peers at the first shuffle of each direction, so that
+     later shuffles only start and complete them instead of calling
+     MPI_Alltoallv.
+   */
   TensorMPIShuffler(const TensorType &src_tensor,
                     const TensorType &dst_tensor,
                     DataType *src_buf=nullptr,
-                    DataType *dst_buf=nullptr):
-      m_helper(src_tensor, dst_tensor, src_buf, dst_buf) {
+                    DataType *dst_buf=nullptr,
+                    bool persistent=false):
+      m_helper(src_tensor, dst_tensor, src_buf, dst_buf),
+      m_persistent(persistent) {
     assert0(src_tensor.get_overlap().reduce_sum());
     m_fwd_sample_to_spatial = is_sample_to_spatial(src_tensor, dst_tensor);
     m_bwd_sample_to_spatial = is_sample_to_spatial(dst_tensor, src_tensor);
   }
 
-  virtual ~TensorMPIShuffler() = default;
+  // Persistent requests are bound to the buffers of this object
+  TensorMPIShuffler(const TensorMPIShuffler &) = delete;
+  TensorMPIShuffler &operator=(const TensorMPIShuffler &) = delete;
+
+  virtual ~TensorMPIShuffler() {
+    for (auto &reqs: m_requests) {
+      for (auto &req: reqs) {
+        DISTCONV_CHECK_MPI(MPI_Request_free(&req));
+      }
+    }
+  }
+
+  bool is_persistent() const {
+    return m_persistent;
+  }
 
   void shuffle_forward(
       const DataType *src, DataType *dst,
@@ -437,6 +563,13 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
   internal::TensorMPIShuffleHelper<DataType, Allocator> m_helper;
   bool m_fwd_sample_to_spatial;
   bool m_bwd_sample_to_spatial;
+  bool m_persistent;
+  // Send and receive buffers of the backward and forward directions
+  // kept in the persistent mode
+  std::shared_ptr<DataType> m_send_bufs[2];
+  std::shared_ptr<DataType> m_recv_bufs[2];
+  // Persistent requests of each direction
+  std::vector<MPI_Request> m_requests[2];
 
   bool is_sample_to_spatial(const TensorType &src,
                             const TensorType &dst) {
@@ -445,6 +578,10 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
     // Only 4D and 5D tensors
     if (nd != 4 && nd != 5) return false;
 
+    // Only block partitioning
+    if (src.get_distribution().is_cyclic() ||
+        dst.get_distribution().is_cyclic()) return false;
+
     // The source tensor must not have splitting other than the sample
     // dimension.
     for (int i = 0; i < nd - 1; ++i) {
@@ -488,60 +625,26 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
       assert_always(m_helper.get_dst_overlap(is_forward).reduce_sum() == 0);
     }
 
-    const int *rank_limits_fwd = m_helper.get_rank_limits_fwd(is_forward);
-    const int *rank_limits_bwd = m_helper.get_rank_limits_bwd(is_forward);
-    const int *send_displs = m_helper.get_send_displs(is_forward);
-    const int *recv_displs = m_helper.get_recv_displs(is_forward);
-
-    auto send_buf = m_helper.get_src_buf(
-        is_forward, stream,
-        [](size_t c, StreamType s) { return new DataType[c]; },
-        [](DataType *p) { delete[] p; });
-    auto recv_buf = m_helper.get_dst_buf(
-        is_forward, stream,
-        [](size_t c, StreamType s) { return new DataType[c]; },
-        [](DataType *p) { delete[] p; });
-
-    int nd = m_helper.get_num_dims();
+    std::shared_ptr<DataType> send_buf;
+    std::shared_ptr<DataType> recv_buf;
+    if (m_persistent && m_requests[is_forward].size() > 0) {
+      send_buf = m_send_bufs[is_forward];
+      recv_buf = m_recv_bufs[is_forward];
+    } else {
+      send_buf = m_helper.get_src_buf(
+          is_forward, stream,
+          [](size_t c, StreamType s) { return new DataType[c]; },
+          [](DataType *p) { delete[] p; });
+      recv_buf = m_helper.get_dst_buf(
+          is_forward, stream,
+          [](size_t c, StreamType s) { return new DataType[c]; },
+          [](DataType *p) { delete[] p; });
+    }
 
     util::profile_push("pack");
-
     if (!getenv("SKIP_PACK")) {
-      if (m_helper.is_src_split_root(is_forward)) {
-        if (get_sample_to_spatial(is_forward) &&
-            (nd == 4 || nd == 5)) {
-          util::MPIPrintStreamDebug() << "Sample-to-spatial packing";
-          util::profile_push("pack-opt");
-          if (nd == 4) {
-            pack_sample_to_spatial4(
-                src, m_helper.get_src_local_shape(is_forward),
-                m_helper.get_dst_local_shape(is_forward),
-                m_helper.get_dst_locale_shape(is_forward),
-                send_buf.get());
-          } else if (nd == 5) {
-            pack_sample_to_spatial5(
-                src, m_helper.get_src_local_shape(is_forward),
-                m_helper.get_dst_local_shape(is_forward),
-                m_helper.get_dst_locale_shape(is_forward),
-                send_buf.get());
-          }
-          util::profile_pop();
-        } else {
-            util::profile_push("pack-default");
-            util::MPIRootPrintStreamWarning()
-                << "Packing does not use the optimized implementation";
-            pack(src,
-                 m_helper.get_src_local_shape(is_forward),
-                 m_helper.get_src_strides(is_forward),
-                 m_helper.get_dst_locale_shape(is_forward),
-                 rank_limits_fwd,
-                 send_buf.get(),
-                 send_displs);
-            util::profile_pop();
-        }
-      }
+      pack_send_buf(src, send_buf.get(), is_forward);
     }
-
     util::profile_pop(); // pack
 
     util::profile_push("transfer");
@@ -551,50 +654,116 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
     util::profile_pop();
 
     util::profile_push("unpack");
-    // unpack
     if (!getenv("SKIP_UNPACK")) {
-      if (m_helper.is_dst_split_root(is_forward)) {
-        if (get_sample_to_spatial(is_forward)) {
-            util::profile_push("unpack-opt");
-            util::MPIPrintStreamDebug() << "Sample-to-spatial unpacking";
-            if (nd == 4)
-            {
-                unpack_sample_to_spatial_halo4(
-                    dst,
-                    m_helper.get_dst_local_shape(is_forward),
-                    m_helper.get_dst_strides(is_forward),
-                    recv_buf.get(),
-                    m_helper.get_dst_overlap(is_forward));
-            }
-            else
-            {
-                unpack_sample_to_spatial_halo5(
-                    dst,
-                    m_helper.get_dst_local_shape(is_forward),
-                    m_helper.get_dst_strides(is_forward),
-                    recv_buf.get(),
-                    m_helper.get_dst_overlap(is_forward));
-            }
-            util::profile_pop();
-        } else {
-            util::profile_push("unpack-default");
-            unpack(dst,
-                   m_helper.get_dst_local_shape(is_forward),
-                   m_helper.get_dst_strides(is_forward),
-                   m_helper.get_src_locale_shape(is_forward),
-                   rank_limits_bwd,
-                   recv_buf.get(),
-                   recv_displs);
-            util::profile_pop();
-        }
-      }
+      unpack_recv_buf(dst, recv_buf.get(), is_forward);
     }
     util::profile_pop();
   }
 
+  // Packs the local source tensor into the send buffer ordered by
+  // destination ranks.
+  virtual void pack_send_buf(const DataType *src, DataType *send_buf,
+                             bool is_forward) {
+    if (!m_helper.is_src_split_root(is_forward)) return;
+    const int nd = m_helper.get_num_dims();
+    if (get_sample_to_spatial(is_forward) &&
+        (nd == 4 || nd == 5)) {
+      util::MPIPrintStreamDebug() << "Sample-to-spatial packing";
+      util::profile_push("pack-opt");
+      if (nd == 4) {
+        pack_sample_to_spatial4(
+            src, m_helper.get_src_local_shape(is_forward),
+            m_helper.get_dst_local_shape(is_forward),
+            m_helper.get_dst_locale_shape(is_forward),
+            send_buf);
+      } else if (nd == 5) {
+        pack_sample_to_spatial5(
+            src, m_helper.get_src_local_shape(is_forward),
+            m_helper.get_dst_local_shape(is_forward),
+            m_helper.get_dst_locale_shape(is_forward),
+            send_buf);
+      }
+      util::profile_pop();
+    } else if (m_helper.is_index_mapped()) {
+      util::profile_push("pack-index-map");
+      pack_by_index_map(src,
+                        m_helper.get_src_local_shape(is_forward),
+                        m_helper.get_dst_locale_shape(is_forward),
+                        m_helper.get_index_map_fwd(is_forward),
+                        m_helper.get_index_counts_fwd(is_forward),
+                        send_buf,
+                        m_helper.get_send_displs(is_forward));
+      util::profile_pop();
+    } else {
+      util::profile_push("pack-default");
+      util::MPIRootPrintStreamWarning()
+          << "Packing does not use the optimized implementation";
+      pack(src,
+           m_helper.get_src_local_shape(is_forward),
+           m_helper.get_src_strides(is_forward),
+           m_helper.get_dst_locale_shape(is_forward),
+           m_helper.get_rank_limits_fwd(is_forward),
+           send_buf,
+           m_helper.get_send_displs(is_forward));
+      util::profile_pop();
+    }
+  }
+
+  // Unpacks the receive buffer, which is ordered by source ranks,
+  // into the local destination tensor.
+  virtual void unpack_recv_buf(DataType *dst, DataType *recv_buf,
+                               bool is_forward) {
+    if (!m_helper.is_dst_split_root(is_forward)) return;
+    const int nd = m_helper.get_num_dims();
+    if (get_sample_to_spatial(is_forward)) {
+      util::profile_push("unpack-opt");
+      util::MPIPrintStreamDebug() << "Sample-to-spatial unpacking";
+      if (nd == 4) {
+        unpack_sample_to_spatial_halo4(
+            dst,
+            m_helper.get_dst_local_shape(is_forward),
+            m_helper.get_dst_strides(is_forward),
+            recv_buf,
+            m_helper.get_dst_overlap(is_forward));
+      } else {
+        unpack_sample_to_spatial_halo5(
+            dst,
+            m_helper.get_dst_local_shape(is_forward),
+            m_helper.get_dst_strides(is_forward),
+            recv_buf,
+            m_helper.get_dst_overlap(is_forward));
+      }
+      util::profile_pop();
+    } else if (m_helper.is_index_mapped()) {
+      util::profile_push("unpack-index-map");
+      unpack_by_index_map(dst,
+                          m_helper.get_dst_local_shape(is_forward),
+                          m_helper.get_src_locale_shape(is_forward),
+                          m_helper.get_index_map_bwd(is_forward),
+                          m_helper.get_index_counts_bwd(is_forward),
+                          recv_buf,
+                          m_helper.get_recv_displs(is_forward));
+      util::profile_pop();
+    } else {
+      util::profile_push("unpack-default");
+      unpack(dst,
+             m_helper.get_dst_local_shape(is_forward),
+             m_helper.get_dst_strides(is_forward),
+             m_helper.get_src_locale_shape(is_forward),
+             m_helper.get_rank_limits_bwd(is_forward),
+             recv_buf,
+             m_helper.get_recv_displs(is_forward));
+      util::profile_pop();
+    }
+  }
+
   virtual void transfer(const std::shared_ptr<DataType> &send_buf,
                         std::shared_ptr<DataType> &recv_buf,
                         bool is_forward) {
+    if (m_persistent) {
+      transfer_persistent(send_buf, recv_buf, is_forward);
+      return;
+    }
     MPI_Alltoallv(send_buf.get(),
                   m_helper.get_send_counts(is_forward),
                   m_helper.get_send_displs(is_forward),
@@ -607,6 +776,48 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
     util::MPIPrintStreamDebug() << "Transfer done";
   }
 
+  // Exchanges the buffers with the peers using persistent requests,
+  // which are set up at the first call of each direction.
+  void transfer_persistent(const std::shared_ptr<DataType> &send_buf,
+                           std::shared_ptr<DataType> &recv_buf,
+                           bool is_forward) {
+    auto &reqs = m_requests[is_forward];
+    if (reqs.empty()) {
+      // Messages of the two directions are told apart by their tags
+      const int tag = is_forward ? 1 : 0;
+      const auto type = util::get_mpi_data_type<DataType>();
+      MPI_Comm comm = m_helper.m_loc.get_comm();
+      const int *send_counts = m_helper.get_send_counts(is_forward);
+      const int *recv_counts = m_helper.get_recv_counts(is_forward);
+      const int *send_displs = m_helper.get_send_displs(is_forward);
+      const int *recv_displs = m_helper.get_recv_displs(is_forward);
+      for (int peer: m_helper.m_peers) {
+        if (recv_counts[peer] > 0) {
+          reqs.push_back(MPI_REQUEST_NULL);
+          DISTCONV_CHECK_MPI(MPI_Recv_init(
+              recv_buf.get() + recv_displs[peer], recv_counts[peer], type,
+              peer, tag, comm, &reqs.back()));
+        }
+        if (send_counts[peer] > 0) {
+          reqs.push_back(MPI_REQUEST_NULL);
+          DISTCONV_CHECK_MPI(MPI_Send_init(
+              send_buf.get() + send_displs[peer], send_counts[peer], type,
+              peer, tag, comm, &reqs.back()));
+        }
+      }
+      m_send_bufs[is_forward] = send_buf;
+      m_recv_bufs[is_forward] = recv_buf;
+    }
+    // The requests are bound to the buffers
+    assert_eq(send_buf.get(), m_send_bufs[is_forward].get());
+    assert_eq(recv_buf.get(), m_recv_bufs[is_forward].get());
+    if (reqs.empty()) return;
+    DISTCONV_CHECK_MPI(MPI_Startall(reqs.size(), reqs.data()));
+    DISTCONV_CHECK_MPI(MPI_Waitall(reqs.size(), reqs.data(),
+                                   MPI_STATUSES_IGNORE));
+    util::MPIPrintStreamDebug() << "Transfer done";
+  }
+
 #if 0
   virtual void transfer_sample_to_spatial(
       const std::shared_ptr<DataType> &send_buf,
@@ -683,6 +894,64 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
     }
   }
 
+  // Counterpart of find_destination for index-mapped shuffles.
+  void find_destination_by_index_map(const IndexVector &src_local_idx,
+                                     const Shape &src_local_shape,
+                                     const Shape &dst_locale_shape,
+                                     const int * __restrict__ index_map,
+                                     const int * __restrict__ index_counts,
+                                     int &dst_rank, size_t &dst_offset) {
+    dst_rank = 0;
+    dst_offset = 0;
+    int rank_dim_offset = 1;
+    size_t local_linear_offset = 1;
+    int index_map_idx = 0;
+    int index_counts_idx = 0;
+    const int ND = src_local_idx.length();
+    for (int i = 0; i < ND; ++i) {
+      const int *entry = index_map + (index_map_idx + src_local_idx[i]) * 2;
+      int dst_rank_idx = entry[0];
+      dst_rank += dst_rank_idx * rank_dim_offset;
+      rank_dim_offset *= dst_locale_shape[i];
+      dst_offset += entry[1] * local_linear_offset;
+      local_linear_offset *= index_counts[index_counts_idx + dst_rank_idx];
+      index_map_idx += src_local_shape[i];
+      index_counts_idx += dst_locale_shape[i];
+    }
+  }
+
+  void pack_by_index_map(const DataType *src, const Shape &src_local_shape,
+                         const Shape &dst_locale_shape,
+                         const int *index_map, const int *index_counts,
+                         DataType *buf, const int *displs) {
+    const size_t size = src_local_shape.size();
+    for (size_t offset = 0; offset < size; ++offset) {
+      const auto idx = src_local_shape.get_index(offset);
+      int rank;
+      size_t packed_buf_offset;
+      find_destination_by_index_map(idx, src_local_shape, dst_locale_shape,
+                                    index_map, index_counts,
+                                    rank, packed_buf_offset);
+      buf[displs[rank] + packed_buf_offset] = src[offset];
+    }
+  }
+
+  void unpack_by_index_map(DataType *dst, const Shape &dst_local_shape,
+                           const Shape &src_locale_shape,
+                           const int *index_map, const int *index_counts,
+                           const DataType *buf, const int *displs) {
+    const size_t size = dst_local_shape.size();
+    for (size_t offset = 0; offset < size; ++offset) {
+      const auto idx = dst_local_shape.get_index(offset);
+      int rank;
+      size_t packed_buf_offset;
+      find_destination_by_index_map(idx, dst_local_shape, src_locale_shape,
+                                    index_map, index_counts,
+                                    rank, packed_buf_offset);
+      dst[offset] = buf[displs[rank] + packed_buf_offset];
+    }
+  }
+
   // NOTE: packed tensor is assumed
   void pack(const DataType *src, const Shape &src_local_shape,
             const IndexVector &src_strides, const Shape &dst_locale_shape,
@@ -947,6 +1216,12 @@ class TensorMPIShuffler<DataType, BaseAllocator> {
   }
 };
 
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class TensorMPIShuffler<float, BaseAllocator>;
+extern template class TensorMPIShuffler<double, BaseAllocator>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
 } // namespace tensor
 } // namespace distconv
 
@@ -39,6 +39,9 @@ class TensorMPICUDAShuffler {
       m_send_displs_d(nullptr), m_recv_displs_d(nullptr),
       m_src_buf(src_buf), m_dst_buf(dst_buf),
       m_src_buf_passed(src_buf != nullptr), m_dst_buf_passed(dst_buf != nullptr) {
+    // The packing kernels assume block partitioning.
+    assert_always(!src_tensor.get_distribution().is_cyclic() &&
+                  !dst_tensor.get_distribution().is_cyclic());
     setup_rank_limits(src_tensor, dst_tensor, m_rank_limits_fwd);
     setup_rank_limits(dst_tensor, src_tensor, m_rank_limits_bwd);
     setup_displs(src_tensor, dst_tensor);
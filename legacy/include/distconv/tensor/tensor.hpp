@@ -320,6 +320,11 @@ class Tensor: public AbstractTensor {
      @return The dimension of the local tensor.
    */
   index_t get_remote_dimension(int dim, index_t rank_idx) const {
+    if (get_distribution().is_cyclic(dim)) {
+      return get_distribution().get_cyclic_local_size(
+          dim, get_shape()[dim],
+          rank_idx / get_distribution().get_num_ranks_per_split(dim));
+    }
     auto loc_shape = get_locale_shape();
     index_t offset = get_dimension_rank_offset(dim, rank_idx);
     index_t next_offset = get_shape()[dim];
@@ -404,17 +409,20 @@ class Tensor: public AbstractTensor {
     return m_impl.get_local_size();
   }
 
-  int allocate() {
-    if (m_shape.is_empty()) {
-      util::PrintStreamError() << "Empty shape";
-      return -1;
+  // Allocate the local buffer, reporting failures such as memory
+  // exhaustion to the caller rather than aborting.
+  h2::Expected<void> try_allocate() {
+    if (H2_UNLIKELY(m_shape.is_empty())) {
+      return H2_UNEXPECTED(InvalidArgument, "Empty shape");
     }
-    if (m_dist.get_locale_shape().is_empty()) {
-      util::PrintStreamError() <<
-          "Empty locale shape: " << m_dist.get_locale_shape();
-      return -1;
+    if (H2_UNLIKELY(m_dist.get_locale_shape().is_empty())) {
+      return H2_UNEXPECTED(InvalidArgument, "Empty locale shape");
     }
-    return m_impl.allocate();
+    return m_impl.try_allocate();
+  }
+
+  int allocate() {
+    return util::to_status(try_allocate());
   }
 
   int nullify() {
@@ -434,8 +442,11 @@ class Tensor: public AbstractTensor {
    * The buffer must have the same size and other properties as they
    * were allocated by this class.
    */
+  // A template so that explicitly instantiating this class does not
+  // require every Memory to support attaching.
+  template <typename Alloc = Allocator>
   int attach(DataType *buffer) {
-    return m_data.attach(buffer);
+    return static_cast<Memory<Alloc> &>(m_data).attach(buffer);
   }
 
   DataType get(const IndexVector &local_idx,
@@ -489,9 +500,10 @@ class Tensor: public AbstractTensor {
     m_data.memset(0, stream);
   }
 
-  void scale(DataType v, typename Stream<Allocator>::type stream=
-             Stream<Allocator>::default_value) {
-    m_impl.scale(v, stream);
+  template <typename Alloc = Allocator>
+  void scale(DataType v, typename Stream<Alloc>::type stream=
+             Stream<Alloc>::default_value) {
+    m_impl.template scale<Alloc>(v, stream);
   }
 
   // REFACTORING: Replace this with get_halo_width
@@ -507,10 +519,11 @@ class Tensor: public AbstractTensor {
     return get_distribution().get_overlap(dim);
   }
 
+  template <typename Alloc = Allocator>
   void clear_halo(int dim,
-                  typename Stream<Allocator>::type stream=
-                  Stream<Allocator>::default_value) {
-    m_impl.clear_halo(dim, stream);
+                  typename Stream<Alloc>::type stream=
+                  Stream<Alloc>::default_value) {
+    m_impl.template clear_halo<Alloc>(dim, stream);
   }
 
   std::ostream &print(std::ostream &os) const {
@@ -95,7 +95,7 @@ class TensorImpl<Tensor<DataType, LocaleCUDA, Allocator>> {
     return get_local_shape(true).get_size();
   }
 
-  int allocate() {
+  h2::Expected<void> try_allocate() {
     const auto &dist = m_tensor->get_distribution();
     const auto &locale_shape = dist.get_locale_shape();
     // MPI num procs must be equal to the locale shape size
@@ -109,9 +109,13 @@ class TensorImpl<Tensor<DataType, LocaleCUDA, Allocator>> {
         << m_tensor->m_locale.get_rank() << ": "
         << "num_local_elements: " << num_local_elements;
     assert_always(num_local_elements > 0);
-    m_tensor->m_data.allocate(num_local_elements * sizeof(DataType),
-                              get_local_real_shape()[0] * sizeof(DataType));
-    return 0;
+    return m_tensor->m_data.try_allocate(
+        num_local_elements * sizeof(DataType),
+        get_local_real_shape()[0] * sizeof(DataType));
+  }
+
+  int allocate() {
+    return util::to_status(try_allocate());
   }
 
   void nullify() {
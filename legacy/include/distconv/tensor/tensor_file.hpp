@@ -0,0 +1,549 @@
+#pragma once
+
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include "mpi.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+  Chunked on-disk tensor format.
+
+  A file consists of a header, a chunk table and the chunks:
+
+    char magic[8]           "DCTENSOR"
+    uint32 version
+    uint32 data type        TensorFileDataType
+    uint32 element size
+    uint32 number of dimensions (nd)
+    uint32 flags            TensorFile::has_checksums
+    uint32 reserved
+    uint64 global shape[nd]
+    uint64 chunk grid[nd]   number of chunks of each dimension
+    {uint64 offset, uint64 checksum}[number of chunks]
+
+  Dimensions are ordered from the innermost one as in tensor shapes,
+  and chunks are numbered with the first dimension moving fastest. A
+  dimension of size n split into c chunks has chunks of n / c
+  elements, and the first n % c chunks have one more, as tensors
+  partition dimensions. A file written from a tensor thus has one
+  chunk per partition. Each chunk is stored contiguously with the
+  first dimension fastest and starts at a page boundary, so that a
+  process reading its chunk only touches its own pages. Checksums are
+  64-bit FNV-1a hashes of the chunk bytes. Values are stored in the
+  native byte order.
+ */
+
+namespace distconv {
+namespace tensor {
+
+template <typename DataType>
+struct TensorFileDataType;
+
+template <> struct TensorFileDataType<float> {
+  static constexpr uint32_t value = 1;
+};
+template <> struct TensorFileDataType<double> {
+  static constexpr uint32_t value = 2;
+};
+template <> struct TensorFileDataType<int> {
+  static constexpr uint32_t value = 3;
+};
+template <> struct TensorFileDataType<long> {
+  static constexpr uint32_t value = 4;
+};
+
+namespace internal {
+
+constexpr size_t tensor_file_alignment = 4096;
+
+inline uint64_t align_tensor_file_offset(uint64_t x) {
+  return (x + tensor_file_alignment - 1) / tensor_file_alignment
+      * tensor_file_alignment;
+}
+
+inline uint64_t fnv1a_hash(const void *p, size_t len) {
+  const unsigned char *b = static_cast<const unsigned char*>(p);
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; ++i) {
+    h ^= b[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// Offset and size of a chunk along a dimension of size n split into
+// c chunks
+inline index_t get_chunk_offset(index_t n, index_t c, index_t i) {
+  return i * (n / c) + std::min(i, n % c);
+}
+
+inline index_t get_chunk_size(index_t n, index_t c, index_t i) {
+  return n / c + (i < n % c ? 1 : 0);
+}
+
+inline uint64_t get_tensor_file_table_offset(int nd) {
+  return 32 + nd * 16;
+}
+
+// Offsets of the chunks followed by the file size
+inline std::vector<uint64_t> get_tensor_file_offsets(
+    const Shape &shape, const Shape &chunk_grid, size_t element_size) {
+  const int nd = shape.num_dims();
+  const index_t num_chunks = chunk_grid.get_size();
+  std::vector<uint64_t> offsets(num_chunks + 1);
+  offsets[0] = align_tensor_file_offset(
+      get_tensor_file_table_offset(nd) + num_chunks * 16);
+  for (index_t c = 0; c < num_chunks; ++c) {
+    index_t rem = c;
+    uint64_t bytes = element_size;
+    for (int i = 0; i < nd; ++i) {
+      bytes *= get_chunk_size(shape[i], chunk_grid[i], rem % chunk_grid[i]);
+      rem /= chunk_grid[i];
+    }
+    offsets[c + 1] = align_tensor_file_offset(offsets[c] + bytes);
+  }
+  return offsets;
+}
+
+// Header and chunk table, padded to the first chunk
+inline std::vector<char> make_tensor_file_header(
+    uint32_t version, uint32_t data_type, uint32_t element_size,
+    uint32_t flags, const Shape &shape, const Shape &chunk_grid,
+    const std::vector<uint64_t> &offsets,
+    const std::vector<uint64_t> &hashes) {
+  const int nd = shape.num_dims();
+  std::vector<char> header(offsets[0], 0);
+  std::memcpy(header.data(), "DCTENSOR", 8);
+  const uint32_t fields[6] = {
+    version, data_type, element_size, (uint32_t)nd, flags, 0};
+  std::memcpy(header.data() + 8, fields, sizeof(fields));
+  uint64_t *dims = reinterpret_cast<uint64_t*>(header.data() + 32);
+  for (int i = 0; i < nd; ++i) {
+    dims[i] = shape[i];
+    dims[nd + i] = chunk_grid[i];
+  }
+  uint64_t *table = dims + 2 * nd;
+  for (size_t c = 0; c < hashes.size(); ++c) {
+    table[c * 2] = offsets[c];
+    table[c * 2 + 1] = hashes[c];
+  }
+  return header;
+}
+
+// Copies the interior of the local partition to a contiguous host
+// buffer
+template <typename DataType, typename Allocator>
+std::vector<DataType> pack_local_interior(
+    const Tensor<DataType, LocaleMPI, Allocator> &t) {
+  const int nd = t.get_num_dims();
+  const auto local_shape = t.get_local_shape();
+  const auto real_shape = t.get_local_real_shape();
+  std::vector<DataType> real_buf(t.get_local_real_size());
+  t.get_data().copyout(real_buf.data());
+  std::vector<DataType> buf(t.get_local_size());
+  if (buf.empty()) return buf;
+  const index_t row_len = local_shape[0];
+  for (index_t r = 0; r < (index_t)buf.size() / row_len; ++r) {
+    IndexVector idx(nd, 0);
+    index_t rem = r;
+    for (int i = 1; i < nd; ++i) {
+      idx[i] = rem % local_shape[i];
+      rem /= local_shape[i];
+    }
+    auto src_idx = idx + t.get_halo_width();
+    std::memcpy(&buf[r * row_len],
+                &real_buf[get_offset(src_idx, real_shape)],
+                row_len * sizeof(DataType));
+  }
+  return buf;
+}
+
+} // namespace internal
+
+class TensorFile {
+ public:
+  static constexpr uint32_t version = 1;
+  static constexpr uint32_t has_checksums = 1;
+
+  /**
+     Open and memory-map a file. Pages are read only when accessed.
+   */
+  TensorFile(const std::string &path): m_path(path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      util::MPIPrintStreamError() << "Failed to open " << path;
+      std::abort();
+    }
+    struct stat st;
+    assert0(fstat(fd, &st));
+    m_size = st.st_size;
+    // Writes to views are private to the process
+    m_addr = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                  fd, 0);
+    close(fd);
+    if (m_addr == MAP_FAILED) {
+      util::MPIPrintStreamError() << "Failed to map " << path;
+      std::abort();
+    }
+    parse_header();
+  }
+
+  ~TensorFile() {
+    munmap(m_addr, m_size);
+  }
+
+  TensorFile(const TensorFile &) = delete;
+  TensorFile &operator=(const TensorFile &) = delete;
+
+  const Shape &get_shape() const {
+    return m_shape;
+  }
+
+  const Shape &get_chunk_grid() const {
+    return m_chunk_grid;
+  }
+
+  uint32_t get_data_type() const {
+    return m_data_type;
+  }
+
+  index_t get_num_chunks() const {
+    return m_chunk_grid.get_size();
+  }
+
+  // Shape of a chunk given its index in the chunk grid
+  Shape get_chunk_shape(const IndexVector &chunk_idx) const {
+    Shape s(m_shape.num_dims(), 0);
+    for (int i = 0; i < m_shape.num_dims(); ++i) {
+      s[i] = internal::get_chunk_size(m_shape[i], m_chunk_grid[i],
+                                      chunk_idx[i]);
+    }
+    return s;
+  }
+
+  const void *get_chunk(index_t chunk) const {
+    return static_cast<const char*>(m_addr) + get_chunk_entry(chunk)[0];
+  }
+
+  bool verify_chunk(index_t chunk, size_t bytes) const {
+    if (!(m_flags & has_checksums)) return true;
+    return internal::fnv1a_hash(get_chunk(chunk), bytes) ==
+        get_chunk_entry(chunk)[1];
+  }
+
+  /**
+     Set t to a zero-copy view of its chunk.
+
+     The distribution of t must split the tensor as the chunks with no
+     halo. Returns non-zero otherwise.
+   */
+  template <typename DataType>
+  int view(Tensor<DataType, LocaleMPI, BaseAllocator> &t) const {
+    // Chunks are contiguous boxes, so cyclic partitions are not
+    // supported by any of the accessors.
+    assert_always(!t.get_distribution().is_cyclic());
+    if (check_type<DataType>() || check_shape(t.get_shape())) return -1;
+    const auto &dist = t.get_distribution();
+    for (int i = 0; i < t.get_num_dims(); ++i) {
+      if (dist.get_split_shape()[i] != m_chunk_grid[i] ||
+          dist.get_overlap(i) != 0) {
+        util::MPIPrintStreamError()
+            << "Distribution " << dist << " does not match chunk grid "
+            << m_chunk_grid << " of " << m_path;
+        return -1;
+      }
+    }
+    if (t.get_local_size() == 0) return 0;
+    const index_t chunk = get_offset(t.get_split_index(), m_chunk_grid);
+    void *p = static_cast<char*>(m_addr) + get_chunk_entry(chunk)[0];
+    const size_t bytes = t.get_local_size() * sizeof(DataType);
+    madvise(align_down(p), bytes + ((char*)p - (char*)align_down(p)),
+            MADV_WILLNEED);
+    t.set_view(p);
+    return 0;
+  }
+
+  /**
+     Copy the interior of t from the file. Any distribution can be
+     used, and only the chunks overlapping with the local partition
+     are accessed.
+   */
+  template <typename DataType, typename Allocator>
+  int read(Tensor<DataType, LocaleMPI, Allocator> &t,
+           bool verify=false) const {
+    assert_always(!t.get_distribution().is_cyclic());
+    if (check_type<DataType>() || check_shape(t.get_shape())) return -1;
+    if (t.get_local_size() == 0) return 0;
+    std::vector<DataType> buf(t.get_local_real_size());
+    t.get_data().copyout(buf.data());
+    if (read_region(t.get_global_index(), t.get_local_shape(), buf.data(),
+                    t.get_local_real_shape(), t.get_halo_width(),
+                    verify)) {
+      return -1;
+    }
+    t.get_data().copyin(buf.data());
+    return 0;
+  }
+
+  /**
+     Copy the region of the given shape starting at global index
+     offset into buf, a host buffer of buf_shape, at buf_offset. Only
+     the chunks overlapping with the region are accessed.
+   */
+  template <typename DataType>
+  int read_region(const IndexVector &offset, const Shape &shape,
+                  DataType *buf, const Shape &buf_shape,
+                  const IndexVector &buf_offset, bool verify=false) const {
+    if (check_type<DataType>()) return -1;
+    const int nd = m_shape.num_dims();
+    assert_eq(shape.num_dims(), nd);
+    if (shape.get_size() == 0) return 0;
+    for (int i = 0; i < nd; ++i) {
+      assert_always(offset[i] + shape[i] <= m_shape[i]);
+    }
+
+    // Range of chunks overlapping with the region
+    IndexVector first(nd, 0), num(nd, 0);
+    for (int i = 0; i < nd; ++i) {
+      const index_t lo = offset[i];
+      const index_t hi = lo + shape[i];
+      index_t c = 0;
+      while (internal::get_chunk_offset(m_shape[i], m_chunk_grid[i], c + 1)
+             <= lo) ++c;
+      first[i] = c;
+      while (c < m_chunk_grid[i] &&
+             internal::get_chunk_offset(m_shape[i], m_chunk_grid[i], c) < hi) {
+        ++c;
+      }
+      num[i] = c - first[i];
+    }
+    const Shape num_shape(num);
+    for (index_t n = 0; n < num_shape.get_size(); ++n) {
+      IndexVector chunk_idx(nd, 0);
+      index_t rem = n;
+      for (int i = 0; i < nd; ++i) {
+        chunk_idx[i] = first[i] + rem % num[i];
+        rem /= num[i];
+      }
+      const index_t chunk = get_offset(chunk_idx, m_chunk_grid);
+      const auto chunk_shape = get_chunk_shape(chunk_idx);
+      const auto *src = static_cast<const DataType*>(get_chunk(chunk));
+      if (verify && !verify_chunk(chunk, chunk_shape.get_size() *
+                                  sizeof(DataType))) {
+        util::MPIPrintStreamError()
+            << "Checksum mismatch of chunk " << chunk << " of " << m_path;
+        return -1;
+      }
+      // Intersection of the chunk and the region in global indices
+      IndexVector lo(nd, 0), box(nd, 0);
+      for (int i = 0; i < nd; ++i) {
+        const index_t c_lo = internal::get_chunk_offset(
+            m_shape[i], m_chunk_grid[i], chunk_idx[i]);
+        lo[i] = std::max(c_lo, offset[i]);
+        const index_t hi = std::min(c_lo + chunk_shape[i],
+                                    offset[i] + shape[i]);
+        box[i] = hi - lo[i];
+      }
+      // Copy rows along the first dimension
+      const Shape box_shape(box);
+      const index_t row_len = box[0];
+      for (index_t r = 0; r < box_shape.get_size() / row_len; ++r) {
+        IndexVector src_idx(nd, 0), dst_idx(nd, 0);
+        index_t rrem = r;
+        for (int i = 0; i < nd; ++i) {
+          const index_t x = i == 0 ? 0 : rrem % box[i];
+          if (i > 0) rrem /= box[i];
+          const index_t g = lo[i] + x;
+          src_idx[i] = g - internal::get_chunk_offset(
+              m_shape[i], m_chunk_grid[i], chunk_idx[i]);
+          dst_idx[i] = g - offset[i] + buf_offset[i];
+        }
+        std::memcpy(&buf[get_offset(dst_idx, buf_shape)],
+                    &src[get_offset(src_idx, chunk_shape)],
+                    row_len * sizeof(DataType));
+      }
+    }
+    return 0;
+  }
+
+  /**
+     Write a tensor collectively with one chunk per partition.
+   */
+  template <typename DataType, typename Allocator>
+  static int write(const Tensor<DataType, LocaleMPI, Allocator> &t,
+                   const std::string &path, bool checksums=true) {
+    assert_always(!t.get_distribution().is_cyclic());
+    MPI_Comm comm = t.get_locale().get_comm();
+    const int nd = t.get_num_dims();
+    const auto &shape = t.get_shape();
+    const auto &chunk_grid = t.get_distribution().get_split_shape();
+    const index_t num_chunks = chunk_grid.get_size();
+    // Every process computes the offsets of all chunks
+    const auto offsets = internal::get_tensor_file_offsets(
+        shape, chunk_grid, sizeof(DataType));
+
+    MPI_File fh;
+    DISTCONV_CHECK_MPI(MPI_File_open(comm, path.c_str(),
+                                     MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                     MPI_INFO_NULL, &fh));
+    DISTCONV_CHECK_MPI(MPI_File_set_size(fh, offsets[num_chunks]));
+
+    // Each chunk is written by the split root of its partition
+    std::vector<uint64_t> hashes(num_chunks, 0);
+    if (t.get_local_size() > 0 && t.is_split_root()) {
+      const index_t chunk = get_offset(t.get_split_index(), chunk_grid);
+      const auto local_shape = t.get_local_shape();
+      for (int i = 0; i < nd; ++i) {
+        assert_eq(local_shape[i], internal::get_chunk_size(
+            shape[i], chunk_grid[i], t.get_split_index()[i]));
+      }
+      const auto buf = internal::pack_local_interior(t);
+      const size_t bytes = buf.size() * sizeof(DataType);
+      if (checksums) {
+        hashes[chunk] = internal::fnv1a_hash(buf.data(), bytes);
+      }
+      // Writes in pieces as counts are int
+      constexpr size_t max_write = 1 << 30;
+      for (size_t off = 0; off < bytes; off += max_write) {
+        DISTCONV_CHECK_MPI(MPI_File_write_at(
+            fh, offsets[chunk] + off, (char*)buf.data() + off,
+            std::min(max_write, bytes - off), MPI_BYTE,
+            MPI_STATUS_IGNORE));
+      }
+    }
+    DISTCONV_CHECK_MPI(MPI_Reduce(
+        t.get_locale().get_rank() == 0 ? MPI_IN_PLACE : hashes.data(),
+        hashes.data(), num_chunks, MPI_UINT64_T, MPI_BOR, 0, comm));
+
+    if (t.get_locale().get_rank() == 0) {
+      const auto header = internal::make_tensor_file_header(
+          version, TensorFileDataType<DataType>::value, sizeof(DataType),
+          checksums ? has_checksums : 0, shape, chunk_grid, offsets,
+          hashes);
+      DISTCONV_CHECK_MPI(MPI_File_write_at(fh, 0, header.data(),
+                                           header.size(), MPI_BYTE,
+                                           MPI_STATUS_IGNORE));
+    }
+    DISTCONV_CHECK_MPI(MPI_File_close(&fh));
+    return 0;
+  }
+
+ private:
+  std::string m_path;
+  void *m_addr;
+  size_t m_size;
+  uint32_t m_data_type;
+  uint32_t m_element_size;
+  uint32_t m_flags;
+  Shape m_shape;
+  Shape m_chunk_grid;
+  const uint64_t *m_table;
+
+  void parse_header() {
+    const char *p = static_cast<const char*>(m_addr);
+    if (m_size < 32 || std::memcmp(p, "DCTENSOR", 8) != 0) {
+      util::MPIPrintStreamError() << m_path << " is not a tensor file";
+      std::abort();
+    }
+    uint32_t fields[6];
+    std::memcpy(fields, p + 8, sizeof(fields));
+    if (fields[0] != version) {
+      util::MPIPrintStreamError()
+          << "Unsupported version " << fields[0] << " of " << m_path;
+      std::abort();
+    }
+    m_data_type = fields[1];
+    m_element_size = fields[2];
+    const int nd = fields[3];
+    m_flags = fields[4];
+    // The header and the table are checked against the file size
+    // before they are read
+    if (fields[3] > (m_size - 32) / 16) {
+      report_corrupt("header");
+    }
+    const uint64_t *dims = reinterpret_cast<const uint64_t*>(p + 32);
+    m_shape = Shape(nd, 0);
+    m_chunk_grid = Shape(nd, 0);
+    uint64_t num_chunks = 1;
+    for (int i = 0; i < nd; ++i) {
+      m_shape[i] = dims[i];
+      m_chunk_grid[i] = dims[nd + i];
+      if (m_chunk_grid[i] == 0 ||
+          m_chunk_grid[i] > m_size / 16 / num_chunks) {
+        report_corrupt("chunk grid");
+      }
+      num_chunks *= m_chunk_grid[i];
+    }
+    if (internal::get_tensor_file_table_offset(nd) + num_chunks * 16
+        > m_size) {
+      report_corrupt("chunk table");
+    }
+    m_table = dims + 2 * nd;
+    // get_chunk trusts the offsets, so every chunk must be within
+    // the file
+    for (index_t c = 0; c < num_chunks; ++c) {
+      const uint64_t offset = get_chunk_entry(c)[0];
+      uint64_t bytes = m_element_size;
+      index_t rem = c;
+      for (int i = 0; i < nd && bytes > 0; ++i) {
+        const uint64_t size = internal::get_chunk_size(
+            m_shape[i], m_chunk_grid[i], rem % m_chunk_grid[i]);
+        rem /= m_chunk_grid[i];
+        bytes = size > m_size / bytes ? m_size + 1 : bytes * size;
+      }
+      if (offset > m_size || bytes > m_size - offset) {
+        report_corrupt("chunk " + std::to_string(c));
+      }
+    }
+  }
+
+  [[noreturn]] void report_corrupt(const std::string &part) const {
+    util::MPIPrintStreamError()
+        << "Corrupt " << part << " of " << m_path << " of " << m_size
+        << " bytes";
+    std::abort();
+  }
+
+  const uint64_t *get_chunk_entry(index_t chunk) const {
+    return m_table + chunk * 2;
+  }
+
+  static void *align_down(void *p) {
+    const size_t page = sysconf(_SC_PAGESIZE);
+    return (void*)((uintptr_t)p / page * page);
+  }
+
+  template <typename DataType>
+  int check_type() const {
+    if (m_data_type != TensorFileDataType<DataType>::value ||
+        m_element_size != sizeof(DataType)) {
+      util::MPIPrintStreamError()
+          << "Data type of " << m_path << " does not match the tensor";
+      return -1;
+    }
+    return 0;
+  }
+
+  int check_shape(const Shape &shape) const {
+    if (shape != m_shape) {
+      util::MPIPrintStreamError()
+          << "Shape " << m_shape << " of " << m_path
+          << " does not match the tensor shape " << shape;
+      return -1;
+    }
+    return 0;
+  }
+};
+
+} // namespace tensor
+} // namespace distconv
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "distconv/tensor/tensor_file.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <future>
+#include <string>
+#include <vector>
+
+/*
+  Streaming loader of mini-batches from a chunked tensor file.
+
+  A dataset is stored as a single tensor file whose last dimension is
+  the sample dimension. Mini-batch b consists of samples [b * B, (b +
+  1) * B), where B is the number of samples of the destination
+  tensor. Each process reads only the region of its local partition
+  from the chunks overlapping with it, so tensors distributed
+  spatially are loaded directly without shuffling from the sample
+  distribution. The next mini-batch is read by a background thread
+  into one of two host buffers, which are allocated once and reused,
+  while the current one is consumed.
+ */
+
+namespace distconv {
+namespace tensor {
+
+template <typename DataType, typename Allocator>
+class TensorFileLoader {
+ public:
+  using TensorType = Tensor<DataType, LocaleMPI, Allocator>;
+
+  /**
+     Open a dataset to load into tensors distributed as t. Halos of
+     loaded tensors are set to zero.
+   */
+  TensorFileLoader(const std::string &path, const TensorType &t,
+                   bool verify=false):
+      m_file(path), m_verify(verify),
+      m_global_index(t.get_global_index()),
+      m_local_shape(t.get_local_shape()),
+      m_local_real_shape(t.get_local_real_shape()),
+      m_halo_width(t.get_halo_width()),
+      m_cur(0), m_pending_batch(-1) {
+    // Partitions are loaded as contiguous boxes
+    assert_always(!t.get_distribution().is_cyclic());
+    const int nd = t.get_num_dims();
+    const auto &file_shape = m_file.get_shape();
+    bool valid = file_shape.num_dims() == nd &&
+        t.get_shape()[nd - 1] <= file_shape[nd - 1];
+    for (int i = 0; valid && i < nd - 1; ++i) {
+      valid = t.get_shape()[i] == file_shape[i];
+    }
+    if (!valid) {
+      util::MPIPrintStreamError()
+          << "Shape " << file_shape << " of " << path
+          << " does not match the tensor shape " << t.get_shape();
+      std::abort();
+    }
+    m_mini_batch_size = t.get_shape()[nd - 1];
+    m_num_batches = file_shape[nd - 1] / m_mini_batch_size;
+    for (auto &buf: m_buffers) {
+      buf.resize(t.get_local_real_size(), DataType(0));
+    }
+  }
+
+  ~TensorFileLoader() {
+    if (m_future.valid()) m_future.wait();
+  }
+
+  TensorFileLoader(const TensorFileLoader &) = delete;
+  TensorFileLoader &operator=(const TensorFileLoader &) = delete;
+
+  // Remaining samples that do not fill a mini-batch are not loaded
+  index_t get_num_batches() const {
+    return m_num_batches;
+  }
+
+  /**
+     Start reading a mini-batch in the background.
+   */
+  void prefetch(index_t batch) {
+    if (m_future.valid()) m_future.wait();
+    batch %= m_num_batches;
+    m_pending_batch = batch;
+    const int buf_idx = (m_cur + 1) % 2;
+    auto offset = m_global_index;
+    offset[offset.length() - 1] += batch * m_mini_batch_size;
+    m_future = std::async(std::launch::async, [this, offset, buf_idx]() {
+      return m_file.read_region(offset, m_local_shape,
+                                m_buffers[buf_idx].data(),
+                                m_local_real_shape, m_halo_width,
+                                m_verify);
+    });
+  }
+
+  /**
+     Load a mini-batch into t and start prefetching the next one.
+
+     The mini-batch is taken from the prefetched buffer when it has
+     been prefetched, and is read synchronously otherwise. Batch
+     indices wrap around the number of mini-batches.
+   */
+  int load(TensorType &t, index_t batch) {
+    batch %= m_num_batches;
+    if (!m_future.valid() || m_pending_batch != batch) {
+      prefetch(batch);
+    }
+    const int ret = m_future.get();
+    m_cur = (m_cur + 1) % 2;
+    if (ret) return ret;
+    if (t.get_local_size() > 0) {
+      t.get_data().copyin(m_buffers[m_cur].data());
+    }
+    prefetch(batch + 1);
+    return 0;
+  }
+
+ private:
+  TensorFile m_file;
+  bool m_verify;
+  IndexVector m_global_index;
+  Shape m_local_shape;
+  Shape m_local_real_shape;
+  IndexVector m_halo_width;
+  index_t m_mini_batch_size;
+  index_t m_num_batches;
+  std::vector<DataType> m_buffers[2];
+  int m_cur;
+  index_t m_pending_batch;
+  std::future<int> m_future;
+};
+
+} // namespace tensor
+} // namespace distconv
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
 #include <type_traits>
 #include <vector>
 #include <cstring>
@@ -92,6 +93,169 @@ class LocaleMPI {
   int m_num_procs;
 };
 
+namespace internal {
+
+// Offsets of a dimension at each rank index of the dimension, and the
+// largest local size of the dimension. Copies of a tensor share the
+// same object.
+struct DimensionOffsets {
+  std::vector<index_t> offsets;
+  index_t max_local_size = 0;
+};
+
+using DimensionOffsetsPtr = std::shared_ptr<const DimensionOffsets>;
+
+// Size of a split of a dimension that is evenly partitioned in units
+// of block_size. The remainder of the block size is taken by the last
+// split.
+inline index_t get_block_partition_size(index_t size, index_t num_splits,
+                                        index_t block_size,
+                                        index_t split_idx) {
+  index_t num_blocks = size / block_size;
+  index_t local_size = num_blocks / num_splits;
+  if (split_idx < num_blocks % num_splits) ++local_size;
+  local_size *= block_size;
+  if (split_idx == num_splits - 1) local_size += size % block_size;
+  return local_size;
+}
+
+// Offsets of an evenly partitioned dimension
+inline DimensionOffsetsPtr get_block_partition_offsets(
+    index_t num_ranks, index_t num_ranks_per_split, index_t size,
+    index_t block_size) {
+  auto p = std::make_shared<DimensionOffsets>();
+  p->offsets.resize(num_ranks);
+  const index_t num_splits = num_ranks / num_ranks_per_split;
+  index_t cur_offset = 0;
+  for (index_t i = 0; i < num_splits; ++i) {
+    index_t local_size = get_block_partition_size(
+        size, num_splits, block_size, i);
+    for (index_t j = 0; j < num_ranks_per_split; ++j) {
+      p->offsets[i * num_ranks_per_split + j] = cur_offset;
+    }
+    p->max_local_size = std::max(p->max_local_size, local_size);
+    cur_offset += local_size;
+  }
+  return p;
+}
+
+// A dimension whose offsets are computed from the local sizes of all
+// the ranks along the dimension
+struct OffsetExchangeEntry {
+  MPI_Comm comm;
+  Shape locale_shape;
+  IndexVector rank_idx;
+  int dim;
+  index_t num_ranks_per_split;
+  index_t size;
+  index_t local_size;
+  std::shared_ptr<DimensionOffsets> offsets;
+};
+
+// Fills the offsets of the entries. Collective over the communicators
+// of the entries, which must be given in the same order at all
+// processes. There is one Allgather for each communicator.
+inline void exchange_offsets(const std::vector<OffsetExchangeEntry> &entries) {
+  std::vector<bool> done(entries.size(), false);
+  for (size_t first = 0; first < entries.size(); ++first) {
+    if (done[first]) continue;
+    MPI_Comm comm = entries[first].comm;
+    std::vector<size_t> group;
+    std::vector<index_t> local_sizes;
+    for (size_t i = first; i < entries.size(); ++i) {
+      if (entries[i].comm != comm) continue;
+      group.push_back(i);
+      local_sizes.push_back(entries[i].local_size);
+      done[i] = true;
+    }
+    int num_procs;
+    DISTCONV_CHECK_MPI(MPI_Comm_size(comm, &num_procs));
+    const size_t n = group.size();
+    std::vector<index_t> all_sizes(n * num_procs);
+    DISTCONV_CHECK_MPI(MPI_Allgather(
+        local_sizes.data(), n * sizeof(index_t), MPI_BYTE,
+        all_sizes.data(), n * sizeof(index_t), MPI_BYTE, comm));
+
+    for (size_t k = 0; k < n; ++k) {
+      const auto &e = entries[group[k]];
+      auto &offsets = e.offsets->offsets;
+      offsets.resize(e.locale_shape[e.dim]);
+      auto rank_idx = e.rank_idx;
+      index_t cur_offset = 0;
+      index_t next_offset = 0;
+      for (index_t j = 0; j < offsets.size(); j += e.num_ranks_per_split) {
+        rank_idx[e.dim] = j;
+        index_t rank = get_offset(rank_idx, e.locale_shape);
+        next_offset = cur_offset + all_sizes[rank * n + k];
+        for (index_t l = 0; l < e.num_ranks_per_split; ++l) {
+          offsets[j + l] = cur_offset;
+        }
+        e.offsets->max_local_size = std::max(e.offsets->max_local_size,
+                                             next_offset - cur_offset);
+        cur_offset = next_offset;
+      }
+      // The total size of dimension must match the size of the tensor
+      if (next_offset != e.size) {
+        util::MPIPrintStreamError()
+            << "The total size of dimension does not match the size of the tensor. "
+            << "Dim: " << e.dim
+            << ", computed: " << next_offset
+            << ", tensor shape: " << e.size
+            << ", local shape: " << e.local_size
+            << ", locale shape: " << e.locale_shape;
+        std::abort();
+      }
+    }
+  }
+}
+
+} // namespace internal
+
+/**
+   Batches the exchange of local sizes of tensors with requested local
+   shapes.
+
+   While an object is alive on a thread, MPI tensors created on the
+   thread do not exchange their local sizes. The exchange is done for
+   all of them at once by flush() or the destructor, with a single
+   Allgather for each communicator. Offsets of the tensors, e.g.,
+   global indices, must not be used before that. Tensors must be
+   created in the same order at all processes.
+ */
+class OffsetExchangeBatch {
+ public:
+  OffsetExchangeBatch(): m_prev(get_current()) {
+    get_current() = this;
+  }
+
+  ~OffsetExchangeBatch() {
+    flush();
+    get_current() = m_prev;
+  }
+
+  OffsetExchangeBatch(const OffsetExchangeBatch &) = delete;
+  OffsetExchangeBatch &operator=(const OffsetExchangeBatch &) = delete;
+
+  void add(const std::vector<internal::OffsetExchangeEntry> &entries) {
+    m_entries.insert(m_entries.end(), entries.begin(), entries.end());
+  }
+
+  void flush() {
+    internal::exchange_offsets(m_entries);
+    m_entries.clear();
+  }
+
+  // The innermost batch of this thread, or nullptr
+  static OffsetExchangeBatch *&get_current() {
+    thread_local OffsetExchangeBatch *current = nullptr;
+    return current;
+  }
+
+ private:
+  OffsetExchangeBatch *m_prev;
+  std::vector<internal::OffsetExchangeEntry> m_entries;
+};
+
 template <typename DataType, typename Allocator>
 class TensorImplHelper;
 
@@ -108,12 +272,10 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
       m_proc_idx(tensor->get_num_dims(), 0),
       m_split_idx(tensor->get_num_dims(), 0),
       m_local_shape(tensor->get_num_dims(), 0),
-      m_local_real_shape(tensor->get_num_dims(), 0),
-      m_max_local_shape(tensor->get_num_dims(), 0),
-      m_offset(tensor->get_num_dims(), 0) {
-    // cyclic distribution not supported
+      m_local_real_shape(tensor->get_num_dims(), 0) {
     if (m_tensor) {
-      ensure_no_cyclic_distribution(m_tensor->get_distribution());
+      init_zero_offsets();
+      ensure_valid_cyclic_distribution(m_tensor->get_distribution());
       init_proc_grid();
       init_local_tensor();
       init_offsets();
@@ -125,16 +287,14 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
       m_split_idx(x.m_split_idx),
       m_local_shape(x.m_local_shape),
       m_local_real_shape(x.m_local_real_shape),
-      m_max_local_shape(x.m_max_local_shape),
-      m_offset(x.m_offset), m_offset_all(x.m_offset_all) {}
+      m_offsets(x.m_offsets) {}
 
   TensorImpl(TensorType *tensor, const TensorImpl<TensorType> &x):
       m_tensor(tensor), m_proc_idx(x.m_proc_idx),
       m_split_idx(x.m_split_idx),
       m_local_shape(x.m_local_shape),
       m_local_real_shape(x.m_local_real_shape),
-      m_max_local_shape(x.m_max_local_shape),
-      m_offset(x.m_offset), m_offset_all(x.m_offset_all) {}
+      m_offsets(x.m_offsets) {}
 
   TensorImpl<TensorType> &operator=(const TensorImpl<TensorType> &x) {
     m_tensor = x.m_tensor;
@@ -142,9 +302,7 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     m_split_idx = x.m_split_idx;
     m_local_shape = x.m_local_shape;
     m_local_real_shape = x.m_local_real_shape;
-    m_max_local_shape = x.m_max_local_shape;
-    m_offset = x.m_offset;
-    m_offset_all = x.m_offset_all;
+    m_offsets = x.m_offsets;
     return *this;
   }
 
@@ -158,6 +316,7 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
 
   void set_distribution(const Distribution &dist) {
     m_tensor->get_distribution() = dist;
+    ensure_valid_cyclic_distribution(dist);
     init_proc_grid();
     init_local_tensor();
     init_offsets();
@@ -173,26 +332,9 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     m_tensor->m_shape[-1] = global_dim;
     m_tensor->m_requested_local_shape[-1] = 0;
     init_local_tensor();
-
-    // m_offset and m_offset_all needs to be updated. The partitioning
-    // is assumed to be done without using requested sizes.
-    int num_procs = m_tensor->get_distribution().get_locale_shape()[-1];
-    int num_splits = m_tensor->get_distribution().get_split_shape()[-1];
-    index_t num_procs_per_split =
-        m_tensor->get_distribution().get_num_ranks_per_split()[-1];
-    index_t local_dim = global_dim / num_splits;
-    int rem = global_dim % num_splits;
-    auto &offsets = m_offset_all.back();
-    index_t cur_offset = 0;
-    for (int i = 0; i < num_procs; i += num_procs_per_split) {
-      for (size_t j = 0; j < num_procs_per_split; ++j) {
-        offsets[i+j] = cur_offset;
-      }
-      cur_offset += local_dim;
-      if (i < rem)  ++cur_offset;
-    }
-    assert_always(offsets[num_procs - 1] + local_dim == global_dim);
-    m_offset[-1] = offsets[m_proc_idx[-1]];
+    // No communication is needed as the requested size is reset
+    m_offsets.back() = get_analytic_offsets(get_num_dims() - 1);
+    assert_always(m_offsets.back() != nullptr);
   }
 
   Shape get_local_shape(bool include_halo) const {
@@ -204,7 +346,11 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
   }
 
   Shape get_max_local_shape() const {
-    return m_max_local_shape;
+    Shape s(m_offsets.size(), 0);
+    for (size_t i = 0; i < m_offsets.size(); ++i) {
+      s[i] = m_offsets[i]->max_local_size;
+    }
+    return s;
   }
 
   Shape get_max_local_real_shape() const {
@@ -223,7 +369,7 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     return get_local_shape(true).get_size();
   }
 
-  int allocate() {
+  h2::Expected<void> try_allocate() {
     const auto &dist = m_tensor->get_distribution();
     const auto &locale_shape = dist.get_locale_shape();
     // MPI num procs must be equal to the locale shape size, except
@@ -241,12 +387,16 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     util::MPIPrintStreamDebug()
         << "num_local_elements: " << num_local_elements;
     if (num_local_elements > 0) {
-      m_tensor->m_data.allocate(num_local_elements * sizeof(DataType),
-                                get_local_real_shape()[0] * sizeof(DataType));
-    } else {
-      util::MPIPrintStreamInfo() << "Ignoring allocation of an empty tensor";
+      return m_tensor->m_data.try_allocate(
+          num_local_elements * sizeof(DataType),
+          get_local_real_shape()[0] * sizeof(DataType));
     }
-    return 0;
+    util::MPIPrintStreamInfo() << "Ignoring allocation of an empty tensor";
+    return {};
+  }
+
+  int allocate() {
+    return util::to_status(try_allocate());
   }
 
   void nullify() {
@@ -258,11 +408,19 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
   }
 
   index_t get_global_index(int dim, index_t local_idx) const {
-    return m_offset[dim] + local_idx;
+    const auto &dist = m_tensor->get_distribution();
+    if (dist.is_cyclic(dim)) {
+      return dist.get_cyclic_global_index(dim, m_split_idx[dim], local_idx);
+    }
+    return get_dimension_offset(dim) + local_idx;
   }
 
   index_t get_local_index(int dim, index_t global_idx) const {
-    return global_idx - m_offset[dim];
+    const auto &dist = m_tensor->get_distribution();
+    if (dist.is_cyclic(dim)) {
+      return dist.get_cyclic_local_index(dim, global_idx);
+    }
+    return global_idx - get_dimension_offset(dim);
   }
 
   index_t get_local_offset(const IndexVector &idx,
@@ -359,7 +517,13 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
   }
 
   index_t get_dimension_rank_offset(int dim, int rank) const {
-    return m_offset_all[dim][rank];
+    if (dim < 0) dim += get_num_dims();
+    return m_offsets[dim]->offsets[rank];
+  }
+
+  index_t get_dimension_offset(int dim) const {
+    if (dim < 0) dim += get_num_dims();
+    return m_offsets[dim]->offsets[m_proc_idx[dim]];
   }
 
   void allreduce_shared_regions() {
@@ -391,12 +555,16 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     MPI_Comm_free(&sub_comm);
   }
 
-  void scale(DataType v, typename Stream<Allocator>::type stream) {
-    HelperType(*this).scale(v, stream);
+  // These are templates so that explicitly instantiating this class
+  // does not require a TensorImplHelper for every allocator.
+  template <typename Alloc = Allocator>
+  void scale(DataType v, typename Stream<Alloc>::type stream) {
+    TensorImplHelper<DataType, Alloc>(*this).scale(v, stream);
   }
 
-  void clear_halo(int dim, typename Stream<Allocator>::type stream) {
-    HelperType(*this).clear_halo(dim, stream);
+  template <typename Alloc = Allocator>
+  void clear_halo(int dim, typename Stream<Alloc>::type stream) {
+    TensorImplHelper<DataType, Alloc>(*this).clear_halo(dim, stream);
   }
 
   TensorType *get_tensor() {
@@ -421,9 +589,15 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     return m_tensor->get_num_spatial_dims();
   }
 
-  void ensure_no_cyclic_distribution(const Distribution &dist) const {
+  void ensure_valid_cyclic_distribution(const Distribution &dist) const {
     for (int i = 0; i < get_num_dims(); ++i) {
-      assert0(dist.get_block_size(i));
+      if (!dist.is_cyclic(i)) continue;
+      // Halo regions would be needed around each block, which the
+      // local buffer layout does not have room for.
+      assert0(dist.get_overlap(i));
+      // Requested local shapes are only meaningful for block
+      // partitioning.
+      assert0(m_tensor->m_requested_local_shape[i]);
     }
   }
 
@@ -455,37 +629,21 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
         real_size_extra = dist.get_overlap(i) * 2;
         util::MPIPrintStreamDebug()
             << "shape requested: " << proc_chunk_size;
+      } else if (dist.is_cyclic(i)) {
+        proc_chunk_size = dist.get_cyclic_local_size(
+            i, tensor_shape[i], m_split_idx[i]);
       } else if (dist.is_distributed(i)) {
         // Make sure each sub tensor has a size that is divisible by
         // bsize. The remainder is taken care by the last process.
-        index_t bsize = m_tensor->m_requested_local_block[i];
-        if (bsize == 0) bsize = 1;
-        auto d = tensor_shape[i] / bsize;
+        index_t bsize = get_block_size(i);
         util::MPIPrintStreamDebug()
             << "tensor_shape[" << i << "]: " << tensor_shape[i]
             << ", bsize: " << bsize;
         assert0(tensor_shape[i] % bsize);
-        proc_chunk_size = d / split_shape[i];
-        auto rem = d % split_shape[i];
+        proc_chunk_size = internal::get_block_partition_size(
+            tensor_shape[i], split_shape[i], bsize, m_split_idx[i]);
         util::MPIPrintStreamDebug()
-            << "proc_chunk_size: " << proc_chunk_size
-            << ", rem: " << rem;
-        if (rem) {
-          util::MPIPrintStreamDebug()
-              << "Tensor shape not divisible at dimension " << i << ". "
-              << "Tensor: " << tensor_shape
-              << ", split shape: " << split_shape
-              << ", block size: " << bsize;
-          if (m_split_idx[i] < rem) {
-            ++proc_chunk_size;
-          }
-        }
-        proc_chunk_size *= bsize;
-        // if this is the last process of this dimension, take care of
-        // the remainder of block size
-        if (m_split_idx[i] == split_shape[i] - 1) {
-          proc_chunk_size += tensor_shape[i] % bsize;
-        }
+            << "proc_chunk_size: " << proc_chunk_size;
         // Add halo regions
         real_size_extra = dist.get_overlap(i) * 2;
       } else {
@@ -506,60 +664,82 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
     //init_offsets();
   }
 
-  void init_offsets() {
+  index_t get_block_size(int dim) const {
+    index_t bsize = m_tensor->m_requested_local_block[dim];
+    return bsize == 0 ? 1 : bsize;
+  }
+
+  // Offsets of a dimension that can be computed without
+  // communication, or nullptr if the local sizes are requested
+  internal::DimensionOffsetsPtr get_analytic_offsets(int dim) const {
     const auto &dist = m_tensor->get_distribution();
-    const auto &loc_shape = dist.get_locale_shape();
+    const index_t num_ranks = dist.get_locale_shape()[dim];
+    const index_t size = m_tensor->get_shape()[dim];
+    if (!dist.is_distributed(dim)) {
+      auto p = std::make_shared<internal::DimensionOffsets>();
+      p->offsets.assign(num_ranks, 0);
+      p->max_local_size = m_local_shape[dim];
+      return p;
+    }
+    if (dist.is_cyclic(dim)) {
+      // Each split starts at its first block. The split of the
+      // first block always holds the most elements.
+      auto p = std::make_shared<internal::DimensionOffsets>();
+      p->offsets.resize(num_ranks);
+      index_t num_ranks_per_split = dist.get_num_ranks_per_split(dim);
+      for (index_t j = 0; j < num_ranks; ++j) {
+        p->offsets[j] = j / num_ranks_per_split * dist.get_block_size(dim);
+      }
+      p->max_local_size = dist.get_cyclic_local_size(dim, size, 0);
+      return p;
+    }
+    if (m_tensor->m_requested_local_shape[dim]) {
+      return nullptr;
+    }
+    return internal::get_block_partition_offsets(
+        num_ranks, dist.get_num_ranks_per_split(dim), size,
+        get_block_size(dim));
+  }
 
-    m_offset_all.clear();
-    m_offset = IndexVector(get_num_dims(), 0);
-    // Initialize max shape with the local shpae. Update as necessary
-    m_max_local_shape = m_local_shape;
+  // Offsets of all dimensions are zero until they are initialized
+  void init_zero_offsets() {
+    const auto &locale_shape = m_tensor->get_distribution().get_locale_shape();
+    m_offsets.clear();
     for (int i = 0; i < get_num_dims(); ++i) {
-      std::vector<index_t> offsets(loc_shape[i]);
-      if (!dist.is_distributed(i)) {
-        for (auto &offset: offsets) {
-          offset = 0;
-        }
-      } else {
-        LocaleMPI subloc = get_sub_locale(i);
-        index_t local_dim = m_local_shape[i];
-        MPI_Allgather(&local_dim, sizeof(index_t), MPI_BYTE,
-                      offsets.data(), sizeof(index_t), MPI_BYTE,
-                      subloc.get_comm());
-        //util::MPIPrintStreamDebug() << "loc shape: " << loc_shape << "\n";
-        // Scan
-        index_t num_ranks_per_split = dist.get_num_ranks_per_split(i);
-        index_t cur_offset = 0;
-        index_t next_offset = 0;
-        for (index_t j = 0; j < loc_shape[i]; j += num_ranks_per_split) {
-          next_offset = cur_offset + offsets[j];
-          for (index_t k = 0; k < num_ranks_per_split; ++k) {
-            offsets[j+k] = cur_offset;
-          }
-          m_max_local_shape[i] = std::max(m_max_local_shape[i], next_offset - cur_offset);
-          cur_offset = next_offset;
-        }
-        // The total size of dimension must match the size of the tensor
-        if (next_offset != m_tensor->get_shape()[i]) {
-          util::MPIPrintStreamError()
-              << "The total size of dimension does not match the size of the tensor. "
-              << "Dim: " << i
-              << ", computed: " << next_offset
-              << ", tensor shape: " << m_tensor->get_shape()[i]
-              << ", local shape: " << m_tensor->get_local_shape()[i]
-              << ", locale shape: " << loc_shape
-              << ", split shape: " << dist.get_split_shape();
-          std::abort();
-        }
-      }
-      m_offset_all.push_back(offsets);
-      m_offset[i] = offsets[m_proc_idx[i]];
-#if 0
-      std::stringstream ss;
-      util::print_vector(ss, m_offset_all.back().begin(), m_offset_all.back().end());
-      util::MPIPrintStreamDebug()
-          << "Tensor offsets for dimension " << i << ": " << ss.str();
-#endif
+      auto p = std::make_shared<internal::DimensionOffsets>();
+      p->offsets.assign(locale_shape[i], 0);
+      m_offsets.push_back(p);
+    }
+  }
+
+  // Requested local shapes must be given for the same dimensions at
+  // all processes, as only those dimensions need communication. The
+  // offsets of those dimensions are zero until the exchange is done.
+  void init_offsets() {
+    const auto &dist = m_tensor->get_distribution();
+    std::vector<internal::OffsetExchangeEntry> entries;
+    m_offsets.assign(get_num_dims(), nullptr);
+    for (int i = 0; i < get_num_dims(); ++i) {
+      m_offsets[i] = get_analytic_offsets(i);
+      if (m_offsets[i]) continue;
+      internal::OffsetExchangeEntry e;
+      e.comm = m_tensor->get_locale().get_comm();
+      e.locale_shape = dist.get_locale_shape();
+      e.rank_idx = m_proc_idx;
+      e.dim = i;
+      e.num_ranks_per_split = dist.get_num_ranks_per_split(i);
+      e.size = m_tensor->get_shape()[i];
+      e.local_size = m_local_shape[i];
+      e.offsets = std::make_shared<internal::DimensionOffsets>();
+      e.offsets->offsets.assign(e.locale_shape[i], 0);
+      m_offsets[i] = e.offsets;
+      entries.push_back(e);
+    }
+    if (entries.empty()) return;
+    if (auto batch = OffsetExchangeBatch::get_current()) {
+      batch->add(entries);
+    } else {
+      internal::exchange_offsets(entries);
     }
   }
 
@@ -568,9 +748,7 @@ class TensorImpl<Tensor<DataType, LocaleMPI, Allocator>> {
   IndexVector m_split_idx;
   Shape m_local_shape;
   Shape m_local_real_shape;
-  Shape m_max_local_shape;
-  IndexVector m_offset;
-  std::vector<std::vector<index_t>> m_offset_all;
+  std::vector<internal::DimensionOffsetsPtr> m_offsets;
 };
 
 namespace internal {
@@ -681,20 +859,44 @@ struct CopyFunctor<Tensor<DataType, LocaleProcess, AllocatorProc>,
                               const IndexVector &global_offset,
                               const Shape &global_shape,
                               const IndexVector &overlap,
-                              size_t pitch) {
+                              size_t pitch,
+                              const Distribution &dist) {
+    const int nd = local_shape.num_dims();
     auto local_real_shape = local_shape + overlap * 2;
-    // copy the MPI local buffer to the destination tensor
-    for (auto it = local_shape.index_begin();
-         it != local_shape.index_end();) {
-      auto src_offset = get_offset(
-          *it + overlap, local_real_shape, pitch);
-      auto dest_offset = get_offset(global_offset + *it,
-                                       global_shape);
-      memcpy(dest + dest_offset,
-             src + src_offset, local_shape[0] * sizeof(DataType));
-      // Skip the rest of the points at dimension 0
-      for (index_t i = 0; i < local_shape[0]; ++i) {
-        ++it;
+    // The global offset of a block-cyclic dimension is the offset of
+    // the first block, which identifies the split.
+    IndexVector split_idx(nd, 0);
+    for (int i = 0; i < nd; ++i) {
+      if (dist.is_cyclic(i)) {
+        split_idx[i] = global_offset[i] / dist.get_block_size(i);
+      }
+    }
+    auto to_global = [&](int dim, index_t local_idx) {
+      return dist.is_cyclic(dim)
+          ? dist.get_cyclic_global_index(dim, split_idx[dim], local_idx)
+          : global_offset[dim] + local_idx;
+    };
+    // Rows along dimension 0 are contiguous in the global tensor
+    // except at block boundaries of a block-cyclic distribution.
+    const index_t run_len = dist.is_cyclic(0) ?
+        dist.get_block_size(0) : local_shape[0];
+    auto row_shape = local_shape;
+    row_shape[0] = 1;
+    for (auto it = row_shape.index_begin();
+         it != row_shape.index_end(); ++it) {
+      IndexVector global_idx(nd);
+      for (int i = 1; i < nd; ++i) {
+        global_idx[i] = to_global(i, (*it)[i]);
+      }
+      for (index_t x = 0; x < local_shape[0]; x += run_len) {
+        auto local_idx = *it;
+        local_idx[0] = x;
+        global_idx[0] = to_global(0, x);
+        auto src_offset = get_offset(
+            local_idx + overlap, local_real_shape, pitch);
+        auto dest_offset = get_offset(global_idx, global_shape);
+        memcpy(dest + dest_offset, src + src_offset,
+               std::min(run_len, local_shape[0] - x) * sizeof(DataType));
       }
     }
   }
@@ -781,7 +983,8 @@ struct CopyFunctor<Tensor<DataType, LocaleProcess, AllocatorProc>,
     src_buf = m_buf;
     const auto &overlap = t_mpi.get_halo_width();
     copy_into_local_buffer(t_proc.get_buffer(), src_buf, shape,
-                           global_offset, t_mpi.get_shape(), overlap, pitch);
+                           global_offset, t_mpi.get_shape(), overlap, pitch,
+                           t_mpi.get_distribution());
   }
 
   int operator()(TensorProcType &t_proc, const TensorMPIType &t_mpi,
@@ -819,6 +1022,26 @@ struct CopyFunctor<Tensor<DataType, LocaleProcess, AllocatorProc>,
   }
 };
 
+// Returns the index along dimension dim of the split-root rank that
+// owns global_idx.
+template <typename DataType, typename Allocator>
+index_t find_owning_split_root(
+    const Tensor<DataType, LocaleMPI, Allocator> &tensor,
+    int dim, index_t global_idx) {
+  const auto &dist = tensor.get_distribution();
+  const index_t num_ranks_per_split = dist.get_num_ranks_per_split(dim);
+  if (dist.is_cyclic(dim)) {
+    return dist.get_cyclic_owner(dim, global_idx) * num_ranks_per_split;
+  }
+  index_t rank_idx = 0;
+  for (index_t j = num_ranks_per_split; j < dist.get_locale_shape(dim);
+       j += num_ranks_per_split) {
+    if (global_idx < tensor.get_dimension_rank_offset(dim, j)) break;
+    rank_idx = j;
+  }
+  return rank_idx;
+}
+
 template <typename DataType, typename Allocator>
 void find_owning_process(const Tensor<DataType, LocaleMPI, Allocator> &tensor,
                          const IndexVector &global_idx,
@@ -836,6 +1059,11 @@ void find_owning_process(const Tensor<DataType, LocaleMPI, Allocator> &tensor,
   rank = IndexVector(nd);
   local_offset = IndexVector(nd);
   for (int i = 0; i < nd; ++i) {
+    if (dist.is_cyclic(i)) {
+      rank[i] = find_owning_split_root(tensor, i, global_idx[i]);
+      local_offset[i] = dist.get_cyclic_local_index(i, global_idx[i]);
+      continue;
+    }
     int rank_idx = 0;
     for (index_t j = 1; j < loc_shape[i]; ++j) {
       if (global_idx[i] < tensor.get_dimension_rank_offset(i, j)) {
@@ -1015,7 +1243,8 @@ struct CopyLocalFunctor {
         nd >= 3) {
       return copy_opt(t_dst, t_src, stream);
     }
-    // Use the 2D copy feature of Memory for the first 2 dimensions
+    // Use the 2D copy feature of Memory for the first 2 dimensions.
+    // The local offsets already include the halo of all dimensions.
     tr_shape[0] = 1;
     tr_shape[1] = 1;
     for (auto it = tr_shape.index_begin(); it != tr_shape.index_end();
@@ -1023,12 +1252,8 @@ struct CopyLocalFunctor {
       Copy(t_dst.get_data(), t_src.get_data(),
            local_shape[0] * sizeof(DataType),
            local_shape[1],
-           (t_dst.get_local_offset(*it) + t_dst.get_halo_width(0))
-           * sizeof(DataType),
-           t_dst.get_halo_width(1),
-           (t_src.get_local_offset(*it) + t_src.get_halo_width(0))
-           * sizeof(DataType),
-           t_src.get_halo_width(1),
+           t_dst.get_local_offset(*it) * sizeof(DataType), 0,
+           t_src.get_local_offset(*it) * sizeof(DataType), 0,
            stream);
     }
     return 0;
@@ -1067,6 +1292,42 @@ struct CopyLocalFunctor3D {
   }
 };
 
+// Specialization for host memory. The whole copy is done by one call
+// of copy_host_runs, which merges contiguous rows and copies them in
+// parallel, instead of one 2D copy per outer index.
+template <typename DataType, typename StreamType>
+struct CopyLocalFunctor3D<DataType, BaseAllocator, BaseAllocator,
+                          StreamType> {
+  int operator()(Tensor<DataType, LocaleMPI, BaseAllocator> &t_dst,
+                 const Tensor<DataType, LocaleMPI, BaseAllocator> &t_src,
+                 StreamType stream) {
+    const int nd = t_src.get_num_dims();
+    const auto local_shape = t_src.get_local_shape();
+    assert_eq(local_shape, t_dst.get_local_shape());
+    assert_eq(nd, t_dst.get_num_dims());
+    if (local_shape.is_empty()) return 0;
+    std::vector<size_t> shape(local_shape.begin() + 1, local_shape.end());
+    internal::copy_host_runs(
+        (char*)t_dst.get_base_ptr(), (const char*)t_src.get_base_ptr(),
+        local_shape[0] * sizeof(DataType), shape, get_strides(t_dst),
+        get_strides(t_src));
+    return 0;
+  }
+
+  // Byte strides of the dimensions except for the first one
+  static std::vector<size_t> get_strides(
+      const Tensor<DataType, LocaleMPI, BaseAllocator> &t) {
+    const auto real_shape = t.get_local_real_shape();
+    std::vector<size_t> strides;
+    size_t stride = t.get_pitch() * sizeof(DataType);
+    for (int i = 1; i < t.get_num_dims(); ++i) {
+      strides.push_back(stride);
+      stride *= real_shape[i];
+    }
+    return strides;
+  }
+};
+
 } // namespace internal
 
 template <typename DataType, typename AllocatorProc,
@@ -1124,7 +1385,9 @@ inline int Copy(Tensor<DataType, LocaleMPI, AllocDest> &t_dest,
   if ((t_dest.get_distribution().get_locale_shape() ==
        t_src.get_distribution().get_locale_shape()) &&
       (t_dest.get_distribution().get_split_shape() ==
-       t_src.get_distribution().get_split_shape())) {
+       t_src.get_distribution().get_split_shape()) &&
+      (t_dest.get_distribution().get_block_size() ==
+       t_src.get_distribution().get_block_size())) {
     if (t_dest.get_local_shape().is_empty() ||
         t_src.get_local_shape().is_empty()) {
       return 0;
@@ -1148,5 +1411,15 @@ inline int Copy(Tensor<DataType, LocaleMPI, AllocDest> &t_dest,
   return internal::CopyByShuffle(t_dest, t_src, stream);
 }
 
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class Tensor<float, LocaleMPI, BaseAllocator>;
+extern template class Tensor<double, LocaleMPI, BaseAllocator>;
+extern template class Tensor<int, LocaleMPI, BaseAllocator>;
+extern template class TensorImpl<Tensor<float, LocaleMPI, BaseAllocator>>;
+extern template class TensorImpl<Tensor<double, LocaleMPI, BaseAllocator>>;
+extern template class TensorImpl<Tensor<int, LocaleMPI, BaseAllocator>>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
 } // namespace tensor
 } // namespace distconv
@@ -191,5 +191,15 @@ int Slice(Tensor<DataType, LocaleMPI, CUDAAllocator>& t_dest1,
           const Tensor<DataType, LocaleMPI, CUDAAllocator>& t_src,
           h2::gpu::DeviceStream s);
 
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation_gpu.cpp
+extern template class Tensor<float, LocaleMPI, CUDAAllocator>;
+extern template class Tensor<double, LocaleMPI, CUDAAllocator>;
+extern template class Tensor<int, LocaleMPI, CUDAAllocator>;
+extern template class TensorImpl<Tensor<float, LocaleMPI, CUDAAllocator>>;
+extern template class TensorImpl<Tensor<double, LocaleMPI, CUDAAllocator>>;
+extern template class TensorImpl<Tensor<int, LocaleMPI, CUDAAllocator>>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
 } // namespace tensor
 } // namespace distconv
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include "mpi.h"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+/*
+  Collective parallel I/O of distributed tensors.
+
+  A tensor is stored as a single raw file of its global elements with
+  the first dimension moving fastest, which is the same layout as
+  binary dumps gathered to a single process. Each process accesses
+  only the interior of its local partition through a subarray
+  filetype, so files can be read back with any process grid.
+ */
+
+namespace distconv {
+namespace tensor {
+
+namespace internal {
+
+// Datatypes of the local interior in the file and in the local buffer
+// including halos
+class MPIIOTypes {
+ public:
+  template <typename DataType, typename Allocator>
+  MPIIOTypes(const Tensor<DataType, LocaleMPI, Allocator> &t,
+             bool has_data) {
+    // Each partition is viewed as a single box of the file.
+    assert_always(!t.get_distribution().is_cyclic());
+    const MPI_Datatype elm_type = util::get_mpi_data_type<DataType>();
+    if (!has_data) {
+      m_file_type = elm_type;
+      m_mem_type = elm_type;
+      m_owns_types = false;
+      return;
+    }
+    const int nd = t.get_num_dims();
+    const auto global_shape = t.get_shape();
+    const auto local_shape = t.get_local_shape();
+    const auto real_shape = t.get_local_real_shape();
+    const auto global_idx = t.get_global_index();
+    std::vector<int> sizes(nd), subsizes(nd), starts(nd);
+    std::vector<int> real_sizes(nd), halo_starts(nd);
+    for (int i = 0; i < nd; ++i) {
+      assert_always(global_shape[i] <= (index_t)INT_MAX);
+      sizes[i] = global_shape[i];
+      subsizes[i] = local_shape[i];
+      starts[i] = global_idx[i];
+      real_sizes[i] = real_shape[i];
+      halo_starts[i] = t.get_halo_width(i);
+    }
+    // The first dimension is the fastest, as in Fortran
+    DISTCONV_CHECK_MPI(MPI_Type_create_subarray(
+        nd, sizes.data(), subsizes.data(), starts.data(),
+        MPI_ORDER_FORTRAN, elm_type, &m_file_type));
+    DISTCONV_CHECK_MPI(MPI_Type_commit(&m_file_type));
+    DISTCONV_CHECK_MPI(MPI_Type_create_subarray(
+        nd, real_sizes.data(), subsizes.data(), halo_starts.data(),
+        MPI_ORDER_FORTRAN, elm_type, &m_mem_type));
+    DISTCONV_CHECK_MPI(MPI_Type_commit(&m_mem_type));
+    m_owns_types = true;
+  }
+
+  ~MPIIOTypes() {
+    if (m_owns_types) {
+      MPI_Type_free(&m_file_type);
+      MPI_Type_free(&m_mem_type);
+    }
+  }
+
+  MPIIOTypes(const MPIIOTypes &) = delete;
+  MPIIOTypes &operator=(const MPIIOTypes &) = delete;
+
+  MPI_Datatype get_file_type() const {
+    return m_file_type;
+  }
+
+  MPI_Datatype get_mem_type() const {
+    return m_mem_type;
+  }
+
+ private:
+  MPI_Datatype m_file_type;
+  MPI_Datatype m_mem_type;
+  bool m_owns_types;
+};
+
+} // namespace internal
+
+/**
+   Write the interior of a tensor into a file with collective MPI-IO.
+
+   Processes sharing the same partition write it only once. The local
+   data is staged through host memory, so any allocator can be used.
+ */
+template <typename DataType, typename Allocator>
+int Dump(const Tensor<DataType, LocaleMPI, Allocator> &t,
+         const std::string &path) {
+  MPI_Comm comm = t.get_locale().get_comm();
+  const bool has_data = t.get_local_size() > 0 && t.is_split_root();
+  internal::MPIIOTypes types(t, has_data);
+  std::vector<DataType> buf;
+  if (has_data) {
+    buf.resize(t.get_local_real_size());
+    t.get_data().copyout(buf.data());
+  }
+  MPI_File fh;
+  DISTCONV_CHECK_MPI(MPI_File_open(comm, path.c_str(),
+                                   MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                   MPI_INFO_NULL, &fh));
+  // Truncates an existing file
+  DISTCONV_CHECK_MPI(MPI_File_set_size(fh, 0));
+  DISTCONV_CHECK_MPI(MPI_File_set_view(
+      fh, 0, util::get_mpi_data_type<DataType>(), types.get_file_type(),
+      "native", MPI_INFO_NULL));
+  DISTCONV_CHECK_MPI(MPI_File_write_all(fh, buf.data(), has_data ? 1 : 0,
+                                        types.get_mem_type(),
+                                        MPI_STATUS_IGNORE));
+  DISTCONV_CHECK_MPI(MPI_File_close(&fh));
+  return 0;
+}
+
+/**
+   Read the interior of a tensor from a file written by Dump with
+   collective MPI-IO. Halos are left unchanged.
+ */
+template <typename DataType, typename Allocator>
+int Load(Tensor<DataType, LocaleMPI, Allocator> &t,
+         const std::string &path) {
+  MPI_Comm comm = t.get_locale().get_comm();
+  const bool has_data = t.get_local_size() > 0;
+  internal::MPIIOTypes types(t, has_data);
+  std::vector<DataType> buf;
+  if (has_data) {
+    buf.resize(t.get_local_real_size());
+    t.get_data().copyout(buf.data());
+  }
+  MPI_File fh;
+  DISTCONV_CHECK_MPI(MPI_File_open(comm, path.c_str(), MPI_MODE_RDONLY,
+                                   MPI_INFO_NULL, &fh));
+  MPI_Offset file_size;
+  DISTCONV_CHECK_MPI(MPI_File_get_size(fh, &file_size));
+  if ((size_t)file_size != t.get_size() * sizeof(DataType)) {
+    util::MPIPrintStreamError()
+        << "Size of " << path << " is " << file_size << " bytes, but "
+        << t.get_size() * sizeof(DataType) << " bytes are expected";
+    DISTCONV_CHECK_MPI(MPI_File_close(&fh));
+    return -1;
+  }
+  DISTCONV_CHECK_MPI(MPI_File_set_view(
+      fh, 0, util::get_mpi_data_type<DataType>(), types.get_file_type(),
+      "native", MPI_INFO_NULL));
+  DISTCONV_CHECK_MPI(MPI_File_read_all(fh, buf.data(), has_data ? 1 : 0,
+                                       types.get_mem_type(),
+                                       MPI_STATUS_IGNORE));
+  DISTCONV_CHECK_MPI(MPI_File_close(&fh));
+  if (has_data) {
+    t.get_data().copyin(buf.data());
+  }
+  return 0;
+}
+
+} // namespace tensor
+} // namespace distconv
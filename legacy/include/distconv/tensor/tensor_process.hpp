@@ -43,6 +43,7 @@ class TensorImpl<Tensor<DataType, LocaleProcess, Allocator>> {
     m_tensor = x.m_tensor;
     m_local_real_shape = 0;
     if (m_tensor) update_local_real_shape();
+    return *this;
   }
 
   LocaleProcess get_sub_locale(int dim) const {
@@ -57,16 +58,19 @@ class TensorImpl<Tensor<DataType, LocaleProcess, Allocator>> {
     return m_tensor->get_shape();
   }
 
-  int allocate() {
+  h2::Expected<void> try_allocate() {
     // When allocating tensor here, no overlap region is created.
     size_t num_elements = get_local_size();
-    if (num_elements == 0) {
-      std::cerr << "Can't allocate an empty tensor\n";
-      return -1;
+    if (H2_UNLIKELY(num_elements == 0)) {
+      return H2_UNEXPECTED(InvalidArgument, "Can't allocate an empty tensor");
     }
     size_t ldim = get_local_shape()[0];
-    return m_tensor->m_data.allocate(num_elements * sizeof(DataType),
-                                     ldim * sizeof(DataType));
+    return m_tensor->m_data.try_allocate(num_elements * sizeof(DataType),
+                                         ldim * sizeof(DataType));
+  }
+
+  int allocate() {
+    return util::to_status(try_allocate());
   }
 
   void nullify() {
@@ -142,5 +146,12 @@ inline int View(Tensor<DataType, LocaleProcess, Allocator> &t_proc,
   return 0;
 }
 
+#ifdef DISTCONV_EXPLICIT_INSTANTIATION
+// Instantiated in src/tensor/instantiation.cpp
+extern template class TensorImpl<Tensor<float, LocaleProcess, BaseAllocator>>;
+extern template class TensorImpl<Tensor<double, LocaleProcess, BaseAllocator>>;
+extern template class TensorImpl<Tensor<int, LocaleProcess, BaseAllocator>>;
+#endif // DISTCONV_EXPLICIT_INSTANTIATION
+
 } // namespace tensor
 } // namespace distconv
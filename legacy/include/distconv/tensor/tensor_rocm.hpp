@@ -105,8 +105,7 @@ public:
 
     size_t get_local_real_size() const { return m_local_real_shape.get_size(); }
 
-    // FIXME (trb 08/11/2022): Why does this return an 'int'?
-    int allocate()
+    h2::Expected<void> try_allocate()
     {
         const auto& dist = m_tensor->get_distribution();
         const auto& locale_shape = dist.get_locale_shape();
@@ -122,11 +121,13 @@ public:
             << m_tensor->m_locale.get_rank() << ": "
             << "num_local_elements: " << num_local_elements;
         assert_always(num_local_elements > 0);
-        m_tensor->m_data.allocate(num_local_elements * sizeof(DataType),
-                                  get_local_real_shape()[0] * sizeof(DataType));
-        return 0;
+        return m_tensor->m_data.try_allocate(
+            num_local_elements * sizeof(DataType),
+            get_local_real_shape()[0] * sizeof(DataType));
     }
 
+    int allocate() { return util::to_status(try_allocate()); }
+
     void nullify() { m_tensor->m_data.nullify(); }
 
     Shape get_local_real_shape() const { return get_local_shape(true); }
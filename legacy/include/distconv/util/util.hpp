@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "distconv_config.hpp"
+#include "h2/utils/Expected.hpp"
 
 // Preprocessors can be confused if an expression contains curly
 // braces and considers an expression is separated at the braces. A
@@ -223,6 +224,15 @@ class PrintStreamWarning: public PrintStream<true> {
   }
 };
 
+// Report the error of a failed result and convert it to the int
+// status code returned by the functions that predate h2::Expected.
+template <typename T>
+inline int to_status(const h2::Expected<T> &result) {
+  if (H2_LIKELY(result.has_value())) return 0;
+  PrintStreamError() << result.error();
+  return -1;
+}
+
 // Copied from https://stackoverflow.com/a/236803
 template<typename Out>
 inline void split(const std::string &s, char delim, Out result) {
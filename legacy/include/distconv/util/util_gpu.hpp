@@ -20,4 +20,20 @@
 #define DISTCONV_CHECK_GPU(...) DISTCONV_CHECK_HIP(__VA_ARGS__)
 #define DISTCONV_GPU_MALLOC(...) DISTCONV_HIP_MALLOC(__VA_ARGS__)
 
+#else
+
+// Host-only builds have no device runtime nor profiler to mark
+// regions for.
+namespace distconv {
+namespace util {
+
+inline void check_for_device_runtime_error() {}
+
+inline void profile_push(const char* name) {}
+
+inline void profile_pop() {}
+
+} // namespace util
+} // namespace distconv
+
 #endif
@@ -0,0 +1,174 @@
+"""Compare two sets of benchmark results and flag regressions.
+
+Reads JSON or CSV files written by the benchmarks with --results-file
+(see benchmarks/benchmark_results.hpp). Records are matched by the
+benchmark name and configuration, and the per-iteration times of each
+metric are compared with a two-sided Mann-Whitney U test. A metric
+regresses when its median grows by more than the threshold and the
+difference is significant.
+
+Usage: python3 compare_results.py base.json new.json [--threshold 0.05]
+
+Exits with status 1 when any regression is found so that it can gate
+performance changes.
+"""
+
+import argparse
+import csv
+import json
+import math
+import sys
+from functools import lru_cache
+
+# Config keys that do not change what is measured.
+ignored_config_keys = {'num_runs', 'num_warmup_runs'}
+
+def load_json(path):
+  with open(path) as f:
+    data = json.load(f)
+  results = {}
+  for rec in data['records']:
+    key = make_key(data['benchmark'], rec['config'])
+    for name, metric in rec['metrics'].items():
+      results[key + (name,)] = [float(x) for x in metric['iterations']]
+  return results
+
+def load_csv(path):
+  results = {}
+  with open(path, newline='') as f:
+    for row in csv.DictReader(f):
+      if row['rank'] != 'max':
+        continue
+      config = {k: v for k, v in row.items()
+                if k not in ('benchmark', 'metric', 'rank', 'iteration',
+                             'time_ms') and v != ''}
+      key = make_key(row['benchmark'], config) + (row['metric'],)
+      results.setdefault(key, []).append(float(row['time_ms']))
+  return results
+
+def load(path):
+  return load_csv(path) if path.endswith('.csv') else load_json(path)
+
+def make_key(benchmark, config):
+  # Values are compared as strings so that JSON and CSV files match.
+  items = tuple(sorted((k, format_value(v)) for k, v in config.items()
+                       if k not in ignored_config_keys))
+  return (benchmark, items)
+
+def format_value(v):
+  if isinstance(v, bool):
+    return 'true' if v else 'false'
+  return str(v)
+
+def median(v):
+  s = sorted(v)
+  n = len(s)
+  return s[n // 2] if n % 2 else (s[n // 2 - 1] + s[n // 2]) / 2
+
+def ranks(values):
+  """Ranks starting at 1 with ties given their average rank."""
+  order = sorted(range(len(values)), key=lambda i: values[i])
+  r = [0.0] * len(values)
+  i = 0
+  while i < len(order):
+    j = i
+    while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+      j += 1
+    for k in range(i, j + 1):
+      r[order[k]] = (i + j) / 2 + 1
+    i = j + 1
+  return r, order
+
+@lru_cache(maxsize=None)
+def num_u_arrangements(m, n, u):
+  """Number of orderings of m and n samples with the statistic u."""
+  if u < 0 or u > m * n:
+    return 0
+  if m == 0 or n == 0:
+    return 1 if u == 0 else 0
+  return num_u_arrangements(m - 1, n, u - n) + num_u_arrangements(m, n - 1, u)
+
+def mann_whitney_u(x, y):
+  """Two-sided p-value of the Mann-Whitney U test."""
+  m, n = len(x), len(y)
+  if m == 0 or n == 0:
+    return 1.0
+  r, order = ranks(list(x) + list(y))
+  u = sum(r[:m]) - m * (m + 1) / 2
+  u = min(u, m * n - u)
+  if m * n <= 400:
+    # Exact distribution, which ignores ties
+    total = math.comb(m + n, m)
+    tail = sum(num_u_arrangements(m, n, k)
+               for k in range(int(math.floor(u)) + 1))
+    return min(1.0, 2 * tail / total)
+  # Normal approximation with tie correction
+  values = sorted(x + y)
+  ties = 0
+  i = 0
+  while i < len(values):
+    j = i
+    while j + 1 < len(values) and values[j + 1] == values[i]:
+      j += 1
+    t = j - i + 1
+    ties += t ** 3 - t
+    i = j + 1
+  sigma = math.sqrt(m * n / 12 * ((m + n + 1) - ties / ((m + n) * (m + n - 1))))
+  if sigma == 0:
+    return 1.0
+  z = (u - m * n / 2 + 0.5) / sigma
+  return min(1.0, math.erfc(-z / math.sqrt(2)))
+
+def compare(base, new, threshold, alpha):
+  rows = []
+  for key in sorted(set(base) & set(new)):
+    b, n = base[key], new[key]
+    bm, nm = median(b), median(n)
+    change = (nm - bm) / bm if bm > 0 else 0.0
+    p = mann_whitney_u(b, n)
+    if p < alpha and change > threshold:
+      status = 'REGRESSION'
+    elif p < alpha and change < -threshold:
+      status = 'improvement'
+    else:
+      status = 'ok'
+    rows.append((key, bm, nm, change, p, status))
+  return rows
+
+def format_key(key):
+  benchmark, config, metric = key
+  return '{} {} {}'.format(
+    benchmark, ','.join('{}={}'.format(k, v) for k, v in config), metric)
+
+def main():
+  parser = argparse.ArgumentParser(
+    description='Compare two sets of benchmark results.')
+  parser.add_argument('base', help='Baseline results (JSON or CSV)')
+  parser.add_argument('new', help='New results (JSON or CSV)')
+  parser.add_argument('--threshold', type=float, default=0.05,
+                      help='Relative change of medians to flag')
+  parser.add_argument('--alpha', type=float, default=0.05,
+                      help='Significance level')
+  parser.add_argument('--all', action='store_true',
+                      help='Print unchanged metrics as well')
+  args = parser.parse_args()
+
+  base = load(args.base)
+  new = load(args.new)
+  rows = compare(base, new, args.threshold, args.alpha)
+  print('status base_ms new_ms change p_value record')
+  for key, bm, nm, change, p, status in rows:
+    if status == 'ok' and not args.all:
+      continue
+    print('{} {:.4g} {:.4g} {:+.2%} {:.3g} {}'.format(
+      status, bm, nm, change, p, format_key(key)))
+  for key in sorted(set(base) ^ set(new)):
+    print('unmatched {} {}'.format(
+      'base' if key in base else 'new', format_key(key)))
+  num_regressions = sum(1 for r in rows if r[5] == 'REGRESSION')
+  print('{} metrics compared, {} regressions'.format(
+    len(rows), num_regressions))
+  return 1 if num_regressions else 0
+
+if __name__ == '__main__':
+  sys.exit(main())
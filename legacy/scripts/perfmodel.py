@@ -1,6 +1,9 @@
 from math import sqrt, log2, log
+import json
+import os
 import pickle
 import subprocess
+import tempfile
 from collections import defaultdict
 import numpy as np
 import matplotlib.pyplot as plt
@@ -34,24 +37,22 @@ def dd4(): return defaultdict(dd3)
 conv_data = defaultdict(dd4)
 
 def run_configuration(n, c, h, w, f, k):
-  r = subprocess.run([cudnn_benchmark, '-n', str(int(n)), '-c', str(int(c)),
-                      '-h', str(int(h)), '-w', str(int(w)), '-m', str(int(f)),
-                      '-s', str(int(k)), '-t', str(int(k))],
-                     stdout=subprocess.PIPE,
-                     stderr=subprocess.STDOUT,
-                     check=True)
-  # Assume five runs.
-  results = r.stdout.split(b'\n')[-7:-2]
-  fwds, bwdds, bwdfs = [], [], []
-  for line in results:
-    # Convert from milliseconds.
-    fwd, bwdd, bwdf = [float(x) / 1000 for x in line.split()[-3:]]
-    fwds.append(fwd)
-    bwdds.append(bwdd)
-    bwdfs.append(bwdf)
-  conv_data[n][c][h][w][f][k]['fwd'] = np.mean(fwds)
-  conv_data[n][c][h][w][f][k]['bwdd'] = np.mean(bwdds)
-  conv_data[n][c][h][w][f][k]['bwdf'] = np.mean(bwdfs)
+  with tempfile.TemporaryDirectory() as tmpdir:
+    results_file = os.path.join(tmpdir, 'results.json')
+    subprocess.run([cudnn_benchmark, '-n', str(int(n)), '-c', str(int(c)),
+                    '-h', str(int(h)), '-w', str(int(w)), '-m', str(int(f)),
+                    '-s', str(int(k)), '-t', str(int(k)),
+                    '--results-file', results_file],
+                   stdout=subprocess.DEVNULL,
+                   stderr=subprocess.STDOUT,
+                   check=True)
+    with open(results_file) as results:
+      metrics = json.load(results)['records'][0]['metrics']
+  # Convert from milliseconds.
+  mean = lambda name: metrics[name]['summary']['mean'] / 1000
+  conv_data[n][c][h][w][f][k]['fwd'] = mean('conv_fwd')
+  conv_data[n][c][h][w][f][k]['bwdd'] = mean('conv_bwd_data')
+  conv_data[n][c][h][w][f][k]['bwdf'] = mean('conv_bwd_filter')
 
 def load_conv_data():
   global conv_data
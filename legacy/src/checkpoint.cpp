@@ -0,0 +1,239 @@
+#include "distconv/checkpoint.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace distconv {
+
+namespace {
+
+bool pwrite_all(int fd, const void *buf, size_t bytes, off_t offset) {
+  const char *p = static_cast<const char*>(buf);
+  while (bytes > 0) {
+    const ssize_t n = pwrite(fd, p, bytes, offset);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    p += n;
+    bytes -= n;
+    offset += n;
+  }
+  return true;
+}
+
+bool pread_all(int fd, void *buf, size_t bytes, off_t offset) {
+  char *p = static_cast<char*>(buf);
+  while (bytes > 0) {
+    const ssize_t n = pread(fd, p, bytes, offset);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    bytes -= n;
+    offset += n;
+  }
+  return true;
+}
+
+} // namespace
+
+Checkpoint::Checkpoint(MPI_Comm comm, const std::string &dir, bool delta):
+    m_comm(comm), m_dir(dir), m_delta(delta), m_step(-1), m_slot(-1),
+    m_pending_step(-1), m_pending_slot(-1), m_num_skipped_chunks(0),
+    m_pending_num_skipped_chunks(0) {
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &m_rank));
+  int manifest[2] = {-1, -1};
+  if (m_rank == 0) {
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+      util::MPIPrintStreamError() << "Failed to create " << dir;
+      std::abort();
+    }
+    std::ifstream ifs(get_manifest_path());
+    if (!(ifs >> manifest[0] >> manifest[1])) {
+      manifest[0] = -1;
+      manifest[1] = -1;
+    }
+  }
+  DISTCONV_CHECK_MPI(MPI_Bcast(manifest, 2, MPI_INT, 0, comm));
+  m_step = manifest[0];
+  m_slot = manifest[1];
+}
+
+Checkpoint::~Checkpoint() {
+  wait();
+}
+
+std::string Checkpoint::get_path(const std::string &name, int slot) const {
+  return m_dir + "/" + name + "." + std::to_string(slot) + ".dct";
+}
+
+std::string Checkpoint::get_manifest_path() const {
+  return m_dir + "/checkpoint";
+}
+
+// Creates the file of a snapshot unless an existing one has the same
+// layout. Returns true if the existing file is reused.
+bool Checkpoint::prepare_file(const Snapshot &s,
+                              const std::string &path) const {
+  const auto offsets = tensor::internal::get_tensor_file_offsets(
+      s.shape, s.chunk_grid, s.element_size);
+  // The chunk table is left zero, and each writer fills its entry
+  const auto header = tensor::internal::make_tensor_file_header(
+      tensor::TensorFile::version, s.data_type, s.element_size,
+      tensor::TensorFile::has_checksums, s.shape, s.chunk_grid, offsets,
+      std::vector<uint64_t>());
+  int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    util::MPIPrintStreamError() << "Failed to open " << path;
+    std::abort();
+  }
+  if (m_delta) {
+    struct stat st;
+    const size_t fixed_len = tensor::internal::get_tensor_file_table_offset(
+        s.shape.num_dims());
+    std::vector<char> existing(fixed_len);
+    if (fstat(fd, &st) == 0 && (uint64_t)st.st_size == offsets.back() &&
+        pread_all(fd, existing.data(), fixed_len, 0) &&
+        std::memcmp(existing.data(), header.data(), fixed_len) == 0) {
+      close(fd);
+      return true;
+    }
+  }
+  if (ftruncate(fd, 0) != 0 || ftruncate(fd, offsets.back()) != 0 ||
+      !pwrite_all(fd, header.data(), header.size(), 0)) {
+    util::MPIPrintStreamError() << "Failed to write " << path;
+    std::abort();
+  }
+  close(fd);
+  return false;
+}
+
+int Checkpoint::write_snapshots(const std::vector<Snapshot> &snapshots,
+                                const std::vector<int> &reuse, int slot,
+                                int &num_skipped) const {
+  num_skipped = 0;
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    const auto &s = snapshots[i];
+    const auto path = get_path(m_entries[i].name, slot);
+    if (!s.valid) {
+      util::MPIPrintStreamError()
+          << "Local shape does not match the chunk of " << path;
+      return -1;
+    }
+    if (!s.has_chunk) continue;
+    const auto offsets = tensor::internal::get_tensor_file_offsets(
+        s.shape, s.chunk_grid, s.element_size);
+    const uint64_t entry_offset =
+        tensor::internal::get_tensor_file_table_offset(s.shape.num_dims())
+        + s.chunk * 16;
+    const uint64_t entry[2] = {
+      offsets[s.chunk], tensor::internal::fnv1a_hash(s.ptr, s.bytes)};
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+      util::MPIPrintStreamError() << "Failed to open " << path;
+      return -1;
+    }
+    uint64_t old_entry[2];
+    if (reuse[i] && pread_all(fd, old_entry, sizeof(old_entry),
+                              entry_offset) &&
+        old_entry[0] == entry[0] && old_entry[1] == entry[1]) {
+      ++num_skipped;
+      close(fd);
+      continue;
+    }
+    // The entry is invalidated first so that a chunk left partially
+    // written is never taken as unchanged
+    const uint64_t zero_entry[2] = {0, 0};
+    bool ok = pwrite_all(fd, zero_entry, sizeof(zero_entry), entry_offset)
+        && fdatasync(fd) == 0
+        && pwrite_all(fd, s.ptr, s.bytes, offsets[s.chunk])
+        && pwrite_all(fd, entry, sizeof(entry), entry_offset)
+        && fdatasync(fd) == 0;
+    close(fd);
+    if (!ok) {
+      util::MPIPrintStreamError() << "Failed to write " << path;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+void Checkpoint::save(int step) {
+  wait();
+  const int slot = m_slot == 0 ? 1 : 0;
+  std::vector<Snapshot> snapshots;
+  for (const auto &e: m_entries) {
+    snapshots.push_back(e.snapshot());
+  }
+  std::vector<int> reuse(m_entries.size(), 0);
+  if (m_rank == 0) {
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+      reuse[i] = prepare_file(snapshots[i], get_path(m_entries[i].name,
+                                                     slot));
+    }
+  }
+  DISTCONV_CHECK_MPI(MPI_Bcast(reuse.data(), reuse.size(), MPI_INT, 0,
+                               m_comm));
+  m_pending_step = step;
+  m_pending_slot = slot;
+  m_future = std::async(
+      std::launch::async,
+      [this, snapshots = std::move(snapshots), reuse, slot]() {
+        return write_snapshots(snapshots, reuse, slot,
+                               m_pending_num_skipped_chunks);
+      });
+}
+
+int Checkpoint::wait() {
+  if (!m_future.valid()) return 0;
+  int ret = m_future.get();
+  DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &ret, 1, MPI_INT, MPI_MIN,
+                                   m_comm));
+  if (ret) {
+    util::MPIRootPrintStreamError()
+        << "Failed to save checkpoint of step " << m_pending_step;
+    return ret;
+  }
+  if (m_rank == 0) {
+    // Replaces the manifest atomically
+    const auto path = get_manifest_path();
+    const auto tmp_path = path + ".tmp";
+    {
+      std::ofstream ofs(tmp_path);
+      ofs << m_pending_step << " " << m_pending_slot << std::endl;
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      util::MPIPrintStreamError() << "Failed to write " << path;
+      std::abort();
+    }
+  }
+  m_step = m_pending_step;
+  m_slot = m_pending_slot;
+  m_num_skipped_chunks = m_pending_num_skipped_chunks;
+  DISTCONV_CHECK_MPI(MPI_Barrier(m_comm));
+  return 0;
+}
+
+int Checkpoint::restore() {
+  wait();
+  if (m_step < 0) return -1;
+  int ret = 0;
+  for (const auto &e: m_entries) {
+    tensor::TensorFile f(get_path(e.name, m_slot));
+    if (e.restore(f)) {
+      ret = -1;
+    }
+  }
+  DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &ret, 1, MPI_INT, MPI_MIN,
+                                   m_comm));
+  return ret ? -1 : m_step;
+}
+
+} // namespace distconv
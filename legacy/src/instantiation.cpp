@@ -0,0 +1,24 @@
+// Explicit instantiations of the layers. The matching extern template
+// declarations are in the backend headers; both are enabled by
+// DISTCONV_EXPLICIT_INSTANTIATION.
+
+#include "distconv/distconv.hpp"
+
+namespace distconv {
+
+#define DEFINE_REF_LAYERS(TYPE)                        \
+  template class Convolution<ref::Backend, TYPE>;       \
+  template class Pooling<ref::Backend, TYPE>;           \
+  template class BatchNormalization<ref::Backend, TYPE>;
+
+DEFINE_REF_LAYERS(float)
+DEFINE_REF_LAYERS(double)
+
+#undef DEFINE_REF_LAYERS
+
+#ifdef DISTCONV_HAS_CUDNN
+template class Convolution<BackendDNNLib, float>;
+template class Convolution<BackendDNNLib, double>;
+#endif // DISTCONV_HAS_CUDNN
+
+} // namespace distconv
@@ -0,0 +1,142 @@
+#include "distconv/load_balancer.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace distconv {
+
+namespace {
+
+// Predicted iteration time when each split processes sizes[i]
+// elements at throughputs[i] elements per second
+double predict_time(const std::vector<index_t> &sizes,
+                    const std::vector<double> &throughputs) {
+  double t = 0;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    t = std::max(t, sizes[i] / throughputs[i]);
+  }
+  return t;
+}
+
+} // namespace
+
+LoadBalancer::LoadBalancer(const tensor::LocaleMPI &locale,
+                           const tensor::Distribution &dist,
+                           int dim, index_t size, index_t block_size,
+                           int window, double threshold):
+    m_comm(locale.get_comm()), m_dim(dim), m_size(size),
+    m_block_size(block_size), m_window(window), m_threshold(threshold),
+    m_num_samples(0), m_elapsed(0) {
+  assert_always(dim >= 0 && dim < dist.num_dims());
+  assert_always(block_size > 0);
+  assert_always(window > 0);
+  assert_always(!dist.is_cyclic(dim));
+  m_split_idx = locale.get_split_idx(dist)[dim];
+  // Neighbors must be able to provide the whole halo
+  m_min_blocks = std::max<index_t>(
+      1, util::ceil(static_cast<index_t>(dist.get_overlap(dim)),
+                    block_size));
+  // Start from the even partitioning of TensorImpl::init_local_tensor
+  const index_t num_splits = dist.get_split_shape()[dim];
+  assert_always(size / block_size >= num_splits * m_min_blocks);
+  m_sizes = partition(size, std::vector<double>(num_splits, 1.0),
+                      block_size, m_min_blocks);
+}
+
+void LoadBalancer::record(double seconds) {
+  assert_always(seconds >= 0);
+  ++m_num_samples;
+  m_elapsed += seconds;
+}
+
+bool LoadBalancer::rebalance() {
+  if (!is_window_complete()) return false;
+
+  const index_t num_splits = m_sizes.size();
+  double local[2] = {static_cast<double>(m_split_idx),
+                     m_elapsed > 0 ?
+                     get_local_size() * m_num_samples / m_elapsed : 0};
+  m_num_samples = 0;
+  m_elapsed = 0;
+
+  int num_procs;
+  DISTCONV_CHECK_MPI(MPI_Comm_size(m_comm, &num_procs));
+  std::vector<double> all(num_procs * 2);
+  DISTCONV_CHECK_MPI(MPI_Allgather(local, 2, MPI_DOUBLE, all.data(), 2,
+                                   MPI_DOUBLE, m_comm));
+
+  // A split is as fast as its slowest process
+  std::vector<double> throughputs(num_splits,
+                                  std::numeric_limits<double>::infinity());
+  for (int i = 0; i < num_procs; ++i) {
+    auto split = static_cast<index_t>(all[i * 2]);
+    throughputs[split] = std::min(throughputs[split], all[i * 2 + 1]);
+  }
+  m_throughputs = throughputs;
+  for (auto t: throughputs) {
+    if (!(t > 0) || !std::isfinite(t)) {
+      util::MPIRootPrintStreamDebug()
+          << "Skipping rebalancing as some splits have no timings";
+      return false;
+    }
+  }
+
+  auto sizes = partition(m_size, throughputs, m_block_size, m_min_blocks);
+  const double cur_time = predict_time(m_sizes, throughputs);
+  const double new_time = predict_time(sizes, throughputs);
+  util::MPIRootPrintStreamDebug()
+      << "Predicted iteration time: " << cur_time << " -> " << new_time;
+  if (sizes == m_sizes || new_time >= cur_time * (1 - m_threshold)) {
+    return false;
+  }
+  m_sizes = sizes;
+  return true;
+}
+
+std::vector<index_t> LoadBalancer::partition(
+    index_t size, const std::vector<double> &weights,
+    index_t block_size, index_t min_blocks) {
+  const index_t n = weights.size();
+  const index_t num_blocks = size / block_size;
+  assert_always(n > 0);
+  assert_always(num_blocks >= n * min_blocks);
+  const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+  assert_always(total > 0);
+
+  // Distribute the blocks beyond the minimum proportionally, and the
+  // blocks lost by rounding down to the largest fractional parts
+  const index_t free_blocks = num_blocks - n * min_blocks;
+  std::vector<index_t> blocks(n);
+  std::vector<double> frac(n);
+  index_t assigned = 0;
+  for (index_t i = 0; i < n; ++i) {
+    double share = free_blocks * weights[i] / total;
+    auto whole = std::min(static_cast<index_t>(share), free_blocks);
+    blocks[i] = min_blocks + whole;
+    frac[i] = share - whole;
+    assigned += whole;
+  }
+  std::vector<index_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&frac](index_t x, index_t y) {
+                     return frac[x] > frac[y];
+                   });
+  for (index_t i = 0; assigned < free_blocks; i = (i + 1) % n) {
+    ++blocks[order[i]];
+    ++assigned;
+  }
+
+  std::vector<index_t> sizes(n);
+  for (index_t i = 0; i < n; ++i) {
+    sizes[i] = blocks[i] * block_size;
+  }
+  sizes[n - 1] += size % block_size;
+  return sizes;
+}
+
+} // namespace distconv
@@ -0,0 +1,497 @@
+#include "distconv/perf_model.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <unistd.h>
+
+namespace distconv {
+namespace perf_model {
+
+namespace {
+
+// Used for links that cannot be measured, e.g., inter-node links on a
+// single node. These are the values of scripts/perfmodel.py.
+constexpr LinkParams default_intra = {8e-6, 2.661e-11};
+constexpr LinkParams default_inter = {1.2e-6, 3.893e-11};
+
+// Allreduces of up to this number of elements use the latency-optimal
+// algorithm
+constexpr size_t large_message_thresh = 1 << 9;
+
+constexpr int small_message_bytes = 8;
+constexpr int large_message_bytes = 1 << 20;
+
+double get_time() {
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Returns the one-way time of messages between rank 0 and peer. Only
+// rank 0 gets the time.
+double ping_pong(MPI_Comm comm, int peer, int bytes, int num_iters) {
+  int rank;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &rank));
+  if (rank != 0 && rank != peer) return 0;
+  std::vector<char> buf(bytes, 0);
+  const int other = rank == 0 ? peer : 0;
+  const int tag = 0;
+  double start = 0;
+  // The first iteration is not timed
+  for (int i = -1; i < num_iters; ++i) {
+    if (i == 0) start = get_time();
+    if (rank == 0) {
+      DISTCONV_CHECK_MPI(MPI_Send(buf.data(), bytes, MPI_BYTE, other, tag,
+                                  comm));
+      DISTCONV_CHECK_MPI(MPI_Recv(buf.data(), bytes, MPI_BYTE, other, tag,
+                                  comm, MPI_STATUS_IGNORE));
+    } else {
+      DISTCONV_CHECK_MPI(MPI_Recv(buf.data(), bytes, MPI_BYTE, other, tag,
+                                  comm, MPI_STATUS_IGNORE));
+      DISTCONV_CHECK_MPI(MPI_Send(buf.data(), bytes, MPI_BYTE, other, tag,
+                                  comm));
+    }
+  }
+  return (get_time() - start) / num_iters / 2;
+}
+
+LinkParams measure_link(MPI_Comm comm, int peer) {
+  const double t_small = ping_pong(comm, peer, small_message_bytes, 100);
+  const double t_large = ping_pong(comm, peer, large_message_bytes, 10);
+  LinkParams l;
+  l.alpha = t_small;
+  l.beta = std::max(t_large - t_small, 0.0) /
+      (large_message_bytes - small_message_bytes);
+  return l;
+}
+
+// Seconds per floating-point operation of a blocked GEMM
+double measure_gamma() {
+  constexpr int n = 128;
+  constexpr int block = 32;
+  std::vector<float> a(n * n, 1.0f), b(n * n, 0.5f), c(n * n);
+  double best = 0;
+  for (int trial = 0; trial < 3; ++trial) {
+    std::fill(c.begin(), c.end(), 0.0f);
+    const double start = get_time();
+    for (int ii = 0; ii < n; ii += block) {
+      for (int kk = 0; kk < n; kk += block) {
+        for (int i = ii; i < ii + block; ++i) {
+          for (int k = kk; k < kk + block; ++k) {
+            const float aik = a[i * n + k];
+            for (int j = 0; j < n; ++j) {
+              c[i * n + j] += aik * b[k * n + j];
+            }
+          }
+        }
+      }
+    }
+    const double t = get_time() - start;
+    if (trial == 0 || t < best) best = t;
+  }
+  // Keeps the computation from being optimized away
+  volatile float sink = c[n * n - 1];
+  (void)sink;
+  return best / (2.0 * n * n * n);
+}
+
+// Host name without the trailing node number, so that nodes of a
+// cluster share cache entries
+std::string get_machine_name() {
+  char hostname[256] = {0};
+  gethostname(hostname, sizeof(hostname) - 1);
+  std::string name(hostname);
+  name = name.substr(0, name.find('.'));
+  while (!name.empty() && std::isdigit(name.back())) name.pop_back();
+  return name.empty() ? "unknown" : name;
+}
+
+std::string get_default_cache_path() {
+  if (const char *p = std::getenv("DISTCONV_PERF_MODEL_CACHE")) {
+    return p;
+  }
+  const char *home = std::getenv("HOME");
+  return std::string(home ? home : ".") + "/.distconv_perf_model";
+}
+
+void bcast_params(MachineParams &p, MPI_Comm comm) {
+  double v[5] = {p.intra.alpha, p.intra.beta, p.inter.alpha, p.inter.beta,
+                 p.gamma};
+  DISTCONV_CHECK_MPI(MPI_Bcast(v, 5, MPI_DOUBLE, 0, comm));
+  DISTCONV_CHECK_MPI(MPI_Bcast(&p.procs_per_node, 1, MPI_INT, 0, comm));
+  p.intra = {v[0], v[1]};
+  p.inter = {v[2], v[3]};
+  p.gamma = v[4];
+}
+
+int get_procs_per_node(MPI_Comm comm) {
+  MPI_Comm node_comm;
+  DISTCONV_CHECK_MPI(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0,
+                                         MPI_INFO_NULL, &node_comm));
+  int node_size;
+  DISTCONV_CHECK_MPI(MPI_Comm_size(node_comm, &node_size));
+  DISTCONV_CHECK_MPI(MPI_Comm_free(&node_comm));
+  DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &node_size, 1, MPI_INT,
+                                   MPI_MAX, comm));
+  return node_size;
+}
+
+int ceil_div(int x, int y) {
+  return (x + y - 1) / y;
+}
+
+int product(const int_vector &v) {
+  return std::accumulate(v.begin(), v.end(), 1, std::multiplies<int>());
+}
+
+int delete_params(MPI_Comm, int, void *attr, void *) {
+  delete static_cast<MachineParams*>(attr);
+  return MPI_SUCCESS;
+}
+
+// Key of the parameters cached as attributes of communicators
+int get_params_keyval() {
+  static const int keyval = [] {
+    int k;
+    DISTCONV_CHECK_MPI(MPI_Comm_create_keyval(
+        MPI_COMM_NULL_COPY_FN, delete_params, &k, nullptr));
+    return k;
+  }();
+  return keyval;
+}
+
+} // namespace
+
+std::ostream &operator<<(std::ostream &os, const MachineParams &p) {
+  return os << "intra-node alpha: " << p.intra.alpha
+            << ", beta: " << p.intra.beta
+            << ", inter-node alpha: " << p.inter.alpha
+            << ", beta: " << p.inter.beta
+            << ", gamma: " << p.gamma
+            << ", processes per node: " << p.procs_per_node;
+}
+
+MachineParams calibrate(MPI_Comm comm) {
+  int rank, np;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &rank));
+  DISTCONV_CHECK_MPI(MPI_Comm_size(comm, &np));
+  MachineParams p;
+  p.intra = default_intra;
+  p.inter = default_inter;
+  p.procs_per_node = get_procs_per_node(comm);
+
+  // Finds the first intra- and inter-node peers of rank 0
+  MPI_Comm node_comm;
+  DISTCONV_CHECK_MPI(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0,
+                                         MPI_INFO_NULL, &node_comm));
+  int node_root = rank;
+  DISTCONV_CHECK_MPI(MPI_Bcast(&node_root, 1, MPI_INT, 0, node_comm));
+  DISTCONV_CHECK_MPI(MPI_Comm_free(&node_comm));
+  std::vector<int> node_roots(np);
+  DISTCONV_CHECK_MPI(MPI_Allgather(&node_root, 1, MPI_INT, node_roots.data(),
+                                   1, MPI_INT, comm));
+  int intra_peer = -1;
+  int inter_peer = -1;
+  for (int i = 1; i < np; ++i) {
+    if (node_roots[i] == node_roots[0] && intra_peer < 0) intra_peer = i;
+    if (node_roots[i] != node_roots[0] && inter_peer < 0) inter_peer = i;
+  }
+
+  if (intra_peer >= 0) p.intra = measure_link(comm, intra_peer);
+  if (inter_peer >= 0) p.inter = measure_link(comm, inter_peer);
+
+  // The slowest process determines the computation time
+  p.gamma = measure_gamma();
+  DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &p.gamma, 1, MPI_DOUBLE,
+                                   MPI_MAX, comm));
+  bcast_params(p, comm);
+  util::MPIRootPrintStreamDebug() << "Calibrated performance model: " << p;
+  return p;
+}
+
+MachineParams load_or_calibrate(MPI_Comm comm,
+                                const std::string &cache_path) {
+  const std::string path = cache_path.empty() ?
+      get_default_cache_path() : cache_path;
+  int rank;
+  DISTCONV_CHECK_MPI(MPI_Comm_rank(comm, &rank));
+  const int procs_per_node = get_procs_per_node(comm);
+  const std::string machine = get_machine_name();
+
+  // Each line is an entry of the machine name, the number of processes
+  // per node, and the parameters
+  MachineParams p;
+  int found = 0;
+  if (rank == 0) {
+    std::ifstream ifs(path);
+    std::string line;
+    while (std::getline(ifs, line)) {
+      std::istringstream iss(line);
+      std::string name;
+      int ppn;
+      MachineParams e;
+      if (!(iss >> name >> ppn >> e.intra.alpha >> e.intra.beta
+            >> e.inter.alpha >> e.inter.beta >> e.gamma)) {
+        continue;
+      }
+      if (name == machine && ppn == procs_per_node) {
+        e.procs_per_node = ppn;
+        p = e;
+        found = 1;
+      }
+    }
+  }
+  DISTCONV_CHECK_MPI(MPI_Bcast(&found, 1, MPI_INT, 0, comm));
+  if (found) {
+    bcast_params(p, comm);
+    return p;
+  }
+
+  p = calibrate(comm);
+  if (rank == 0) {
+    std::ofstream ofs(path, std::ios::app);
+    if (ofs) {
+      ofs << machine << " " << p.procs_per_node << " "
+          << p.intra.alpha << " " << p.intra.beta << " "
+          << p.inter.alpha << " " << p.inter.beta << " "
+          << p.gamma << std::endl;
+    } else {
+      util::MPIRootPrintStreamWarning()
+          << "Failed to write performance model cache: " << path;
+    }
+  }
+  return p;
+}
+
+const MachineParams &get_machine_params(MPI_Comm comm) {
+  const int keyval = get_params_keyval();
+  void *attr;
+  int found;
+  DISTCONV_CHECK_MPI(MPI_Comm_get_attr(comm, keyval, &attr, &found));
+  if (!found) {
+    attr = new MachineParams(load_or_calibrate(comm));
+    DISTCONV_CHECK_MPI(MPI_Comm_set_attr(comm, keyval, attr));
+  }
+  return *static_cast<MachineParams*>(attr);
+}
+
+int_vector ConvLayer::get_output_spatial() const {
+  int_vector out(spatial.size());
+  for (size_t i = 0; i < spatial.size(); ++i) {
+    const int k = i < filter.size() ? filter[i] : 1;
+    const int stride = i < strides.size() ? strides[i] : 1;
+    const int pad = i < pads.size() ? pads[i] : 0;
+    // Same as create_convolution_output_tensor
+    if (spatial[i] + pad * 2 < k) {
+      out[i] = 0;
+    } else {
+      out[i] = ceil_div(spatial[i] - k + 1 + pad * 2, stride);
+    }
+  }
+  return out;
+}
+
+double ConvLayer::get_flops() const {
+  return 2.0 * num_samples * num_channels * num_filters
+      * product(get_output_spatial()) * product(filter) / num_groups;
+}
+
+int ConvDecomposition::get_num_procs() const {
+  return p_n * product(p_s) * p_c * p_f;
+}
+
+std::ostream &operator<<(std::ostream &os, const ConvDecomposition &d) {
+  return os << "N: " << d.p_n << ", spatial: " << util::join_xd_array(d.p_s)
+            << ", C: " << d.p_c << ", F: " << d.p_f
+            << ", algorithm: " << d.chanfilt_algo;
+}
+
+std::ostream &operator<<(std::ostream &os, const LayerTime &t) {
+  return os << "compute: " << t.compute
+            << ", halo exchange: " << t.halo_exchange
+            << ", channel/filter: " << t.chanfilt
+            << ", allreduce: " << t.allreduce
+            << ", total: " << t.get_total();
+}
+
+double allreduce_time(const MachineParams &m, int p, size_t bytes,
+                      bool inter_node, size_t word_size) {
+  if (p <= 1) return 0;
+  const auto &l = inter_node ? m.inter : m.intra;
+  const double n = bytes / word_size;
+  const double lp = std::log2(p);
+  if (n <= large_message_thresh) {
+    return lp * (l.alpha + bytes * l.beta + n * m.gamma);
+  }
+  const double f = (p - 1.0) / p;
+  return 2 * lp * l.alpha + 2 * f * bytes * l.beta + f * n * m.gamma;
+}
+
+double allgather_time(const MachineParams &m, int p, size_t bytes,
+                      bool inter_node) {
+  if (p <= 1) return 0;
+  const auto &l = inter_node ? m.inter : m.intra;
+  return std::log2(p) * l.alpha + (p - 1.0) / p * bytes * l.beta;
+}
+
+double reduce_scatter_time(const MachineParams &m, int p, size_t bytes,
+                           bool inter_node, size_t word_size) {
+  if (p <= 1) return 0;
+  return allgather_time(m, p, bytes, inter_node) +
+      (p - 1.0) / p * bytes / word_size * m.gamma;
+}
+
+double send_recv_time(const MachineParams &m, size_t bytes,
+                      bool inter_node) {
+  const auto &l = inter_node ? m.inter : m.intra;
+  return l.alpha + bytes * l.beta;
+}
+
+/*
+  Ranks are ordered with the innermost spatial dimension moving
+  fastest, followed by the channel and sample dimensions, and are
+  assumed to fill nodes one after another. A group of processes
+  spans nodes when its members are farther apart than a node.
+ */
+LayerTime predict_conv(const MachineParams &m, const ConvLayer &layer,
+                       const ConvDecomposition &d) {
+  const int nsd = layer.spatial.size();
+  int_vector p_s = d.p_s;
+  p_s.resize(nsd, 1);
+  const auto out_spatial = layer.get_output_spatial();
+  const int n_l = ceil_div(layer.num_samples, d.p_n);
+  int_vector s_l(nsd), o_l(nsd);
+  for (int i = 0; i < nsd; ++i) {
+    s_l[i] = ceil_div(layer.spatial[i], p_s[i]);
+    o_l[i] = ceil_div(out_spatial[i], p_s[i]);
+  }
+  const size_t w = layer.word_size;
+  const int ppn = std::max(m.procs_per_node, 1);
+  const auto spans_nodes = [ppn](int stride, int count) {
+    return count > 1 && stride * count > ppn;
+  };
+  const int spatial_procs = product(p_s);
+
+  // Channels and filters computed locally, and the sizes of the
+  // groups of the channel/filter collectives
+  int c_l = layer.num_channels;
+  int f_l = layer.num_filters;
+  const int chanfilt_procs = d.p_c * d.p_f;
+  const bool chanfilt_inter = spans_nodes(spatial_procs, chanfilt_procs);
+  const size_t input_bytes = (size_t)n_l * layer.num_channels
+      * product(s_l) * w;
+  const size_t output_bytes = (size_t)n_l * layer.num_filters
+      * product(o_l) * w;
+
+  LayerTime t;
+  switch (d.chanfilt_algo) {
+    case ChannelParallelismAlgorithm::NONE:
+      break;
+    case ChannelParallelismAlgorithm::X:
+      // Stationary input: reduce-scatter the partial outputs of all
+      // filters, and allgather the output gradients
+      c_l = ceil_div(c_l, chanfilt_procs);
+      t.chanfilt = reduce_scatter_time(m, chanfilt_procs, output_bytes,
+                                       chanfilt_inter, w) +
+          allgather_time(m, chanfilt_procs, output_bytes, chanfilt_inter);
+      break;
+    case ChannelParallelismAlgorithm::Y:
+      // Stationary output: allgather the input, and reduce-scatter
+      // the partial input gradients
+      f_l = ceil_div(f_l, chanfilt_procs);
+      t.chanfilt = allgather_time(m, chanfilt_procs, input_bytes,
+                                  chanfilt_inter) +
+          reduce_scatter_time(m, chanfilt_procs, input_bytes,
+                              chanfilt_inter, w);
+      break;
+    case ChannelParallelismAlgorithm::W:
+    case ChannelParallelismAlgorithm::AUTO: {
+      // Stationary weights: the input is gathered over filter groups
+      // and the output is reduced over channel groups
+      c_l = ceil_div(c_l, d.p_c);
+      f_l = ceil_div(f_l, d.p_f);
+      const bool c_inter = spans_nodes(spatial_procs, d.p_c);
+      const bool f_inter = spans_nodes(spatial_procs * d.p_c, d.p_f);
+      t.chanfilt = allgather_time(m, d.p_f, input_bytes / d.p_c, f_inter) +
+          reduce_scatter_time(m, d.p_c, output_bytes / d.p_f, c_inter, w) +
+          allgather_time(m, d.p_c, output_bytes / d.p_f, c_inter) +
+          reduce_scatter_time(m, d.p_f, input_bytes / d.p_c, f_inter, w);
+      break;
+    }
+  }
+
+  // Forward, backward data and backward filter convolutions
+  ConvLayer local = layer;
+  local.num_samples = n_l;
+  local.num_channels = c_l;
+  local.num_filters = f_l;
+  local.spatial = s_l;
+  t.compute = 3 * local.get_flops() * m.gamma;
+
+  // Halos of the input in forward and of the output gradients in
+  // backward, exchanged with both neighbors
+  int stride = 1;
+  for (int i = 0; i < nsd; ++i) {
+    const int k = i < (int)layer.filter.size() ? layer.filter[i] : 1;
+    if (p_s[i] > 1 && k > 1) {
+      const int width = (k - 1) / 2;
+      const bool inter = spans_nodes(stride, 2);
+      const size_t face = product(s_l) / s_l[i] * width * n_l * w;
+      const size_t face_out = product(o_l) / o_l[i] * width * n_l * w;
+      t.halo_exchange += send_recv_time(m, 2 * face * c_l, inter) +
+          send_recv_time(m, 2 * face_out * f_l, inter);
+    }
+    stride *= p_s[i];
+  }
+
+  // Weight gradients are summed over the processes that hold the same
+  // channels and filters
+  const int weight_procs = d.p_n * spatial_procs;
+  const size_t weight_bytes = (size_t)c_l * f_l * product(layer.filter)
+      / layer.num_groups * w;
+  t.allreduce = allreduce_time(m, weight_procs, weight_bytes,
+                               weight_procs > ppn, w);
+  return t;
+}
+
+ChannelParallelismAlgorithm select_chanfilt_algorithm(
+    const MachineParams &m, const ConvLayer &layer,
+    const ConvDecomposition &d) {
+  if (d.p_c * d.p_f == 1) return ChannelParallelismAlgorithm::NONE;
+  bool has_halo = false;
+  for (size_t i = 0; i < d.p_s.size() && i < layer.filter.size(); ++i) {
+    has_halo |= d.p_s[i] > 1 && layer.filter[i] > 1;
+  }
+  std::vector<ChannelParallelismAlgorithm> candidates = {
+    ChannelParallelismAlgorithm::X};
+  if (!has_halo) {
+    candidates.push_back(ChannelParallelismAlgorithm::Y);
+    if (d.p_c > 1 && d.p_f > 1) {
+      candidates.push_back(ChannelParallelismAlgorithm::W);
+    }
+  }
+  ChannelParallelismAlgorithm best = candidates.front();
+  double best_time = 0;
+  for (auto algo: candidates) {
+    ConvDecomposition c = d;
+    c.chanfilt_algo = algo;
+    const double time = predict_conv(m, layer, c).get_total();
+    util::MPIRootPrintStreamDebug()
+        << "Predicted time of " << c << ": " << time;
+    if (algo == candidates.front() || time < best_time) {
+      best = algo;
+      best_time = time;
+    }
+  }
+  return best;
+}
+
+} // namespace perf_model
+} // namespace distconv
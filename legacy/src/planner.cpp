@@ -0,0 +1,339 @@
+#include "distconv/planner.hpp"
+#include "distconv/util/util.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace distconv {
+namespace perf_model {
+
+namespace {
+
+// Returns all ordered factorizations of np into n factors
+std::vector<int_vector> get_factorizations(int np, int n) {
+  if (n == 0) {
+    return np == 1 ? std::vector<int_vector>{{}} : std::vector<int_vector>{};
+  }
+  std::vector<int_vector> factorizations;
+  for (int f = 1; f <= np; ++f) {
+    if (np % f) continue;
+    for (auto &rest: get_factorizations(np / f, n - 1)) {
+      rest.insert(rest.begin(), f);
+      factorizations.push_back(rest);
+    }
+  }
+  return factorizations;
+}
+
+// Locale shape of the input and output tensors, ordered as tensor
+// dimensions
+tensor::Shape get_locale_shape(const ConvDecomposition &d) {
+  tensor::Shape shape(d.p_s);
+  shape.push_back(d.p_c * d.p_f);
+  shape.push_back(d.p_n);
+  return shape;
+}
+
+int get_filter_size(const ConvLayer &layer, int i) {
+  return i < (int)layer.filter.size() ? layer.filter[i] : 1;
+}
+
+// Halo width of each spatial dimension of a layer in d
+int_vector get_halo_widths(const ConvLayer &layer,
+                           const ConvDecomposition &d) {
+  int_vector r(layer.spatial.size(), 0);
+  for (size_t i = 0; i < r.size(); ++i) {
+    if (i < d.p_s.size() && d.p_s[i] > 1) {
+      r[i] = (get_filter_size(layer, i) - 1) / 2;
+    }
+  }
+  return r;
+}
+
+} // namespace
+
+std::ostream &operator<<(std::ostream &os, const LayerPlan &p) {
+  return os << p.decomp << ", " << p.time
+            << ", shuffle: " << p.shuffle_time;
+}
+
+std::vector<ConvDecomposition> get_decompositions(const ConvLayer &layer,
+                                                  int num_procs) {
+  const int nsd = layer.spatial.size();
+  std::vector<ConvDecomposition> decomps;
+  for (const auto &f: get_factorizations(num_procs, nsd + 2)) {
+    ConvDecomposition d;
+    d.p_s.assign(f.begin(), f.begin() + nsd);
+    const int p_chanfilt = f[nsd];
+    d.p_n = f[nsd + 1];
+    if (d.p_n > layer.num_samples) continue;
+    bool valid = true;
+    for (int i = 0; i < nsd; ++i) {
+      if (d.p_s[i] == 1) continue;
+      const int min_size = std::max(get_filter_size(layer, i), 1);
+      valid &= layer.spatial[i] / d.p_s[i] >= min_size;
+    }
+    if (!valid) continue;
+    if (p_chanfilt == 1) {
+      decomps.push_back(d);
+      continue;
+    }
+    // Grouped convolutions are not supported with channel/filter
+    // parallelism
+    if (layer.num_groups != 1 || p_chanfilt > layer.num_channels ||
+        p_chanfilt > layer.num_filters) {
+      continue;
+    }
+    d.p_c = p_chanfilt;
+    for (auto algo: {ChannelParallelismAlgorithm::X,
+                     ChannelParallelismAlgorithm::Y}) {
+      d.chanfilt_algo = algo;
+      decomps.push_back(d);
+    }
+    d.chanfilt_algo = ChannelParallelismAlgorithm::W;
+    for (int p_f = 2; p_f < p_chanfilt; ++p_f) {
+      if (p_chanfilt % p_f) continue;
+      d.p_c = p_chanfilt / p_f;
+      d.p_f = p_f;
+      decomps.push_back(d);
+    }
+  }
+  return decomps;
+}
+
+double shuffle_time(const MachineParams &m, const ConvLayer &layer,
+                    const ConvDecomposition &src,
+                    const ConvDecomposition &dst) {
+  const auto src_shape = get_locale_shape(src);
+  const auto dst_shape = get_locale_shape(dst);
+  if (src_shape == dst_shape) return 0;
+  // Each process sends its local output to the processes whose
+  // blocks overlap with it
+  size_t bytes = layer.word_size;
+  int num_peers = 1;
+  const auto out_spatial = layer.get_output_spatial();
+  for (int i = 0; i < src_shape.num_dims(); ++i) {
+    int size;
+    if (i < (int)out_spatial.size()) {
+      size = out_spatial[i];
+    } else if (i == (int)out_spatial.size()) {
+      size = layer.num_filters;
+    } else {
+      size = layer.num_samples;
+    }
+    bytes *= util::ceil(size, (int)src_shape[i]);
+    num_peers *= std::max(
+        util::ceil((int)dst_shape[i], (int)src_shape[i]), 1);
+  }
+  const int np = src.get_num_procs();
+  const bool inter_node = np > m.procs_per_node;
+  const auto &l = inter_node ? m.inter : m.intra;
+  return 2 * (std::min(num_peers, np) * l.alpha + bytes * l.beta);
+}
+
+std::vector<LayerPlan> plan_convolutions(
+    const MachineParams &m, const std::vector<ConvLayer> &layers,
+    int num_procs) {
+  const int num_layers = layers.size();
+  if (num_layers == 0) return {};
+  std::vector<std::vector<ConvDecomposition>> candidates(num_layers);
+  std::vector<std::vector<double>> layer_times(num_layers);
+  // Best time of the layers up to each candidate, and the candidate
+  // of the previous layer that achieves it
+  std::vector<std::vector<double>> best_times(num_layers);
+  std::vector<std::vector<int>> best_prev(num_layers);
+
+  for (int i = 0; i < num_layers; ++i) {
+    candidates[i] = get_decompositions(layers[i], num_procs);
+    if (candidates[i].empty()) {
+      util::MPIRootPrintStreamError()
+          << "No decomposition of layer " << i << " over "
+          << num_procs << " processes";
+      std::abort();
+    }
+    for (const auto &d: candidates[i]) {
+      layer_times[i].push_back(predict_conv(m, layers[i], d).get_total());
+    }
+    const int nc = candidates[i].size();
+    best_times[i].assign(nc, std::numeric_limits<double>::infinity());
+    best_prev[i].assign(nc, -1);
+    for (int k = 0; k < nc; ++k) {
+      if (i == 0) {
+        best_times[i][k] = layer_times[i][k];
+        continue;
+      }
+      for (int j = 0; j < (int)candidates[i - 1].size(); ++j) {
+        const double t = best_times[i - 1][j] + layer_times[i][k] +
+            shuffle_time(m, layers[i - 1], candidates[i - 1][j],
+                         candidates[i][k]);
+        if (t < best_times[i][k]) {
+          best_times[i][k] = t;
+          best_prev[i][k] = j;
+        }
+      }
+    }
+  }
+
+  std::vector<LayerPlan> plans(num_layers);
+  const auto &last = best_times[num_layers - 1];
+  int k = std::min_element(last.begin(), last.end()) - last.begin();
+  for (int i = num_layers - 1; i >= 0; --i) {
+    auto &p = plans[i];
+    const auto &layer = layers[i];
+    p.decomp = candidates[i][k];
+    p.time = predict_conv(m, layer, p.decomp);
+    const int prev = best_prev[i][k];
+    if (prev >= 0) {
+      p.shuffle_time = shuffle_time(m, layers[i - 1],
+                                    candidates[i - 1][prev], p.decomp);
+    }
+    p.input_dist = make_input_distribution(layer, p.decomp);
+    p.filter_dist = make_filter_distribution(p.decomp);
+    p.output_dist = make_output_distribution(layer, p.decomp);
+    p.d_output_dist = make_d_output_distribution(layer, p.decomp);
+    util::MPIRootPrintStreamDebug() << "Plan of layer " << i << ": " << p;
+    k = prev;
+  }
+  return plans;
+}
+
+LayerTime predict_deep_halo_chain(const MachineParams &m,
+                                  const ConvLayer &layer,
+                                  const ConvDecomposition &d,
+                                  int num_layers, int depth) {
+  assert_always(num_layers > 0);
+  assert_always(depth > 0);
+  assert_always(layer.get_output_spatial() == layer.spatial);
+  const int nsd = layer.spatial.size();
+  int_vector p_s = d.p_s;
+  p_s.resize(nsd, 1);
+  const int n_l = util::ceil(layer.num_samples, d.p_n);
+  int_vector s_l(nsd);
+  for (int i = 0; i < nsd; ++i) {
+    s_l[i] = util::ceil(layer.spatial[i], p_s[i]);
+  }
+  const auto r = get_halo_widths(layer, d);
+  const size_t w = layer.word_size;
+  const int ppn = std::max(m.procs_per_node, 1);
+
+  LayerTime t;
+  for (int start = 0; start < num_layers; start += depth) {
+    const int seg_len = std::min(depth, num_layers - start);
+    const int c = start == 0 ? layer.num_channels : layer.num_filters;
+    // One exchange of the segment input. Each face includes the halo
+    // regions of the preceding dimensions.
+    int stride = 1;
+    for (int i = 0; i < nsd; ++i) {
+      if (r[i] > 0) {
+        size_t face = (size_t)seg_len * r[i] * n_l * c * w;
+        for (int j = 0; j < nsd; ++j) {
+          if (j == i) continue;
+          face *= s_l[j] + (j < i ? 2 * seg_len * r[j] : 0);
+        }
+        t.halo_exchange += send_recv_time(m, 2 * face, stride * 2 > ppn);
+      }
+      stride *= p_s[i];
+    }
+    // Each layer computes its local output extended by the halo
+    // still needed by the rest of the segment
+    for (int k = 0; k < seg_len; ++k) {
+      ConvLayer local = layer;
+      local.num_samples = n_l;
+      local.num_channels = start + k == 0 ? layer.num_channels
+          : layer.num_filters;
+      for (int i = 0; i < nsd; ++i) {
+        local.spatial[i] = s_l[i] + 2 * (seg_len - 1 - k) * r[i];
+      }
+      t.compute += local.get_flops() * m.gamma;
+    }
+  }
+  return t;
+}
+
+int plan_deep_halo_depth(const MachineParams &m, const ConvLayer &layer,
+                         const ConvDecomposition &d, int num_layers) {
+  const auto r = get_halo_widths(layer, d);
+  int best = 1;
+  double best_time = std::numeric_limits<double>::infinity();
+  for (int depth = 1; depth <= num_layers; ++depth) {
+    bool fits = true;
+    for (size_t i = 0; i < r.size(); ++i) {
+      if (r[i] == 0) continue;
+      // Halos must fit in the smallest local partition as checked by
+      // DeepHaloConvolutionChain
+      fits &= depth * r[i] <= layer.spatial[i] / d.p_s[i];
+    }
+    if (!fits) break;
+    const double time = predict_deep_halo_chain(m, layer, d, num_layers,
+                                                depth).get_total();
+    util::MPIRootPrintStreamDebug()
+        << "Deep-halo depth " << depth << ": " << time;
+    if (time < best_time) {
+      best_time = time;
+      best = depth;
+    }
+  }
+  return best;
+}
+
+tensor::Distribution make_input_distribution(const ConvLayer &layer,
+                                             const ConvDecomposition &d) {
+  const auto locale_shape = get_locale_shape(d);
+  IntVector overlap(locale_shape.num_dims(), 0);
+  for (int i = 0; i < (int)d.p_s.size(); ++i) {
+    const int k = get_filter_size(layer, i);
+    if (d.p_s[i] > 1 && k % 2) {
+      overlap[i] = (k - 1) / 2;
+    }
+  }
+  return tensor::Distribution::make_overlapped_distribution(
+      locale_shape, overlap);
+}
+
+tensor::Distribution make_filter_distribution(const ConvDecomposition &d) {
+  auto locale_shape = get_locale_shape(d);
+  tensor::Shape split_shape(locale_shape.num_dims(), 1);
+  switch (d.chanfilt_algo) {
+    case ChannelParallelismAlgorithm::X:
+      locale_shape[-1] = 1;
+      split_shape[-2] = locale_shape[-2];
+      break;
+    case ChannelParallelismAlgorithm::Y:
+      locale_shape[-1] = locale_shape[-2];
+      locale_shape[-2] = 1;
+      split_shape[-1] = locale_shape[-1];
+      break;
+    case ChannelParallelismAlgorithm::W:
+      locale_shape[-1] = d.p_f;
+      locale_shape[-2] = d.p_c;
+      split_shape[-1] = d.p_f;
+      split_shape[-2] = d.p_c;
+      break;
+    default:
+      break;
+  }
+  return tensor::Distribution::make_shared_distribution(
+      locale_shape, split_shape);
+}
+
+tensor::Distribution make_output_distribution(const ConvLayer &layer,
+                                              const ConvDecomposition &d) {
+  return make_input_distribution(layer, d).get_non_overlapped_distribution();
+}
+
+tensor::Distribution make_d_output_distribution(const ConvLayer &layer,
+                                                const ConvDecomposition &d) {
+  auto dist = make_output_distribution(layer, d);
+  for (int i = 0; i < (int)d.p_s.size(); ++i) {
+    if (d.p_s[i] > 1) {
+      dist.set_overlap(i, (get_filter_size(layer, i) - 1) / 2);
+    }
+  }
+  return dist;
+}
+
+} // namespace perf_model
+} // namespace distconv
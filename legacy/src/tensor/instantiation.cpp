@@ -0,0 +1,42 @@
+// Explicit instantiations of the host tensor, shuffle and halo
+// exchange classes. The matching extern template declarations are in
+// the headers; both are enabled by DISTCONV_EXPLICIT_INSTANTIATION.
+
+#include "distconv/tensor/halo_exchange_host_concurrent.hpp"
+#include "distconv/tensor/halo_exchange_host_mpi.hpp"
+#include "distconv/tensor/halo_exchange_host_shm.hpp"
+#include "distconv/tensor/shuffle_mpi.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/tensor/tensor_process.hpp"
+
+namespace distconv {
+namespace tensor {
+
+#define DEFINE_TENSOR(TYPE)                                             \
+  template class TensorImpl<Tensor<TYPE, LocaleProcess, BaseAllocator>>; \
+  template class Tensor<TYPE, LocaleMPI, BaseAllocator>;               \
+  template class TensorImpl<Tensor<TYPE, LocaleMPI, BaseAllocator>>;
+
+DEFINE_TENSOR(float)
+DEFINE_TENSOR(double)
+DEFINE_TENSOR(int)
+
+#undef DEFINE_TENSOR
+
+#define DEFINE_SHUFFLE_AND_HALO(TYPE)                           \
+  template class TensorMPIShuffler<TYPE, BaseAllocator>;        \
+  template class HaloExchange<TYPE, BaseAllocator, HostMPIBackend>; \
+  template class HaloExchangeHostBlockingMPI<TYPE>;             \
+  template class HaloExchangeHostPersistent<TYPE>;              \
+  template class HaloExchangeHostNeighbor<TYPE>;                \
+  template class HaloExchangeHostConcurrent<TYPE>;              \
+  template class HaloExchangeHostConcurrentNeighbor<TYPE>;      \
+  template class HaloExchangeHostSHM<TYPE>;
+
+DEFINE_SHUFFLE_AND_HALO(float)
+DEFINE_SHUFFLE_AND_HALO(double)
+
+#undef DEFINE_SHUFFLE_AND_HALO
+
+} // namespace tensor
+} // namespace distconv
@@ -0,0 +1,21 @@
+// Explicit instantiations of the device tensor classes. The matching
+// extern template declarations are in tensor_mpi_cuda.hpp; both are
+// enabled by DISTCONV_EXPLICIT_INSTANTIATION.
+
+#include "distconv/tensor/tensor_mpi_cuda.hpp"
+
+namespace distconv {
+namespace tensor {
+
+#define DEFINE_TENSOR(TYPE)                                  \
+  template class Tensor<TYPE, LocaleMPI, CUDAAllocator>;     \
+  template class TensorImpl<Tensor<TYPE, LocaleMPI, CUDAAllocator>>;
+
+DEFINE_TENSOR(float)
+DEFINE_TENSOR(double)
+DEFINE_TENSOR(int)
+
+#undef DEFINE_TENSOR
+
+} // namespace tensor
+} // namespace distconv
@@ -46,6 +46,44 @@ int test_view() {
   return 0;
 }
 
+// Simulates memory exhaustion.
+struct NullAllocator: public BaseAllocator {
+  static void allocate(void *&p, size_t &pitch,
+                       size_t size, size_t ldim) {
+    p = nullptr;
+    pitch = ldim;
+  }
+};
+
+namespace distconv {
+namespace tensor {
+template <>
+struct Stream<NullAllocator>: public Stream<BaseAllocator> {};
+} // namespace tensor
+} // namespace distconv
+
+int test_alloc_error() {
+  util::PrintStreamInfo() << "test_alloc_error";
+
+  constexpr int ND = 3;
+  auto dist = Distribution::make_localized_distribution(ND);
+  auto loc = get_locale<LocaleProcess>();
+
+  using TensorType = Tensor<int, LocaleProcess, NullAllocator>;
+  TensorType t = get_tensor<TensorType>(Shape({2, 2, 2}), loc, dist);
+  auto result = t.try_allocate();
+  assert_always(!result.has_value());
+  assert_always(result.error().code() == h2::ErrorCode::OutOfMemory);
+  assert_always(t.is_null());
+
+  using EmptyTensorType = Tensor<int, LocaleProcess, BaseAllocator>;
+  EmptyTensorType e = get_tensor<EmptyTensorType>(Shape({0, 2, 2}), loc, dist);
+  result = e.try_allocate();
+  assert_always(!result.has_value());
+  assert_always(result.error().code() == h2::ErrorCode::InvalidArgument);
+  return 0;
+}
+
 /*
   Usage: ./test_tensor
  */
@@ -65,6 +103,7 @@ int main(int argc, char *argv[]) {
   assert0(test_data_access<PitchedTensorType>(Shape({2, 2, 2}), dist));
 
   assert0(test_view<BaseAllocator>());
+  assert0(test_alloc_error());
 
   util::PrintStreamInfo() << "Completed successfully.";
   return 0;
@@ -0,0 +1,168 @@
+#include "distconv/checkpoint.hpp"
+#include "distconv/distconv.hpp"
+#include "distconv/tensor/tensor.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util_mpi.hpp"
+#include "test_tensor.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <unistd.h>
+
+using namespace distconv;
+using namespace distconv::tensor;
+
+using TensorMPIFloat = Tensor<float, LocaleMPI, BaseAllocator>;
+using TensorMPIInt = Tensor<int, LocaleMPI, BaseAllocator>;
+
+const std::string dir_path = "test_tensor_checkpoint.d";
+
+template <typename TensorType>
+void init_tensor(TensorType &t, int step) {
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    t.set(*it, get_linearlized_offset(t.get_global_index(*it),
+                                      t.get_shape()) + step);
+  }
+}
+
+template <typename TensorType>
+int check_tensor(const TensorType &t, int step) {
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    typename TensorType::data_type ref = get_linearlized_offset(
+        t.get_global_index(*it), t.get_shape()) + step;
+    auto stored = t.get(*it);
+    if (ref != stored) {
+      util::MPIPrintStreamError()
+          << "Mismatch at: " << *it << ", ref: " << ref
+          << ", stored: " << stored;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  int pid;
+  int np;
+  MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+  MPI_Comm_size(MPI_COMM_WORLD, &np);
+
+  if (argc != 3) {
+    if (pid == 0) {
+      std::cerr << "Error! Usage: " << argv[0] << " proc_x proc_y\n";
+    }
+    MPI_Finalize();
+    exit(1);
+  }
+
+  int proc_x = atoi(argv[1]);
+  int proc_y = atoi(argv[2]);
+  assert_always(proc_x * proc_y == np);
+
+  Shape filter_shape({3, 3, 5, 7});
+  Shape stat_shape({1, 1, 13, 1});
+  LocaleMPI loc(MPI_COMM_WORLD);
+  auto filter_dist = Distribution::make_shared_distribution(
+      Shape({proc_x, proc_y, 1, 1}), Shape({proc_x, 1, 1, 1}));
+  auto stat_dist = Distribution::make_distribution(Shape({1, 1, np, 1}));
+
+  {
+    util::MPIRootPrintStreamInfo() << "Saving with " << filter_dist
+                                   << " and " << stat_dist;
+    TensorMPIFloat filter(filter_shape, loc, filter_dist);
+    TensorMPIInt stat(stat_shape, loc, stat_dist);
+    assert0(filter.allocate());
+    assert0(stat.allocate());
+    Checkpoint ckpt(MPI_COMM_WORLD, dir_path);
+    ckpt.add("filter", filter);
+    ckpt.add("stat", stat);
+    assert_always(ckpt.get_last_step() == -1);
+    assert_always(ckpt.restore() == -1);
+
+    init_tensor(filter, 1);
+    init_tensor(stat, 1);
+    ckpt.save(1);
+    // The snapshot is taken by save, so the tensors can be updated
+    init_tensor(filter, 2);
+    assert0(ckpt.wait());
+    assert_always(ckpt.get_last_step() == 1);
+    assert_always(ckpt.get_num_skipped_chunks() == 0);
+
+    ckpt.save(2);
+    assert0(ckpt.wait());
+
+    // Same slot as step 1, where only the filter differs
+    init_tensor(filter, 3);
+    ckpt.save(3);
+    assert0(ckpt.wait());
+    const int num_stat_chunks =
+        stat.get_local_size() > 0 && stat.is_split_root() ? 1 : 0;
+    assert_always(ckpt.get_num_skipped_chunks() == num_stat_chunks);
+  }
+
+  {
+    // Restarts with a different process grid
+    auto filter_dist2 = Distribution::make_distribution(
+        Shape({1, 1, 1, np}));
+    auto stat_dist2 = Distribution::make_shared_distribution(
+        Shape({1, 1, np, 1}), Shape({1, 1, 1, 1}));
+    util::MPIRootPrintStreamInfo() << "Restoring with " << filter_dist2
+                                   << " and " << stat_dist2;
+    TensorMPIFloat filter(filter_shape, loc, filter_dist2);
+    TensorMPIInt stat(stat_shape, loc, stat_dist2);
+    assert0(filter.allocate());
+    assert0(stat.allocate());
+    Checkpoint ckpt(MPI_COMM_WORLD, dir_path);
+    ckpt.add("filter", filter);
+    ckpt.add("stat", stat);
+    assert_always(ckpt.restore() == 3);
+    assert0(check_tensor(filter, 3));
+    assert0(check_tensor(stat, 1));
+  }
+
+  {
+    // Partitions with requested local shapes can be restored but not
+    // saved
+    const index_t split_idx = loc.get_split_idx(stat_dist)[2];
+    Shape requested(4, 0);
+    requested[2] = split_idx == np - 1 ? stat_shape[2] - (np - 1) : 1;
+    const bool irregular = requested[2] !=
+        tensor::internal::get_chunk_size(stat_shape[2], np, split_idx);
+    util::MPIRootPrintStreamInfo() << "Restoring with requested shapes";
+    TensorMPIInt stat(stat_shape, loc, stat_dist, requested);
+    assert0(stat.allocate());
+    Checkpoint ckpt(MPI_COMM_WORLD, dir_path);
+    ckpt.add("stat", stat);
+    assert_always(ckpt.restore() == 3);
+    assert0(check_tensor(stat, 1));
+    int any_irregular = irregular;
+    DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &any_irregular, 1,
+                                     MPI_INT, MPI_LOR, MPI_COMM_WORLD));
+    ckpt.save(4);
+    assert_always((ckpt.wait() != 0) == (any_irregular != 0));
+    if (any_irregular) {
+      assert_always(ckpt.get_last_step() == 3);
+    }
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (pid == 0) {
+    for (const auto &name: {"filter", "stat"}) {
+      for (int slot = 0; slot < 2; ++slot) {
+        std::remove((dir_path + "/" + name + "." + std::to_string(slot)
+                     + ".dct").c_str());
+      }
+    }
+    std::remove((dir_path + "/checkpoint").c_str());
+    rmdir(dir_path.c_str());
+  }
+  util::MPIRootPrintStreamInfo() << "Completed successfully.";
+
+  MPI_Finalize();
+  return 0;
+}
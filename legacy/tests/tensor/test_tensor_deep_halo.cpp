@@ -0,0 +1,112 @@
+#include "distconv/deep_halo.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util_mpi.hpp"
+#include "test_tensor.hpp"
+
+#include <cmath>
+#include <iostream>
+
+using namespace distconv;
+using namespace distconv::tensor;
+
+using Chain = DeepHaloConvolutionChain<double>;
+
+constexpr int num_layers = 4;
+
+// Channels and filter sizes vary over the layers
+const int_vector num_filters = {3, 2, 4, 2};
+const std::vector<int_vector> filter_dims_2d = {{3, 3}, {5, 3}, {1, 3},
+                                                {3, 5}};
+const std::vector<int_vector> filter_dims_3d = {{3, 3, 1}, {5, 3, 3},
+                                                {1, 3, 3}, {3, 5, 3}};
+
+std::unique_ptr<Chain> make_chain(const LocaleMPI &loc,
+                                  const Shape &proc_shape,
+                                  const Shape &shape, int depth) {
+  const auto &filter_dims = shape.num_dims() == 4 ? filter_dims_2d
+      : filter_dims_3d;
+  auto chain = std::make_unique<Chain>(loc, proc_shape, shape, num_filters,
+                                       filter_dims, depth);
+  auto &x = chain->get_input();
+  auto local_shape = x.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    x.set(*it, get_linearlized_offset(x.get_global_index(*it),
+                                      x.get_shape()) % 11);
+  }
+  for (int l = 0; l < num_layers; ++l) {
+    auto &f = chain->get_filter(l);
+    for (size_t i = 0; i < f.size(); ++i) {
+      f[i] = (double)((i * 7 + l) % 5) - 2;
+    }
+  }
+  return chain;
+}
+
+// Compares the output with that of a single process
+int check_output(const Chain &chain, const Chain &ref) {
+  const auto &t = chain.get_output();
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    auto stored = t.get(*it);
+    auto expected = ref.get_output().get(t.get_global_index(*it));
+    if (stored != expected) {
+      util::MPIPrintStreamError()
+          << "Mismatch at: " << *it << ", expected: " << expected
+          << ", stored: " << stored;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  int pid;
+  int np;
+  MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+  MPI_Comm_size(MPI_COMM_WORLD, &np);
+
+  if (argc != 3) {
+    if (pid == 0) {
+      std::cerr << "Error! Usage: " << argv[0] << " proc_x proc_y\n";
+    }
+    MPI_Finalize();
+    exit(1);
+  }
+
+  int proc_x = atoi(argv[1]);
+  int proc_y = atoi(argv[2]);
+  assert_always(proc_x * proc_y == np);
+
+  // Large enough for the halo of all the layers. Tensors must be
+  // freed before MPI_Finalize.
+  for (const auto &shape: {Shape({8 * proc_x + 1, 6 * proc_y, 2, 2}),
+                           Shape({8 * proc_x + 1, 6 * proc_y, 4, 2, 2})}) {
+    util::MPIRootPrintStreamInfo() << "Shape: " << shape;
+    LocaleMPI self(MPI_COMM_SELF, false);
+    auto ref = make_chain(self, Shape(shape.num_dims(), 1), shape, 1);
+    ref->forward();
+
+    LocaleMPI loc(MPI_COMM_WORLD);
+    Shape proc_shape(shape.num_dims(), 1);
+    proc_shape[0] = proc_x;
+    proc_shape[1] = proc_y;
+    for (int depth = 1; depth <= num_layers; ++depth) {
+      auto chain = make_chain(loc, proc_shape, shape, depth);
+      assert_eq(chain->get_num_exchanges(), util::ceil(num_layers, depth));
+      chain->forward();
+      assert0(check_output(*chain, *ref));
+      // Repeated passes give the same output
+      chain->forward();
+      assert0(check_output(*chain, *ref));
+      util::MPIRootPrintStreamInfo() << "Depth " << depth << " done";
+    }
+  }
+
+  util::MPIRootPrintStreamInfo() << "Completed successfully.";
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,180 @@
+#include "distconv/distconv.hpp"
+#include "distconv/tensor/tensor.hpp"
+#include "distconv/tensor/tensor_file.hpp"
+#include "distconv/tensor/tensor_file_loader.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util_mpi.hpp"
+#include "test_tensor.hpp"
+
+#include <iostream>
+
+using namespace distconv;
+using namespace distconv::tensor;
+
+using DataType = int;
+using TensorMPI = Tensor<DataType, LocaleMPI, BaseAllocator>;
+
+const std::string file_path = "test_tensor_file.dct";
+
+void init_tensor(TensorMPI &t) {
+  assert0(t.allocate());
+  t.zero();
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    t.set(*it, get_linearlized_offset(t.get_global_index(*it),
+                                      t.get_shape()));
+  }
+}
+
+int check_tensor(const TensorMPI &t) {
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    DataType ref = get_linearlized_offset(t.get_global_index(*it),
+                                          t.get_shape());
+    DataType stored = t.get(*it);
+    if (ref != stored) {
+      util::MPIPrintStreamError()
+          << "Mismatch at: " << *it << ", ref: " << ref
+          << ", stored: " << stored;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// Writes a tensor with src_dist and reads it back with dest_dist
+int test_read(const Shape &shape, const Distribution &src_dist,
+              const Distribution &dest_dist) {
+  util::MPIRootPrintStreamInfo()
+      << "test_read: " << shape << ", " << src_dist << " -> " << dest_dist;
+  LocaleMPI loc(MPI_COMM_WORLD);
+  TensorMPI src(shape, loc, src_dist);
+  init_tensor(src);
+  assert0(TensorFile::write(src, file_path));
+
+  TensorFile file(file_path);
+  assert_always(file.get_shape() == shape);
+  assert_always(file.get_chunk_grid() == src_dist.get_split_shape());
+  TensorMPI dest(shape, loc, dest_dist);
+  assert0(dest.allocate());
+  assert0(file.read(dest, true));
+  return check_tensor(dest);
+}
+
+// Views the chunks of a file written with the same distribution
+int test_view(const Shape &shape, const Distribution &dist) {
+  util::MPIRootPrintStreamInfo()
+      << "test_view: " << shape << ", " << dist;
+  LocaleMPI loc(MPI_COMM_WORLD);
+  TensorMPI src(shape, loc, dist);
+  init_tensor(src);
+  assert0(TensorFile::write(src, file_path, false));
+
+  TensorFile file(file_path);
+  TensorMPI dest(shape, loc, dist);
+  assert0(file.view(dest));
+  assert_always(dest.get_local_size() == 0 || dest.is_view());
+  return check_tensor(dest);
+}
+
+// Writes a dataset distributed by samples and loads mini-batches of it
+// with dist
+int test_loader(const Shape &shape, index_t mini_batch_size,
+                const Distribution &dist) {
+  util::MPIRootPrintStreamInfo()
+      << "test_loader: " << shape << ", " << mini_batch_size << ", "
+      << dist;
+  const int nd = shape.num_dims();
+  LocaleMPI loc(MPI_COMM_WORLD);
+  IntVector sample_split(nd, 1);
+  sample_split[nd - 1] = loc.get_size();
+  TensorMPI src(shape, loc, Distribution::make_distribution(
+      Shape(sample_split)));
+  init_tensor(src);
+  assert0(TensorFile::write(src, file_path));
+
+  auto batch_shape = shape;
+  batch_shape[nd - 1] = mini_batch_size;
+  TensorMPI dest(batch_shape, loc, dist);
+  assert0(dest.allocate());
+  TensorFileLoader<DataType, BaseAllocator> loader(file_path, dest, true);
+  const index_t num_batches = loader.get_num_batches();
+  assert_eq(num_batches, shape[nd - 1] / mini_batch_size);
+  // Continues past the last mini-batch to check wrapping around, and
+  // skips one to check loading without prefetching
+  for (index_t b = 0; b <= num_batches + 2; ++b) {
+    if (b == 1) continue;
+    assert0(loader.load(dest, b));
+    const index_t first = (b % num_batches) * mini_batch_size;
+    auto local_shape = dest.get_local_shape();
+    for (auto it = local_shape.index_begin();
+         it != local_shape.index_end(); ++it) {
+      auto idx = dest.get_global_index(*it);
+      idx[nd - 1] += first;
+      DataType ref = get_linearlized_offset(idx, shape);
+      DataType stored = dest.get(*it);
+      if (ref != stored) {
+        util::MPIPrintStreamError()
+            << "Mismatch at: " << *it << " of mini-batch " << b
+            << ", ref: " << ref << ", stored: " << stored;
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  int pid;
+  int np;
+  MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+  MPI_Comm_size(MPI_COMM_WORLD, &np);
+
+  if (argc != 3) {
+    if (pid == 0) {
+      std::cerr << "Error! Usage: " << argv[0] << " proc_x proc_y\n";
+    }
+    MPI_Finalize();
+    exit(1);
+  }
+
+  int proc_x = atoi(argv[1]);
+  int proc_y = atoi(argv[2]);
+  assert_always(proc_x * proc_y == np);
+
+  // Sizes not divisible by the process counts
+  Shape shape({13, 11, 3});
+
+  auto dist_xy = Distribution::make_distribution(
+      Shape({proc_x, proc_y, 1}));
+  auto dist_xy_halo = Distribution::make_overlapped_distribution(
+      Shape({proc_x, proc_y, 1}), IntVector({1, 1, 0}));
+  auto dist_yx = Distribution::make_overlapped_distribution(
+      Shape({proc_y, proc_x, 1}), IntVector({1, 0, 0}));
+  auto dist_n = Distribution::make_distribution(Shape({1, 1, np}));
+  auto dist_shared = Distribution::make_shared_distribution(
+      Shape({proc_x, proc_y, 1}), Shape({proc_x, 1, 1}));
+
+  assert0(test_read(shape, dist_xy_halo, dist_xy_halo));
+  assert0(test_read(shape, dist_xy_halo, dist_yx));
+  assert0(test_read(shape, dist_yx, dist_n));
+  assert0(test_read(shape, dist_shared, dist_xy));
+  assert0(test_view(shape, dist_xy));
+  assert0(test_view(shape, dist_n));
+  assert0(test_loader(Shape({9, 7, 2, 11}), 3,
+                      Distribution::make_overlapped_distribution(
+                          Shape({proc_x, proc_y, 1, 1}),
+                          IntVector({1, 1, 0, 0}))));
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (pid == 0) {
+    std::remove(file_path.c_str());
+  }
+  util::MPIRootPrintStreamInfo() << "Completed successfully.";
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include "distconv/load_balancer.hpp"
+#include "distconv/tensor/tensor.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/util/util_mpi.hpp"
+#include "test_tensor.hpp"
+
+#include <iostream>
+
+using namespace distconv;
+using namespace distconv::tensor;
+
+using TensorMPI = Tensor<int, LocaleMPI, BaseAllocator>;
+
+template <typename TensorType>
+void init_tensor(TensorType &t) {
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    t.set(*it, get_linearlized_offset(t.get_global_index(*it),
+                                      t.get_shape()));
+  }
+}
+
+template <typename TensorType>
+int check_tensor(const TensorType &t) {
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    typename TensorType::data_type ref = get_linearlized_offset(
+        t.get_global_index(*it), t.get_shape());
+    auto stored = t.get(*it);
+    if (ref != stored) {
+      util::MPIPrintStreamError()
+          << "Mismatch at: " << *it << ", ref: " << ref
+          << ", stored: " << stored;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// Records iterations in which split i processes (i + 1) elements per
+// second
+void run_window(LoadBalancer &lb, index_t split_idx) {
+  while (!lb.is_window_complete()) {
+    lb.record(static_cast<double>(lb.get_local_size()) / (split_idx + 1));
+  }
+}
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  int pid;
+  int np;
+  MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+  MPI_Comm_size(MPI_COMM_WORLD, &np);
+
+  if (argc != 3) {
+    if (pid == 0) {
+      std::cerr << "Error! Usage: " << argv[0] << " proc_x proc_y\n";
+    }
+    MPI_Finalize();
+    exit(1);
+  }
+
+  int proc_x = atoi(argv[1]);
+  int proc_y = atoi(argv[2]);
+  assert_always(proc_x * proc_y == np);
+
+  {
+    auto sizes = LoadBalancer::partition(10, {1, 1, 1}, 1);
+    assert_always(sizes == std::vector<index_t>({4, 3, 3}));
+    sizes = LoadBalancer::partition(23, {1, 3}, 4);
+    assert_always(sizes == std::vector<index_t>({8, 15}));
+    sizes = LoadBalancer::partition(20, {1, 100}, 2, 2);
+    assert_always(sizes == std::vector<index_t>({4, 16}));
+  }
+
+  const int dim = 1;
+  Shape shape({5, 10 * proc_y + 3, 4});
+  LocaleMPI loc(MPI_COMM_WORLD);
+  auto dist = Distribution::make_overlapped_distribution(
+      Shape({proc_x, proc_y, 1}), IntVector({0, 1, 0}));
+  TensorMPI t(shape, loc, dist);
+  assert0(t.allocate());
+  init_tensor(t);
+
+  LoadBalancer lb(loc, dist, dim, shape[dim], 1, 4, 0.1);
+  const index_t split_idx = t.get_split_index()[dim];
+  // The initial partitioning is the default one
+  assert_always(lb.is_balanced(t));
+  assert_always(lb.get_local_size() == t.get_local_shape()[dim]);
+  assert_always(!lb.rebalance());
+
+  run_window(lb, split_idx);
+  const bool changed = lb.rebalance();
+  util::MPIRootPrintStreamInfo() << "Split sizes after rebalancing: "
+                                 << util::join_array(lb.get_split_sizes(),
+                                                     ", ");
+  // Splits are uneven only with multiple splits
+  assert_always(changed == (proc_y > 1));
+  const auto &sizes = lb.get_split_sizes();
+  for (int i = 1; i < proc_y; ++i) {
+    assert_always(sizes[i] >= sizes[i - 1]);
+  }
+
+  assert0(lb.apply(t));
+  assert_always(lb.is_balanced(t));
+  assert_always(t.get_local_shape()[dim] == lb.get_local_size());
+  assert0(check_tensor(t));
+
+  // The partitioning is already proportional to the throughput, so it
+  // must stay
+  run_window(lb, split_idx);
+  assert_always(!lb.rebalance());
+
+  // Tensors created later can use the partitioning directly
+  TensorMPI t2(shape, loc, dist, lb.get_requested_local_shape(t));
+  assert0(t2.allocate());
+  assert_always(lb.is_balanced(t2));
+
+  util::MPIRootPrintStreamInfo() << "Completed successfully.";
+
+  MPI_Finalize();
+  return 0;
+}
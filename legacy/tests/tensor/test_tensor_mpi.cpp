@@ -231,10 +231,142 @@ int test_copy_redist(const Shape &shape,
   return 0;
 }
 
+template <typename TensorType>
+void fill_global_offsets(TensorType &t) {
+  for (auto it = t.get_local_shape().index_begin();
+       it != t.get_local_shape().index_end(); ++it) {
+    t.get_buffer()[t.get_local_offset(*it)] = t.get_global_offset(*it);
+  }
+}
+
+template <typename TensorType>
+int check_global_offsets(const TensorType &t) {
+  for (auto it = t.get_local_shape().index_begin();
+       it != t.get_local_shape().index_end(); ++it) {
+    auto ref = static_cast<typename TensorType::data_type>(
+        t.get_global_offset(*it));
+    auto stored = t.get_const_buffer()[t.get_local_offset(*it)];
+    if (ref != stored) {
+      util::MPIPrintStreamError()
+          << "Mismatch at: " << *it
+          << ", ref: " << ref << ", stored: " << stored;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+template <typename TensorProc, typename TensorMPI>
+int test_block_cyclic(const Shape &shape, const Distribution &dist,
+                      const Distribution &dist_other) {
+  util::MPIRootPrintStreamInfo() << "test_block_cyclic: " << dist;
+  auto loc = get_locale<LocaleMPI>();
+  auto t = get_tensor<TensorMPI>(shape, loc, dist);
+  assert0(t.allocate());
+
+  // Local and global indices must map to each other, and the local
+  // partitions must cover the tensor.
+  for (auto it = t.get_local_shape().index_begin();
+       it != t.get_local_shape().index_end(); ++it) {
+    IndexVector rank_idx, local_idx;
+    internal::find_owning_process(t, t.get_global_index(*it),
+                                  rank_idx, local_idx);
+    assert_eq(local_idx, *it);
+    assert_eq(t.get_local_index(t.get_global_index(*it)), *it);
+  }
+  index_t num_elements = t.get_local_size();
+  MPI_Allreduce(MPI_IN_PLACE, &num_elements, 1, MPI_UNSIGNED_LONG, MPI_SUM,
+                MPI_COMM_WORLD);
+  assert_eq(num_elements, (index_t)shape.get_size());
+  fill_global_offsets(t);
+
+  // Gather to the root process
+  auto loc_proc = get_locale<LocaleProcess>();
+  auto t_proc = get_tensor<TensorProc>(loc_proc,
+                                       Distribution::make_localized_distribution(
+                                           shape.num_dims()));
+  assert0(Copy(t_proc, t, 0));
+  if (loc.get_rank() == 0) {
+    assert0(check_global_offsets(t_proc));
+  }
+
+  // Redistribute to another distribution and back
+  auto t_other = get_tensor<TensorMPI>(shape, loc, dist_other);
+  assert0(t_other.allocate());
+  assert0(Copy(t_other, t));
+  assert0(check_global_offsets(t_other));
+  auto t_back = get_tensor<TensorMPI>(shape, loc, dist);
+  assert0(t_back.allocate());
+  assert0(Copy(t_back, t_other));
+  assert0(check_global_offsets(t_back));
+  return 0;
+}
+
 /*
   Usage: mpirun -np N ./test_tensor_mpi, where N must be >= 8 and
   divisible by 8.
  */
+// Requests split i of dimension 1 to have 2 * i + 3 elements and
+// split j of dimension 2 to have j + 1 elements
+Shape get_irregular_shape(const Distribution &dist) {
+  Shape shape({3, 0, 0});
+  for (int i = 0; i < (int)dist.get_split_shape()[1]; ++i)
+    shape[1] += 2 * i + 3;
+  for (int j = 0; j < (int)dist.get_split_shape()[2]; ++j)
+    shape[2] += j + 1;
+  return shape;
+}
+
+template <typename TensorType>
+int check_irregular_offsets(const TensorType &t) {
+  auto split_idx = t.get_split_index();
+  index_t offset1 = 0;
+  for (index_t i = 0; i < split_idx[1]; ++i) offset1 += 2 * i + 3;
+  index_t offset2 = split_idx[2] * (split_idx[2] + 1) / 2;
+  if (t.get_local_shape()[1] != 2 * split_idx[1] + 3 ||
+      t.get_local_shape()[2] != split_idx[2] + 1 ||
+      t.get_global_index(1, 0) != offset1 ||
+      t.get_global_index(2, 0) != offset2 ||
+      t.get_max_local_shape()[2] != t.get_distribution().get_split_shape()[2]) {
+    util::MPIPrintStreamError()
+        << "Invalid offsets of " << t
+        << ", max local shape: " << t.get_max_local_shape();
+    return -1;
+  }
+  return 0;
+}
+
+template <typename TensorType>
+int test_requested_offsets(const Distribution &dist) {
+  auto shape = get_irregular_shape(dist);
+  auto split_idx = LocaleMPI(MPI_COMM_WORLD).get_split_idx(dist);
+  Shape requested(3, 0);
+  requested[1] = 2 * split_idx[1] + 3;
+  requested[2] = split_idx[2] + 1;
+
+  TensorType t(shape, LocaleMPI(MPI_COMM_WORLD), dist, requested);
+  if (check_irregular_offsets(t)) return -1;
+
+  // The local sizes of all the tensors are exchanged at once. Copies
+  // made before the exchange share the offsets.
+  TensorType t_copy;
+  {
+    OffsetExchangeBatch batch;
+    TensorType t1(shape, LocaleMPI(MPI_COMM_WORLD), dist, requested);
+    Shape shape2({3, 4, 1});
+    shape2[2] = dist.get_split_shape()[2];
+    TensorType t2(shape2, LocaleMPI(MPI_COMM_WORLD), dist);
+    t_copy = t1;
+    // The offsets are zero until the exchange
+    if (t1.get_global_index(1, 0) != 0 ||
+        t1.get_global_index(2, 0) != 0) return -1;
+    batch.flush();
+    if (check_irregular_offsets(t1)) return -1;
+    if (t2.get_global_index(1, 0) != split_idx[1] * 2) return -1;
+  }
+  return check_irregular_offsets(t_copy);
+}
+
 int main(int argc, char *argv[]) {
   MPI_Init(&argc, &argv);
   int pid;
@@ -274,6 +406,21 @@ int main(int argc, char *argv[]) {
                                            dist, shared_dist, 0));
   util::MPIRootPrintStreamInfo() << "test_copy success";
 
+  // Uneven block counts and a trailing partial block in both dims
+  auto cyclic_dist = Distribution::make_block_cyclic_distribution(
+      {1, 2, np/2}, {0, 3, 2});
+  assert0(test_block_cyclic<TensorProc, TensorMPI>(
+      Shape({3, 11, np + 1}), cyclic_dist,
+      Distribution::make_distribution({1, 2, np/2})));
+  assert0(test_block_cyclic<TensorProc, TensorMPI>(
+      Shape({3, 11, np + 1}), cyclic_dist,
+      Distribution::make_block_cyclic_distribution({2, 1, np/2}, {1, 0, 1})));
+  util::MPIRootPrintStreamInfo() << "test_block_cyclic success";
+
+  assert0(test_requested_offsets<TensorMPI>(
+      Distribution::make_distribution({1, 2, np/2})));
+  util::MPIRootPrintStreamInfo() << "test_requested_offsets success";
+
   util::MPIRootPrintStreamInfo() << "Testing 4D tensors";
   assert_always((np % 8) == 0 && np >= 8);
   using TensorMPI4 = Tensor<DataType, LocaleMPI, BaseAllocator>;
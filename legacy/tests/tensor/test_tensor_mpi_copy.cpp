@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <vector>
 
 using namespace distconv;
 using namespace distconv::tensor;
@@ -16,10 +17,13 @@ inline LocaleMPI get_locale<LocaleMPI>() {
   return loc;
 }
 
+// With generic_local_copy, the local copy functor that is not
+// specialized for host memory is used instead of Copy
 template <typename TensorSrc, typename TensorDest>
 int test_copy_shuffle(const Shape &shape,
                       const Distribution &dist_src,
-                      const Distribution &dist_dest) {
+                      const Distribution &dist_dest,
+                      bool generic_local_copy=false) {
   util::MPIRootPrintStreamInfo() << "test_copy_shuffle\n";
   assert_eq(shape.num_dims(), 3);
   auto loc_dest = get_locale<typename TensorDest::locale_type>();
@@ -44,7 +48,15 @@ int test_copy_shuffle(const Shape &shape,
   }
 
   assert0(t_dest.allocate());
-  assert0(Copy(t_dest, t_src));
+  if (generic_local_copy) {
+    assert0((tensor::internal::CopyLocalFunctor<
+             typename TensorSrc::data_type,
+             typename TensorSrc::allocator_type,
+             typename TensorDest::allocator_type, DefaultStream>()(
+                 t_dest, t_src, DefaultStream::value)));
+  } else {
+    assert0(Copy(t_dest, t_src));
+  }
 
   util::MPIPrintStreamDebug() << "src tensor: " << t_src
                               << ", dest tensor: " << t_dest;
@@ -77,6 +89,34 @@ int test_copy_shuffle(const Shape &shape,
   return 0;
 }
 
+// Copies rows of a strided buffer with non-temporal stores, which
+// requires the streaming threshold to be at most 1 MiB
+int test_streaming_copy() {
+  const size_t len = 1000, src_pitch = 1003, num_rows = 300;
+  std::vector<int> src(src_pitch * num_rows);
+  std::vector<int> dst(len * num_rows, -1);
+  for (size_t i = 0; i < src.size(); ++i) src[i] = i;
+  // Unaligned source and destination
+  const bool streaming = tensor::internal::copy_host_runs(
+      (char*)(dst.data() + 1), (const char*)(src.data() + 2),
+      (len - 1) * sizeof(int), {num_rows}, {len * sizeof(int)},
+      {src_pitch * sizeof(int)});
+  if (!streaming) {
+    util::MPIPrintStreamError() << "Non-temporal stores not used";
+    return -1;
+  }
+  for (size_t y = 0; y < num_rows; ++y) {
+    for (size_t x = 0; x < len - 1; ++x) {
+      if (dst[y * len + x + 1] != src[y * src_pitch + x + 2]) {
+        util::MPIPrintStreamError()
+            << "Mismatch at: " << x << ", " << y;
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
 /*
   Usage: mpirun -np N ./test_tensor_mpi_copy px py, where px * py == N
  */
@@ -158,6 +198,47 @@ int main(int argc, char *argv[]) {
     assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist2, dist1));
   }
 #endif
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: generic local copy with different overlap.";
+    auto dist1 = Distribution::make_overlapped_distribution(
+        Shape({proc_x, proc_y, 1}), IntVector({1, 1, 0}));
+    auto dist2 = Distribution::make_overlapped_distribution(
+        Shape({proc_x, proc_y, 1}), IntVector({2, 0, 0}));
+    auto dist3 = Distribution::make_distribution({proc_x, proc_y, 1});
+    Shape shape({8 * proc_x, 6 * proc_y, np});
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist1, dist2,
+                                                    true));
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist2, dist3,
+                                                    true));
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist3, dist1,
+                                                    true));
+  }
+
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: large local copies split across threads.";
+    // Local tensors of about 1 MiB with the streaming threshold lowered
+    // so that non-temporal stores are used too
+    const size_t threshold =
+        tensor::internal::get_host_copy_streaming_threshold();
+    tensor::internal::set_host_copy_streaming_threshold(256 * 1024);
+    assert0(test_streaming_copy());
+    auto dist1 = Distribution::make_overlapped_distribution(
+        Shape({proc_x, proc_y, 1}), IntVector({2, 1, 0}));
+    auto dist2 = Distribution::make_overlapped_distribution(
+        Shape({proc_x, proc_y, 1}), IntVector({0, 3, 0}));
+    auto dist3 = Distribution::make_distribution({proc_x, proc_y, 1});
+    Shape shape({512 * proc_x + 3, 256 * proc_y, 2 * np});
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist1, dist2));
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist2, dist3));
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist3, dist1));
+    assert0(test_copy_shuffle<TensorMPI, TensorMPI>(shape, dist1, dist1));
+    tensor::internal::set_host_copy_streaming_threshold(threshold);
+  }
+
   // Copy of Memory with BasePitchedAllocator not supported
 #if 0
   {
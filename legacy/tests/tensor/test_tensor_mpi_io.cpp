@@ -0,0 +1,167 @@
+#include "distconv/distconv.hpp"
+#include "distconv/tensor/tensor_mpi.hpp"
+#include "distconv/tensor/tensor_mpi_io.hpp"
+#include "distconv/util/util_mpi.hpp"
+#include "test_tensor.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace distconv;
+using namespace distconv::tensor;
+
+using DataType = int;
+using TensorMPI = Tensor<DataType, LocaleMPI, BaseAllocator>;
+
+const std::string file_path = "test_tensor_mpi_io.out";
+// Value of the elements that are not read from files
+constexpr DataType sentinel = -1;
+
+void init_tensor(TensorMPI &t) {
+  auto local_shape = t.get_local_shape();
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    t.set(*it, get_linearlized_offset(t.get_global_index(*it),
+                                      t.get_shape()));
+  }
+}
+
+// Sets all elements including halos to the sentinel
+void fill_sentinel(TensorMPI &t) {
+  DataType *buf = t.get_buffer();
+  for (size_t i = 0; i < t.get_local_real_size(); ++i) {
+    buf[i] = sentinel;
+  }
+}
+
+// Checks the interior against the global offsets and that the halo
+// elements are untouched
+int check_tensor(const TensorMPI &t) {
+  auto local_shape = t.get_local_shape();
+  size_t num_interior = 0;
+  for (auto it = local_shape.index_begin();
+       it != local_shape.index_end(); ++it) {
+    DataType ref = get_linearlized_offset(t.get_global_index(*it),
+                                          t.get_shape());
+    DataType stored = t.get(*it);
+    if (ref != stored) {
+      util::MPIPrintStreamError()
+          << "Mismatch at: " << *it << ", ref: " << ref
+          << ", stored: " << stored;
+      return -1;
+    }
+    ++num_interior;
+  }
+  const DataType *buf = t.get_buffer();
+  size_t num_sentinels = 0;
+  for (size_t i = 0; i < t.get_local_real_size(); ++i) {
+    if (buf[i] == sentinel) ++num_sentinels;
+  }
+  if (num_sentinels + num_interior != t.get_local_real_size()) {
+    util::MPIPrintStreamError()
+        << "Halo modified: " << num_sentinels << " of "
+        << t.get_local_real_size() - num_interior << " elements intact";
+    return -1;
+  }
+  return 0;
+}
+
+// Dumps a tensor with src_dist and loads it with dest_dist
+int test_dump_load(const Shape &shape, const Distribution &src_dist,
+                   const Distribution &dest_dist, bool use_wrappers) {
+  util::MPIRootPrintStreamInfo()
+      << "test_dump_load: " << shape << ", " << src_dist << " -> "
+      << dest_dist;
+  LocaleMPI loc(MPI_COMM_WORLD);
+  TensorMPI src(shape, loc, src_dist);
+  assert0(src.allocate());
+  src.zero();
+  init_tensor(src);
+  TensorMPI dest(shape, loc, dest_dist);
+  assert0(dest.allocate());
+  if (dest.get_local_size() > 0) {
+    fill_sentinel(dest);
+  }
+
+  if (use_wrappers) {
+    // Both append ".out" to the path
+    const std::string prefix = file_path.substr(0, file_path.size() - 4);
+    assert0(dump_tensor(src, prefix, true));
+    assert0(load_tensor(dest, prefix));
+  } else {
+    assert0(Dump(src, file_path));
+    assert0(Load(dest, file_path));
+  }
+
+  int num_errors = dest.get_local_size() > 0 ? -check_tensor(dest) : 0;
+  DISTCONV_CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &num_errors, 1, MPI_INT,
+                                   MPI_SUM, MPI_COMM_WORLD));
+  return num_errors;
+}
+
+/*
+  Usage: mpirun -np N ./test_tensor_mpi_io px py, where px * py == N
+ */
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  int pid;
+  int np;
+  MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+  MPI_Comm_size(MPI_COMM_WORLD, &np);
+
+  if (argc != 3) {
+    if (pid == 0) {
+      std::cerr << "Error! Usage: " << argv[0] << " proc_x proc_y\n";
+    }
+    MPI_Finalize();
+    exit(1);
+  }
+
+  int proc_x = atoi(argv[1]);
+  int proc_y = atoi(argv[2]);
+  assert_always(proc_x * proc_y == np);
+
+  const Shape shape({7 * proc_x + 1, 5 * proc_y, 3, 2 * np});
+  const auto spatial = Distribution::make_overlapped_distribution(
+      Shape({proc_x, proc_y, 1, 1}), IntVector({1, 1, 0, 0}));
+  const auto transposed = Distribution::make_overlapped_distribution(
+      Shape({proc_y, proc_x, 1, 1}), IntVector({0, 1, 0, 0}));
+  const auto sample = make_sample_distribution(4, np);
+  // All processes share a single partition
+  const auto shared = Distribution::make_shared_distribution(
+      Shape({proc_x, proc_y, 1, 1}), Shape({1, 1, 1, 1}));
+
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: dump and load with different grids and halos.";
+    assert0(test_dump_load(shape, spatial, transposed, false));
+    assert0(test_dump_load(shape, transposed, sample, false));
+    assert0(test_dump_load(shape, sample, spatial, false));
+  }
+
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: dump and load of shared tensors.";
+    assert0(test_dump_load(shape, shared, spatial, false));
+    assert0(test_dump_load(shape, transposed, shared, false));
+  }
+
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: binary dump_tensor and load_tensor.";
+    assert0(test_dump_load(shape, spatial, sample, true));
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (pid == 0) {
+    std::remove(file_path.c_str());
+  }
+  util::MPIRootPrintStreamInfo() << "Completed successfully.";
+
+  MPI_Finalize();
+  return 0;
+}
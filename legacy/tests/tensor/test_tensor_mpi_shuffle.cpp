@@ -153,6 +153,36 @@ int test_copy_shuffle(const Shape &shape,
   return 0;
 }
 
+// Repeats shuffles in both directions with persistent requests
+template <typename Allocator>
+int test_persistent_shuffle(const Shape &shape,
+                            const Distribution &dist_src,
+                            const Distribution &dist_dest) {
+  using TensorMPI = Tensor<DataType, LocaleMPI, Allocator>;
+  auto loc = get_locale<LocaleMPI>();
+  auto t_src = get_tensor<TensorMPI>(shape, loc, dist_src);
+  auto t_dest = get_tensor<TensorMPI>(shape, loc, dist_dest);
+  assert_always(t_src.allocate() == 0);
+  assert_always(t_dest.allocate() == 0);
+
+  TensorMPIShuffler<DataType, Allocator> shuffler(t_src, t_dest, nullptr,
+                                                  nullptr, true);
+  assert_always(shuffler.is_persistent());
+  int error_counter = 0;
+  for (int i = 0; i < 3; ++i) {
+    init_tensor(t_src);
+    t_dest.zero();
+    shuffler.shuffle_forward(t_src.get_base_ptr(), t_dest.get_base_ptr());
+    if (t_dest.is_split_root()) error_counter += check_tensor(t_dest);
+    t_src.zero();
+    shuffler.shuffle_backward(t_dest.get_base_ptr(), t_src.get_base_ptr());
+    if (t_src.is_split_root()) error_counter += check_tensor(t_src);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &error_counter, 1, MPI_INT, MPI_SUM,
+                MPI_COMM_WORLD);
+  return error_counter;
+}
+
 Distribution get_sample_dist(const Shape &shape, int np) {
   int last_dim = shape[get_sample_dim()];
   if (last_dim >= np) {
@@ -202,6 +232,18 @@ int run_tests(const Shape &proc_dim,
         shape, dist2, dist1, method)) == 0);
   }
 
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: repeated shuffles with persistent requests.";
+    auto dist1 = Distribution::make_distribution(proc_dim);
+    auto dist2 = get_sample_dist(shape, np);
+    assert_always((test_persistent_shuffle<Allocator>(
+        shape, dist1, dist2)) == 0);
+    assert_always((test_persistent_shuffle<Allocator>(
+        shape, dist2, dist1)) == 0);
+  }
+
   // Host shuffler does not support halo
 #if 0
   {
@@ -236,6 +278,28 @@ int run_tests(const Shape &proc_dim,
         shape, dist2, dist1, method)) == 0);
   }
 
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo()
+        << "Test: copy between block-cyclic and block distributions.";
+    Shape block_size(ND, 0);
+    for (int i = 0; i < NSD; i++)
+      block_size[i] = 3;
+    block_size[-1] = 1;
+    auto dist1 = Distribution::make_block_cyclic_distribution(
+        proc_dim, block_size);
+    auto dist2 = Distribution::make_distribution(proc_dim);
+    auto dist3 = get_sample_dist(shape, np);
+    util::MPIRootPrintStreamInfo() << "dist1 (" << dist1
+                                   << ") to dist2 (" << dist2 << ")";
+    assert_always((test_copy_shuffle<ND, TensorMPI, TensorMPI>(
+        shape, dist1, dist2, method)) == 0);
+    MPI_Barrier(MPI_COMM_WORLD);
+    util::MPIRootPrintStreamInfo() << "dist1 (" << dist1
+                                   << ") to dist3 (" << dist3 << ")";
+    assert_always((test_copy_shuffle<ND, TensorMPI, TensorMPI>(
+        shape, dist1, dist3, method)) == 0);
+  }
 
   {
     MPI_Barrier(MPI_COMM_WORLD);
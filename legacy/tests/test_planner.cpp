@@ -0,0 +1,243 @@
+#include "distconv/distconv.hpp"
+#include "distconv/perf_model.hpp"
+#include "distconv/planner.hpp"
+#include "distconv/util/util_mpi.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace distconv;
+using namespace distconv::perf_model;
+
+namespace {
+
+// Latency-bound machine, where deeper halos are always faster
+MachineParams get_high_latency_params() {
+  MachineParams m;
+  m.intra = {1e-3, 1e-12};
+  m.inter = {1e-3, 1e-12};
+  m.gamma = 1e-15;
+  m.procs_per_node = 4;
+  return m;
+}
+
+// Machine of the hand-checked predictions below, with four
+// processes per node
+MachineParams get_params() {
+  MachineParams m;
+  m.intra = {1e-6, 1e-9};
+  m.inter = {1e-5, 1e-8};
+  m.gamma = 1e-12;
+  m.procs_per_node = 4;
+  return m;
+}
+
+// 3x3 convolution that keeps the spatial shape
+ConvLayer get_same_conv(int size, int num_samples=1, int num_channels=1,
+                        int num_filters=1) {
+  ConvLayer layer;
+  layer.num_samples = num_samples;
+  layer.num_channels = num_channels;
+  layer.num_filters = num_filters;
+  layer.spatial = {size, size};
+  layer.filter = {3, 3};
+  layer.strides = {1, 1};
+  layer.pads = {1, 1};
+  return layer;
+}
+
+// 1x1 convolution over 4x4 images of a single sample
+ConvLayer get_pointwise_conv(int num_channels, int num_filters) {
+  ConvLayer layer;
+  layer.num_samples = 1;
+  layer.num_channels = num_channels;
+  layer.num_filters = num_filters;
+  layer.spatial = {4, 4};
+  layer.filter = {1, 1};
+  layer.strides = {1, 1};
+  layer.pads = {0, 0};
+  return layer;
+}
+
+int check_time(const std::string &name, double time, double ref) {
+  if (std::abs(time - ref) > 1e-9 * ref) {
+    util::MPIRootPrintStreamError()
+        << "Mismatch of " << name << ": " << time << ", ref: " << ref;
+    return -1;
+  }
+  return 0;
+}
+
+int test_predict_conv() {
+  const auto m = get_params();
+  {
+    // Two samples of 8x8 images with 4 channels and 4 filters split
+    // between two processes of a node along the outermost dimension
+    ConvDecomposition d;
+    d.p_s = {1, 2};
+    const auto t = predict_conv(m, get_same_conv(8, 2, 4, 4), d);
+    // 3 passes of 2*2*4*4*(8*4)*9 flops
+    if (check_time("compute", t.compute, 55296e-12)) return -1;
+    // Two messages of 2*8*2*4*4 bytes
+    if (check_time("halo exchange", t.halo_exchange,
+                   2 * (1e-6 + 512e-9))) return -1;
+    if (t.chanfilt != 0) return -1;
+    // 4*4*9 elements over two processes with the latency-optimal
+    // algorithm
+    if (check_time("allreduce", t.allreduce,
+                   1e-6 + 576e-9 + 144e-12)) return -1;
+  }
+  {
+    // Eight samples split over two nodes
+    ConvDecomposition d;
+    d.p_n = 8;
+    d.p_s = {1, 1};
+    const auto t = predict_conv(m, get_same_conv(8, 8, 4, 4), d);
+    if (check_time("compute", t.compute, 55296e-12)) return -1;
+    if (t.halo_exchange != 0) return -1;
+    if (check_time("allreduce", t.allreduce,
+                   3 * (1e-5 + 576e-8 + 144e-12))) return -1;
+  }
+  {
+    // Stationary weights over two channel and two filter groups.
+    // Each of the four collectives moves half of 128 bytes.
+    ConvDecomposition d;
+    d.p_s = {1, 1};
+    d.p_c = 2;
+    d.p_f = 2;
+    d.chanfilt_algo = ChannelParallelismAlgorithm::W;
+    const auto t = predict_conv(m, get_pointwise_conv(4, 4), d);
+    if (check_time("compute", t.compute, 3 * 2 * 2 * 2 * 16e-12)) {
+      return -1;
+    }
+    if (check_time("channel/filter", t.chanfilt,
+                   4 * (1e-6 + 64e-9) + 2 * 16e-12)) return -1;
+    if (t.allreduce != 0) return -1;
+  }
+  return 0;
+}
+
+int test_select_chanfilt_algorithm() {
+  const auto m = get_params();
+  ConvDecomposition d;
+  d.p_s = {1, 1};
+  if (select_chanfilt_algorithm(m, get_pointwise_conv(4, 4), d)
+      != ChannelParallelismAlgorithm::NONE) return -1;
+  d.p_c = 2;
+  // The smaller of the input and output is communicated
+  if (select_chanfilt_algorithm(m, get_pointwise_conv(2, 8), d)
+      != ChannelParallelismAlgorithm::Y) return -1;
+  if (select_chanfilt_algorithm(m, get_pointwise_conv(8, 2), d)
+      != ChannelParallelismAlgorithm::X) return -1;
+  // Only X supports halos
+  d.p_s = {1, 2};
+  if (select_chanfilt_algorithm(m, get_same_conv(8, 1, 2, 8), d)
+      != ChannelParallelismAlgorithm::X) return -1;
+  // Stationary weights communicate (I + O) / 2 bytes instead of
+  // 3 / 2 of either
+  d.p_s = {1, 1};
+  d.p_f = 2;
+  if (select_chanfilt_algorithm(m, get_pointwise_conv(4, 4), d)
+      != ChannelParallelismAlgorithm::W) return -1;
+  return 0;
+}
+
+int test_plan_convolutions() {
+  const auto m = get_params();
+  {
+    // Splitting samples avoids the halo exchanges of spatial
+    // decompositions with the same computation and allreduces
+    const std::vector<ConvLayer> layers(2, get_same_conv(8, 2));
+    const auto plans = plan_convolutions(m, layers, 2);
+    if (plans.size() != 2) return -1;
+    for (const auto &p: plans) {
+      if (p.decomp.p_n != 2 || p.decomp.p_s != int_vector({1, 1})) {
+        return -1;
+      }
+      if (p.shuffle_time != 0) return -1;
+      if (check_time("plan", p.time.get_total(),
+                     3 * 1152e-12 + 1e-6 + 36e-9 + 9e-12)) return -1;
+    }
+  }
+  {
+    // Both spatial decompositions of a single sample take the same
+    // time, and the second layer keeps the one of the first
+    const std::vector<ConvLayer> layers(2, get_same_conv(8));
+    const auto plans = plan_convolutions(m, layers, 2);
+    if (plans.size() != 2) return -1;
+    if (plans[0].decomp.p_s != plans[1].decomp.p_s) return -1;
+    if (plans[1].shuffle_time != 0) return -1;
+  }
+  {
+    // Each process sends 4*8 elements to both processes of the other
+    // decomposition in forward and backward
+    ConvDecomposition src, dst;
+    src.p_s = {2, 1};
+    dst.p_s = {1, 2};
+    if (check_time("shuffle", shuffle_time(m, get_same_conv(8), src, dst),
+                   2 * (2e-6 + 128e-9))) return -1;
+  }
+  return 0;
+}
+
+int test_predict_deep_halo_chain() {
+  const auto m = get_params();
+  const auto layer = get_same_conv(8);
+  ConvDecomposition d;
+  d.p_s = {1, 2};
+  {
+    // Two exchanges of 8-element rows and two layers of 8x4 outputs
+    const auto t = predict_deep_halo_chain(m, layer, d, 2, 1);
+    if (check_time("halo exchange", t.halo_exchange,
+                   2 * (1e-6 + 64e-9))) return -1;
+    if (check_time("compute", t.compute, 2 * 576e-12)) return -1;
+  }
+  {
+    // One exchange of two rows, and the first layer computes 8x6
+    // outputs
+    const auto t = predict_deep_halo_chain(m, layer, d, 2, 2);
+    if (check_time("halo exchange", t.halo_exchange,
+                   1e-6 + 128e-9)) return -1;
+    if (check_time("compute", t.compute, 864e-12 + 576e-12)) return -1;
+  }
+  return 0;
+}
+
+// Halos of the selected depth must fit in the smallest local
+// partition even when the grid does not divide the spatial size
+int test_deep_halo_depth() {
+  const auto m = get_high_latency_params();
+  ConvDecomposition d;
+  d.p_s = {1, 4};
+  // Local sizes of 3, 3, 2 and 2
+  if (plan_deep_halo_depth(m, get_same_conv(10), d, 3) != 2) return -1;
+  // Local sizes of 3
+  if (plan_deep_halo_depth(m, get_same_conv(12), d, 3) != 3) return -1;
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+
+  assert0(test_predict_conv());
+  util::MPIRootPrintStreamInfo() << "test_predict_conv success";
+
+  assert0(test_select_chanfilt_algorithm());
+  util::MPIRootPrintStreamInfo() << "test_select_chanfilt_algorithm success";
+
+  assert0(test_plan_convolutions());
+  util::MPIRootPrintStreamInfo() << "test_plan_convolutions success";
+
+  assert0(test_predict_deep_halo_chain());
+  util::MPIRootPrintStreamInfo() << "test_predict_deep_halo_chain success";
+
+  assert0(test_deep_halo_depth());
+  util::MPIRootPrintStreamInfo() << "test_deep_halo_depth success";
+
+  util::MPIRootPrintStreamInfo() << "Completed successfully.";
+  MPI_Finalize();
+  return 0;
+}
@@ -283,6 +283,36 @@ void h2::gpu::destroy(cudaEvent_t const event)
     H2_CHECK_CUDA(cudaEventDestroy(event));
 }
 
+void h2::gpu::record(cudaEvent_t const event, cudaStream_t const stream)
+{
+    H2_GPU_TRACE(
+        "record event {} on stream {}", (void*) event, (void*) stream);
+    H2_CHECK_CUDA(cudaEventRecord(event, stream));
+}
+
+void h2::gpu::wait(cudaStream_t const stream, cudaEvent_t const event)
+{
+    H2_GPU_TRACE(
+        "stream {} waits on event {}", (void*) stream, (void*) event);
+    H2_CHECK_CUDA(cudaStreamWaitEvent(stream, event, 0));
+}
+
+bool h2::gpu::query(cudaEvent_t const event)
+{
+    auto const status = cudaEventQuery(event);
+    if (status == cudaErrorNotReady)
+        return false;
+    H2_CHECK_CUDA(status);
+    return true;
+}
+
+float h2::gpu::elapsed_time(cudaEvent_t const start, cudaEvent_t const end)
+{
+    float ms;
+    H2_CHECK_CUDA(cudaEventElapsedTime(&ms, start, end));
+    return ms;
+}
+
 void h2::gpu::sync()
 {
     H2_GPU_TRACE("synchronizing gpu");
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+#include "h2/gpu/host/allocator.hpp"
+
+#include "h2/gpu/logger.hpp"
+
+#include <new>
+
+namespace
+{
+
+// Match the alignment of cudaMalloc.
+constexpr std::align_val_t alignment_{256};
+
+// base^exp, saturating at INVALID_SIZE.
+std::size_t saturating_pow(std::size_t const base, unsigned int const exp)
+{
+    using Alloc = h2::gpu::host::CachingHostAllocator;
+    std::size_t result = 1;
+    for (unsigned int i = 0; i < exp; ++i)
+    {
+        if (result > Alloc::INVALID_SIZE / base)
+            return Alloc::INVALID_SIZE;
+        result *= base;
+    }
+    return result;
+}
+
+} // namespace
+
+namespace h2
+{
+namespace gpu
+{
+namespace host
+{
+
+CachingHostAllocator::CachingHostAllocator(unsigned int const bin_growth,
+                                           unsigned int const min_bin,
+                                           unsigned int const max_bin,
+                                           std::size_t const max_cached_bytes,
+                                           bool const skip_cleanup,
+                                           bool const debug)
+    : m_bin_growth{bin_growth},
+      m_min_bin{min_bin},
+      m_min_bin_bytes{saturating_pow(bin_growth, min_bin)},
+      m_max_bin_bytes{max_bin == INVALID_BIN
+                          ? INVALID_SIZE
+                          : saturating_pow(bin_growth, max_bin)},
+      m_max_cached_bytes{max_cached_bytes},
+      m_skip_cleanup{skip_cleanup},
+      m_debug{debug}
+{}
+
+CachingHostAllocator::~CachingHostAllocator()
+{
+    if (!m_skip_cleanup)
+        FreeAllCached();
+}
+
+void CachingHostAllocator::get_bin(std::size_t const bytes,
+                                   unsigned int& bin,
+                                   std::size_t& rounded) const noexcept
+{
+    if (bytes > m_max_bin_bytes)
+    {
+        bin = INVALID_BIN;
+        rounded = bytes;
+        return;
+    }
+    bin = m_min_bin;
+    rounded = m_min_bin_bytes;
+    while (rounded < bytes)
+    {
+        if (rounded > INVALID_SIZE / m_bin_growth)
+        {
+            bin = INVALID_BIN;
+            rounded = bytes;
+            return;
+        }
+        ++bin;
+        rounded *= m_bin_growth;
+    }
+}
+
+void CachingHostAllocator::release(Block& block)
+{
+    if (block.ready)
+        destroy(block.ready);
+    ::operator delete(block.ptr, alignment_);
+}
+
+DeviceError CachingHostAllocator::DeviceAllocate(void** const ptr,
+                                                 std::size_t const bytes,
+                                                 DeviceStream const stream)
+{
+    if (!ptr)
+        return DeviceError::InvalidValue;
+
+    Block block{nullptr, 0, INVALID_BIN, stream, nullptr};
+    get_bin(bytes, block.bin, block.bytes);
+
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (block.bin != INVALID_BIN)
+    {
+        auto const range = m_cached.equal_range(block.bin);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            Block& cached = it->second;
+            if (cached.stream == stream || query(cached.ready))
+            {
+                block.ptr = cached.ptr;
+                block.ready = cached.ready;
+                m_cached_bytes -= cached.bytes;
+                m_cached.erase(it);
+                if (m_debug)
+                    H2_GPU_DEBUG("reusing cached block {} ({} bytes)",
+                                 block.ptr,
+                                 block.bytes);
+                break;
+            }
+        }
+    }
+
+    if (!block.ptr)
+    {
+        block.ptr = ::operator new(block.bytes, alignment_, std::nothrow);
+        if (!block.ptr)
+        {
+            // Retry after returning the cache to the system.
+            for (auto& kv : m_cached)
+            {
+                sync(kv.second.ready);
+                release(kv.second);
+            }
+            m_cached.clear();
+            m_cached_bytes = 0;
+            block.ptr = ::operator new(block.bytes, alignment_, std::nothrow);
+            if (!block.ptr)
+                return DeviceError::MemoryAllocation;
+        }
+        if (m_debug)
+            H2_GPU_DEBUG(
+                "allocated new block {} ({} bytes)", block.ptr, block.bytes);
+    }
+
+    m_live_bytes += block.bytes;
+    m_live.emplace(block.ptr, block);
+    *ptr = block.ptr;
+    return DeviceError::Success;
+}
+
+DeviceError CachingHostAllocator::DeviceFree(void* const ptr)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto const it = m_live.find(ptr);
+    if (it == m_live.end())
+        return DeviceError::InvalidValue;
+
+    Block block = it->second;
+    m_live.erase(it);
+    m_live_bytes -= block.bytes;
+
+    if (block.bin != INVALID_BIN
+        && m_cached_bytes + block.bytes <= m_max_cached_bytes)
+    {
+        // Other streams may reuse the block once the work that is
+        // currently on its stream is done.
+        if (!block.ready)
+            block.ready = make_event_notiming();
+        record(block.ready, block.stream);
+        m_cached_bytes += block.bytes;
+        m_cached.emplace(block.bin, block);
+        if (m_debug)
+            H2_GPU_DEBUG("cached block {} ({} bytes)", block.ptr, block.bytes);
+    }
+    else
+    {
+        if (m_debug)
+            H2_GPU_DEBUG("freed block {} ({} bytes)", block.ptr, block.bytes);
+        // The memory may still be in use by work on its stream.
+        sync(block.stream);
+        release(block);
+    }
+    return DeviceError::Success;
+}
+
+DeviceError CachingHostAllocator::FreeAllCached()
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    for (auto& kv : m_cached)
+    {
+        sync(kv.second.ready);
+        release(kv.second);
+    }
+    m_cached.clear();
+    m_cached_bytes = 0;
+    return DeviceError::Success;
+}
+
+std::size_t CachingHostAllocator::cached_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_cached_bytes;
+}
+
+std::size_t CachingHostAllocator::live_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_live_bytes;
+}
+
+} // namespace host
+} // namespace gpu
+} // namespace h2
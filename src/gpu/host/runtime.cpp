@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+#include "h2/gpu/runtime.hpp"
+
+#include "h2/gpu/error.hpp"
+#include "h2/gpu/logger.hpp"
+#include "h2/gpu/memory_utils.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+// The emulated runtime has a single device (the host). Each stream
+// owns a worker thread that runs its tasks in order. Streams that are
+// destroyed finish their outstanding work first, so destroy() blocks
+// where cudaStreamDestroy() would not. A device-wide sync() that is
+// still waiting on a destroyed stream finishes it instead.
+
+namespace h2
+{
+namespace gpu
+{
+namespace host
+{
+
+class Stream
+{
+public:
+    Stream() : m_worker{[this]() { run(); }} {}
+
+    ~Stream()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_stop = true;
+        }
+        m_work_cv.notify_one();
+        m_worker.join();
+    }
+
+    void launch(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_tasks.push_back(std::move(task));
+        }
+        m_work_cv.notify_one();
+    }
+
+    bool idle() const
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        return m_tasks.empty() && !m_busy;
+    }
+
+    // Wait for all enqueued work, then rethrow the first exception
+    // thrown by a task since the last sync, if any.
+    void sync()
+    {
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_idle_cv.wait(lock,
+                           [this]() { return m_tasks.empty() && !m_busy; });
+            std::swap(error, m_error);
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mtx);
+        while (true)
+        {
+            m_work_cv.wait(lock,
+                           [this]() { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty())
+                return;
+
+            auto task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_busy = true;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (error && !m_error)
+                m_error = error;
+            m_busy = false;
+            if (m_tasks.empty())
+                m_idle_cv.notify_all();
+        }
+    }
+
+    mutable std::mutex m_mtx;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_idle_cv;
+    std::deque<std::function<void()>> m_tasks;
+    std::exception_ptr m_error;
+    bool m_busy = false;
+    bool m_stop = false;
+    // Declared last so that it starts after the rest is constructed.
+    std::thread m_worker;
+}; // class Stream
+
+class Event
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // The shared state outlives the Event so that tasks enqueued by
+    // record() or wait() may still refer to it after destroy().
+    struct State
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::uint64_t recorded = 0;
+        std::uint64_t completed = 0;
+        Clock::time_point time;
+    };
+
+    explicit Event(bool timing)
+        : m_state{std::make_shared<State>()}, m_timing{timing}
+    {}
+
+    std::shared_ptr<State> const& state() const noexcept { return m_state; }
+    bool timing() const noexcept { return m_timing; }
+
+private:
+    std::shared_ptr<State> m_state;
+    bool m_timing;
+}; // class Event
+
+} // namespace host
+} // namespace gpu
+} // namespace h2
+
+namespace
+{
+
+using h2::gpu::DeviceError;
+using h2::gpu::DeviceEvent;
+using h2::gpu::DeviceStream;
+using h2::gpu::GPUError;
+using h2::gpu::host::Event;
+using h2::gpu::host::Stream;
+
+bool initialized_ = false;
+
+// Streams other than the default stream, for device-wide sync. These
+// own the streams so that sync() can keep them alive.
+std::mutex streams_mtx_;
+std::unordered_map<Stream*, std::shared_ptr<Stream>> streams_;
+
+Stream& default_stream()
+{
+    static Stream stream;
+    return stream;
+}
+
+Stream& get_stream(DeviceStream const stream)
+{
+    return (stream ? *stream : default_stream());
+}
+
+void wait_for(Event::State& state, std::uint64_t const ticket)
+{
+    std::unique_lock<std::mutex> lock(state.mtx);
+    state.cv.wait(lock, [&]() { return state.completed >= ticket; });
+}
+
+} // namespace
+
+int h2::gpu::num_gpus()
+{
+    return 1;
+}
+
+int h2::gpu::current_gpu()
+{
+    return 0;
+}
+
+void h2::gpu::set_gpu(int id)
+{
+    H2_GPU_TRACE("setting device to id={}", id);
+    if (id != 0)
+        throw GPUError(DeviceError::InvalidValue);
+}
+
+void h2::gpu::init_runtime()
+{
+    if (initialized_)
+        return;
+
+    H2_GPU_TRACE("initializing emulated gpu runtime");
+    initialized_ = true;
+}
+
+void h2::gpu::finalize_runtime()
+{
+    if (!initialized_)
+        return;
+
+    H2_GPU_TRACE("finalizing emulated gpu runtime");
+    initialized_ = false;
+}
+
+bool h2::gpu::runtime_is_initialized()
+{
+    return initialized_;
+}
+
+bool h2::gpu::runtime_is_finalized()
+{
+    return !initialized_;
+}
+
+DeviceStream h2::gpu::make_stream()
+{
+    auto stream = std::make_shared<Stream>();
+    DeviceStream const handle = stream.get();
+    {
+        std::lock_guard<std::mutex> lock(streams_mtx_);
+        streams_.emplace(handle, std::move(stream));
+    }
+    H2_GPU_TRACE("created stream {}", (void*) handle);
+    return handle;
+}
+
+DeviceStream h2::gpu::make_stream_nonblocking()
+{
+    // Emulated streams never synchronize implicitly.
+    return make_stream();
+}
+
+void h2::gpu::destroy(DeviceStream const stream)
+{
+    H2_GPU_TRACE("destroy stream {}", (void*) stream);
+    if (!stream)
+        throw GPUError(DeviceError::InvalidValue);
+    std::shared_ptr<Stream> owner;
+    {
+        std::lock_guard<std::mutex> lock(streams_mtx_);
+        auto const it = streams_.find(stream);
+        if (it == streams_.end())
+            throw GPUError(DeviceError::InvalidValue);
+        owner = std::move(it->second);
+        streams_.erase(it);
+    }
+    // Joins the worker unless sync() still holds the stream.
+    owner.reset();
+}
+
+DeviceEvent h2::gpu::make_event()
+{
+    auto* const event = new Event(/*timing=*/true);
+    H2_GPU_TRACE("created event {}", (void*) event);
+    return event;
+}
+
+DeviceEvent h2::gpu::make_event_notiming()
+{
+    auto* const event = new Event(/*timing=*/false);
+    H2_GPU_TRACE("created non-timing event {}", (void*) event);
+    return event;
+}
+
+void h2::gpu::destroy(DeviceEvent const event)
+{
+    H2_GPU_TRACE("destroy event {}", (void*) event);
+    delete event;
+}
+
+void h2::gpu::record(DeviceEvent const event, DeviceStream const stream)
+{
+    H2_GPU_TRACE(
+        "record event {} on stream {}", (void*) event, (void*) stream);
+    if (!event)
+        throw GPUError(DeviceError::InvalidValue);
+
+    auto state = event->state();
+    std::uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        ticket = ++state->recorded;
+    }
+    bool const timing = event->timing();
+    get_stream(stream).launch([state, ticket, timing]() {
+        {
+            std::lock_guard<std::mutex> lock(state->mtx);
+            if (timing)
+                state->time = Event::Clock::now();
+            state->completed = ticket;
+        }
+        state->cv.notify_all();
+    });
+}
+
+void h2::gpu::wait(DeviceStream const stream, DeviceEvent const event)
+{
+    H2_GPU_TRACE(
+        "stream {} waits on event {}", (void*) stream, (void*) event);
+    if (!event)
+        throw GPUError(DeviceError::InvalidValue);
+
+    auto state = event->state();
+    std::uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        ticket = state->recorded;
+    }
+    get_stream(stream).launch([state, ticket]() { wait_for(*state, ticket); });
+}
+
+bool h2::gpu::query(DeviceEvent const event)
+{
+    if (!event)
+        throw GPUError(DeviceError::InvalidValue);
+
+    auto const& state = event->state();
+    std::lock_guard<std::mutex> lock(state->mtx);
+    return state->completed >= state->recorded;
+}
+
+float h2::gpu::elapsed_time(DeviceEvent const start, DeviceEvent const end)
+{
+    if (!start || !end || !start->timing() || !end->timing())
+        throw GPUError(DeviceError::InvalidValue);
+
+    Event::Clock::time_point start_time, end_time;
+    for (auto* const event : {start, end})
+    {
+        auto const& state = event->state();
+        std::lock_guard<std::mutex> lock(state->mtx);
+        if (state->recorded == 0)
+            throw GPUError(DeviceError::InvalidValue);
+        if (state->completed < state->recorded)
+            throw GPUError(DeviceError::NotReady);
+        (event == start ? start_time : end_time) = state->time;
+    }
+    return std::chrono::duration<float, std::milli>(end_time - start_time)
+        .count();
+}
+
+void h2::gpu::launch(DeviceStream const stream, std::function<void()> task)
+{
+    get_stream(stream).launch(std::move(task));
+}
+
+bool h2::gpu::query(DeviceStream const stream)
+{
+    return get_stream(stream).idle();
+}
+
+void h2::gpu::sync()
+{
+    H2_GPU_TRACE("synchronizing emulated gpu");
+    std::vector<std::shared_ptr<Stream>> streams;
+    {
+        std::lock_guard<std::mutex> lock(streams_mtx_);
+        streams.reserve(streams_.size());
+        for (auto const& kv : streams_)
+            streams.push_back(kv.second);
+    }
+    default_stream().sync();
+    for (auto const& stream : streams)
+        stream->sync();
+}
+
+void h2::gpu::sync(DeviceEvent const event)
+{
+    H2_GPU_TRACE("synchronizing event {}", (void*) event);
+    if (!event)
+        throw GPUError(DeviceError::InvalidValue);
+
+    auto const& state = event->state();
+    std::uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        ticket = state->recorded;
+    }
+    wait_for(*state, ticket);
+}
+
+void h2::gpu::sync(DeviceStream const stream)
+{
+    H2_GPU_TRACE("synchronizing stream {}", (void*) stream);
+    get_stream(stream).sync();
+}
+
+h2::gpu::MemInfo h2::gpu::mem_info()
+{
+    auto const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    MemInfo info;
+    info.free = static_cast<size_t>(sysconf(_SC_AVPHYS_PAGES)) * page_size;
+    info.total = static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * page_size;
+    return info;
+}
@@ -14,9 +14,12 @@
 #elif H2_HAS_ROCM
 #include <hip/hip_runtime.h>
 #include <hipcub/hipcub.hpp>
+#elif H2_HAS_GPU_EMULATION
+#include "h2/gpu/host/allocator.hpp"
 #endif
 
 #include <cstdlib>
+#include <cstring>
 
 // Note: The behavior of functions in this file may be impacted by the
 // following user-provided environment variables (these corresponde
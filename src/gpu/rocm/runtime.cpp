@@ -425,6 +425,36 @@ void h2::gpu::destroy(hipEvent_t const event)
     H2_CHECK_HIP(hipEventDestroy(event));
 }
 
+void h2::gpu::record(hipEvent_t const event, hipStream_t const stream)
+{
+    H2_GPU_TRACE(
+        "record event {} on stream {}", (void*) event, (void*) stream);
+    H2_CHECK_HIP(hipEventRecord(event, stream));
+}
+
+void h2::gpu::wait(hipStream_t const stream, hipEvent_t const event)
+{
+    H2_GPU_TRACE(
+        "stream {} waits on event {}", (void*) stream, (void*) event);
+    H2_CHECK_HIP(hipStreamWaitEvent(stream, event, 0));
+}
+
+bool h2::gpu::query(hipEvent_t const event)
+{
+    auto const status = hipEventQuery(event);
+    if (status == hipErrorNotReady)
+        return false;
+    H2_CHECK_HIP(status);
+    return true;
+}
+
+float h2::gpu::elapsed_time(hipEvent_t const start, hipEvent_t const end)
+{
+    float ms;
+    H2_CHECK_HIP(hipEventElapsedTime(&ms, start, end));
+    return ms;
+}
+
 void h2::gpu::sync()
 {
     H2_GPU_TRACE("synchronizing gpu");
@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <h2/utils/Expected.hpp>
+
+#include <ostream>
+
+namespace h2
+{
+char const* to_string(ErrorCode code) noexcept
+{
+    switch (code)
+    {
+    case ErrorCode::InvalidArgument: return "invalid argument";
+    case ErrorCode::OutOfMemory: return "out of memory";
+    case ErrorCode::NotImplemented: return "not implemented";
+    case ErrorCode::NotSupported: return "not supported";
+    case ErrorCode::Communication: return "communication error";
+    case ErrorCode::Internal: return "internal error";
+    }
+    return "unknown error";
+}
+
+std::ostream& operator<<(std::ostream& os, Error const& err)
+{
+    os << to_string(err.code());
+    if (err.context() && *err.context())
+        os << ": " << err.context();
+    if (err.file() && *err.file())
+        os << " (" << err.file() << ":" << err.line() << ")";
+    return os;
+}
+} // namespace h2
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+// Compile-time benchmark of the typelist algorithms. The list length
+// is given by H2_TLIST_BENCHMARK_SIZE; see CMakeLists.txt.
+
+#include "h2/meta/Core.hpp"
+#include "h2/meta/TypeList.hpp"
+
+#include <utility>
+
+#ifndef H2_TLIST_BENCHMARK_SIZE
+#define H2_TLIST_BENCHMARK_SIZE 10
+#endif
+
+using namespace h2::meta;
+
+namespace
+{
+constexpr int N = H2_TLIST_BENCHMARK_SIZE;
+
+template <int I>
+using IntT = ValueAsType<int, I>;
+
+template <typename A, typename B>
+struct ValueLess : ValueAsType<bool, (A::value < B::value)>
+{};
+
+template <typename Seq>
+struct ListsT;
+
+template <int... Is>
+struct ListsT<std::integer_sequence<int, Is...>>
+{
+    // N distinct types in decreasing order
+    using reversed = TL<IntT<N - 1 - Is>...>;
+    using sorted = TL<IntT<Is>...>;
+    // Each type of a list of N/2 types twice
+    using duplicates = TL<IntT<Is % (N / 2)>...>;
+
+    // Accesses every element
+    static constexpr bool at =
+        (EqV<tlist::At<reversed, Is>, IntT<N - 1 - Is>>() && ...);
+    // Finds every element
+    static constexpr bool find =
+        ((tlist::Find<reversed, IntT<Is>> == N - 1UL - Is) && ...);
+};
+
+using Lists = ListsT<std::make_integer_sequence<int, N>>;
+using Reversed = typename Lists::reversed;
+
+template <int... Is>
+constexpr auto HalfList(std::integer_sequence<int, Is...>)
+{
+    return TL<IntT<Is>...>{};
+}
+
+} // namespace
+
+static_assert(Lists::at, "At");
+static_assert(Lists::find, "Find");
+static_assert(
+    EqV<tlist::Sort<Reversed, ValueLess>, typename Lists::sorted>(), "Sort");
+static_assert(
+    EqV<tlist::Unique<typename Lists::duplicates>,
+        decltype(HalfList(std::make_integer_sequence<int, N / 2>{}))>(),
+    "Unique");
+static_assert(tlist::Length<tlist::Remove<Reversed, IntT<N / 2>>> == N - 1,
+              "Remove");
+static_assert(
+    EqV<tlist::At<tlist::Replace<Reversed, IntT<0>, bool>, N - 1>, bool>(),
+    "Replace");
@@ -51,3 +51,28 @@ static_assert(
     EqV<tlist::Sort<IntList<4, 8, 2, 1, 3, 3, 9, 6>, ValueLess>,
         IntList<1, 2, 3, 3, 4, 6, 8, 9>>(),
     "Sort a random list.");
+
+namespace
+{
+template <int Key, int Tag>
+struct KeyTag
+{
+    static constexpr int value = Key;
+};
+} // namespace
+
+static_assert(
+    EqV<tlist::Sort<TL<KeyTag<2, 0>,
+                       KeyTag<1, 1>,
+                       KeyTag<2, 2>,
+                       KeyTag<1, 3>,
+                       KeyTag<0, 4>,
+                       KeyTag<2, 5>>,
+                    ValueLess>,
+        TL<KeyTag<0, 4>,
+           KeyTag<1, 1>,
+           KeyTag<1, 3>,
+           KeyTag<2, 0>,
+           KeyTag<2, 2>,
+           KeyTag<2, 5>>>(),
+    "Sorting is stable.");
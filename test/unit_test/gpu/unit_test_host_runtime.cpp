@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include <h2/gpu/host/allocator.hpp>
+#include <h2/gpu/memory_utils.hpp>
+#include <h2/gpu/runtime.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace h2::gpu;
+
+TEST_CASE("Emulated device", "[gpu][host]")
+{
+    CHECK(num_gpus() == 1);
+    CHECK(current_gpu() == 0);
+    CHECK_NOTHROW(set_gpu(0));
+    CHECK_THROWS(set_gpu(1));
+}
+
+TEST_CASE("Emulated streams run tasks in order", "[gpu][host]")
+{
+    DeviceStream stream = make_stream();
+    std::vector<int> order;
+    for (int i = 0; i < 100; ++i)
+        launch(stream, [&order, i]() { order.push_back(i); });
+    sync(stream);
+    CHECK(query(stream));
+    REQUIRE(order.size() == 100UL);
+    for (int i = 0; i < 100; ++i)
+        CHECK(order[i] == i);
+    destroy(stream);
+}
+
+TEST_CASE("Emulated streams report task failures on sync", "[gpu][host]")
+{
+    DeviceStream stream = make_stream_nonblocking();
+    bool ran_after = false;
+    launch(stream, []() { throw std::runtime_error("task failed"); });
+    launch(stream, [&ran_after]() { ran_after = true; });
+    CHECK_THROWS_AS(sync(stream), std::runtime_error);
+    CHECK(ran_after);
+    CHECK_NOTHROW(sync(stream));
+    destroy(stream);
+}
+
+TEST_CASE("Emulated events order streams", "[gpu][host]")
+{
+    DeviceStream producer = make_stream();
+    DeviceStream consumer = make_stream();
+    DeviceEvent event = make_event_notiming();
+
+    // The event has not been recorded, so it is complete.
+    CHECK(query(event));
+
+    std::atomic<bool> release{false};
+    int value = 0;
+    int seen = -1;
+    launch(producer, [&]() {
+        while (!release)
+            std::this_thread::yield();
+        value = 42;
+    });
+    record(event, producer);
+    wait(consumer, event);
+    launch(consumer, [&]() { seen = value; });
+
+    CHECK_FALSE(query(event));
+    CHECK_FALSE(query(consumer));
+    release = true;
+    sync(consumer);
+    CHECK(query(event));
+    CHECK(seen == 42);
+
+    destroy(event);
+    destroy(consumer);
+    destroy(producer);
+}
+
+TEST_CASE("Emulated events reject null events", "[gpu][host]")
+{
+    DeviceEvent const event = nullptr;
+    CHECK_THROWS(query(event));
+    CHECK_THROWS(sync(event));
+    CHECK_THROWS(record(event, nullptr));
+    CHECK_THROWS(wait(nullptr, event));
+}
+
+TEST_CASE("Emulated streams may be destroyed during a device sync",
+          "[gpu][host]")
+{
+    DeviceStream stream = make_stream();
+    std::atomic<bool> release{false};
+    std::atomic<bool> ran{false};
+    launch(stream, [&]() {
+        while (!release)
+            std::this_thread::yield();
+        ran = true;
+    });
+    std::thread syncer([]() { h2::gpu::sync(); });
+    // Give the device sync time to start waiting on the stream.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::thread releaser([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        release = true;
+    });
+    destroy(stream);
+    releaser.join();
+    syncer.join();
+    CHECK(ran);
+}
+
+TEST_CASE("Emulated events time stream work", "[gpu][host]")
+{
+    DeviceStream stream = make_stream();
+    DeviceEvent start = make_event();
+    DeviceEvent end = make_event();
+    DeviceEvent no_timing = make_event_notiming();
+
+    CHECK_THROWS(elapsed_time(start, end));
+
+    record(start, stream);
+    launch(stream, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    });
+    record(end, stream);
+    record(no_timing, stream);
+    sync(end);
+    CHECK(elapsed_time(start, end) >= 10.f);
+    CHECK_THROWS(elapsed_time(start, no_timing));
+
+    sync(stream);
+    destroy(no_timing);
+    destroy(end);
+    destroy(start);
+    destroy(stream);
+}
+
+TEST_CASE("Emulated memory functions", "[gpu][host]")
+{
+    DeviceStream stream = make_stream();
+    std::vector<int> src(1024, 7), dst(1024, 0);
+
+    mem_copy(dst.data(), src.data(), dst.size(), stream);
+    sync(stream);
+    CHECK(dst == src);
+
+    mem_zero(dst.data(), dst.size(), stream);
+    sync(stream);
+    CHECK(dst == std::vector<int>(1024, 0));
+
+    mem_copy(dst.data(), src.data(), dst.size());
+    CHECK(dst == src);
+    mem_zero(dst.data(), dst.size());
+    CHECK(dst == std::vector<int>(1024, 0));
+
+    auto const info = mem_info();
+    CHECK(info.total > 0UL);
+    CHECK(info.free <= info.total);
+
+    destroy(stream);
+}
+
+TEST_CASE("Emulated caching allocator", "[gpu][host]")
+{
+    host::CachingHostAllocator alloc{/*bin_growth=*/2, /*min_bin=*/8};
+    DeviceStream stream = make_stream();
+    DeviceStream other = make_stream();
+
+    SECTION("Blocks are rounded up to bins and reused")
+    {
+        void* ptr = nullptr;
+        REQUIRE(ok(alloc.DeviceAllocate(&ptr, 300, stream)));
+        CHECK(reinterpret_cast<std::uintptr_t>(ptr) % 256 == 0UL);
+        CHECK(alloc.live_bytes() == 512UL);
+
+        REQUIRE(ok(alloc.DeviceFree(ptr)));
+        CHECK(alloc.live_bytes() == 0UL);
+        CHECK(alloc.cached_bytes() == 512UL);
+
+        void* again = nullptr;
+        REQUIRE(ok(alloc.DeviceAllocate(&again, 400, stream)));
+        CHECK(again == ptr);
+        CHECK(alloc.cached_bytes() == 0UL);
+        REQUIRE(ok(alloc.DeviceFree(again)));
+    }
+
+    SECTION("Blocks in use on one stream are not given to another")
+    {
+        std::atomic<bool> release{false};
+        void* ptr = nullptr;
+        REQUIRE(ok(alloc.DeviceAllocate(&ptr, 256, stream)));
+        launch(stream, [&release]() {
+            while (!release)
+                std::this_thread::yield();
+        });
+        REQUIRE(ok(alloc.DeviceFree(ptr)));
+
+        void* other_ptr = nullptr;
+        REQUIRE(ok(alloc.DeviceAllocate(&other_ptr, 256, other)));
+        CHECK(other_ptr != ptr);
+
+        release = true;
+        sync(stream);
+        void* reused = nullptr;
+        REQUIRE(ok(alloc.DeviceAllocate(&reused, 256, other)));
+        CHECK(reused == ptr);
+
+        REQUIRE(ok(alloc.DeviceFree(reused)));
+        REQUIRE(ok(alloc.DeviceFree(other_ptr)));
+    }
+
+    SECTION("Unknown pointers are rejected")
+    {
+        int x;
+        CHECK_FALSE(ok(alloc.DeviceFree(&x)));
+    }
+
+    REQUIRE(ok(alloc.FreeAllCached()));
+    CHECK(alloc.cached_bytes() == 0UL);
+    destroy(other);
+    destroy(stream);
+}
@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include <h2/patterns/factory/FrozenObjectFactory.hpp>
+#include <h2/patterns/factory/NullptrErrorPolicy.hpp>
+#include <h2/patterns/factory/ObjectFactory.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+namespace
+{
+struct WidgetBase
+{
+    virtual ~WidgetBase() = default;
+    virtual int value() const { return 0; }
+};
+struct Widget : WidgetBase
+{};
+struct Gizmo : WidgetBase
+{};
+struct ValueWidget : WidgetBase
+{
+    ValueWidget(int v) : v_(v) {}
+    int value() const override { return v_; }
+    int v_;
+};
+
+std::unique_ptr<WidgetBase> MakeWidget()
+{
+    return std::unique_ptr<Widget>(new Widget);
+}
+
+std::unique_ptr<WidgetBase> MakeGizmo()
+{
+    return std::unique_ptr<Gizmo>(new Gizmo);
+}
+
+template <typename T>
+T GetKey(int i);
+
+template <>
+int GetKey<int>(int i)
+{
+    return i;
+}
+
+template <>
+std::string GetKey<std::string>(int i)
+{
+    return "Builder number " + std::to_string(i);
+}
+
+template <typename IdType, int N>
+void BenchmarkFactories()
+{
+    using Factory = h2::factory::ObjectFactory<WidgetBase, IdType>;
+    using FrozenFactory = h2::factory::FrozenObjectFactory<WidgetBase, IdType>;
+    Factory factory;
+    FrozenFactory frozen_factory;
+    for (int i = 0; i < N; ++i)
+    {
+        factory.register_builder(GetKey<IdType>(i), MakeWidget);
+        frozen_factory.register_builder(GetKey<IdType>(i), MakeWidget);
+    }
+    frozen_factory.freeze();
+    std::vector<IdType> keys;
+    for (int i = 0; i < N; ++i)
+        keys.push_back(GetKey<IdType>((i * 7) % N));
+
+    // Builders that do not allocate isolate the lookup cost.
+    using LookupFactory =
+        h2::factory::ObjectFactory<WidgetBase,
+                                   IdType,
+                                   std::function<std::unique_ptr<WidgetBase>()>,
+                                   h2::factory::NullptrErrorPolicy>;
+    using FrozenLookupFactory =
+        h2::factory::FrozenObjectFactory<WidgetBase,
+                                         IdType,
+                                         h2::factory::InplaceBuilder<
+                                             std::unique_ptr<WidgetBase>()>,
+                                         h2::factory::NullptrErrorPolicy>;
+    auto make_null = []() { return std::unique_ptr<WidgetBase>(); };
+    LookupFactory lookup_factory;
+    FrozenLookupFactory frozen_lookup_factory;
+    for (int i = 0; i < N; ++i)
+    {
+        lookup_factory.register_builder(GetKey<IdType>(i), make_null);
+        frozen_lookup_factory.register_builder(GetKey<IdType>(i), make_null);
+    }
+    frozen_lookup_factory.freeze();
+
+    auto const suffix = ", " + std::to_string(N) + " builders";
+    BENCHMARK("ObjectFactory lookup" + suffix)
+    {
+        std::size_t n = 0;
+        for (auto const& key : keys)
+            n += lookup_factory.create_object(key) == nullptr;
+        return n;
+    };
+    BENCHMARK("FrozenObjectFactory lookup" + suffix)
+    {
+        std::size_t n = 0;
+        for (auto const& key : keys)
+            n += frozen_lookup_factory.create_object(key) == nullptr;
+        return n;
+    };
+    BENCHMARK("ObjectFactory creation" + suffix)
+    {
+        std::size_t n = 0;
+        for (auto const& key : keys)
+            n += factory.create_object(key)->value();
+        return n;
+    };
+    BENCHMARK("FrozenObjectFactory creation" + suffix)
+    {
+        std::size_t n = 0;
+        for (auto const& key : keys)
+            n += frozen_factory.create_object(key)->value();
+        return n;
+    };
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("testing the frozen factory class",
+                   "[factory][utilities]",
+                   std::string,
+                   int)
+{
+    using WidgetFactory =
+        h2::factory::FrozenObjectFactory<WidgetBase, TestType>;
+
+    WidgetFactory factory;
+    auto const widget_key = GetKey<TestType>(2);
+    auto const gizmo_key = GetKey<TestType>(1);
+    auto const invalid_key = GetKey<TestType>(0);
+
+    SECTION("New builders are registered")
+    {
+        CHECK(factory.register_builder(widget_key, MakeWidget));
+        CHECK(factory.register_builder(gizmo_key, MakeGizmo));
+        CHECK_FALSE(factory.register_builder(gizmo_key, MakeWidget));
+        CHECK(factory.size() == 2UL);
+
+        // The ids are sorted.
+        auto const& ids = factory.registered_ids();
+        REQUIRE(ids.size() == 2UL);
+        CHECK(ids[0] < ids[1]);
+    }
+
+    SECTION("Objects are created before and after freezing")
+    {
+        CHECK(factory.register_builder(widget_key, MakeWidget));
+        CHECK(factory.register_builder(gizmo_key, MakeGizmo));
+
+        auto w = factory.create_object(widget_key);
+        auto const& w_ref = *w;
+        CHECK(typeid(w_ref) == typeid(Widget));
+
+        factory.freeze();
+        CHECK(factory.is_frozen());
+
+        auto g = factory.create_object(gizmo_key);
+        auto const& g_ref = *g;
+        CHECK(typeid(g_ref) == typeid(Gizmo));
+        CHECK_THROWS_WITH(factory.create_object(invalid_key),
+                          "Unknown type identifier.");
+    }
+
+    SECTION("A frozen factory cannot be modified")
+    {
+        CHECK(factory.register_builder(widget_key, MakeWidget));
+        factory.freeze();
+        CHECK_THROWS_AS(factory.register_builder(gizmo_key, MakeGizmo),
+                        std::logic_error);
+        CHECK_THROWS_AS(factory.unregister(widget_key), std::logic_error);
+        CHECK(factory.size() == 1UL);
+    }
+
+    SECTION("Keys are removed")
+    {
+        CHECK(factory.register_builder(widget_key, MakeWidget));
+        CHECK(factory.register_builder(gizmo_key, MakeGizmo));
+        CHECK(factory.unregister(widget_key));
+        CHECK_FALSE(factory.unregister(widget_key));
+        CHECK(factory.size() == 1UL);
+        CHECK(factory.registered_ids().front() == gizmo_key);
+        CHECK_THROWS_AS(factory.create_object(widget_key), std::exception);
+    }
+}
+
+TEST_CASE("Frozen factory with arguments and stateful builders",
+          "[factory][utilities]")
+{
+    using Builder = h2::factory::InplaceBuilder<
+        std::unique_ptr<WidgetBase>(int)>;
+    h2::factory::FrozenObjectFactory<WidgetBase, int, Builder> factory;
+
+    int const offset = 10;
+    CHECK(factory.register_builder(0, [](int v) {
+        return std::unique_ptr<WidgetBase>(new ValueWidget(v));
+    }));
+    CHECK(factory.register_builder(1, [offset](int v) {
+        return std::unique_ptr<WidgetBase>(new ValueWidget(v + offset));
+    }));
+    factory.freeze();
+
+    CHECK(factory.create_object(0, 3)->value() == 3);
+    CHECK(factory.create_object(1, 3)->value() == 13);
+
+    SECTION("Objects are created concurrently")
+    {
+        constexpr int num_threads = 4;
+        constexpr int num_objects = 1000;
+        std::atomic<int> num_errors(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&factory, &num_errors, t]() {
+                for (int i = 0; i < num_objects; ++i)
+                {
+                    int const id = (i + t) % 2;
+                    if (factory.create_object(id, i)->value()
+                        != i + 10 * id)
+                        ++num_errors;
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        CHECK(num_errors == 0);
+    }
+}
+
+TEST_CASE("InplaceBuilder", "[factory][utilities]")
+{
+    using Builder = h2::factory::InplaceBuilder<int(int)>;
+
+    Builder empty;
+    CHECK_FALSE(empty);
+
+    auto ptr = std::make_shared<int>(5);
+    Builder b([ptr](int x) { return *ptr + x; });
+    REQUIRE(b);
+    CHECK(b(1) == 6);
+    CHECK(ptr.use_count() == 2);
+
+    Builder moved(std::move(b));
+    CHECK_FALSE(b);
+    CHECK(moved(2) == 7);
+    CHECK(ptr.use_count() == 2);
+
+    b = std::move(moved);
+    CHECK(b(3) == 8);
+    b = Builder();
+    CHECK_FALSE(b);
+    CHECK(ptr.use_count() == 1);
+}
+
+TEST_CASE("Frozen factory vs. object factory",
+          "[factory][utilities][!benchmark]")
+{
+    BenchmarkFactories<int, 4>();
+    BenchmarkFactories<int, 64>();
+    BenchmarkFactories<std::string, 4>();
+    BenchmarkFactories<std::string, 64>();
+}
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include <h2/patterns/factory/PooledCopyFactory.hpp>
+#include <h2/patterns/factory/PooledPrototypeFactory.hpp>
+#include <h2/patterns/factory/PrototypeFactory.hpp>
+
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+namespace
+{
+struct WidgetBase
+{
+    virtual WidgetBase* Copy() const = 0;
+    virtual void Assign(WidgetBase const& other) = 0;
+    virtual int Data() const noexcept = 0;
+    virtual ~WidgetBase() = default;
+};
+
+template <typename Derived>
+struct WidgetImpl : WidgetBase
+{
+    WidgetImpl(int d) : data_(d) {}
+    WidgetBase* Copy() const override
+    {
+        return new Derived(static_cast<Derived const&>(*this));
+    }
+    void Assign(WidgetBase const& other) override
+    {
+        static_cast<Derived&>(*this) = dynamic_cast<Derived const&>(other);
+    }
+    int Data() const noexcept override { return data_; }
+    int data_;
+};
+
+struct Widget : WidgetImpl<Widget>
+{
+    using WidgetImpl::WidgetImpl;
+};
+
+struct Gizmo : WidgetImpl<Gizmo>
+{
+    using WidgetImpl::WidgetImpl;
+};
+
+// Owns a buffer, which a reset can reuse but a copy has to allocate.
+struct Buffered : WidgetImpl<Buffered>
+{
+    Buffered(int d, std::size_t size) : WidgetImpl(d), buffer_(size, 1.f) {}
+    std::vector<float> buffer_;
+};
+
+struct BasicCopyPolicy
+{
+    std::unique_ptr<WidgetBase> Copy(WidgetBase const& obj) const
+    {
+        return std::unique_ptr<WidgetBase>(obj.Copy());
+    }
+};
+
+struct AssignResetPolicy
+{
+    void Reset(WidgetBase& obj, WidgetBase const& prototype) const
+    {
+        obj.Assign(prototype);
+    }
+};
+
+std::unique_ptr<WidgetBase> CopyWidget(WidgetBase const& obj)
+{
+    return std::unique_ptr<WidgetBase>(obj.Copy());
+}
+
+} // namespace
+
+TEST_CASE("testing the object pool", "[factory][utilities]")
+{
+    h2::factory::ObjectPool<WidgetBase> pool;
+    CHECK_FALSE(pool.acquire());
+
+    WidgetBase* address;
+    {
+        auto w = pool.adopt(std::unique_ptr<WidgetBase>(new Widget(3)));
+        address = w.get();
+        CHECK(pool.size() == 1UL);
+        CHECK(pool.num_free() == 0UL);
+    }
+    CHECK(pool.num_free() == 1UL);
+
+    auto w = pool.acquire();
+    CHECK(w.get() == address);
+    CHECK(w->Data() == 3);
+    CHECK(pool.num_free() == 0UL);
+    CHECK_FALSE(pool.acquire());
+}
+
+TEST_CASE("testing the pooled prototype factory class", "[factory][utilities]")
+{
+    using WidgetFactory =
+        h2::factory::PooledPrototypeFactory<WidgetBase,
+                                            std::string,
+                                            BasicCopyPolicy,
+                                            AssignResetPolicy>;
+
+    WidgetFactory factory;
+    CHECK(factory.register_prototype(
+        "widget", std::unique_ptr<WidgetBase>(new Widget(17))));
+    CHECK(factory.register_prototype(
+        "gizmo", std::unique_ptr<WidgetBase>(new Gizmo(71))));
+    CHECK_FALSE(factory.register_prototype(
+        "widget", std::unique_ptr<WidgetBase>(new Widget(13))));
+    CHECK(factory.size() == 2UL);
+
+    SECTION("Copies are recycled per prototype")
+    {
+        WidgetBase* address;
+        {
+            auto w = factory.copy_prototype("widget");
+            auto const& w_ref = *w;
+            CHECK(typeid(w_ref) == typeid(Widget));
+            CHECK(w->Data() == 17);
+            static_cast<Widget&>(*w).data_ = 5;
+            address = w.get();
+        }
+        CHECK(factory.get_pool("widget")->num_free() == 1UL);
+
+        // A gizmo does not reuse the widget.
+        auto g = factory.copy_prototype("gizmo");
+        auto const& g_ref = *g;
+        CHECK(typeid(g_ref) == typeid(Gizmo));
+        CHECK(g.get() != address);
+
+        // The recycled widget is reset to the prototype.
+        auto w = factory.copy_prototype("widget");
+        CHECK(w.get() == address);
+        CHECK(w->Data() == 17);
+        CHECK(factory.get_pool("widget")->size() == 1UL);
+
+        auto w2 = factory.copy_prototype("widget");
+        CHECK(w2.get() != address);
+        CHECK(factory.get_pool("widget")->size() == 2UL);
+    }
+
+    SECTION("Unknown ids are handled by the error policy")
+    {
+        CHECK_THROWS(factory.copy_prototype("invalid key"));
+        CHECK(factory.get_pool("invalid key") == nullptr);
+    }
+
+    SECTION("Unregister types.")
+    {
+        CHECK(factory.unregister("widget"));
+        CHECK_FALSE(factory.unregister("widget"));
+        CHECK(factory.size() == 1UL);
+        CHECK(factory.registered_ids().front() == "gizmo");
+    }
+}
+
+TEST_CASE("testing the pooled copy factory class", "[factory][utilities]")
+{
+    using WidgetFactory =
+        h2::factory::PooledCopyFactory<WidgetBase,
+                                       AssignResetPolicy,
+                                       std::unique_ptr<WidgetBase> (*)(
+                                           WidgetBase const&)>;
+
+    WidgetFactory factory;
+    CHECK(factory.register_builder(typeid(Widget), CopyWidget));
+    CHECK(factory.register_builder(typeid(Gizmo), CopyWidget));
+    CHECK(factory.size() == 2UL);
+
+    Widget const w1(1), w2(2);
+    Gizmo const g(3);
+    WidgetBase* address;
+    {
+        auto c = factory.copy_object(w1);
+        CHECK(c->Data() == 1);
+        address = c.get();
+    }
+    auto c = factory.copy_object(w2);
+    CHECK(c.get() == address);
+    CHECK(c->Data() == 2);
+    CHECK(factory.get_pool(typeid(Widget))->size() == 1UL);
+
+    auto cg = factory.copy_object(g);
+    auto const& cg_ref = *cg;
+    CHECK(typeid(cg_ref) == typeid(Gizmo));
+    CHECK(cg->Data() == 3);
+
+    CHECK(factory.unregister(typeid(Gizmo)));
+    CHECK_THROWS(factory.copy_object(g));
+}
+
+TEST_CASE("Recycled copies match their source", "[factory][utilities]")
+{
+    using WidgetFactory =
+        h2::factory::PooledCopyFactory<WidgetBase, AssignResetPolicy>;
+
+    WidgetFactory factory;
+    CHECK(factory.register_builder(typeid(Buffered), CopyWidget));
+
+    Buffered b1(1, 4), b2(2, 2);
+    b2.buffer_[1] = 5.f;
+    WidgetBase* address;
+    {
+        auto c = factory.copy_object(b1);
+        address = c.get();
+        static_cast<Buffered&>(*c).buffer_[0] = 7.f;
+    }
+    auto c = factory.copy_object(b2);
+    REQUIRE(c.get() == address);
+    CHECK(c->Data() == 2);
+    CHECK(static_cast<Buffered const&>(*c).buffer_
+          == std::vector<float>{1.f, 5.f});
+}
+
+TEST_CASE("Pooled prototype factory vs. prototype factory",
+          "[factory][utilities][!benchmark]")
+{
+    using Factory =
+        h2::factory::PrototypeFactory<WidgetBase, int, BasicCopyPolicy>;
+    using PooledFactory = h2::factory::
+        PooledPrototypeFactory<WidgetBase, int, BasicCopyPolicy>;
+    using PooledResetFactory = h2::factory::PooledPrototypeFactory<
+        WidgetBase, int, BasicCopyPolicy, AssignResetPolicy>;
+
+    for (std::size_t size : {0UL, 1024UL})
+    {
+        Factory factory;
+        PooledFactory pooled_factory;
+        PooledResetFactory pooled_reset_factory;
+        factory.register_prototype(
+            0, std::unique_ptr<WidgetBase>(new Buffered(1, size)));
+        pooled_factory.register_prototype(
+            0, std::unique_ptr<WidgetBase>(new Buffered(1, size)));
+        pooled_reset_factory.register_prototype(
+            0, std::unique_ptr<WidgetBase>(new Buffered(1, size)));
+
+        auto const suffix = ", " + std::to_string(size) + " floats";
+        BENCHMARK("PrototypeFactory" + suffix)
+        {
+            return factory.copy_prototype(0)->Data();
+        };
+        BENCHMARK("PooledPrototypeFactory" + suffix)
+        {
+            return pooled_factory.copy_prototype(0)->Data();
+        };
+        BENCHMARK("PooledPrototypeFactory with reset" + suffix)
+        {
+            return pooled_reset_factory.copy_prototype(0)->Data();
+        };
+    }
+}
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include "h2/meta/TypeList.hpp"
+#include "h2/patterns/multimethods/SwitchDispatcher.hpp"
+#include "h2/patterns/multimethods/TableDispatcher.hpp"
+
+#include <utility>
+
+using namespace h2::meta;
+using namespace h2::multimethods;
+
+namespace
+{
+struct base
+{
+    virtual ~base() = default;
+};
+struct derived_one : base
+{};
+struct derived_two : base
+{};
+struct derived_three : base
+{};
+struct derived_four : base
+{};
+// Not in any list, but derived from a listed type.
+struct derived_two_more : derived_two
+{};
+
+struct DeductionException : std::logic_error
+{
+    DeductionException()
+        : std::logic_error("Failed to deduce the type of an argument")
+    {}
+};
+
+struct DispatchException : std::logic_error
+{
+    DispatchException() : std::logic_error("No viable overload found.") {}
+};
+
+struct TestFunctor
+{
+    int operator()(derived_one const&, derived_one const&) { return 0; }
+    int operator()(derived_two const&, derived_one const&) { return 1; }
+    int operator()(derived_one const&, derived_two const&) { return 2; }
+    int operator()(derived_two const&, derived_two const&) { return 3; }
+    int operator()(derived_one const&, derived_one const&, derived_two const&)
+    {
+        return 4;
+    }
+
+    template <typename... Ts>
+    int DeductionError(Ts&&...)
+    {
+        throw DeductionException{};
+    }
+
+    template <typename... Ts>
+    int DispatchError(Ts&&...)
+    {
+        throw DispatchException{};
+    }
+};
+
+struct TestFunctorWithArgs
+{
+    int operator()(int x, derived_one const&, derived_one const&)
+    {
+        return 0 + x;
+    }
+    int operator()(int x, derived_two const&, derived_one const&)
+    {
+        return 1 + x;
+    }
+
+    template <typename... Ts>
+    int DeductionError(Ts&&...)
+    {
+        throw DeductionException{};
+    }
+
+    template <typename... Ts>
+    int DispatchError(Ts&&...)
+    {
+        throw DispatchException{};
+    }
+};
+
+// Large lists of distinct types for benchmarking
+template <int I>
+struct numbered : base
+{};
+
+template <typename Seq>
+struct NumberedListT;
+
+template <int... Is>
+struct NumberedListT<std::integer_sequence<int, Is...>>
+{
+    using type = TL<numbered<Is>...>;
+};
+
+template <int N>
+using NumberedList =
+    typename NumberedListT<std::make_integer_sequence<int, N>>::type;
+
+struct BenchmarkFunctor
+{
+    template <int I, int J>
+    int operator()(numbered<I> const&, numbered<J> const&)
+    {
+        return I + J;
+    }
+
+    template <typename... Ts>
+    int DeductionError(Ts&&...)
+    {
+        throw DeductionException{};
+    }
+
+    template <typename... Ts>
+    int DispatchError(Ts&&...)
+    {
+        throw DispatchException{};
+    }
+};
+
+template <int N>
+void BenchmarkDispatchers()
+{
+    using List = NumberedList<N>;
+    using Switch =
+        SwitchDispatcher<BenchmarkFunctor, int, base, List, base, List>;
+    using Table =
+        TableDispatcher<BenchmarkFunctor, int, base, List, base, List>;
+    // The last type is the worst case of the switch dispatcher.
+    numbered<N - 1> last;
+    numbered<0> first;
+    base& a = last;
+    base& b = first;
+    BenchmarkFunctor f;
+    REQUIRE(Switch::Exec(f, a, b) == Table::Exec(f, a, b));
+
+    BENCHMARK("SwitchDispatcher, " + std::to_string(N) + " types")
+    {
+        return Switch::Exec(f, a, b);
+    };
+    BENCHMARK("TableDispatcher, " + std::to_string(N) + " types")
+    {
+        return Table::Exec(f, a, b);
+    };
+}
+
+} // namespace
+
+using DTypes = TL<derived_one, derived_two, derived_three>;
+using DTypesNoD3 = TL<derived_one, derived_two>;
+
+TEST_CASE("Table dispatcher", "[h2][utils][multimethods]")
+{
+    derived_one d1;
+    derived_two d2;
+    derived_three d3;
+    derived_four d4;
+    derived_two_more d2m;
+
+    base* d1_b = &d1;
+    base* d2_b = &d2;
+    base* d3_b = &d3;
+    base* d4_b = &d4;
+    base* d2m_b = &d2m;
+
+    SECTION("Double dispatch, basic functor with all deduced arguments.")
+    {
+        using Dispatcher =
+            TableDispatcher<TestFunctor, int, base, DTypes, base, DTypes>;
+
+        TestFunctor f;
+        CHECK(Dispatcher::Exec(f, *d1_b, *d1_b) == f(d1, d1));
+        CHECK(Dispatcher::Exec(f, *d1_b, *d2_b) == f(d1, d2));
+        CHECK(Dispatcher::Exec(f, *d2_b, *d1_b) == f(d2, d1));
+        CHECK(Dispatcher::Exec(f, *d2_b, *d2_b) == f(d2, d2));
+
+        CHECK_THROWS_AS(Dispatcher::Exec(f, *d3_b, *d1_b), DispatchException);
+        CHECK_THROWS_AS(Dispatcher::Exec(f, *d1_b, *d3_b), DispatchException);
+        CHECK_THROWS_AS(Dispatcher::Exec(f, *d4_b, *d1_b), DeductionException);
+        CHECK_THROWS_AS(Dispatcher::Exec(f, *d1_b, *d4_b), DeductionException);
+    }
+
+    SECTION("Types derived from listed types deduce as SwitchDispatcher.")
+    {
+        using Dispatcher =
+            TableDispatcher<TestFunctor, int, base, DTypes, base, DTypes>;
+        using Reference =
+            SwitchDispatcher<TestFunctor, int, base, DTypes, base, DTypes>;
+
+        TestFunctor f;
+        CHECK(Dispatcher::Exec(f, *d2m_b, *d1_b)
+              == Reference::Exec(f, *d2m_b, *d1_b));
+        CHECK(Dispatcher::Exec(f, *d1_b, *d2m_b)
+              == Reference::Exec(f, *d1_b, *d2m_b));
+
+        // A listed base earlier in the list takes precedence.
+        using BaseFirst = TL<derived_two, derived_two_more>;
+        using Dispatcher2 = TableDispatcher<TestFunctor,
+                                            int,
+                                            base,
+                                            BaseFirst,
+                                            base,
+                                            BaseFirst>;
+        CHECK(Dispatcher2::Exec(f, *d2m_b, *d2m_b) == f(d2, d2));
+    }
+
+    SECTION("Triple dispatch")
+    {
+        using Dispatcher = TableDispatcher<
+            TestFunctor, int, base, DTypes, base, DTypes, base, DTypesNoD3>;
+        TestFunctor f;
+        CHECK(Dispatcher::Exec(f, *d1_b, *d1_b, *d2_b) == f(d1, d1, d2));
+        CHECK_THROWS_AS(
+            Dispatcher::Exec(f, *d1_b, *d1_b, *d1_b), DispatchException);
+        CHECK_THROWS_AS(
+            Dispatcher::Exec(f, *d1_b, *d1_b, *d3_b), DeductionException);
+    }
+
+    SECTION("Functor with additional arguments.")
+    {
+        using Dispatcher = TableDispatcher<
+            TestFunctorWithArgs, int, base, DTypes, base, DTypes>;
+
+        TestFunctorWithArgs f;
+        CHECK(Dispatcher::Exec(f, *d1_b, *d1_b, 13) == f(13, d1, d1));
+        CHECK(Dispatcher::Exec(f, *d2_b, *d1_b, 13) == f(13, d2, d1));
+        CHECK_THROWS_AS(
+            Dispatcher::Exec(f, *d2_b, *d3_b, 13), DispatchException);
+        CHECK_THROWS_AS(
+            Dispatcher::Exec(f, *d2_b, *d4_b, 13), DeductionException);
+    }
+}
+
+TEST_CASE("Table dispatcher vs. switch dispatcher",
+          "[h2][utils][multimethods][!benchmark]")
+{
+    BenchmarkDispatchers<2>();
+    BenchmarkDispatchers<4>();
+    BenchmarkDispatchers<8>();
+    BenchmarkDispatchers<16>();
+    BenchmarkDispatchers<32>();
+}
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2020 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include "h2/meta/TypeList.hpp"
+#include "h2/patterns/multimethods/ValueDispatcher.hpp"
+
+#include <type_traits>
+
+using namespace h2::meta;
+using namespace h2::multimethods;
+
+namespace
+{
+enum class DataType
+{
+    FLOAT,
+    DOUBLE,
+    INT,
+    CHAR
+};
+
+enum class Device
+{
+    CPU,
+    GPU
+};
+
+struct DeductionException : std::logic_error
+{
+    DeductionException()
+        : std::logic_error("Failed to deduce the case of a value")
+    {}
+};
+
+struct DispatchException : std::logic_error
+{
+    DispatchException() : std::logic_error("No viable overload found.") {}
+};
+
+struct TestFunctor
+{
+    // Integers are only supported on CPUs.
+    template <typename DTCase, typename NDCase>
+    std::enable_if_t<std::is_floating_point<typename DTCase::type>::value,
+                     int>
+    operator()(int x, DTCase, NDCase, ValueCase<Device::GPU>)
+    {
+        return x + 100 * sizeof(typename DTCase::type) + 10 * NDCase::value
+               + 1;
+    }
+
+    template <typename DTCase, typename NDCase>
+    int operator()(int x, DTCase, NDCase, ValueCase<Device::CPU>)
+    {
+        return x + 100 * sizeof(typename DTCase::type) + 10 * NDCase::value;
+    }
+
+    template <typename... Ts>
+    int DeductionError(Ts&&...)
+    {
+        throw DeductionException{};
+    }
+
+    template <typename... Ts>
+    int DispatchError(Ts&&...)
+    {
+        throw DispatchException{};
+    }
+};
+
+struct NDFunctor
+{
+    template <typename NDCase>
+    int operator()(NDCase)
+    {
+        return NDCase::value;
+    }
+
+    template <typename... Ts>
+    int DeductionError(Ts&&...)
+    {
+        return -1;
+    }
+
+    template <typename... Ts>
+    int DispatchError(Ts&&...)
+    {
+        return -2;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Value dispatcher", "[h2][utils][multimethods]")
+{
+    using DTCases = TL<ValueCase<DataType::FLOAT, float>,
+                       ValueCase<DataType::DOUBLE, double>,
+                       ValueCase<DataType::INT, int>>;
+    using NDCases = TL<ValueCase<4>, ValueCase<5>>;
+    using DeviceCases = TL<ValueCase<Device::CPU>, ValueCase<Device::GPU>>;
+
+    SECTION("Single value")
+    {
+        using Dispatcher = ValueDispatcher<NDFunctor, int, NDCases>;
+        CHECK(Dispatcher::Exec(NDFunctor{}, 4) == 4);
+        CHECK(Dispatcher::Exec(NDFunctor{}, 5) == 5);
+        CHECK(Dispatcher::Exec(NDFunctor{}, 3) == -1);
+    }
+
+    SECTION("meta::ValueAsType cases")
+    {
+        using Dispatcher = ValueDispatcher<
+            NDFunctor,
+            int,
+            TL<ValueAsType<int, 2>, ValueAsType<int, 3>>>;
+        CHECK(Dispatcher::Exec(NDFunctor{}, 2) == 2);
+        CHECK(Dispatcher::Exec(NDFunctor{}, 3) == 3);
+    }
+
+    SECTION("Multiple values with additional arguments")
+    {
+        using Dispatcher =
+            ValueDispatcher<TestFunctor, int, DTCases, NDCases, DeviceCases>;
+        TestFunctor f;
+        CHECK(Dispatcher::Exec(f, DataType::FLOAT, 4, Device::CPU, 7)
+              == 447);
+        CHECK(Dispatcher::Exec(f, DataType::DOUBLE, 5, Device::CPU, 7)
+              == 857);
+        CHECK(Dispatcher::Exec(f, DataType::DOUBLE, 4, Device::GPU, 7)
+              == 848);
+        CHECK(Dispatcher::Exec(f, DataType::INT, 5, Device::CPU, 0) == 450);
+
+        // No overload for integers on GPUs
+        CHECK_THROWS_AS(Dispatcher::Exec(f, DataType::INT, 4, Device::GPU, 0),
+                        DispatchException);
+        // Values with no case
+        CHECK_THROWS_AS(
+            Dispatcher::Exec(f, DataType::CHAR, 4, Device::CPU, 0),
+            DeductionException);
+        CHECK_THROWS_AS(
+            Dispatcher::Exec(f, DataType::FLOAT, 3, Device::CPU, 0),
+            DeductionException);
+    }
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019-2022 Lawrence Livermore National Security, LLC and other
+// DiHydrogen Project Developers. See the top-level LICENSE file for details.
+//
+// SPDX-License-Identifier: Apache-2.0
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include <h2/utils/Expected.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+h2::Expected<int> parse_digit(char c)
+{
+    if (c < '0' || c > '9')
+        return H2_UNEXPECTED(InvalidArgument, "not a digit");
+    return c - '0';
+}
+
+h2::Expected<int> sum_digits(std::string const& str)
+{
+    int sum = 0;
+    for (char c : str)
+    {
+        auto digit = parse_digit(c);
+        if (!digit)
+            return h2::make_unexpected(digit.error());
+        sum += *digit;
+    }
+    return sum;
+}
+
+h2::Expected<void> check_digits(std::string const& str)
+{
+    H2_PROPAGATE_ERROR(sum_digits(str));
+    return {};
+}
+
+} // namespace
+
+TEST_CASE("Expected holds a value or an error", "[utilities][expected]")
+{
+    SECTION("Success")
+    {
+        auto const result = sum_digits("123");
+        REQUIRE(result.has_value());
+        CHECK(static_cast<bool>(result));
+        CHECK(*result == 6);
+        CHECK(result.value() == 6);
+        CHECK(result.value_or(-1) == 6);
+    }
+
+    SECTION("Failure")
+    {
+        auto const result = sum_digits("1x3");
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().code() == h2::ErrorCode::InvalidArgument);
+        CHECK(std::string(result.error().context()) == "not a digit");
+        CHECK(result.error().line() > 0);
+        CHECK(result.value_or(-1) == -1);
+        CHECK_THROWS_AS(result.value(), h2::BadExpectedAccess);
+    }
+
+    SECTION("Move-only values")
+    {
+        h2::Expected<std::unique_ptr<int>> result =
+            std::unique_ptr<int>(new int(42));
+        REQUIRE(result);
+        auto ptr = std::move(result).value();
+        CHECK(*ptr == 42);
+    }
+
+    SECTION("Errors print their code and context")
+    {
+        std::ostringstream oss;
+        oss << H2_MAKE_ERROR(OutOfMemory, "tensor allocation");
+        CHECK(oss.str().find("out of memory: tensor allocation")
+              != std::string::npos);
+    }
+}
+
+TEST_CASE("Expected<void> propagates errors", "[utilities][expected]")
+{
+    CHECK(check_digits("42").has_value());
+    CHECK_NOTHROW(check_digits("42").value());
+
+    auto const result = check_digits("4two");
+    REQUIRE_FALSE(result);
+    CHECK(result.error().code() == h2::ErrorCode::InvalidArgument);
+    CHECK_THROWS_AS(result.value(), h2::BadExpectedAccess);
+}
+
+TEST_CASE("Expected success path",
+          "[utilities][expected][!benchmark]")
+{
+    auto const digits = std::string(64, '7');
+    BENCHMARK("Expected")
+    {
+        return sum_digits(digits).value_or(0);
+    };
+}